@@ -364,6 +364,7 @@
       PetscEnum MATOP_SET_BLOCK_SIZES
       PetscEnum MATOP_AYPX
       PetscEnum MATOP_RESIDUAL
+      PetscEnum MATOP_INVERT_VBLOCK_DIAGONAL
 
       parameter(MATOP_SET_VALUES=0)
       parameter(MATOP_GET_ROW=1)
@@ -507,6 +508,7 @@
       parameter(MATOP_SET_BLOCK_SIZES=139)
       parameter(MATOP_AYPX=140)
       parameter(MATOP_RESIDUAL=141)
+      parameter(MATOP_INVERT_VBLOCK_DIAGONAL=142)
 !
 !
 !
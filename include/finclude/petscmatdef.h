@@ -84,6 +84,9 @@
 #define MATAIJPERM         'aijperm'
 #define MATSEQAIJPERM      'seqaijperm'
 #define MATMPIAIJPERM      'mpiaijperm'
+#define MATAIJDELTA        'aijdelta'
+#define MATSEQAIJDELTA     'seqaijdelta'
+#define MATMPIAIJDELTA     'mpiaijdelta'
 #define MATSHELL           'shell'
 #define MATDENSE           'dense'
 #define MATSEQDENSE        'seqdense'
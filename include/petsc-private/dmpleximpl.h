@@ -9,6 +9,8 @@
 PETSC_EXTERN PetscLogEvent DMPLEX_Distribute, DMPLEX_Stratify, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM;
 PETSC_EXTERN PetscLogEvent DMPLEX_Partition, DMPLEX_Distribute, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_Stratify, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM;
 
+#define DMPLEX_MAX_CONE_BLOCKS 16 /* runs of points with equal cone size which replace the cone section, must fit in an unsigned char */
+
 /* This is an integer map, in addition it is also a container class
    Design points:
      - Low storage is the most important design point
@@ -33,15 +35,21 @@ typedef struct {
   PetscInt             dim;               /* Topological mesh dimension */
 
   /* Sieve */
-  PetscSection         coneSection;       /* Layout of cones (inedges for DAG) */
+  PetscSection         coneSection;       /* Layout of cones (inedges for DAG), NULL while the cone blocks describe it */
   PetscInt             maxConeSize;       /* Cached for fast lookup */
   PetscInt            *cones;             /* Cone for each point */
   PetscInt            *coneOrientations;  /* Orientation of each cone point, means cone traveral should start on point 'o', and if negative start on -(o+1) and go in reverse */
+  PetscInt             numConeBlocks;     /* Number of runs of points with equal cone size, or 0 if the cone section is used */
+  PetscInt             coneBlockStart[DMPLEX_MAX_CONE_BLOCKS+1]; /* First point in each run, and the chart end */
+  PetscInt             coneBlockSize[DMPLEX_MAX_CONE_BLOCKS];    /* Cone size of all points in each run */
+  PetscInt             coneBlockOffset[DMPLEX_MAX_CONE_BLOCKS];  /* Offset into cones[] of the first point in each run */
+  unsigned char       *coneBlock;         /* Run of each point in the chart */
   PetscSection         supportSection;    /* Layout of cones (inedges for DAG) */
   PetscInt             maxSupportSize;    /* Cached for fast lookup */
   PetscInt            *supports;          /* Cone for each point */
   PetscBool            refinementUniform; /* Flag for uniform cell refinement */
   PetscReal            refinementLimit;   /* Maximum volume for refined cell */
+  PetscBool            interpolateLazy;   /* Create faces and edges only when a section needs them */
   PetscInt             hybridPointMax[8]; /* Allow segregation of some points, each dimension has a divider (used in VTK output and refinement) */
 
   PetscInt            *facesTmp;          /* Work space for faces operation */
@@ -68,9 +76,39 @@ typedef struct {
   PetscReal            printTol;
 } DM_Plex;
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetConeOffset_Private"
+/* The size of the cone of point p and its offset into cones[], from the cone blocks if they describe the layout, else the cone section */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexGetConeOffset_Private(DM_Plex *mesh, PetscInt p, PetscInt *size, PetscInt *off)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mesh->numConeBlocks) {
+    PetscInt b;
+
+#if defined(PETSC_USE_DEBUG)
+    if ((p < mesh->coneBlockStart[0]) || (p >= mesh->coneBlockStart[mesh->numConeBlocks])) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Mesh point %D should be in [%D, %D)", p, mesh->coneBlockStart[0], mesh->coneBlockStart[mesh->numConeBlocks]);
+#endif
+    b = mesh->coneBlock[p - mesh->coneBlockStart[0]];
+    if (size) *size = mesh->coneBlockSize[b];
+    if (off)  *off  = mesh->coneBlockOffset[b] + (p - mesh->coneBlockStart[b])*mesh->coneBlockSize[b];
+  } else {
+    if (size) {ierr = PetscSectionGetDof(mesh->coneSection, p, size);CHKERRQ(ierr);}
+    if (off)  {ierr = PetscSectionGetOffset(mesh->coneSection, p, off);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
 PETSC_EXTERN PetscErrorCode DMPlexVTKWriteAll_VTU(DM,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMPlexVTKGetCellType(DM,PetscInt,PetscInt,PetscInt*);
 PETSC_EXTERN PetscErrorCode VecView_Plex_Local(Vec,PetscViewer);
 PETSC_EXTERN PetscErrorCode VecView_Plex(Vec,PetscViewer);
+PETSC_EXTERN PetscErrorCode DMPlexView_HDF5(DM,PetscViewer);
+PETSC_EXTERN PetscErrorCode DMPlexLoad_HDF5(DM,PetscViewer);
+PETSC_EXTERN PetscErrorCode DMPlexCreateNumbering_Private(DM,PetscInt,PetscInt,PetscSF,IS*);
+PETSC_EXTERN PetscErrorCode DMPlexInterpolatePointSF_Internal(DM);
+PETSC_EXTERN PetscErrorCode DMPlexBuildFromCellListParallel_Private(DM,PetscInt,PetscInt,PetscInt,const int[],PetscSF*);
+PETSC_EXTERN PetscErrorCode DMPlexBuildCoordinatesParallel_Private(DM,PetscInt,PetscInt,PetscSF,const double[]);
 
 #endif /* _PLEXIMPL_H */
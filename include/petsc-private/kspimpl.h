@@ -279,6 +279,10 @@ PETSC_STATIC_INLINE PetscErrorCode KSP_PCApplyBAorABTranspose(KSP ksp,Vec x,Vec
 
 PETSC_EXTERN PetscLogEvent KSP_GMRESOrthogonalization, KSP_SetUp, KSP_Solve;
 
+PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigCacheKey(PC,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigCacheSet(Mat,PetscInt,PetscReal,PetscReal);
+PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigCacheGet(Mat,PetscInt,PetscReal*,PetscReal*,PetscBool*);
+
 PETSC_INTERN PetscErrorCode MatGetSchurComplement_Basic(Mat,IS,IS,IS,IS,MatReuse,Mat*,MatReuse,Mat*);
 
 #endif
@@ -41,6 +41,8 @@ PETSC_EXTERN PetscBool petsc_logObjects;
 PETSC_EXTERN int        petsc_numActions, petsc_maxActions;
 PETSC_EXTERN int        petsc_numObjects, petsc_maxObjects;
 PETSC_EXTERN int        petsc_numObjectsDestroyed;
+PETSC_EXTERN PetscBool  petsc_logcounters;
+PETSC_EXTERN PetscBool  petsc_logmemory;
 
 PETSC_EXTERN FILE          *petsc_tracefile;
 PETSC_EXTERN int            petsc_tracelevel;
@@ -65,6 +67,8 @@ PETSC_EXTERN PetscErrorCode EventPerfLogDestroy(PetscEventPerfLog);
 PETSC_EXTERN PetscErrorCode EventPerfLogEnsureSize(PetscEventPerfLog, int);
 PETSC_EXTERN PetscErrorCode EventPerfInfoClear(PetscEventPerfInfo *);
 PETSC_EXTERN PetscErrorCode EventPerfInfoCopy(PetscEventPerfInfo *, PetscEventPerfInfo *);
+PETSC_EXTERN PetscErrorCode EventPerfInfoMemoryBegin(PetscEventPerfInfo *, int);
+PETSC_EXTERN PetscErrorCode EventPerfInfoMemoryEnd(PetscEventPerfInfo *, int);
 /* Registration functions */
 PETSC_EXTERN PetscErrorCode EventRegLogRegister(PetscEventRegLog, const char [], PetscClassId, PetscLogEvent *);
 /* Query functions */
@@ -83,6 +87,15 @@ PETSC_EXTERN PetscErrorCode PetscLogEventBeginComplete(PetscLogEvent, int, Petsc
 PETSC_EXTERN PetscErrorCode PetscLogEventEndComplete(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventBeginTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventEndTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventBeginNested(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventEndNested(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_INTERN PetscErrorCode PetscLogNestedDestroy_Private(void);
+PETSC_EXTERN PetscErrorCode PetscLogEventBeginTimeline(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventEndTimeline(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_INTERN PetscErrorCode PetscLogTimelineDestroy_Private(void);
+PETSC_EXTERN PetscErrorCode PetscLogCountersRead(PetscLogDouble[]);
+PETSC_INTERN PetscErrorCode PetscLogCountersDestroy_Private(void);
+PETSC_EXTERN PetscErrorCode PetscLogBegin_Private(void);
 
 /* Creation and destruction functions */
 PETSC_EXTERN PetscErrorCode PetscClassRegLogCreate(PetscClassRegLog *);
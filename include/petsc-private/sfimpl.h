@@ -48,6 +48,7 @@ struct _p_PetscSF {
 };
 
 PETSC_EXTERN PetscBool PetscSFRegisterAllCalled;
+PETSC_EXTERN PetscLogEvent PETSCSF_Wait;
 
 PETSC_EXTERN PetscErrorCode MPIPetsc_Type_unwrap(MPI_Datatype,MPI_Datatype*);
 PETSC_EXTERN PetscErrorCode MPIPetsc_Type_compare(MPI_Datatype,MPI_Datatype,PetscBool*);
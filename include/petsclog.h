@@ -111,12 +111,15 @@ struct _n_PetscClassPerfLog {
 typedef struct {
   char         *name;         /* The name of this event */
   PetscClassId classid;       /* The class the event is associated with */
+  PetscBool    wait;          /* The event only waits for communication, see PetscLogEventSetWait() */
 #if defined (PETSC_HAVE_MPE)
   int          mpe_id_begin; /* MPE IDs that define the event */
   int          mpe_id_end;
 #endif
 } PetscEventRegInfo;
 
+#define PETSC_LOG_NUM_COUNTERS 3
+
 typedef struct {
   int            id;            /* The integer identifying this event */
   PetscBool      active;        /* The flag to activate logging */
@@ -128,6 +131,11 @@ typedef struct {
   PetscLogDouble numMessages;   /* The number of messages in this event */
   PetscLogDouble messageLength; /* The total message lengths in this event */
   PetscLogDouble numReductions; /* The number of reductions in this event */
+  PetscLogDouble counters[PETSC_LOG_NUM_COUNTERS]; /* The cycles, instructions and last level cache misses, see PetscLogCountersBegin() */
+  PetscLogDouble mallocs;       /* The number of PetscMalloc() calls in this event, see PetscLogMemoryBegin() */
+  PetscLogDouble mallocSpace;   /* The number of bytes PetscMalloc()ed in this event */
+  PetscLogDouble mallocMax;     /* The maximum memory PetscMalloc()ed during this event */
+  PetscLogDouble mallocLive;    /* The memory PetscMalloc()ed when this event last ended */
 } PetscEventPerfInfo;
 
 typedef struct _n_PetscEventRegLog *PetscEventRegLog;
@@ -227,6 +235,10 @@ PETSC_EXTERN PetscErrorCode (*PetscLogPHD)(PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
+PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogCountersBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogMemoryBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
 /* General functions */
@@ -239,6 +251,9 @@ PETSC_EXTERN PetscErrorCode PetscLogView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogViewPython(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogPrintDetailed(MPI_Comm, const char[]);
 PETSC_EXTERN PetscErrorCode PetscLogDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogNestedView(PetscViewer);
+PETSC_EXTERN PetscErrorCode PetscLogNestedViewFlameGraph(PetscViewer);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineView(PetscViewer);
 
 PETSC_EXTERN PetscErrorCode PetscGetFlops(PetscLogDouble *);
 
@@ -255,6 +270,7 @@ PETSC_EXTERN PetscErrorCode PetscLogEventRegister(const char[], PetscClassId,Pet
 PETSC_EXTERN PetscErrorCode PetscLogEventActivate(PetscLogEvent);
 PETSC_EXTERN PetscErrorCode PetscLogEventDeactivate(PetscLogEvent);
 PETSC_EXTERN PetscErrorCode PetscLogEventSetActiveAll(PetscLogEvent, PetscBool );
+PETSC_EXTERN PetscErrorCode PetscLogEventSetWait(PetscLogEvent, PetscBool );
 PETSC_EXTERN PetscErrorCode PetscLogEventActivateClass(PetscClassId);
 PETSC_EXTERN PetscErrorCode PetscLogEventDeactivateClass(PetscClassId);
 
@@ -409,6 +425,7 @@ PETSC_STATIC_INLINE PetscErrorCode PetscMPITypeSizeComm(MPI_Comm comm, PetscLogD
 #define PetscLogEventActivateClass(a)   0
 #define PetscLogEventDeactivateClass(a) 0
 #define PetscLogEventSetActiveAll(a,b)  0
+#define PetscLogEventSetWait(a,b)       0
 
 #define PetscLogPLB                        0
 #define PetscLogPLE                        0
@@ -434,6 +451,13 @@ PETSC_STATIC_INLINE PetscErrorCode PetscMPITypeSizeComm(MPI_Comm comm, PetscLogD
 #define PetscLogTraceBegin(file)            0
 #define PetscLogSet(lb,le)                  0
 #define PetscLogAllBegin()                  0
+#define PetscLogNestedBegin()               0
+#define PetscLogNestedView(viewer)          0
+#define PetscLogNestedViewFlameGraph(viewer) 0
+#define PetscLogTimelineBegin()             0
+#define PetscLogTimelineView(viewer)        0
+#define PetscLogCountersBegin()             0
+#define PetscLogMemoryBegin()               0
 #define PetscLogDump(c)                     0
 #define PetscLogEventRegister(a,b,c)        0
 #define PetscLogObjects(a)                  0
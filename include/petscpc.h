@@ -56,6 +56,7 @@ typedef const char* PCType;
 #define PCNN              "nn"
 #define PCCHOLESKY        "cholesky"
 #define PCPBJACOBI        "pbjacobi"
+#define PCVPBJACOBI       "vpbjacobi"
 #define PCMAT             "mat"
 #define PCHYPRE           "hypre"
 #define PCPARMS           "parms"
@@ -173,6 +174,9 @@ PETSC_EXTERN PetscErrorCode PCSetDiagonalScale(PC,Vec);
 PETSC_EXTERN PetscErrorCode PCJacobiSetUseRowMax(PC);
 PETSC_EXTERN PetscErrorCode PCJacobiSetUseRowSum(PC);
 PETSC_EXTERN PetscErrorCode PCJacobiSetUseAbs(PC);
+PETSC_EXTERN PetscErrorCode PCJacobiGetUseRowMax(PC,PetscBool*);
+PETSC_EXTERN PetscErrorCode PCJacobiGetUseRowSum(PC,PetscBool*);
+PETSC_EXTERN PetscErrorCode PCJacobiGetUseAbs(PC,PetscBool*);
 PETSC_EXTERN PetscErrorCode PCSORSetSymmetric(PC,MatSORType);
 PETSC_EXTERN PetscErrorCode PCSORSetOmega(PC,PetscReal);
 PETSC_EXTERN PetscErrorCode PCSORSetIterations(PC,PetscInt,PetscInt);
@@ -450,7 +454,11 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetType( PC,PCGAMGType );
 PETSC_EXTERN PetscErrorCode PCGAMGSetNSmooths(PC pc, PetscInt n);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSymGraph(PC pc, PetscBool n);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSquareGraph(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetCoarsenType(PC,MatCoarsenType);
 PETSC_EXTERN PetscErrorCode PCGAMGSetReuseProl(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetResmoothProl(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetUseSubcomm(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetCoarseRedundant(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGInitializePackage(void);
 
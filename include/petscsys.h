@@ -1073,6 +1073,11 @@ PETSC_EXTERN PetscErrorCode (*PetscTrMalloc)(size_t,int,const char[],const char[
 PETSC_EXTERN PetscErrorCode (*PetscTrFree)(void*,int,const char[],const char[],const char[]);
 PETSC_EXTERN PetscErrorCode PetscMallocSet(PetscErrorCode (*)(size_t,int,const char[],const char[],const char[],void**),PetscErrorCode (*)(void*,int,const char[],const char[],const char[]));
 PETSC_EXTERN PetscErrorCode PetscMallocClear(void);
+PETSC_EXTERN PetscErrorCode PetscMallocPool(size_t,int,const char[],const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscFreePool(void*,int,const char[],const char[],const char[]);
+PETSC_EXTERN PetscErrorCode PetscMallocPoolDestroy(void);
+PETSC_EXTERN PetscErrorCode PetscMallocSetHugePageThreshold(size_t);
+PETSC_EXTERN PetscErrorCode PetscMallocGetHugePageThreshold(size_t*);
 
 /*
     PetscLogDouble variables are used to contain double precision numbers
@@ -1089,12 +1094,17 @@ PETSC_EXTERN PetscErrorCode PetscMallocDump(FILE *);
 PETSC_EXTERN PetscErrorCode PetscMallocDumpLog(FILE *);
 PETSC_EXTERN PetscErrorCode PetscMallocGetCurrentUsage(PetscLogDouble *);
 PETSC_EXTERN PetscErrorCode PetscMallocGetMaximumUsage(PetscLogDouble *);
+PETSC_EXTERN PetscErrorCode PetscMallocGetTotalUsage(PetscLogDouble *,PetscLogDouble *);
+PETSC_EXTERN PetscErrorCode PetscMallocPushMaximumUsage(int);
+PETSC_EXTERN PetscErrorCode PetscMallocPopMaximumUsage(int,PetscLogDouble *);
 PETSC_EXTERN PetscErrorCode PetscMallocDebug(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscMallocGetDebug(PetscBool*);
 PETSC_EXTERN PetscErrorCode PetscMallocValidate(int,const char[],const char[],const char[]);
 PETSC_EXTERN PetscErrorCode PetscMallocSetDumpLog(void);
 PETSC_EXTERN PetscErrorCode PetscMallocSetDumpLogThreshold(PetscLogDouble);
 PETSC_EXTERN PetscErrorCode PetscMallocGetDumpLog(PetscBool*);
+PETSC_EXTERN PetscErrorCode PetscMallocPoolView(FILE*);
+PETSC_EXTERN PetscErrorCode PetscMallocPoolGetStatistics(PetscLogDouble*,PetscLogDouble*);
 
 /*E
     PetscDataType - Used for handling different basic data types.
@@ -1324,6 +1334,8 @@ PETSC_EXTERN PetscErrorCode PetscPythonFinalize(void);
 PETSC_EXTERN PetscErrorCode PetscPythonPrintError(void);
 PETSC_EXTERN PetscErrorCode PetscPythonMonitorSet(PetscObject,const char[]);
 
+PETSC_EXTERN PetscErrorCode PetscMallocPlacementInfo(PetscObject,const char[],const void*,size_t);
+
 /*
      These are so that in extern C code we can caste function pointers to non-extern C
    function pointers. Since the regular C++ code expects its function pointers to be C++
@@ -2361,6 +2373,21 @@ PETSC_EXTERN PetscErrorCode PetscSegBufferExtractInPlace(PetscSegBuffer,void*);
 PETSC_EXTERN PetscErrorCode PetscSegBufferGetSize(PetscSegBuffer,size_t*);
 PETSC_EXTERN PetscErrorCode PetscSegBufferUnuse(PetscSegBuffer,size_t);
 
+/*S
+   PetscArena - memory for temporary arrays that is released all at once
+
+   Level: developer
+
+.seealso: PetscArenaCreate(), PetscArenaMalloc(), PetscArenaPush(), PetscArenaPop(), PetscArenaDestroy()
+S*/
+typedef struct _n_PetscArena *PetscArena;
+PETSC_EXTERN PetscErrorCode PetscArenaCreate(size_t,PetscArena*);
+PETSC_EXTERN PetscErrorCode PetscArenaMalloc(PetscArena,size_t,void*);
+PETSC_EXTERN PetscErrorCode PetscArenaPush(PetscArena);
+PETSC_EXTERN PetscErrorCode PetscArenaPop(PetscArena);
+PETSC_EXTERN PetscErrorCode PetscArenaReset(PetscArena);
+PETSC_EXTERN PetscErrorCode PetscArenaDestroy(PetscArena*);
+
 /* Type-safe wrapper to encourage use of PETSC_RESTRICT. Does not use PetscFunctionBegin because the error handling
  * prevents the compiler from completely erasing the stub. This is called in inner loops so it has to be as fast as
  * possible. */
@@ -0,0 +1,135 @@
+
+static char help[] = "Times the SeqBAIJ MatMult(), MatMultAdd(), MatMultTranspose(), ILU(0) numeric factorization\n\
+and MatSolve() kernels over a range of block sizes, with and without the SIMD kernels.\n\
+  -m <m>           : the matrix is a 5 point stencil on an m by m grid with dense bs by bs blocks\n\
+  -bs_min <bs_min> : smallest block size\n\
+  -bs_max <bs_max> : largest block size\n\
+  -its <its>       : number of calls timed for each kernel\n\n";
+
+#include <petscmat.h>
+#include <petsctime.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "CreateMatrix"
+static PetscErrorCode CreateMatrix(PetscInt m,PetscInt bs,PetscBool simd,Mat *A)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,k,row,cols[5],nc;
+  PetscScalar    *v;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsSetValue("-mat_baij_simd",simd ? "1" : "0");CHKERRQ(ierr);
+  ierr = MatCreateSeqBAIJ(PETSC_COMM_SELF,bs,m*m*bs,m*m*bs,5,NULL,A);CHKERRQ(ierr);
+  ierr = PetscMalloc(bs*bs*sizeof(PetscScalar),&v);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    for (j=0; j<m; j++) {
+      row = i*m + j; nc = 0;
+      if (i > 0)   cols[nc++] = row - m;
+      if (j > 0)   cols[nc++] = row - 1;
+      if (j < m-1) cols[nc++] = row + 1;
+      if (i < m-1) cols[nc++] = row + m;
+      for (k=0; k<bs*bs; k++) v[k] = -1.0/(1.0 + k);
+      ierr = MatSetValuesBlocked(*A,1,&row,nc,cols,v,INSERT_VALUES);CHKERRQ(ierr);
+      for (k=0; k<bs*bs; k++) v[k] = (k % (bs+1)) ? 0.1/(1.0 + k) : 8.0*bs;
+      ierr = MatSetValuesBlocked(*A,1,&row,1,&row,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TimeKernels"
+/* t[] gets the time per call of MatMult, MatMultAdd, MatMultTranspose, ILU(0) numeric factorization and MatSolve */
+static PetscErrorCode TimeKernels(PetscInt m,PetscInt bs,PetscBool simd,PetscInt its,PetscLogDouble *t,PetscLogDouble *flops)
+{
+  PetscErrorCode ierr;
+  Mat            A,F;
+  Vec            x,y;
+  IS             row,col;
+  MatFactorInfo  info;
+  MatInfo        minfo;
+  PetscLogDouble t0,t1;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  ierr = CreateMatrix(m,bs,simd,&A);CHKERRQ(ierr);
+  ierr = MatGetInfo(A,MAT_LOCAL,&minfo);CHKERRQ(ierr);
+  *flops = 2.0*minfo.nz_used;
+  ierr = MatGetVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {ierr = MatMult(A,x,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  t[0] = (t1-t0)/its;
+
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {ierr = MatMultAdd(A,x,y,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  t[1] = (t1-t0)/its;
+
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {ierr = MatMultTranspose(A,x,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  t[2] = (t1-t0)/its;
+
+  ierr = MatGetOrdering(A,MATORDERINGNATURAL,&row,&col);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill = 1.0;
+  ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+  ierr = MatILUFactorSymbolic(F,A,row,col,&info);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  t[3] = (t1-t0)/its;
+
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {ierr = MatSolve(F,x,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  t[4] = (t1-t0)/its;
+
+  ierr = ISDestroy(&row);CHKERRQ(ierr);
+  ierr = ISDestroy(&col);CHKERRQ(ierr);
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  const char     *names[] = {"MatMult","MatMultAdd","MatMultTranspose","MatLUFactorNumeric","MatSolve"};
+  PetscLogDouble ts[5],tv[5],flops;
+  PetscInt       m = 100,bs,bs_min = 1,bs_max = 8,its = 20,k;
+  PetscErrorCode ierr;
+
+  PetscInitialize(&argc,&argv,0,help);
+  ierr = PetscOptionsGetInt(NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-bs_min",&bs_min,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-bs_max",&bs_max,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-its",&its,NULL);CHKERRQ(ierr);
+
+  ierr = PetscPrintf(PETSC_COMM_SELF,"SeqBAIJ kernels : %D x %D grid, 5 point stencil, time per call\n",m,m);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"    %-2s %-20s %12s %12s %8s %10s\n","bs","kernel","scalar (s)","simd (s)","speedup","Mflop/s");CHKERRQ(ierr);
+  for (bs=bs_min; bs<=bs_max; bs++) {
+    ierr = TimeKernels(m,bs,PETSC_FALSE,its,ts,&flops);CHKERRQ(ierr);
+    ierr = TimeKernels(m,bs,PETSC_TRUE,its,tv,&flops);CHKERRQ(ierr);
+    for (k=0; k<5; k++) {
+      if (k < 3) {
+        ierr = PetscPrintf(PETSC_COMM_SELF,"    %-2D %-20s %12.4e %12.4e %8.2f %10.1f\n",bs,names[k],ts[k],tv[k],ts[k]/tv[k],1.e-6*flops/tv[k]);CHKERRQ(ierr);
+      } else {
+        ierr = PetscPrintf(PETSC_COMM_SELF,"    %-2D %-20s %12.4e %12.4e %8.2f\n",bs,names[k],ts[k],tv[k],ts[k]/tv[k]);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = PetscFinalize();
+  return 0;
+}
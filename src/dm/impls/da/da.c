@@ -596,6 +596,9 @@ PetscErrorCode  DMDASetOwnershipRanges(DM da, const PetscInt lx[], const PetscIn
 
    Notes: you should call this on the coarser of the two DMDAs you pass to DMCreateInterpolation()
 
+   If the matrix type of the DMDA is MATSHELL (DMSetMatType() or -dm_mat_type shell) the DMDA_Q1 interpolation is
+   a MATSHELL that applies the stencil without storing the matrix, so multigrid hierarchies can be fully matrix-free
+
 .keywords:  distributed array, interpolation
 
 .seealso: DMDACreate1d(), DMDACreate2d(), DMDACreate3d(), DMDestroy(), DMDA, DMDAInterpolationType
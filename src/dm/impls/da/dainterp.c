@@ -971,6 +971,215 @@ PetscErrorCode DMCreateInterpolation_DA_3D_Q1(DM dac,DM daf,Mat *A)
   PetscFunctionReturn(0);
 }
 
+/*
+   Matrix-free Q1 interpolation: the weights are recomputed from the grid indices in each application, only the
+   scatter of the coarse ghost box (including the corners, also with DMDA_STENCIL_STAR) is stored.
+*/
+typedef struct {
+  PetscInt   dof;
+  PetscInt   ratio[3];          /* refinement ratio in each direction, 1 for directions not present */
+  PetscInt   fs[3],fm[3];       /* owned corner and size on the fine grid */
+  PetscInt   cgs[3],cgm[3];     /* ghost corner and size on the coarse grid */
+  VecScatter scatter;           /* coarse global vector to the coarse ghost box */
+  Vec        cghost;            /* sequential vector on the coarse ghost box */
+} DMDAInterpShell;
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDAInterpShellApply_Private"
+/*
+   y += P x with x on the coarse ghost box and y on the owned fine points, or x += P^T y with transpose
+*/
+static PetscErrorCode DMDAInterpShellApply_Private(DMDAInterpShell *ctx,PetscScalar *xc,PetscScalar *yf,PetscBool transpose)
+{
+  PetscErrorCode ierr;
+  const PetscInt dof = ctx->dof,*r = ctx->ratio;
+  PetscInt       i,j,k,ic,jc,kc,ii,jj,kk,nx,ny,nz,c,nterms = 0;
+  PetscReal      wx[2],wy[2],wz[2],w;
+  PetscScalar    *yrow,*xp;
+
+  PetscFunctionBegin;
+  for (k=ctx->fs[2]; k<ctx->fs[2]+ctx->fm[2]; k++) {
+    kc    = k/r[2];
+    wz[1] = ((PetscReal)(k - kc*r[2]))/((PetscReal)r[2]); wz[0] = 1.0 - wz[1];
+    nz    = (kc*r[2] != k) ? 2 : 1;
+    for (j=ctx->fs[1]; j<ctx->fs[1]+ctx->fm[1]; j++) {
+      jc    = j/r[1];
+      wy[1] = ((PetscReal)(j - jc*r[1]))/((PetscReal)r[1]); wy[0] = 1.0 - wy[1];
+      ny    = (jc*r[1] != j) ? 2 : 1;
+      for (i=ctx->fs[0]; i<ctx->fs[0]+ctx->fm[0]; i++) {
+        ic    = i/r[0];
+        wx[1] = ((PetscReal)(i - ic*r[0]))/((PetscReal)r[0]); wx[0] = 1.0 - wx[1];
+        nx    = (ic*r[0] != i) ? 2 : 1;
+        yrow  = yf + dof*(((k-ctx->fs[2])*ctx->fm[1] + (j-ctx->fs[1]))*ctx->fm[0] + (i-ctx->fs[0]));
+        nterms += nx*ny*nz;
+        for (kk=0; kk<nz; kk++) {
+          for (jj=0; jj<ny; jj++) {
+            for (ii=0; ii<nx; ii++) {
+              w  = wz[kk]*wy[jj]*wx[ii];
+              xp = xc + dof*(((kc+kk-ctx->cgs[2])*ctx->cgm[1] + (jc+jj-ctx->cgs[1]))*ctx->cgm[0] + (ic+ii-ctx->cgs[0]));
+              if (transpose) {
+                for (c=0; c<dof; c++) xp[c] += w*yrow[c];
+              } else {
+                for (c=0; c<dof; c++) yrow[c] += w*xp[c];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  ierr = PetscLogFlops(2.0*dof*nterms);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultAdd_DAInterpShell"
+static PetscErrorCode MatMultAdd_DAInterpShell(Mat A,Vec x,Vec w,Vec y)
+{
+  PetscErrorCode  ierr;
+  DMDAInterpShell *ctx;
+  PetscScalar     *xc,*yf;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&ctx);CHKERRQ(ierr);
+  if (w != y) {ierr = VecCopy(w,y);CHKERRQ(ierr);}
+  ierr = VecScatterBegin(ctx->scatter,x,ctx->cghost,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(ctx->scatter,x,ctx->cghost,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGetArray(ctx->cghost,&xc);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yf);CHKERRQ(ierr);
+  ierr = DMDAInterpShellApply_Private(ctx,xc,yf,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&yf);CHKERRQ(ierr);
+  ierr = VecRestoreArray(ctx->cghost,&xc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMult_DAInterpShell"
+static PetscErrorCode MatMult_DAInterpShell(Mat A,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(y,0.0);CHKERRQ(ierr);
+  ierr = MatMultAdd_DAInterpShell(A,x,y,y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultTransposeAdd_DAInterpShell"
+static PetscErrorCode MatMultTransposeAdd_DAInterpShell(Mat A,Vec x,Vec w,Vec y)
+{
+  PetscErrorCode  ierr;
+  DMDAInterpShell *ctx;
+  PetscScalar     *xc,*yf;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&ctx);CHKERRQ(ierr);
+  if (w != y) {ierr = VecCopy(w,y);CHKERRQ(ierr);}
+  ierr = VecSet(ctx->cghost,0.0);CHKERRQ(ierr);
+  ierr = VecGetArray(ctx->cghost,&xc);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&yf);CHKERRQ(ierr);
+  ierr = DMDAInterpShellApply_Private(ctx,xc,yf,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = VecRestoreArray(x,&yf);CHKERRQ(ierr);
+  ierr = VecRestoreArray(ctx->cghost,&xc);CHKERRQ(ierr);
+  ierr = VecScatterBegin(ctx->scatter,ctx->cghost,y,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  ierr = VecScatterEnd(ctx->scatter,ctx->cghost,y,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultTranspose_DAInterpShell"
+static PetscErrorCode MatMultTranspose_DAInterpShell(Mat A,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(y,0.0);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd_DAInterpShell(A,x,y,y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDestroy_DAInterpShell"
+static PetscErrorCode MatDestroy_DAInterpShell(Mat A)
+{
+  PetscErrorCode  ierr;
+  DMDAInterpShell *ctx;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,(void**)&ctx);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&ctx->scatter);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->cghost);CHKERRQ(ierr);
+  ierr = PetscFree(ctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMCreateInterpolation_DA_Shell_Q1"
+/*
+   Q1 interpolation in 1, 2 or 3 dimensions as a MATSHELL; same weights as DMCreateInterpolation_DA_[123]D_Q1()
+*/
+PetscErrorCode DMCreateInterpolation_DA_Shell_Q1(DM dac,DM daf,Mat *A)
+{
+  PetscErrorCode   ierr;
+  PetscInt         dim,dof,d,Mc[3],Mf[3],mc[3],nghost,*idx_c,lo,hi;
+  DMDABoundaryType bd[3];
+  PetscMPIInt      size_c,size_f;
+  DMDAInterpShell  *ctx;
+  IS               is;
+  Vec              vc;
+  MPI_Comm         comm;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)daf,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)dac),&size_c);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size_f);CHKERRQ(ierr);
+  if (size_c != size_f) SETERRQ2(comm,PETSC_ERR_SUP,"Matrix-free interpolation requires the coarse DMDA on the same processes, %d != %d",size_c,size_f);
+  ierr = DMDAGetInfo(dac,&dim,&Mc[0],&Mc[1],&Mc[2],0,0,0,0,0,&bd[0],&bd[1],&bd[2],0);CHKERRQ(ierr);
+  ierr = DMDAGetInfo(daf,0,&Mf[0],&Mf[1],&Mf[2],0,0,0,&dof,0,0,0,0,0);CHKERRQ(ierr);
+
+  ierr     = PetscNew(DMDAInterpShell,&ctx);CHKERRQ(ierr);
+  ctx->dof = dof;
+  ierr     = DMDAGetCorners(daf,&ctx->fs[0],&ctx->fs[1],&ctx->fs[2],&ctx->fm[0],&ctx->fm[1],&ctx->fm[2]);CHKERRQ(ierr);
+  ierr     = DMDAGetCorners(dac,0,0,0,&mc[0],&mc[1],&mc[2]);CHKERRQ(ierr);
+  ierr     = DMDAGetGhostCorners(dac,&ctx->cgs[0],&ctx->cgs[1],&ctx->cgs[2],&ctx->cgm[0],&ctx->cgm[1],&ctx->cgm[2]);CHKERRQ(ierr);
+  for (d=0; d<3; d++) {
+    if (d >= dim) ctx->ratio[d] = 1;
+    else if (bd[d] == DMDA_BOUNDARY_PERIODIC) {
+      ctx->ratio[d] = Mf[d]/Mc[d];
+      if (ctx->ratio[d]*Mc[d] != Mf[d]) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Ratio between levels: fine/coarse must be integer in direction %D: fine %D coarse %D",d,Mf[d],Mc[d]);
+    } else {
+      ctx->ratio[d] = (Mf[d]-1)/(Mc[d]-1);
+      if (ctx->ratio[d]*(Mc[d]-1) != Mf[d]-1) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Ratio between levels: (fine - 1)/(coarse - 1) must be integer in direction %D: fine %D coarse %D",d,Mf[d],Mc[d]);
+    }
+    if (!ctx->fm[d]) continue;
+    /* the coarse points used by the owned fine points must be in the coarse ghost box */
+    lo = ctx->fs[d]/ctx->ratio[d];
+    hi = (ctx->fs[d]+ctx->fm[d]-1)/ctx->ratio[d];
+    if (hi*ctx->ratio[d] != ctx->fs[d]+ctx->fm[d]-1) hi++;
+    if (lo < ctx->cgs[d] || hi >= ctx->cgs[d]+ctx->cgm[d]) SETERRQ5(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Processor's coarse DMDA must lie over fine DMDA\n\
+                                          direction %D coarse points %D to %D, ghost coarse points %D to %D",d,lo,hi,ctx->cgs[d],ctx->cgs[d]+ctx->cgm[d]-1);
+  }
+
+  /* scatter to the whole coarse ghost box, the global indices cover it also for the star stencil */
+  nghost = dof*ctx->cgm[0]*ctx->cgm[1]*ctx->cgm[2];
+  ierr   = DMDAGetGlobalIndices(dac,NULL,&idx_c);CHKERRQ(ierr);
+  ierr   = ISCreateGeneral(PETSC_COMM_SELF,nghost,idx_c,PETSC_COPY_VALUES,&is);CHKERRQ(ierr);
+  ierr   = VecCreateSeq(PETSC_COMM_SELF,nghost,&ctx->cghost);CHKERRQ(ierr);
+  ierr   = DMGetGlobalVector(dac,&vc);CHKERRQ(ierr);
+  ierr   = VecScatterCreate(vc,is,ctx->cghost,NULL,&ctx->scatter);CHKERRQ(ierr);
+  ierr   = DMRestoreGlobalVector(dac,&vc);CHKERRQ(ierr);
+  ierr   = ISDestroy(&is);CHKERRQ(ierr);
+
+  ierr = MatCreateShell(comm,dof*ctx->fm[0]*ctx->fm[1]*ctx->fm[2],dof*mc[0]*mc[1]*mc[2],dof*Mf[0]*Mf[1]*Mf[2],dof*Mc[0]*Mc[1]*Mc[2],ctx,A);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT,(void (*)(void))MatMult_DAInterpShell);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT_ADD,(void (*)(void))MatMultAdd_DAInterpShell);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT_TRANSPOSE,(void (*)(void))MatMultTranspose_DAInterpShell);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT_TRANSPOSE_ADD,(void (*)(void))MatMultTransposeAdd_DAInterpShell);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_DESTROY,(void (*)(void))MatDestroy_DAInterpShell);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMCreateInterpolation_DA"
 PetscErrorCode  DMCreateInterpolation_DA(DM dac,DM daf,Mat *A,Vec *scale)
@@ -980,6 +1189,7 @@ PetscErrorCode  DMCreateInterpolation_DA(DM dac,DM daf,Mat *A,Vec *scale)
   DMDABoundaryType bxc,byc,bzc,bxf,byf,bzf;
   DMDAStencilType  stc,stf;
   DM_DA            *ddc = (DM_DA*)dac->data;
+  PetscBool        shell;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dac,DM_CLASSID,1);
@@ -998,7 +1208,11 @@ PetscErrorCode  DMCreateInterpolation_DA(DM dac,DM daf,Mat *A,Vec *scale)
   if (dimc > 1 && Nc < 2 && Nf > 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Coarse grid requires at least 2 points in y direction");
   if (dimc > 2 && Pc < 2 && Pf > 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Coarse grid requires at least 2 points in z direction");
 
-  if (ddc->interptype == DMDA_Q1) {
+  ierr = PetscStrcmp(dac->mattype,MATSHELL,&shell);CHKERRQ(ierr);
+  if (shell) {
+    if (ddc->interptype != DMDA_Q1) SETERRQ(PetscObjectComm((PetscObject)daf),PETSC_ERR_SUP,"Matrix-free interpolation only for DMDA_Q1");
+    ierr = DMCreateInterpolation_DA_Shell_Q1(dac,daf,A);CHKERRQ(ierr);
+  } else if (ddc->interptype == DMDA_Q1) {
     if (dimc == 1) {
       ierr = DMCreateInterpolation_DA_1D_Q1(dac,daf,A);CHKERRQ(ierr);
     } else if (dimc == 2) {
@@ -617,6 +617,7 @@ PetscErrorCode DMCreateMatrix_DA(DM da, Mat *J)
   Mat            A;
   MPI_Comm       comm;
   MatType        Atype;
+  PetscBool      isShell;
   PetscSection   section, sectionGlobal;
   void           (*aij)(void)=NULL,(*baij)(void)=NULL,(*sbaij)(void)=NULL;
   MatType        mtype;
@@ -631,7 +632,7 @@ PetscErrorCode DMCreateMatrix_DA(DM da, Mat *J)
   if (section) {
     PetscInt  bs = -1;
     PetscInt  localSize;
-    PetscBool isShell, isBlock, isSeqBlock, isMPIBlock, isSymBlock, isSymSeqBlock, isSymMPIBlock, isSymmetric;
+    PetscBool isBlock, isSeqBlock, isMPIBlock, isSymBlock, isSymSeqBlock, isSymMPIBlock, isSymmetric;
 
     ierr = DMGetDefaultGlobalSection(da, &sectionGlobal);CHKERRQ(ierr);
     ierr = PetscSectionGetConstrainedStorageSize(sectionGlobal, &localSize);CHKERRQ(ierr);
@@ -788,7 +789,8 @@ PetscErrorCode DMCreateMatrix_DA(DM da, Mat *J)
   ierr = MatSetStencil(A,dim,dims,starts,dof);CHKERRQ(ierr);
   ierr = MatSetDM(A,da);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
-  if (size > 1) {
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSHELL,&isShell);CHKERRQ(ierr);
+  if (size > 1 && !isShell) {
     /* change viewer to display matrix in natural ordering */
     ierr = MatShellSetOperation(A, MATOP_VIEW, (void (*)(void))MatView_MPI_DA);CHKERRQ(ierr);
     ierr = MatShellSetOperation(A, MATOP_LOAD, (void (*)(void))MatLoad_MPI_DA);CHKERRQ(ierr);
@@ -0,0 +1,311 @@
+static char help[] = "Tests distribution, parallel refinement and lazy interpolation of a DMPlex which is already spread over several processes\n\n";
+
+#include <petscdmplex.h>
+#include <petscsf.h>
+
+typedef struct {
+  PetscInt  debug;        /* The debugging level */
+  PetscInt  numXCells;    /* The number of cells in each row */
+  PetscBool interpolate;  /* Generate intermediate mesh elements */
+  PetscBool serial;       /* Create the whole mesh on the first process */
+  PetscBool cellList;     /* Create the mesh from contiguous slabs of cells and vertices, as a parallel reader does */
+  PetscBool redistribute; /* Distribute the distributed mesh again */
+  PetscBool rankLabel;    /* Before redistributing, label the cells of every process but the first */
+  PetscInt  numLevels;    /* The number of uniform refinements of the distributed mesh */
+  PetscBool faceDofs;     /* Lay out a field on the faces of an uninterpolated mesh, which creates the faces lazily */
+} AppCtx;
+
+#undef __FUNCT__
+#define __FUNCT__ "ProcessOptions"
+PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  options->debug        = 0;
+  options->numXCells    = 2;
+  options->interpolate  = PETSC_FALSE;
+  options->serial       = PETSC_FALSE;
+  options->cellList     = PETSC_FALSE;
+  options->redistribute = PETSC_FALSE;
+  options->rankLabel    = PETSC_FALSE;
+  options->numLevels    = 0;
+  options->faceDofs     = PETSC_FALSE;
+
+  ierr = PetscOptionsBegin(comm, "", "Distribution Problem Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-debug", "The debugging level", "ex10.c", options->debug, &options->debug, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_x_cells", "The number of cells in each row", "ex10.c", options->numXCells, &options->numXCells, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-interpolate", "Generate intermediate mesh elements, only with -serial or -cell_list", "ex10.c", options->interpolate, &options->interpolate, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-serial", "Create the whole mesh on the first process", "ex10.c", options->serial, &options->serial, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-cell_list", "Create the mesh from contiguous slabs of cells and vertices", "ex10.c", options->cellList, &options->cellList, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-redistribute", "Distribute the distributed mesh again", "ex10.c", options->redistribute, &options->redistribute, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-rank_label", "Before redistributing, label the cells of every process but the first", "ex10.c", options->rankLabel, &options->rankLabel, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-num_levels", "The number of uniform refinements of the distributed mesh, needs -interpolate", "ex10.c", options->numLevels, &options->numLevels, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-face_dofs", "Lay out a field on faces, creating them lazily when not interpolated", "ex10.c", options->faceDofs, &options->faceDofs, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+};
+
+#undef __FUNCT__
+#define __FUNCT__ "CreateMeshCellList"
+/* The same strip of quadrilaterals, but each process holds a contiguous slab of the cells and of the vertices */
+PetscErrorCode CreateMeshCellList(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  const PetscInt nx = user->numXCells;
+  PetscInt       numRows, numCells, numVertices, cStart, cEnd, vStart, vEnd, c, v;
+  int           *cells;
+  double        *coords;
+  PetscMPIInt    rank, size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  numRows     = size*(size+1)/2;
+  numCells    = numRows*nx;
+  numVertices = (numRows+1)*(nx+1);
+  cStart      = rank*(numCells/size) + PetscMin(rank, numCells%size);
+  cEnd        = cStart + numCells/size + (rank < numCells%size ? 1 : 0);
+  vStart      = rank*(numVertices/size) + PetscMin(rank, numVertices%size);
+  vEnd        = vStart + numVertices/size + (rank < numVertices%size ? 1 : 0);
+  ierr = PetscMalloc2((cEnd-cStart)*4,int,&cells,(vEnd-vStart)*2,double,&coords);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt i = c%nx, j = c/nx, off = (c-cStart)*4;
+
+    cells[off+0] = j*(nx+1)+i;
+    cells[off+1] = j*(nx+1)+i+1;
+    cells[off+2] = (j+1)*(nx+1)+i+1;
+    cells[off+3] = (j+1)*(nx+1)+i;
+  }
+  for (v = vStart; v < vEnd; ++v) {
+    coords[(v-vStart)*2+0] = v%(nx+1);
+    coords[(v-vStart)*2+1] = v/(nx+1);
+  }
+  ierr = DMPlexCreateFromCellListParallel(comm, 2, cEnd-cStart, vEnd-vStart, 4, user->interpolate, cells, 2, coords, NULL, dm);CHKERRQ(ierr);
+  ierr = PetscFree2(cells,coords);CHKERRQ(ierr);
+  ierr = DMPlexCreateLabel(*dm, "row");CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {ierr = DMPlexSetLabelValue(*dm, "row", c-cStart, c/nx);CHKERRQ(ierr);}
+  ierr = PetscObjectSetName((PetscObject) *dm, "Strip Mesh");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CreateMesh"
+/* Process r holds rows [r(r+1)/2, (r+1)(r+2)/2) of a strip of quadrilaterals, so the pieces are unbalanced. The bottom
+   row of vertices on process r is shared with the top row on process r-1, which owns it. Each cell is labeled with
+   its row. With -serial, the first process holds all the rows. */
+PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  const PetscInt nx = user->numXCells;
+  PetscInt       rStart, numRows, numCells, numVertices, i, j;
+  int           *cells;
+  double        *coords;
+  PetscMPIInt    rank, size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (user->cellList) {
+    ierr = CreateMeshCellList(comm, user, dm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  if (user->serial) {
+    rStart  = 0;
+    numRows = !rank ? size*(size+1)/2 : 0;
+  } else {
+    rStart  = rank*(rank+1)/2;
+    numRows = rank+1;
+  }
+  numCells    = numRows*nx;
+  numVertices = numRows ? (numRows+1)*(nx+1) : 0;
+  ierr = PetscMalloc2(numCells*4,int,&cells,numVertices*2,double,&coords);CHKERRQ(ierr);
+  for (j = 0; j < numRows; ++j) {
+    for (i = 0; i < nx; ++i) {
+      const PetscInt c = j*nx+i;
+
+      cells[c*4+0] = j*(nx+1)+i;
+      cells[c*4+1] = j*(nx+1)+i+1;
+      cells[c*4+2] = (j+1)*(nx+1)+i+1;
+      cells[c*4+3] = (j+1)*(nx+1)+i;
+    }
+  }
+  for (j = 0; j < (numRows ? numRows+1 : 0); ++j) {
+    for (i = 0; i <= nx; ++i) {
+      coords[(j*(nx+1)+i)*2+0] = i;
+      coords[(j*(nx+1)+i)*2+1] = rStart+j;
+    }
+  }
+  ierr = DMPlexCreateFromCellList(comm, 2, numCells, numVertices, 4, user->interpolate, cells, 2, coords, dm);CHKERRQ(ierr);
+  ierr = PetscFree2(cells,coords);CHKERRQ(ierr);
+  ierr = DMPlexCreateLabel(*dm, "row");CHKERRQ(ierr);
+  for (j = 0; j < numRows; ++j) {
+    for (i = 0; i < nx; ++i) {ierr = DMPlexSetLabelValue(*dm, "row", j*nx+i, rStart+j);CHKERRQ(ierr);}
+  }
+  {
+    PetscSF      sf;
+    PetscInt    *localPoints  = NULL;
+    PetscSFNode *remotePoints = NULL;
+    PetscInt     numLeaves    = (!user->serial && rank) ? nx+1 : 0;
+
+    ierr = PetscMalloc2(numLeaves,PetscInt,&localPoints,numLeaves,PetscSFNode,&remotePoints);CHKERRQ(ierr);
+    for (i = 0; i < numLeaves; ++i) {
+      localPoints[i]        = numCells + i;
+      remotePoints[i].rank  = rank-1;
+      remotePoints[i].index = rank*nx + rank*(nx+1) + i;
+    }
+    ierr = DMGetPointSF(*dm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sf, numCells+numVertices, numLeaves, localPoints, PETSC_COPY_VALUES, remotePoints, PETSC_COPY_VALUES);CHKERRQ(ierr);
+    ierr = PetscFree2(localPoints,remotePoints);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectSetName((PetscObject) *dm, "Strip Mesh");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CheckMesh"
+/* Check that every cell still carries its row label, and count the owned vertices and edges */
+PetscErrorCode CheckMesh(DM dm, AppCtx *user)
+{
+  MPI_Comm       comm;
+  PetscSF        sf;
+  PetscSection   coordSection;
+  Vec            coordinates;
+  const PetscInt *leaves;
+  PetscInt       cStart, cEnd, vStart, vEnd, c, l, numLeaves, numOwned, counts[3], gcounts[3];
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  counts[0] = cEnd - cStart;
+  counts[2] = 0;
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *coords = NULL;
+    PetscReal    y      = 0.0;
+    PetscInt     csize, row, d;
+
+    ierr = DMPlexVecGetClosure(dm, coordSection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    for (d = 0; d < csize/2; ++d) y += PetscRealPart(coords[d*2+1]);
+    ierr = DMPlexVecRestoreClosure(dm, coordSection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    ierr = DMPlexGetLabelValue(dm, "row", c, &row);CHKERRQ(ierr);
+    /* Refined cells keep the row label of their parent */
+    y   /= 4.0;
+    if ((csize != 8) || (y < row) || (y > row+1)) ++counts[2];
+  }
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, NULL, &numLeaves, &leaves, NULL);CHKERRQ(ierr);
+  numOwned = vEnd - vStart;
+  for (l = 0; l < numLeaves; ++l) {
+    const PetscInt point = leaves ? leaves[l] : l;
+
+    if ((point >= vStart) && (point < vEnd)) --numOwned;
+  }
+  counts[1] = numOwned;
+  ierr = PetscSynchronizedPrintf(comm, "[%d] cells %D vertices %D owned vertices %D\n", rank, cEnd-cStart, vEnd-vStart, numOwned);CHKERRQ(ierr);
+  ierr = PetscSynchronizedFlush(comm);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(counts, gcounts, 3, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm, "Total cells %D owned vertices %D misplaced cells %D\n", gcounts[0], gcounts[1], gcounts[2]);CHKERRQ(ierr);
+  if (user->interpolate) {
+    PetscInt eStart, eEnd, numOwnedEdges, numEdges;
+
+    ierr = DMPlexGetDepthStratum(dm, 1, &eStart, &eEnd);CHKERRQ(ierr);
+    numOwnedEdges = eEnd - eStart;
+    for (l = 0; l < numLeaves; ++l) {
+      const PetscInt point = leaves ? leaves[l] : l;
+
+      if ((point >= eStart) && (point < eEnd)) --numOwnedEdges;
+    }
+    ierr = MPI_Allreduce(&numOwnedEdges, &numEdges, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "Total owned edges %D\n", numEdges);CHKERRQ(ierr);
+  }
+  if (user->debug) {ierr = DMView(dm, PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc, char **argv)
+{
+  AppCtx         user;
+  DM             dm, distributedMesh;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);CHKERRQ(ierr);
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = CheckMesh(dm, &user);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, "simple", 0, NULL, &distributedMesh);CHKERRQ(ierr);
+  if (distributedMesh) {
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    dm   = distributedMesh;
+  }
+  ierr = CheckMesh(dm, &user);CHKERRQ(ierr);
+  if (user.redistribute) {
+    if (user.rankLabel) {
+      PetscInt    cStart, cEnd, c;
+      PetscMPIInt rank;
+
+      /* The first process does not even know the label, which must not get lost */
+      ierr = MPI_Comm_rank(PETSC_COMM_WORLD, &rank);CHKERRQ(ierr);
+      ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+      if (rank) {
+        ierr = DMPlexCreateLabel(dm, "rank");CHKERRQ(ierr);
+        for (c = cStart; c < cEnd; ++c) {ierr = DMPlexSetLabelValue(dm, "rank", c, rank);CHKERRQ(ierr);}
+      }
+    }
+    ierr = DMPlexDistribute(dm, "simple", 0, NULL, &distributedMesh);CHKERRQ(ierr);
+    if (distributedMesh) {
+      ierr = DMDestroy(&dm);CHKERRQ(ierr);
+      dm   = distributedMesh;
+    }
+    ierr = CheckMesh(dm, &user);CHKERRQ(ierr);
+    if (user.rankLabel) {
+      DMLabel     label;
+      PetscInt    numLabeled, numLabeledGlobal;
+      PetscMPIInt size, p;
+
+      ierr = MPI_Comm_size(PETSC_COMM_WORLD, &size);CHKERRQ(ierr);
+      ierr = DMPlexGetLabel(dm, "rank", &label);CHKERRQ(ierr);
+      if (!label) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "The label \"rank\" was lost in the redistribution");
+      for (p = 1; p < size; ++p) {
+        ierr = DMLabelGetStratumSize(label, p, &numLabeled);CHKERRQ(ierr);
+        ierr = MPI_Allreduce(&numLabeled, &numLabeledGlobal, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);CHKERRQ(ierr);
+        ierr = PetscPrintf(PETSC_COMM_WORLD, "Total cells labeled by process %d %D\n", p, numLabeledGlobal);CHKERRQ(ierr);
+      }
+    }
+  }
+  if (user.numLevels) {
+    DM      *dmRefined;
+    PetscInt l;
+
+    ierr = PetscMalloc(user.numLevels * sizeof(DM), &dmRefined);CHKERRQ(ierr);
+    ierr = DMPlexSetRefinementUniform(dm, PETSC_TRUE);CHKERRQ(ierr);
+    ierr = DMRefineHierarchy(dm, user.numLevels, dmRefined);CHKERRQ(ierr);
+    for (l = 0; l < user.numLevels; ++l) {
+      ierr = CheckMesh(dmRefined[l], &user);CHKERRQ(ierr);
+      ierr = DMDestroy(&dmRefined[l]);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(dmRefined);CHKERRQ(ierr);
+  }
+  if (user.faceDofs) {
+    PetscSection section;
+    PetscInt     numDof[3] = {0, 1, 0};
+
+    ierr = DMPlexSetInterpolationLazy(dm, PETSC_TRUE);CHKERRQ(ierr);
+    ierr = DMPlexCreateSection(dm, 2, 1, NULL, numDof, 0, NULL, NULL, &section);CHKERRQ(ierr);
+    ierr = DMSetDefaultSection(dm, section);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&section);CHKERRQ(ierr);
+    user.interpolate = PETSC_TRUE;
+    ierr = CheckMesh(dm, &user);CHKERRQ(ierr);
+  }
+  ierr = DMViewFromOptions(dm, NULL, "-final_dm_view");CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
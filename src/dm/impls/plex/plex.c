@@ -108,6 +108,126 @@ PetscErrorCode VecView_Plex(Vec v, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscSectionGetMemory_Private"
+/* Bytes held by the atlas, constraints and fields of a section */
+static PetscErrorCode PetscSectionGetMemory_Private(PetscSection s, PetscLogDouble *mem)
+{
+  PetscInt       f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!s) PetscFunctionReturn(0);
+  *mem += 2*(s->atlasLayout.pEnd - s->atlasLayout.pStart)*sizeof(PetscInt);
+  if (s->bc) {
+    PetscInt size;
+
+    ierr  = PetscSectionGetMemory_Private(s->bc, mem);CHKERRQ(ierr);
+    ierr  = PetscSectionGetStorageSize(s->bc, &size);CHKERRQ(ierr);
+    *mem += size*sizeof(PetscInt);
+  }
+  for (f = 0; f < s->numFields; ++f) {ierr = PetscSectionGetMemory_Private(s->field[f], mem);CHKERRQ(ierr);}
+  ierr = PetscSectionGetMemory_Private(s->clSection, mem);CHKERRQ(ierr);
+  if (s->clIndices) {
+    PetscInt size;
+
+    ierr  = ISGetLocalSize(s->clIndices, &size);CHKERRQ(ierr);
+    *mem += size*sizeof(PetscInt);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscSFGetMemory_Private"
+/* Bytes held by the graph of a star forest */
+static PetscErrorCode PetscSFGetMemory_Private(PetscSF sf, PetscLogDouble *mem)
+{
+  PetscInt       nroots, nleaves;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!sf) PetscFunctionReturn(0);
+  ierr = PetscSFGetGraph(sf, &nroots, &nleaves, NULL, NULL);CHKERRQ(ierr);
+  if (nroots < 0) PetscFunctionReturn(0);
+  *mem += nleaves*(sizeof(PetscInt) + sizeof(PetscSFNode));
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexView_Memory_Private"
+/*
+  DMPlexView_Memory_Private - Print the bytes used by the mesh topology, labels, sections, coordinates and star forests,
+  summed and maximized over the processes. Only the arrays which grow with the mesh are counted.
+*/
+static PetscErrorCode DMPlexView_Memory_Private(DM dm, PetscViewer viewer)
+{
+  DM_Plex          *mesh = (DM_Plex*) dm->data;
+  DMLabel           next = mesh->labels;
+  DM                cdm;
+  const char       *names[6] = {"Topology", "Labels", "Sections", "Coordinates", "Star forests", "Total"};
+  PetscLogDouble    mem[6], memSum[6], memMax[6];
+  PetscInt          size, i;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(mem, 6 * sizeof(PetscLogDouble));CHKERRQ(ierr);
+  /* Topology: cone and support sections, cones, orientations and supports */
+  ierr    = PetscSectionGetMemory_Private(mesh->coneSection, &mem[0]);CHKERRQ(ierr);
+  ierr    = PetscSectionGetMemory_Private(mesh->supportSection, &mem[0]);CHKERRQ(ierr);
+  if (mesh->numConeBlocks) {
+    const PetscInt nb = mesh->numConeBlocks;
+
+    size    = mesh->coneBlockOffset[nb-1] + (mesh->coneBlockStart[nb] - mesh->coneBlockStart[nb-1])*mesh->coneBlockSize[nb-1];
+    mem[0] += (mesh->coneBlockStart[nb] - mesh->coneBlockStart[0])*sizeof(unsigned char);
+  } else {
+    ierr = PetscSectionGetStorageSize(mesh->coneSection, &size);CHKERRQ(ierr);
+  }
+  mem[0] += 2*size*sizeof(PetscInt);
+  if (mesh->supports) {
+    ierr    = PetscSectionGetStorageSize(mesh->supportSection, &size);CHKERRQ(ierr);
+    mem[0] += size*sizeof(PetscInt);
+  }
+  /* Labels, including depth */
+  for (; next; next = next->next) {
+    PetscInt v;
+
+    for (v = 0, size = 0; v < next->numStrata; ++v) size += next->stratumSizes[v];
+    mem[1] += (size + 3*next->numStrata)*sizeof(PetscInt);
+    if (next->bt) mem[1] += PetscBTLength(next->pEnd - next->pStart);
+  }
+  if (mesh->subpointMap) {
+    PetscInt v;
+
+    for (v = 0, size = 0; v < mesh->subpointMap->numStrata; ++v) size += mesh->subpointMap->stratumSizes[v];
+    mem[1] += (size + 3*mesh->subpointMap->numStrata)*sizeof(PetscInt);
+  }
+  /* Sections used to lay out fields */
+  ierr = PetscSectionGetMemory_Private(dm->defaultSection, &mem[2]);CHKERRQ(ierr);
+  ierr = PetscSectionGetMemory_Private(dm->defaultGlobalSection, &mem[2]);CHKERRQ(ierr);
+  /* Coordinates and their section */
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = PetscSectionGetMemory_Private(cdm->defaultSection, &mem[3]);CHKERRQ(ierr);
+  if (dm->coordinatesLocal) {
+    ierr    = VecGetLocalSize(dm->coordinatesLocal, &size);CHKERRQ(ierr);
+    mem[3] += size*sizeof(PetscScalar);
+  }
+  if (dm->coordinates && (dm->coordinates != dm->coordinatesLocal)) {
+    ierr    = VecGetLocalSize(dm->coordinates, &size);CHKERRQ(ierr);
+    mem[3] += size*sizeof(PetscScalar);
+  }
+  /* Point SF and dof SF */
+  ierr = PetscSFGetMemory_Private(dm->sf, &mem[4]);CHKERRQ(ierr);
+  ierr = PetscSFGetMemory_Private(dm->defaultSF, &mem[4]);CHKERRQ(ierr);
+  for (i = 0; i < 5; ++i) mem[5] += mem[i];
+  ierr = MPI_Allreduce(mem, memSum, 6, MPIU_PETSCLOGDOUBLE, MPI_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = MPI_Allreduce(mem, memMax, 6, MPIU_PETSCLOGDOUBLE, MPI_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer, "Memory usage in bytes:%16s%16s\n", "Total", "Max");CHKERRQ(ierr);
+  for (i = 0; i < 6; ++i) {
+    ierr = PetscViewerASCIIPrintf(viewer, "  %-20s%16.0f%16.0f\n", names[i], memSum[i], memMax[i]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexView_Ascii"
 PetscErrorCode DMPlexView_Ascii(DM dm, PetscViewer viewer)
@@ -155,8 +275,7 @@ PetscErrorCode DMPlexView_Ascii(DM dm, PetscViewer viewer)
     for (p = pStart; p < pEnd; ++p) {
       PetscInt dof, off, c;
 
-      ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-      ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+      ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
       for (c = off; c < off+dof; ++c) {
         ierr = PetscViewerASCIISynchronizedPrintf(viewer, "[%D]: %D <---- %D (%D)\n", rank, p, mesh->cones[c], mesh->coneOrientations[c]);CHKERRQ(ierr);
       }
@@ -338,6 +457,7 @@ PetscErrorCode DMPlexView_Ascii(DM dm, PetscViewer viewer)
       ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
       ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
     }
+    if (format == PETSC_VIEWER_ASCII_INFO) {ierr = DMPlexView_Memory_Private(dm, viewer);CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
@@ -346,7 +466,7 @@ PetscErrorCode DMPlexView_Ascii(DM dm, PetscViewer viewer)
 #define __FUNCT__ "DMView_Plex"
 PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer)
 {
-  PetscBool      iascii, isbinary;
+  PetscBool      iascii, isbinary, ishdf5;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -354,8 +474,15 @@ PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer)
   PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
   ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERASCII, &iascii);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERBINARY, &isbinary);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERHDF5, &ishdf5);CHKERRQ(ierr);
   if (iascii) {
     ierr = DMPlexView_Ascii(dm, viewer);CHKERRQ(ierr);
+  } else if (ishdf5) {
+#if defined(PETSC_HAVE_HDF5)
+    ierr = DMPlexView_HDF5(dm, viewer);CHKERRQ(ierr);
+#else
+    SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "HDF5 not supported in this build.\nPlease reconfigure using --download-hdf5");
+#endif
 #if 0
   } else if (isbinary) {
     ierr = DMPlexView_Binary(dm, viewer);CHKERRQ(ierr);
@@ -364,6 +491,27 @@ PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMLoad_Plex"
+PetscErrorCode DMLoad_Plex(DM dm, PetscViewer viewer)
+{
+  PetscBool      ishdf5;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERHDF5, &ishdf5);CHKERRQ(ierr);
+  if (ishdf5) {
+#if defined(PETSC_HAVE_HDF5)
+    ierr = DMPlexLoad_HDF5(dm, viewer);CHKERRQ(ierr);
+#else
+    SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "HDF5 not supported in this build.\nPlease reconfigure using --download-hdf5");
+#endif
+  } else SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "DMPlex can only be loaded from an HDF5 viewer");
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMDestroy_Plex"
 PetscErrorCode DMDestroy_Plex(DM dm)
@@ -375,6 +523,7 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   PetscFunctionBegin;
   if (--mesh->refct > 0) PetscFunctionReturn(0);
   ierr = PetscSectionDestroy(&mesh->coneSection);CHKERRQ(ierr);
+  ierr = PetscFree(mesh->coneBlock);CHKERRQ(ierr);
   ierr = PetscFree(mesh->cones);CHKERRQ(ierr);
   ierr = PetscFree(mesh->coneOrientations);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&mesh->supportSection);CHKERRQ(ierr);
@@ -525,6 +674,84 @@ PetscErrorCode DMPlexSetDimension(DM dm, PetscInt dim)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexSetUpConeBlocks_Private"
+/*
+  DMPlexSetUpConeBlocks_Private - Split the chart into runs of points with equal cone size, so that cone offsets
+  can be computed arithmetically. Meshes with a single cell type have one run per stratum. The runs and a byte
+  per point naming its run then replace the cone section. If more than DMPLEX_MAX_CONE_BLOCKS runs are needed,
+  the cone section is kept and used for all lookups.
+*/
+static PetscErrorCode DMPlexSetUpConeBlocks_Private(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscInt       pStart, pEnd, p, b, nb = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSectionGetChart(mesh->coneSection, &pStart, &pEnd);CHKERRQ(ierr);
+  if (pEnd <= pStart) PetscFunctionReturn(0);
+  for (p = pStart; p < pEnd; ++p) {
+    PetscInt dof, off;
+
+    ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+    if (nb && (dof == mesh->coneBlockSize[nb-1]) && (off == mesh->coneBlockOffset[nb-1] + (p - mesh->coneBlockStart[nb-1])*dof)) continue;
+    if (nb == DMPLEX_MAX_CONE_BLOCKS) PetscFunctionReturn(0);
+    mesh->coneBlockStart[nb]  = p;
+    mesh->coneBlockSize[nb]   = dof;
+    mesh->coneBlockOffset[nb] = off;
+    ++nb;
+  }
+  mesh->coneBlockStart[nb] = pEnd;
+  ierr = PetscMalloc((pEnd-pStart) * sizeof(unsigned char), &mesh->coneBlock);CHKERRQ(ierr);
+  for (b = 0; b < nb; ++b) {
+    for (p = mesh->coneBlockStart[b]; p < mesh->coneBlockStart[b+1]; ++p) mesh->coneBlock[p-pStart] = (unsigned char) b;
+  }
+  mesh->numConeBlocks = nb;
+  ierr = PetscSectionDestroy(&mesh->coneSection);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateConeSection_Private"
+/* DMPlexCreateConeSection_Private - Recreate the cone section from the cone blocks, which stay valid */
+static PetscErrorCode DMPlexCreateConeSection_Private(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscInt       b, p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mesh->coneSection) PetscFunctionReturn(0);
+  /* Only some processes may get here, so the section must not take a tag from the communicator of the mesh */
+  ierr = PetscSectionCreate(PETSC_COMM_SELF, &mesh->coneSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(mesh->coneSection, mesh->coneBlockStart[0], mesh->coneBlockStart[mesh->numConeBlocks]);CHKERRQ(ierr);
+  for (b = 0; b < mesh->numConeBlocks; ++b) {
+    for (p = mesh->coneBlockStart[b]; p < mesh->coneBlockStart[b+1]; ++p) {
+      ierr = PetscSectionSetDof(mesh->coneSection, p, mesh->coneBlockSize[b]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscSectionSetUp(mesh->coneSection);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexResetConeBlocks_Private"
+/* DMPlexResetConeBlocks_Private - Go back to the cone section before the cone layout is changed */
+static PetscErrorCode DMPlexResetConeBlocks_Private(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!mesh->numConeBlocks) PetscFunctionReturn(0);
+  ierr = DMPlexCreateConeSection_Private(dm);CHKERRQ(ierr);
+  ierr = PetscFree(mesh->coneBlock);CHKERRQ(ierr);
+  mesh->numConeBlocks = 0;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexGetChart"
 /*@
@@ -550,7 +777,11 @@ PetscErrorCode DMPlexGetChart(DM dm, PetscInt *pStart, PetscInt *pEnd)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  ierr = PetscSectionGetChart(mesh->coneSection, pStart, pEnd);CHKERRQ(ierr);
+  if (mesh->coneSection) {ierr = PetscSectionGetChart(mesh->coneSection, pStart, pEnd);CHKERRQ(ierr);}
+  else {
+    if (pStart) *pStart = mesh->coneBlockStart[0];
+    if (pEnd)   *pEnd   = mesh->coneBlockStart[mesh->numConeBlocks];
+  }
   PetscFunctionReturn(0);
 }
 
@@ -579,6 +810,7 @@ PetscErrorCode DMPlexSetChart(DM dm, PetscInt pStart, PetscInt pEnd)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexResetConeBlocks_Private(dm);CHKERRQ(ierr);
   ierr = PetscSectionSetChart(mesh->coneSection, pStart, pEnd);CHKERRQ(ierr);
   ierr = PetscSectionSetChart(mesh->supportSection, pStart, pEnd);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -610,7 +842,7 @@ PetscErrorCode DMPlexGetConeSize(DM dm, PetscInt p, PetscInt *size)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(size, 3);
-  ierr = PetscSectionGetDof(mesh->coneSection, p, size);CHKERRQ(ierr);
+  ierr = DMPlexGetConeOffset_Private(mesh, p, size, NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -642,6 +874,7 @@ PetscErrorCode DMPlexSetConeSize(DM dm, PetscInt p, PetscInt size)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexResetConeBlocks_Private(dm);CHKERRQ(ierr);
   ierr = PetscSectionSetDof(mesh->coneSection, p, size);CHKERRQ(ierr);
 
   mesh->maxConeSize = PetscMax(mesh->maxConeSize, size);
@@ -681,7 +914,7 @@ PetscErrorCode DMPlexGetCone(DM dm, PetscInt p, const PetscInt *cone[])
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(cone, 3);
-  ierr  = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+  ierr  = DMPlexGetConeOffset_Private(mesh, p, NULL, &off);CHKERRQ(ierr);
   *cone = &mesh->cones[off];
   PetscFunctionReturn(0);
 }
@@ -716,11 +949,10 @@ PetscErrorCode DMPlexSetCone(DM dm, PetscInt p, const PetscInt cone[])
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  ierr = PetscSectionGetChart(mesh->coneSection, &pStart, &pEnd);CHKERRQ(ierr);
-  ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-  if (dof) PetscValidPointer(cone, 3);
-  ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
   if ((p < pStart) || (p >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Mesh point %D is not in the valid range [%D, %D)", p, pStart, pEnd);
+  ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
+  if (dof) PetscValidPointer(cone, 3);
   for (c = 0; c < dof; ++c) {
     if ((cone[c] < pStart) || (cone[c] >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone point %D is not in the valid range [%D, %D)", cone[c], pStart, pEnd);
     mesh->cones[off+c] = cone[c];
@@ -758,19 +990,13 @@ PetscErrorCode DMPlexSetCone(DM dm, PetscInt p, const PetscInt cone[])
 PetscErrorCode DMPlexGetConeOrientation(DM dm, PetscInt p, const PetscInt *coneOrientation[])
 {
   DM_Plex       *mesh = (DM_Plex*) dm->data;
-  PetscInt       off;
+  PetscInt       dof, off;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-#if defined(PETSC_USE_DEBUG)
-  {
-    PetscInt dof;
-    ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-    if (dof) PetscValidPointer(coneOrientation, 3);
-  }
-#endif
-  ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+  ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
+  if (dof) PetscValidPointer(coneOrientation, 3);
 
   *coneOrientation = &mesh->coneOrientations[off];
   PetscFunctionReturn(0);
@@ -809,15 +1035,14 @@ PetscErrorCode DMPlexSetConeOrientation(DM dm, PetscInt p, const PetscInt coneOr
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  ierr = PetscSectionGetChart(mesh->coneSection, &pStart, &pEnd);CHKERRQ(ierr);
-  ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-  if (dof) PetscValidPointer(coneOrientation, 3);
-  ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
   if ((p < pStart) || (p >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Mesh point %D is not in the valid range [%D, %D)", p, pStart, pEnd);
+  ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
+  if (dof) PetscValidPointer(coneOrientation, 3);
   for (c = 0; c < dof; ++c) {
     PetscInt cdof, o = coneOrientation[c];
 
-    ierr = PetscSectionGetDof(mesh->coneSection, mesh->cones[off+c], &cdof);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOffset_Private(mesh, mesh->cones[off+c], &cdof, NULL);CHKERRQ(ierr);
     if (o && ((o < -(cdof+1)) || (o >= cdof))) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone orientation %D is not in the valid range [%D. %D)", o, -(cdof+1), cdof);
     mesh->coneOrientations[off+c] = o;
   }
@@ -835,11 +1060,10 @@ PetscErrorCode DMPlexInsertCone(DM dm, PetscInt p, PetscInt conePos, PetscInt co
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  ierr = PetscSectionGetChart(mesh->coneSection, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
   if ((p < pStart) || (p >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Mesh point %D is not in the valid range [%D, %D)", p, pStart, pEnd);
   if ((conePoint < pStart) || (conePoint >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone point %D is not in the valid range [%D, %D)", conePoint, pStart, pEnd);
-  ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-  ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+  ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
   if ((conePos < 0) || (conePos >= dof)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone position %D of point %D is not in the valid range [0, %D)", conePos, p, dof);
   mesh->cones[off+conePos] = conePoint;
   PetscFunctionReturn(0);
@@ -856,10 +1080,9 @@ PetscErrorCode DMPlexInsertConeOrientation(DM dm, PetscInt p, PetscInt conePos,
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  ierr = PetscSectionGetChart(mesh->coneSection, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
   if ((p < pStart) || (p >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Mesh point %D is not in the valid range [%D, %D)", p, pStart, pEnd);
-  ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-  ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+  ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
   if ((conePos < 0) || (conePos >= dof)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone position %D of point %D is not in the valid range [0, %D)", conePos, p, dof);
   mesh->coneOrientations[off+conePos] = coneOrientation;
   PetscFunctionReturn(0);
@@ -1123,9 +1346,11 @@ PetscErrorCode DMPlexGetTransitiveClosure(DM dm, PetscInt p, PetscBool useCone,
     const PetscInt off = rev ? -(o+1) : o;
 
     if (useCone) {
-      ierr = DMPlexGetConeSize(dm, q, &tmpSize);CHKERRQ(ierr);
-      ierr = DMPlexGetCone(dm, q, &tmp);CHKERRQ(ierr);
-      ierr = DMPlexGetConeOrientation(dm, q, &tmpO);CHKERRQ(ierr);
+      PetscInt qoff;
+
+      ierr = DMPlexGetConeOffset_Private(mesh, q, &tmpSize, &qoff);CHKERRQ(ierr);
+      tmp  = &mesh->cones[qoff];
+      tmpO = &mesh->coneOrientations[qoff];
     } else {
       ierr = DMPlexGetSupportSize(dm, q, &tmpSize);CHKERRQ(ierr);
       ierr = DMPlexGetSupport(dm, q, &tmp);CHKERRQ(ierr);
@@ -1142,7 +1367,8 @@ PetscErrorCode DMPlexGetTransitiveClosure(DM dm, PetscInt p, PetscBool useCone,
 
       if (rev) {
         PetscInt childSize, coff;
-        ierr = DMPlexGetConeSize(dm, cp, &childSize);CHKERRQ(ierr);
+
+        ierr = DMPlexGetConeOffset_Private(mesh, cp, &childSize, NULL);CHKERRQ(ierr);
         coff = tmpO[i] < 0 ? -(tmpO[i]+1) : tmpO[i];
         co   = childSize ? -(((coff+childSize-1)%childSize)+1) : 0;
       }
@@ -1251,6 +1477,7 @@ PetscErrorCode DMSetUp_Plex(DM dm)
   ierr = PetscMalloc(size * sizeof(PetscInt), &mesh->cones);CHKERRQ(ierr);
   ierr = PetscMalloc(size * sizeof(PetscInt), &mesh->coneOrientations);CHKERRQ(ierr);
   ierr = PetscMemzero(mesh->coneOrientations, size * sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = DMPlexSetUpConeBlocks_Private(dm);CHKERRQ(ierr);
   if (mesh->maxSupportSize) {
     ierr = PetscSectionSetUp(mesh->supportSection);CHKERRQ(ierr);
     ierr = PetscSectionGetStorageSize(mesh->supportSection, &size);CHKERRQ(ierr);
@@ -1306,8 +1533,7 @@ PetscErrorCode DMPlexSymmetrize(DM dm)
   for (p = pStart; p < pEnd; ++p) {
     PetscInt dof, off, c;
 
-    ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-    ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
     for (c = off; c < off+dof; ++c) {
       ierr = PetscSectionAddDof(mesh->supportSection, mesh->cones[c], 1);CHKERRQ(ierr);
     }
@@ -1328,8 +1554,7 @@ PetscErrorCode DMPlexSymmetrize(DM dm)
   for (p = pStart; p < pEnd; ++p) {
     PetscInt dof, off, c;
 
-    ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
-    ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOffset_Private(mesh, p, &dof, &off);CHKERRQ(ierr);
     for (c = off; c < off+dof; ++c) {
       const PetscInt q = mesh->cones[c];
       PetscInt       offS;
@@ -1710,8 +1935,7 @@ PetscErrorCode DMPlexGetMeet(DM dm, PetscInt numPoints, const PetscInt points[],
   ierr = DMGetWorkArray(dm, mesh->maxConeSize, PETSC_INT, &meet[0]);CHKERRQ(ierr);
   ierr = DMGetWorkArray(dm, mesh->maxConeSize, PETSC_INT, &meet[1]);CHKERRQ(ierr);
   /* Copy in cone of first point */
-  ierr = PetscSectionGetDof(mesh->coneSection, points[0], &dof);CHKERRQ(ierr);
-  ierr = PetscSectionGetOffset(mesh->coneSection, points[0], &off);CHKERRQ(ierr);
+  ierr = DMPlexGetConeOffset_Private(mesh, points[0], &dof, &off);CHKERRQ(ierr);
   for (meetSize = 0; meetSize < dof; ++meetSize) {
     meet[i][meetSize] = mesh->cones[off+meetSize];
   }
@@ -1719,8 +1943,7 @@ PetscErrorCode DMPlexGetMeet(DM dm, PetscInt numPoints, const PetscInt points[],
   for (p = 1; p < numPoints; ++p) {
     PetscInt newMeetSize = 0;
 
-    ierr = PetscSectionGetDof(mesh->coneSection, points[p], &dof);CHKERRQ(ierr);
-    ierr = PetscSectionGetOffset(mesh->coneSection, points[p], &off);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOffset_Private(mesh, points[p], &dof, &off);CHKERRQ(ierr);
     for (c = 0; c < dof; ++c) {
       const PetscInt point = mesh->cones[off+c];
 
@@ -2281,6 +2504,102 @@ PetscErrorCode DMPlexCreateNeighborCSR(DM dm, PetscInt cellHeight, PetscInt *num
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateNeighborCSRParallel_Private"
+/*
+  DMPlexCreateNeighborCSRParallel_Private - Convert the local dual graph from DMPlexCreateNeighborCSR() into a piece of the
+  distributed dual graph, with vertices numbered by global cell number, and add the edges which cross process boundaries
+
+  Input Parameters:
++ dm         - The DMPlex, whose cells are not shared with other processes
+. cellOffset - The global number of the first local cell
+. numCells   - The number of local cells
+. offsets    - The local CSR offsets
+- adjacency  - The local CSR adjacency, in local cell numbers
+
+  Output Parameters:
++ offsets    - The CSR offsets, including remote edges
+- adjacency  - The CSR adjacency in global cell numbers
+
+  Note: Remote edges are found by exchanging the cell on each side of the faces shared through the point SF, so they
+  are only found for interpolated meshes.
+*/
+static PetscErrorCode DMPlexCreateNeighborCSRParallel_Private(DM dm, PetscInt cellOffset, PetscInt numCells, PetscInt **offsets, PetscInt **adjacency)
+{
+  PetscSF            sf;
+  const PetscInt    *ilocal;
+  const PetscSFNode *iremote;
+  PetscInt          *off = *offsets, *adj = *adjacency, *newOff, *newAdj, *localCells, *remoteCells;
+  PetscInt           dim, depth, nroots, nleaves, pStart, pEnd, cStart, cEnd, fStart, fEnd, c, f, a;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  if (numCells && off) {
+    for (a = 0; a < off[numCells]; ++a) adj[a] += cellOffset - cStart;
+  }
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote);CHKERRQ(ierr);
+  /* Every process must take part in the SF communication, even without remote edges */
+  if (nroots < 0) PetscFunctionReturn(0);
+  for (a = 0; a < nleaves; ++a) {
+    const PetscInt point = ilocal ? ilocal[a] : a;
+
+    if ((point >= cStart) && (point < cEnd)) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Cell %D is shared with another process, cannot partition overlapping meshes", point);
+  }
+  ierr = PetscMalloc2(pEnd-pStart,PetscInt,&localCells,pEnd-pStart,PetscInt,&remoteCells);CHKERRQ(ierr);
+  for (f = 0; f < pEnd-pStart; ++f) localCells[f] = remoteCells[f] = -1;
+  if (depth == dim) {
+    ierr = DMPlexGetHeightStratum(dm, 1, &fStart, &fEnd);CHKERRQ(ierr);
+    for (f = fStart; f < fEnd; ++f) {
+      const PetscInt *support;
+      PetscInt        supportSize;
+
+      ierr = DMPlexGetSupportSize(dm, f, &supportSize);CHKERRQ(ierr);
+      if (supportSize != 1) continue;
+      ierr = DMPlexGetSupport(dm, f, &support);CHKERRQ(ierr);
+      localCells[f-pStart] = cellOffset + support[0] - cStart;
+    }
+  }
+  /* Roots receive the cell on the leaf side, leaves receive the cell on the root side */
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, localCells, remoteCells, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, localCells, remoteCells, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf, MPIU_INT, localCells, remoteCells);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf, MPIU_INT, localCells, remoteCells);CHKERRQ(ierr);
+  if (depth == dim && numCells) {
+    ierr = PetscMalloc((numCells+1) * sizeof(PetscInt), &newOff);CHKERRQ(ierr);
+    newOff[0] = 0;
+    for (c = cStart; c < cEnd; ++c) {
+      const PetscInt *cone;
+      PetscInt        coneSize, cp, numRemote = 0;
+
+      ierr = DMPlexGetConeSize(dm, c, &coneSize);CHKERRQ(ierr);
+      ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+      for (cp = 0; cp < coneSize; ++cp) if ((localCells[cone[cp]-pStart] >= 0) && (remoteCells[cone[cp]-pStart] >= 0)) ++numRemote;
+      newOff[c-cStart+1] = newOff[c-cStart] + off[c-cStart+1] - off[c-cStart] + numRemote;
+    }
+    ierr = PetscMalloc(newOff[numCells] * sizeof(PetscInt), &newAdj);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {
+      const PetscInt *cone;
+      PetscInt        coneSize, cp, n = newOff[c-cStart];
+
+      for (a = off[c-cStart]; a < off[c-cStart+1]; ++a) newAdj[n++] = adj[a];
+      ierr = DMPlexGetConeSize(dm, c, &coneSize);CHKERRQ(ierr);
+      ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+      for (cp = 0; cp < coneSize; ++cp) if ((localCells[cone[cp]-pStart] >= 0) && (remoteCells[cone[cp]-pStart] >= 0)) newAdj[n++] = remoteCells[cone[cp]-pStart];
+    }
+    ierr = PetscFree(off);CHKERRQ(ierr);
+    ierr = PetscFree(adj);CHKERRQ(ierr);
+    *offsets   = newOff;
+    *adjacency = newAdj;
+  }
+  ierr = PetscFree2(localCells,remoteCells);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_HAVE_CHACO)
 #if defined(PETSC_HAVE_UNISTD_H)
 #include <unistd.h>
@@ -2484,6 +2803,46 @@ PetscErrorCode DMPlexPartition_ParMetis(DM dm, PetscInt numVertices, PetscInt st
 }
 #endif
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexPartition_Simple"
+/*
+  DMPlexPartition_Simple - Divide the global cell numbering into contiguous, equally sized pieces
+
+  This needs no external package and runs in parallel, so it is useful for redistributing a mesh which was read or
+  created in parallel, and as a starting point for parallel partitioners.
+*/
+PetscErrorCode DMPlexPartition_Simple(DM dm, PetscInt numVertices, PetscInt start[], PetscInt adjacency[], PetscSection *partSection, IS *partition)
+{
+  MPI_Comm       comm;
+  PetscInt       numGlobalVertices, vOffset, np, v;
+  PetscMPIInt    commSize;
+  PetscInt      *points;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &commSize);CHKERRQ(ierr);
+  ierr = MPI_Scan(&numVertices, &vOffset, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  vOffset -= numVertices;
+  ierr = MPI_Allreduce(&numVertices, &numGlobalVertices, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(comm, partSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(*partSection, 0, commSize);CHKERRQ(ierr);
+  /* Partition np gets global vertices [np*N/P + min(np, N%P), (np+1)*N/P + min(np+1, N%P)) */
+  for (np = 0; np < commSize; ++np) {
+    const PetscInt pBegin = np*(numGlobalVertices/commSize) + PetscMin(np, numGlobalVertices%commSize);
+    const PetscInt pEnd   = pBegin + numGlobalVertices/commSize + (np < numGlobalVertices%commSize ? 1 : 0);
+    const PetscInt lBegin = PetscMax(pBegin, vOffset), lEnd = PetscMin(pEnd, vOffset+numVertices);
+
+    if (lEnd > lBegin) {ierr = PetscSectionSetDof(*partSection, np, lEnd - lBegin);CHKERRQ(ierr);}
+  }
+  ierr = PetscSectionSetUp(*partSection);CHKERRQ(ierr);
+  /* Since the pieces are contiguous, the local vertices are already in partition order */
+  ierr = PetscMalloc(numVertices * sizeof(PetscInt), &points);CHKERRQ(ierr);
+  for (v = 0; v < numVertices; ++v) points[v] = v;
+  ierr = ISCreateGeneral(comm, numVertices, points, PETSC_OWN_POINTER, partition);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexEnlargePartition"
 /* Expand the partition by BFS on the adjacency graph */
@@ -2563,6 +2922,12 @@ PetscErrorCode DMPlexEnlargePartition(DM dm, const PetscInt start[], const Petsc
   . origPartSection - If enlarge is true, the PetscSection giving the division of points before enlarging by partition, otherwise NULL
   - origPartition - If enlarge is true, the list of points before enlarging by partition, otherwise NULL
 
+  Options Database Keys:
+  . -dm_plex_partitioner <chaco, metis, simple> - The partitioning package
+
+  Note: If the cells are spread over several processes, the dual graph is built in parallel and a parallel partitioner
+  (metis, which uses ParMetis, or simple) must be used.
+
   Level: developer
 
 .seealso DMPlexDistribute()
@@ -2570,7 +2935,7 @@ PetscErrorCode DMPlexEnlargePartition(DM dm, const PetscInt start[], const Petsc
 PetscErrorCode DMPlexCreatePartition(DM dm, const char name[], PetscInt height, PetscBool enlarge, PetscSection *partSection, IS *partition, PetscSection *origPartSection, IS *origPartition)
 {
   char           partname[1024];
-  PetscBool      isChaco = PETSC_FALSE, isMetis = PETSC_FALSE, flg;
+  PetscBool      isChaco = PETSC_FALSE, isMetis = PETSC_FALSE, isSimple = PETSC_FALSE, flg;
   PetscMPIInt    size;
   PetscErrorCode ierr;
 
@@ -2598,14 +2963,30 @@ PetscErrorCode DMPlexCreatePartition(DM dm, const char name[], PetscInt height,
   if (name) {
     ierr = PetscStrcmp(name, "chaco", &isChaco);CHKERRQ(ierr);
     ierr = PetscStrcmp(name, "metis", &isMetis);CHKERRQ(ierr);
+    ierr = PetscStrcmp(name, "simple", &isSimple);CHKERRQ(ierr);
   }
   if (height == 0) {
-    PetscInt  numVertices;
-    PetscInt *start     = NULL;
-    PetscInt *adjacency = NULL;
+    PetscInt    numVertices, cStart, cEnd;
+    PetscInt   *start     = NULL;
+    PetscInt   *adjacency = NULL;
+    PetscMPIInt hasCells, numProcsWithCells;
 
     ierr = DMPlexCreateNeighborCSR(dm, 0, &numVertices, &start, &adjacency);CHKERRQ(ierr);
-    if (!name || isChaco) {
+    ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    hasCells = cEnd > cStart ? 1 : 0;
+    ierr = MPI_Allreduce(&hasCells, &numProcsWithCells, 1, MPI_INT, MPI_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+    if (numProcsWithCells > 1) {
+      PetscInt vOffset;
+
+      if (!name || isChaco) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Chaco cannot partition a distributed mesh, use -dm_plex_partitioner metis or simple");
+      if (enlarge) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Overlap is not yet supported when partitioning a distributed mesh");
+      ierr = MPI_Scan(&numVertices, &vOffset, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+      vOffset -= numVertices;
+      ierr = DMPlexCreateNeighborCSRParallel_Private(dm, vOffset, numVertices, &start, &adjacency);CHKERRQ(ierr);
+    }
+    if (isSimple) {
+      ierr = DMPlexPartition_Simple(dm, numVertices, start, adjacency, partSection, partition);CHKERRQ(ierr);
+    } else if (!name || isChaco) {
 #if defined(PETSC_HAVE_CHACO)
       ierr = DMPlexPartition_Chaco(dm, numVertices, start, adjacency, partSection, partition);CHKERRQ(ierr);
 #else
@@ -2614,6 +2995,8 @@ PetscErrorCode DMPlexCreatePartition(DM dm, const char name[], PetscInt height,
     } else if (isMetis) {
 #if defined(PETSC_HAVE_PARMETIS)
       ierr = DMPlexPartition_ParMetis(dm, numVertices, start, adjacency, partSection, partition);CHKERRQ(ierr);
+#else
+      SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Mesh partitioning needs external package support.\nPlease reconfigure with --download-parmetis.");
 #endif
     } else SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Unknown mesh partitioning package %s", name);
     if (enlarge) {
@@ -2798,6 +3181,133 @@ PetscErrorCode DMPlexDistributeData(DM dm, PetscSF pointSF, PetscSection origina
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateMigrationSF_Private"
+/*
+  DMPlexCreateMigrationSF_Private - Create the SF which moves points of the original mesh to their new processes
+
+  Input Parameters:
++ dm      - The original DMPlex, which may be distributed
+- pointSF - The SF from PetscSFConvertPartition(), which sends each point of a partition closure from every process holding it
+
+  Output Parameters:
++ migrationSF  - The SF whose roots are owned points of the original mesh and whose leaves are the points of the new mesh
+. renumbering  - The global number of each new point
+- globalPoints - The global number of each original local point
+
+  Note: A point shared by several processes can arrive at its new process once from each of them. Each copy is
+  replaced by the owning copy and duplicates are removed. The new points are ordered by stratum, in the order the
+  strata are laid out in the original mesh, and then by global number, so the strata are contiguous as DMPlex expects.
+  The global number of a point is its owner's local number shifted by the size of the charts on lower ranks.
+*/
+static PetscErrorCode DMPlexCreateMigrationSF_Private(DM dm, PetscSF pointSF, PetscSF *migrationSF, ISLocalToGlobalMapping *renumbering, PetscInt **globalPoints)
+{
+  MPI_Comm           comm;
+  PetscSF            sf;
+  const PetscInt    *ilocal, *leaves;
+  const PetscSFNode *iremote;
+  PetscSFNode       *rootOwners, *leafOwners, *rootKeys, *leafKeys, *remotePoints;
+  PetscInt          *ownedGlobals, *perm, *leafGlobals, *newGlobals, *keyOffsets;
+  PetscInt           pEnd, depth, d, nroots, nleaves, numLeaves, maxLeaf, pointOffset, numKeys, numNewPoints, p, l;
+  PetscMPIInt        rank;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, NULL, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  pEnd = PetscMax(pEnd, 0); /* An empty mesh may never have had its chart set */
+  ierr = MPI_Scan(&pEnd, &pointOffset, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  pointOffset -= pEnd;
+  /* Owner and global number of every local point */
+  ierr = PetscMalloc(pEnd * sizeof(PetscInt), globalPoints);CHKERRQ(ierr);
+  ierr = PetscMalloc3(pEnd,PetscSFNode,&rootOwners,pEnd,PetscSFNode,&rootKeys,pEnd,PetscInt,&ownedGlobals);CHKERRQ(ierr);
+  for (p = 0; p < pEnd; ++p) {
+    rootOwners[p].rank  = rank;
+    rootOwners[p].index = p;
+    rootKeys[p].rank    = -1;
+    rootKeys[p].index   = -1;
+    ownedGlobals[p]     = pointOffset + p;
+    (*globalPoints)[p]  = pointOffset + p;
+  }
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote);CHKERRQ(ierr);
+  if (nroots >= 0) {
+    for (l = 0; l < nleaves; ++l) {
+      const PetscInt q = ilocal ? ilocal[l] : l;
+
+      rootOwners[q].rank  = iremote[l].rank;
+      rootOwners[q].index = iremote[l].index;
+    }
+    ierr = PetscSFBcastBegin(sf, MPIU_INT, ownedGlobals, *globalPoints);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, MPIU_INT, ownedGlobals, *globalPoints);CHKERRQ(ierr);
+  }
+  /* The key of a point is the position of its stratum in the chart, ignoring empty strata */
+  for (d = 0; d <= depth; ++d) {
+    PetscInt sStart, sEnd, e, key = 0;
+
+    ierr = DMPlexGetDepthStratum(dm, d, &sStart, &sEnd);CHKERRQ(ierr);
+    for (e = 0; e <= depth; ++e) {
+      PetscInt eStart, eEnd;
+
+      ierr = DMPlexGetDepthStratum(dm, e, &eStart, &eEnd);CHKERRQ(ierr);
+      if ((eEnd > eStart) && (eStart < sStart)) ++key;
+    }
+    for (p = sStart; p < sEnd; ++p) {
+      rootKeys[p].rank  = key;
+      rootKeys[p].index = (*globalPoints)[p];
+    }
+  }
+  /* Send owners and keys to the new processes */
+  ierr = PetscSFGetGraph(pointSF, NULL, &numLeaves, &leaves, NULL);CHKERRQ(ierr);
+  for (l = 0, maxLeaf = 0; l < numLeaves; ++l) maxLeaf = PetscMax(maxLeaf, (leaves ? leaves[l] : l)+1);
+  ierr = PetscMalloc4(maxLeaf,PetscSFNode,&leafOwners,maxLeaf,PetscSFNode,&leafKeys,numLeaves,PetscInt,&perm,numLeaves,PetscInt,&leafGlobals);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(pointSF, MPIU_2INT, rootOwners, leafOwners);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(pointSF, MPIU_2INT, rootOwners, leafOwners);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(pointSF, MPIU_2INT, rootKeys, leafKeys);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(pointSF, MPIU_2INT, rootKeys, leafKeys);CHKERRQ(ierr);
+  ierr = PetscFree3(rootOwners,rootKeys,ownedGlobals);CHKERRQ(ierr);
+  /* Sort received points by global number, and remove duplicates */
+  for (l = 0; l < numLeaves; ++l) {
+    perm[l]        = leaves ? leaves[l] : l;
+    leafGlobals[l] = leafKeys[perm[l]].index;
+  }
+  ierr = PetscSortIntWithArray(numLeaves, leafGlobals, perm);CHKERRQ(ierr);
+  for (l = 0, numNewPoints = 0; l < numLeaves; ++l) {
+    if (numNewPoints && (leafGlobals[numNewPoints-1] == leafGlobals[l])) continue;
+    leafGlobals[numNewPoints] = leafGlobals[l];
+    perm[numNewPoints]        = perm[l];
+    ++numNewPoints;
+  }
+  /* Stable counting sort by stratum key, the original mesh may be empty here so the keys come from the senders */
+  for (l = 0, numKeys = 0; l < numNewPoints; ++l) {
+    if (leafKeys[perm[l]].rank < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point with global number %D has no stratum", leafGlobals[l]);
+    numKeys = PetscMax(numKeys, leafKeys[perm[l]].rank+1);
+  }
+  ierr = PetscMalloc((numKeys+1) * sizeof(PetscInt), &keyOffsets);CHKERRQ(ierr);
+  ierr = PetscMemzero(keyOffsets, (numKeys+1) * sizeof(PetscInt));CHKERRQ(ierr);
+  for (l = 0; l < numNewPoints; ++l) ++keyOffsets[leafKeys[perm[l]].rank+1];
+  for (d = 0; d < numKeys; ++d) keyOffsets[d+1] += keyOffsets[d];
+  ierr = PetscMalloc(numNewPoints * sizeof(PetscSFNode), &remotePoints);CHKERRQ(ierr);
+  ierr = PetscMalloc(numNewPoints * sizeof(PetscInt), &newGlobals);CHKERRQ(ierr);
+  for (l = 0; l < numNewPoints; ++l) {
+    const PetscInt q = perm[l];
+    const PetscInt n = keyOffsets[leafKeys[q].rank]++;
+
+    remotePoints[n].rank  = leafOwners[q].rank;
+    remotePoints[n].index = leafOwners[q].index;
+    newGlobals[n]         = leafGlobals[l];
+  }
+  ierr = PetscFree(keyOffsets);CHKERRQ(ierr);
+  ierr = PetscFree4(leafOwners,leafKeys,perm,leafGlobals);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, migrationSF);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(*migrationSF);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(*migrationSF, pEnd, numNewPoints, NULL, PETSC_OWN_POINTER, remotePoints, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingCreate(comm, numNewPoints, newGlobals, PETSC_OWN_POINTER, renumbering);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexDistribute"
 /*@C
@@ -2816,10 +3326,15 @@ PetscErrorCode DMPlexDistributeData(DM dm, PetscSF pointSF, PetscSection origina
 
   Note: If the mesh was not distributed, the return value is NULL
 
+  The original mesh may itself be distributed, for example when it was read in parallel or is being rebalanced, as long
+  as no cell is shared between processes. In that case the dual graph is built in parallel, and a parallel partitioner
+  such as ParMetis or the simple partitioner must be used. The points, cones, coordinates and labels are all moved by a
+  single PetscSF from the owning process of each point, so no process ever holds the whole mesh.
+
   Level: intermediate
 
 .keywords: mesh, elements
-.seealso: DMPlexCreate(), DMPlexDistributeByFace()
+.seealso: DMPlexCreate(), DMPlexDistributeByFace(), DMPlexCreatePartition()
 @*/
 PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overlap, PetscSF *sf, DM *dmParallel)
 {
@@ -2830,11 +3345,11 @@ PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overla
   IS                     origCellPart,        cellPart,        part;
   PetscSection           origCellPartSection, cellPartSection, partSection;
   PetscSFNode           *remoteRanks;
-  PetscSF                partSF, pointSF, coneSF;
-  ISLocalToGlobalMapping renumbering;
+  PetscSF                partSF, closureSF, pointSF, coneSF;
+  ISLocalToGlobalMapping closureRenumbering, renumbering;
   PetscSection           originalConeSection, newConeSection;
-  PetscInt              *remoteOffsets;
-  PetscInt              *cones, *newCones, newConesSize;
+  PetscInt              *remoteOffsets, *globalPoints;
+  PetscInt              *cones, *globalCones, *newCones, conesSize, newConesSize, c;
   PetscBool              flg;
   PetscMPIInt            rank, numProcs, p;
   PetscErrorCode         ierr;
@@ -2857,9 +3372,8 @@ PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overla
   ierr = PetscLogEventBegin(DMPLEX_Partition,dm,0,0,0);CHKERRQ(ierr);
   if (overlap > 1) SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Overlap > 1 not yet implemented");
   ierr = DMPlexCreatePartition(dm, partitioner, height, overlap > 0 ? PETSC_TRUE : PETSC_FALSE, &cellPartSection, &cellPart, &origCellPartSection, &origCellPart);CHKERRQ(ierr);
-  /* Create SF assuming a serial partition for all processes: Could check for IS length here */
-  if (!rank) numRemoteRanks = numProcs;
-  else       numRemoteRanks = 0;
+  /* Create SF from every process to all partitions, since the original mesh may be distributed */
+  numRemoteRanks = numProcs;
   ierr = PetscMalloc(numRemoteRanks * sizeof(PetscSFNode), &remoteRanks);CHKERRQ(ierr);
   for (p = 0; p < numRemoteRanks; ++p) {
     remoteRanks[p].rank  = p;
@@ -2889,7 +3403,10 @@ PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overla
   ierr  = PetscObjectSetName((PetscObject) *dmParallel, "Parallel Mesh");CHKERRQ(ierr);
   pmesh = (DM_Plex*) (*dmParallel)->data;
   /* Distribute sieve points and the global point numbering (replaces creating remote bases) */
-  ierr = PetscSFConvertPartition(partSF, partSection, part, &renumbering, &pointSF);CHKERRQ(ierr);
+  ierr = PetscSFConvertPartition(partSF, partSection, part, &closureRenumbering, &closureSF);CHKERRQ(ierr);
+  ierr = DMPlexCreateMigrationSF_Private(dm, closureSF, &pointSF, &renumbering, &globalPoints);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingDestroy(&closureRenumbering);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&closureSF);CHKERRQ(ierr);
   if (flg) {
     ierr = PetscPrintf(comm, "Point Partition:\n");CHKERRQ(ierr);
     ierr = PetscSectionView(partSection, PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
@@ -2903,6 +3420,8 @@ PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overla
   ierr = DMPlexGetConeSection(dm, &originalConeSection);CHKERRQ(ierr);
   ierr = DMPlexGetConeSection(*dmParallel, &newConeSection);CHKERRQ(ierr);
   ierr = PetscSFDistributeSection(pointSF, originalConeSection, &remoteOffsets, newConeSection);CHKERRQ(ierr);
+  /* DMSetUp() may replace the cone section by cone blocks, but the section is still needed to send the cones */
+  ierr = PetscObjectReference((PetscObject) newConeSection);CHKERRQ(ierr);
   ierr = DMSetUp(*dmParallel);CHKERRQ(ierr);
   {
     PetscInt pStart, pEnd, p;
@@ -2914,12 +3433,16 @@ PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overla
       pmesh->maxConeSize = PetscMax(pmesh->maxConeSize, coneSize);
     }
   }
-  /* Communicate and renumber cones */
+  /* Communicate cones in the global numbering, and renumber */
   ierr = PetscSFCreateSectionSF(pointSF, originalConeSection, remoteOffsets, newConeSection, &coneSF);CHKERRQ(ierr);
   ierr = DMPlexGetCones(dm, &cones);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(originalConeSection, &conesSize);CHKERRQ(ierr);
+  ierr = PetscMalloc(conesSize * sizeof(PetscInt), &globalCones);CHKERRQ(ierr);
+  for (c = 0; c < conesSize; ++c) globalCones[c] = globalPoints[cones[c]];
   ierr = DMPlexGetCones(*dmParallel, &newCones);CHKERRQ(ierr);
-  ierr = PetscSFBcastBegin(coneSF, MPIU_INT, cones, newCones);CHKERRQ(ierr);
-  ierr = PetscSFBcastEnd(coneSF, MPIU_INT, cones, newCones);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(coneSF, MPIU_INT, globalCones, newCones);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(coneSF, MPIU_INT, globalCones, newCones);CHKERRQ(ierr);
+  ierr = PetscFree(globalCones);CHKERRQ(ierr);
   ierr = PetscSectionGetStorageSize(newConeSection, &newConesSize);CHKERRQ(ierr);
   ierr = ISGlobalToLocalMappingApply(renumbering, IS_GTOLM_MASK, newConesSize, newCones, NULL, newCones);CHKERRQ(ierr);
   ierr = PetscOptionsHasName(((PetscObject) dm)->prefix, "-cones_view", &flg);CHKERRQ(ierr);
@@ -2935,11 +3458,12 @@ PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overla
   ierr = PetscSFBcastBegin(coneSF, MPIU_INT, cones, newCones);CHKERRQ(ierr);
   ierr = PetscSFBcastEnd(coneSF, MPIU_INT, cones, newCones);CHKERRQ(ierr);
   ierr = PetscSFDestroy(&coneSF);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&newConeSection);CHKERRQ(ierr);
   /* Create supports and stratify sieve */
   {
     PetscInt pStart, pEnd;
 
-    ierr = PetscSectionGetChart(pmesh->coneSection, &pStart, &pEnd);CHKERRQ(ierr);
+    ierr = DMPlexGetChart(*dmParallel, &pStart, &pEnd);CHKERRQ(ierr);
     ierr = PetscSectionSetChart(pmesh->supportSection, pStart, pEnd);CHKERRQ(ierr);
   }
   ierr = DMPlexSymmetrize(*dmParallel);CHKERRQ(ierr);
@@ -2964,170 +3488,175 @@ PetscErrorCode DMPlexDistribute(DM dm, const char partitioner[], PetscInt overla
   /* Distribute labels */
   ierr = PetscLogEventBegin(DMPLEX_DistributeLabels,dm,0,0,0);CHKERRQ(ierr);
   {
-    DMLabel  next      = mesh->labels, newNext = pmesh->labels;
-    PetscInt numLabels = 0, l;
-
-    /* Bcast number of labels */
-    while (next) {
-      ++numLabels; next = next->next;
+    DMLabel      next      = mesh->labels, newNext = pmesh->labels;
+    PetscInt     numLabels = 0, pStart, pEnd, l, n;
+    char        *localNames, *allNames, **labelNames;
+    PetscMPIInt *nameSizes, *nameOffsets, localSize = 0, proc;
+    size_t       len;
+    PetscBool    isdepth, found;
+
+    /* Gather the union of label names, since a distributed mesh may have labels that are missing on some processes */
+    for (next = mesh->labels; next; next = next->next) {
+      ierr = PetscStrcmp(next->name, "depth", &isdepth);CHKERRQ(ierr);
+      if (isdepth) continue;    /* skip because "depth" is not distributed */
+      ierr       = PetscStrlen(next->name, &len);CHKERRQ(ierr);
+      localSize += (PetscMPIInt) len+1;
+    }
+    ierr = PetscMalloc3(localSize+1,char,&localNames,numProcs,PetscMPIInt,&nameSizes,numProcs+1,PetscMPIInt,&nameOffsets);CHKERRQ(ierr);
+    for (next = mesh->labels, n = 0; next; next = next->next) {
+      ierr = PetscStrcmp(next->name, "depth", &isdepth);CHKERRQ(ierr);
+      if (isdepth) continue;
+      ierr = PetscStrlen(next->name, &len);CHKERRQ(ierr);
+      ierr = PetscMemcpy(&localNames[n], next->name, len+1);CHKERRQ(ierr);
+      n   += len+1;
+    }
+    ierr = MPI_Allgather(&localSize, 1, MPI_INT, nameSizes, 1, MPI_INT, comm);CHKERRQ(ierr);
+    for (proc = 0, nameOffsets[0] = 0; proc < numProcs; ++proc) nameOffsets[proc+1] = nameOffsets[proc] + nameSizes[proc];
+    ierr = PetscMalloc2(nameOffsets[numProcs]+1,char,&allNames,nameOffsets[numProcs]+1,char*,&labelNames);CHKERRQ(ierr);
+    ierr = MPI_Allgatherv(localNames, localSize, MPI_CHAR, allNames, nameSizes, nameOffsets, MPI_CHAR, comm);CHKERRQ(ierr);
+    /* Keep the first occurrence of each name in process order, so every process sees the same list */
+    for (n = 0; n < nameOffsets[numProcs]; n += len+1) {
+      ierr = PetscStrlen(&allNames[n], &len);CHKERRQ(ierr);
+      for (l = 0, found = PETSC_FALSE; l < numLabels && !found; ++l) {ierr = PetscStrcmp(labelNames[l], &allNames[n], &found);CHKERRQ(ierr);}
+      if (!found) labelNames[numLabels++] = &allNames[n];
     }
-    ierr = MPI_Bcast(&numLabels, 1, MPIU_INT, 0, comm);CHKERRQ(ierr);
-    next = mesh->labels;
+    ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
     for (l = 0; l < numLabels; ++l) {
-      DMLabel         newLabel;
-      const PetscInt *partArray;
-      char           *name;
-      PetscInt       *stratumSizes = NULL, *points = NULL;
-      PetscMPIInt    *sendcnts     = NULL, *offsets = NULL, *displs = NULL;
-      PetscInt        nameSize, s, p, proc;
-      PetscBool       isdepth;
-      size_t          len = 0;
-
-      /* Bcast name (could filter for no points) */
-      if (!rank) {ierr = PetscStrlen(next->name, &len);CHKERRQ(ierr);}
-      nameSize = len;
-      ierr     = MPI_Bcast(&nameSize, 1, MPIU_INT, 0, comm);CHKERRQ(ierr);
-      ierr     = PetscMalloc(nameSize+1, &name);CHKERRQ(ierr);
-      if (!rank) {ierr = PetscMemcpy(name, next->name, nameSize+1);CHKERRQ(ierr);}
-      ierr = MPI_Bcast(name, nameSize+1, MPI_CHAR, 0, comm);CHKERRQ(ierr);
-      ierr = PetscStrcmp(name, "depth", &isdepth);CHKERRQ(ierr);
-      if (isdepth) {            /* skip because "depth" is not distributed */
-        ierr = PetscFree(name);CHKERRQ(ierr);
-        if (!rank) next = next->next;
-        continue;
-      }
+      DMLabel      label = NULL, newLabel;
+      PetscSection valueSection, newValueSection;
+      char        *name;
+      PetscInt    *values, *newValues, *localStrata, *strata, *counts;
+      PetscMPIInt *recvcnts, *displs, numLocalStrata;
+      PetscInt     numAllStrata, numValues, numNewValues, s, v, pnew, newStart, newEnd;
+
+      ierr = PetscStrallocpy(labelNames[l], &name);CHKERRQ(ierr);
+      /* The label may be missing on processes which hold no part of the original mesh */
+      ierr = DMPlexGetLabel(dm, name, &label);CHKERRQ(ierr);
+      /* Gather the union of stratum values over all processes */
+      numLocalStrata = label ? label->numStrata : 0;
+      ierr = PetscMalloc2(numProcs,PetscMPIInt,&recvcnts,numProcs+1,PetscMPIInt,&displs);CHKERRQ(ierr);
+      ierr = MPI_Allgather(&numLocalStrata, 1, MPI_INT, recvcnts, 1, MPI_INT, comm);CHKERRQ(ierr);
+      for (proc = 0, displs[0] = 0; proc < numProcs; ++proc) displs[proc+1] = displs[proc] + recvcnts[proc];
+      numAllStrata = displs[numProcs];
+      ierr = PetscMalloc2(numLocalStrata,PetscInt,&localStrata,numAllStrata,PetscInt,&strata);CHKERRQ(ierr);
+      for (s = 0; s < numLocalStrata; ++s) localStrata[s] = label->stratumValues[s];
+      ierr = MPI_Allgatherv(localStrata, numLocalStrata, MPIU_INT, strata, recvcnts, displs, MPIU_INT, comm);CHKERRQ(ierr);
+      ierr = PetscSortRemoveDupsInt(&numAllStrata, strata);CHKERRQ(ierr);
+      ierr = PetscFree2(recvcnts,displs);CHKERRQ(ierr);
       ierr           = PetscNew(struct _n_DMLabel, &newLabel);CHKERRQ(ierr);
       newLabel->name = name;
-      /* Bcast numStrata (could filter for no points in stratum) */
-      if (!rank) newLabel->numStrata = next->numStrata;
-      ierr = MPI_Bcast(&newLabel->numStrata, 1, MPIU_INT, 0, comm);CHKERRQ(ierr);
+      newLabel->numStrata = numAllStrata;
       ierr = PetscMalloc3(newLabel->numStrata,PetscInt,&newLabel->stratumValues,
                           newLabel->numStrata,PetscInt,&newLabel->stratumSizes,
                           newLabel->numStrata+1,PetscInt,&newLabel->stratumOffsets);CHKERRQ(ierr);
-      /* Bcast stratumValues (could filter for no points in stratum) */
-      if (!rank) {ierr = PetscMemcpy(newLabel->stratumValues, next->stratumValues, next->numStrata * sizeof(PetscInt));CHKERRQ(ierr);}
-      ierr = MPI_Bcast(newLabel->stratumValues, newLabel->numStrata, MPIU_INT, 0, comm);CHKERRQ(ierr);
-      /* Find size on each process and Scatter
-           we use the fact that both the stratum points and partArray are sorted */
-      if (!rank) {
-        ierr = ISGetIndices(part, &partArray);CHKERRQ(ierr);
-        ierr = PetscMalloc(numProcs*next->numStrata * sizeof(PetscInt), &stratumSizes);CHKERRQ(ierr);
-        ierr = PetscMemzero(stratumSizes, numProcs*next->numStrata * sizeof(PetscInt));CHKERRQ(ierr);
-        /* TODO We should switch to using binary search if the label is a lot smaller than partitions */
-        for (proc = 0; proc < numProcs; ++proc) {
-          PetscInt dof, off;
-
-          ierr = PetscSectionGetDof(partSection, proc, &dof);CHKERRQ(ierr);
-          ierr = PetscSectionGetOffset(partSection, proc, &off);CHKERRQ(ierr);
-          for (s = 0; s < next->numStrata; ++s) {
-            PetscInt lStart = next->stratumOffsets[s], lEnd = next->stratumOffsets[s]+next->stratumSizes[s];
-            PetscInt pStart = off,                     pEnd = off+dof;
-
-            while (pStart < pEnd && lStart < lEnd) {
-              if (partArray[pStart] > next->points[lStart]) {
-                ++lStart;
-              } else if (next->points[lStart] > partArray[pStart]) {
-                ++pStart;
-              } else {
-                ++stratumSizes[proc*next->numStrata+s];
-                ++pStart; ++lStart;
-              }
-            }
+      for (s = 0; s < newLabel->numStrata; ++s) {
+        newLabel->stratumValues[s] = strata[s];
+        newLabel->stratumSizes[s]  = 0;
+      }
+      ierr = PetscFree2(localStrata,strata);CHKERRQ(ierr);
+      /* Lay out the values of each point, which may lie in several strata */
+      ierr = PetscSectionCreate(PETSC_COMM_SELF, &valueSection);CHKERRQ(ierr);
+      ierr = PetscSectionSetChart(valueSection, pStart, pEnd);CHKERRQ(ierr);
+      if (label) {
+        for (s = 0; s < label->numStrata; ++s) {
+          for (v = label->stratumOffsets[s]; v < label->stratumOffsets[s]+label->stratumSizes[s]; ++v) {
+            ierr = PetscSectionAddDof(valueSection, label->points[v], 1);CHKERRQ(ierr);
+          }
+        }
+      }
+      ierr = PetscSectionSetUp(valueSection);CHKERRQ(ierr);
+      ierr = PetscSectionGetStorageSize(valueSection, &numValues);CHKERRQ(ierr);
+      ierr = PetscMalloc(numValues * sizeof(PetscInt), &values);CHKERRQ(ierr);
+      ierr = PetscMalloc((pEnd-pStart) * sizeof(PetscInt), &counts);CHKERRQ(ierr);
+      ierr = PetscMemzero(counts, (pEnd-pStart) * sizeof(PetscInt));CHKERRQ(ierr);
+      if (label) {
+        for (s = 0; s < label->numStrata; ++s) {
+          for (v = label->stratumOffsets[s]; v < label->stratumOffsets[s]+label->stratumSizes[s]; ++v) {
+            const PetscInt point = label->points[v];
+            PetscInt       off;
+
+            ierr = PetscSectionGetOffset(valueSection, point, &off);CHKERRQ(ierr);
+            values[off+counts[point-pStart]++] = label->stratumValues[s];
           }
         }
-        ierr = ISRestoreIndices(part, &partArray);CHKERRQ(ierr);
       }
-      ierr = MPI_Scatter(stratumSizes, newLabel->numStrata, MPIU_INT, newLabel->stratumSizes, newLabel->numStrata, MPIU_INT, 0, comm);CHKERRQ(ierr);
-      /* Calculate stratumOffsets */
+      ierr = PetscFree(counts);CHKERRQ(ierr);
+      /* Move the values with the points */
+      ierr = PetscSectionCreate(PETSC_COMM_SELF, &newValueSection);CHKERRQ(ierr);
+      ierr = DMPlexDistributeData(dm, pointSF, valueSection, MPIU_INT, values, newValueSection, (void**) &newValues);CHKERRQ(ierr);
+      ierr = PetscSectionGetStorageSize(newValueSection, &numNewValues);CHKERRQ(ierr);
+      ierr = PetscSectionGetChart(newValueSection, &newStart, &newEnd);CHKERRQ(ierr);
+      /* Count and fill strata, points come out sorted since we traverse them in order */
+      for (v = 0; v < numNewValues; ++v) {
+        ierr = PetscFindInt(newValues[v], newLabel->numStrata, newLabel->stratumValues, &s);CHKERRQ(ierr);
+        if (s < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Label value %D was not gathered", newValues[v]);
+        ++newLabel->stratumSizes[s];
+      }
       newLabel->stratumOffsets[0] = 0;
       for (s = 0; s < newLabel->numStrata; ++s) {
         newLabel->stratumOffsets[s+1] = newLabel->stratumSizes[s] + newLabel->stratumOffsets[s];
+        newLabel->stratumSizes[s]     = 0;
       }
-      /* Pack points and Scatter */
-      if (!rank) {
-        ierr = PetscMalloc3(numProcs,PetscMPIInt,&sendcnts,numProcs,PetscMPIInt,&offsets,numProcs+1,PetscMPIInt,&displs);CHKERRQ(ierr);
-        displs[0] = 0;
-        for (p = 0; p < numProcs; ++p) {
-          sendcnts[p] = 0;
-          for (s = 0; s < next->numStrata; ++s) {
-            sendcnts[p] += stratumSizes[p*next->numStrata+s];
-          }
-          offsets[p]  = displs[p];
-          displs[p+1] = displs[p] + sendcnts[p];
-        }
-        ierr = PetscMalloc(displs[numProcs] * sizeof(PetscInt), &points);CHKERRQ(ierr);
-        /* TODO We should switch to using binary search if the label is a lot smaller than partitions */
-        for (proc = 0; proc < numProcs; ++proc) {
-          PetscInt dof, off;
-
-          ierr = PetscSectionGetDof(partSection, proc, &dof);CHKERRQ(ierr);
-          ierr = PetscSectionGetOffset(partSection, proc, &off);CHKERRQ(ierr);
-          for (s = 0; s < next->numStrata; ++s) {
-            PetscInt lStart = next->stratumOffsets[s], lEnd = next->stratumOffsets[s]+next->stratumSizes[s];
-            PetscInt pStart = off,                     pEnd = off+dof;
-
-            while (pStart < pEnd && lStart < lEnd) {
-              if (partArray[pStart] > next->points[lStart]) {
-                ++lStart;
-              } else if (next->points[lStart] > partArray[pStart]) {
-                ++pStart;
-              } else {
-                points[offsets[proc]++] = next->points[lStart];
-                ++pStart; ++lStart;
-              }
-            }
-          }
+      ierr = PetscMalloc(numNewValues * sizeof(PetscInt), &newLabel->points);CHKERRQ(ierr);
+      for (pnew = newStart; pnew < newEnd; ++pnew) {
+        PetscInt dof, off, d;
+
+        ierr = PetscSectionGetDof(newValueSection, pnew, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(newValueSection, pnew, &off);CHKERRQ(ierr);
+        for (d = off; d < off+dof; ++d) {
+          ierr = PetscFindInt(newValues[d], newLabel->numStrata, newLabel->stratumValues, &s);CHKERRQ(ierr);
+          newLabel->points[newLabel->stratumOffsets[s]+newLabel->stratumSizes[s]++] = pnew;
         }
       }
-      ierr = PetscMalloc(newLabel->stratumOffsets[newLabel->numStrata] * sizeof(PetscInt), &newLabel->points);CHKERRQ(ierr);
-      ierr = MPI_Scatterv(points, sendcnts, displs, MPIU_INT, newLabel->points, newLabel->stratumOffsets[newLabel->numStrata], MPIU_INT, 0, comm);CHKERRQ(ierr);
-      ierr = PetscFree(points);CHKERRQ(ierr);
-      ierr = PetscFree3(sendcnts,offsets,displs);CHKERRQ(ierr);
-      ierr = PetscFree(stratumSizes);CHKERRQ(ierr);
-      /* Renumber points */
-      ierr = ISGlobalToLocalMappingApply(renumbering, IS_GTOLM_MASK, newLabel->stratumOffsets[newLabel->numStrata], newLabel->points, NULL, newLabel->points);CHKERRQ(ierr);
-      /* Sort points */
-      for (s = 0; s < newLabel->numStrata; ++s) {
-        ierr = PetscSortInt(newLabel->stratumSizes[s], &newLabel->points[newLabel->stratumOffsets[s]]);CHKERRQ(ierr);
-      }
+      ierr = PetscFree(values);CHKERRQ(ierr);
+      ierr = PetscFree(newValues);CHKERRQ(ierr);
+      ierr = PetscSectionDestroy(&valueSection);CHKERRQ(ierr);
+      ierr = PetscSectionDestroy(&newValueSection);CHKERRQ(ierr);
       /* Insert into list */
       if (newNext) newNext->next = newLabel;
       else pmesh->labels = newLabel;
       newNext = newLabel;
-      if (!rank) next = next->next;
     }
+    ierr = PetscFree2(allNames,labelNames);CHKERRQ(ierr);
+    ierr = PetscFree3(localNames,nameSizes,nameOffsets);CHKERRQ(ierr);
   }
   ierr = PetscLogEventEnd(DMPLEX_DistributeLabels,dm,0,0,0);CHKERRQ(ierr);
   /* Setup hybrid structure */
   {
-    const PetscInt *gpoints;
-    PetscInt        depth, n, d;
+    PetscInt *hybridFlags, *newHybridFlags, hybridMax[8], depth, pStart, pEnd, newStart, newEnd, d, p;
 
-    for (d = 0; d <= dim; ++d) {pmesh->hybridPointMax[d] = mesh->hybridPointMax[d];}
-    ierr = MPI_Bcast(pmesh->hybridPointMax, dim+1, MPIU_INT, 0, comm);CHKERRQ(ierr);
-    ierr = ISLocalToGlobalMappingGetSize(renumbering, &n);CHKERRQ(ierr);
-    ierr = ISLocalToGlobalMappingGetIndices(renumbering, &gpoints);CHKERRQ(ierr);
     ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+    ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+    ierr = DMPlexGetChart(*dmParallel, &newStart, &newEnd);CHKERRQ(ierr);
+    ierr = PetscMalloc2(pEnd-pStart,PetscInt,&hybridFlags,newEnd-newStart,PetscInt,&newHybridFlags);CHKERRQ(ierr);
+    ierr = PetscMemzero(hybridFlags, (pEnd-pStart) * sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMemzero(newHybridFlags, (newEnd-newStart) * sizeof(PetscInt));CHKERRQ(ierr);
+    /* Flag the hybrid points for each dimension, and move the flags with the points */
     for (d = 0; d <= dim; ++d) {
-      PetscInt pmax = pmesh->hybridPointMax[d], newmax = 0, pEnd, stratum[2], p;
+      PetscInt pmax = mesh->hybridPointMax[d], stratum[2];
 
       if (pmax < 0) continue;
       ierr = DMPlexGetDepthStratum(dm, d > depth ? depth : d, &stratum[0], &stratum[1]);CHKERRQ(ierr);
+      for (p = PetscMax(pmax, stratum[0]); p < stratum[1]; ++p) hybridFlags[p-pStart] |= 1 << d;
+    }
+    ierr = MPI_Allreduce(mesh->hybridPointMax, hybridMax, dim+1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(pointSF, MPIU_INT, hybridFlags, newHybridFlags);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(pointSF, MPIU_INT, hybridFlags, newHybridFlags);CHKERRQ(ierr);
+    for (d = 0; d <= dim; ++d) {
+      PetscInt newmax = 0;
+
+      pmesh->hybridPointMax[d] = -1;
+      if (hybridMax[d] < 0) continue;
       /* This mesh is not interpolated, so there is still a problem here */
       ierr = DMPlexGetDepthStratum(*dmParallel, d > 0 ? 1 : d, NULL, &pEnd);CHKERRQ(ierr);
-      ierr = MPI_Bcast(stratum, 2, MPIU_INT, 0, comm);CHKERRQ(ierr);
-      for (p = 0; p < n; ++p) {
-        const PetscInt point = gpoints[p];
-
-        if ((point >= stratum[0]) && (point < stratum[1]) && (point >= pmax)) ++newmax;
-      }
+      for (p = 0; p < newEnd-newStart; ++p) if (newHybridFlags[p] & (1 << d)) ++newmax;
       if (newmax > 0) pmesh->hybridPointMax[d] = pEnd - newmax;
-      else            pmesh->hybridPointMax[d] = -1;
     }
-    ierr = ISLocalToGlobalMappingRestoreIndices(renumbering, &gpoints);CHKERRQ(ierr);
+    ierr = PetscFree2(hybridFlags,newHybridFlags);CHKERRQ(ierr);
   }
   /* Cleanup Partition */
   ierr = ISLocalToGlobalMappingDestroy(&renumbering);CHKERRQ(ierr);
+  ierr = PetscFree(globalPoints);CHKERRQ(ierr);
   ierr = PetscSFDestroy(&partSF);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&partSection);CHKERRQ(ierr);
   ierr = ISDestroy(&part);CHKERRQ(ierr);
@@ -4909,6 +5438,7 @@ PetscErrorCode CellRefinerSetCones(CellRefiner refiner, DM dm, PetscInt depthSiz
       }
       ierr = DMPlexSetSupport(rdm, newp, supportNew);CHKERRQ(ierr);
     }
+    ierr = PetscFree(supportRef);CHKERRQ(ierr);
     break;
   case 3:
     if (cMax < 0) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "No cell maximum specified in hybrid mesh");
@@ -5457,6 +5987,25 @@ PetscErrorCode CellRefinerCreateSF(CellRefiner refiner, DM dm, PetscInt depthSiz
         numLeavesNew += 4 + 4;
       }
       break;
+    case 3:
+      /* Hybrid simplicial 2D */
+      if ((p >= vStart) && (p < vEnd)) {
+        /* Old vertices stay the same */
+        ++numLeavesNew;
+      } else if ((p >= fStart) && (p < fMax)) {
+        /* Old interior faces add new faces and vertex */
+        numLeavesNew += 1 + 2;
+      } else if ((p >= fMax) && (p < fEnd)) {
+        /* Old hybrid faces stay the same */
+        ++numLeavesNew;
+      } else if ((p >= cStart) && (p < cMax)) {
+        /* Old interior cells add new cells and interior faces */
+        numLeavesNew += 4 + 3;
+      } else if ((p >= cMax) && (p < cEnd)) {
+        /* Old hybrid cells add new cells and hybrid face */
+        numLeavesNew += 2 + 1;
+      }
+      break;
     default:
       SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Unknown cell refiner %d", refiner);
     }
@@ -5608,11 +6157,11 @@ PetscErrorCode CellRefinerCreateSF(CellRefiner refiner, DM dm, PetscInt depthSiz
           remotePointsNew[m].index = rfStartNew[n] + (rdepthMaxOld[n*(depth+1)+depth-1] - rfStart[n])*2 + (rp - rcStart[n])*3 + r;
           remotePointsNew[m].rank  = rrank;
         }
-      } else if ((p >= cStart) && (p < cMax)) {
+      } else if ((p >= cMax) && (p < cEnd)) {
         /* Old hybrid cells add new cells and hybrid face */
         for (r = 0; r < 2; ++r, ++m) {
-          localPointsNew[m]        = cStartNew     + (p  - cStart)*4     + r;
-          remotePointsNew[m].index = rcStartNew[n] + (rp - rcStart[n])*4 + r;
+          localPointsNew[m]        = cStartNew     + (cMax                            - cStart)*4     + (p  - cMax)*2                            + r;
+          remotePointsNew[m].index = rcStartNew[n] + (rdepthMaxOld[n*(depth+1)+depth] - rcStart[n])*4 + (rp - rdepthMaxOld[n*(depth+1)+depth])*2 + r;
           remotePointsNew[m].rank  = rrank;
         }
         localPointsNew[m]        = fStartNew     + (fMax                              - fStart)*2     + (cMax                            - cStart)*3     + (p  - cMax);
@@ -5629,7 +6178,7 @@ PetscErrorCode CellRefinerCreateSF(CellRefiner refiner, DM dm, PetscInt depthSiz
   ierr = ISDestroy(&processRanks);CHKERRQ(ierr);
   ierr = PetscSFSetGraph(sfNew, pEndNew-pStartNew, numLeavesNew, localPointsNew, PETSC_OWN_POINTER, remotePointsNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
   ierr = PetscFree5(rdepthSize,rvStartNew,reStartNew,rfStartNew,rcStartNew);CHKERRQ(ierr);
-  ierr = PetscFree6(depthSizeOld,rdepthSizeOld,rvStart,reStart,rfStart,rcStart);CHKERRQ(ierr);
+  ierr = PetscFree7(depthSizeOld,rdepthSizeOld,rdepthMaxOld,rvStart,reStart,rfStart,rcStart);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -5767,7 +6316,7 @@ PetscErrorCode CellRefinerCreateLabels(CellRefiner refiner, DM dm, PetscInt dept
               ierr = DMLabelSetValue(labelNew, newp, values[val]);CHKERRQ(ierr);
             }
             for (r = 0; r < 3; ++r) {
-              newp = fStartNew + (fEnd - fStart)*2 + (p - cStart)*3 + r;
+              newp = fStartNew + (fMax - fStart)*2 + (p - cStart)*3 + r;
               ierr = DMLabelSetValue(labelNew, newp, values[val]);CHKERRQ(ierr);
             }
           } else if ((p >= cMax) && (p < cEnd)) {
@@ -5798,6 +6347,35 @@ PetscErrorCode CellRefinerCreateLabels(CellRefiner refiner, DM dm, PetscInt dept
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "CellRefinerStratify"
+/* The new points are numbered by depth for every refiner, so the depth label can be made directly without searching the supports */
+PetscErrorCode CellRefinerStratify(DM dm, PetscInt depthSize[], DM rdm)
+{
+  DMLabel        label;
+  PetscInt       depth, cStartNew, cEndNew, vStartNew, vEndNew, fStartNew, fEndNew, eStartNew, eEndNew, p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = GetDepthStart_Private(depth, depthSize, &cStartNew, &fStartNew, &eStartNew, &vStartNew);CHKERRQ(ierr);
+  ierr = GetDepthEnd_Private(depth, depthSize, &cEndNew, &fEndNew, &eEndNew, &vEndNew);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(DMPLEX_Stratify,rdm,0,0,0);CHKERRQ(ierr);
+  ierr = DMPlexCreateLabel(rdm, "depth");CHKERRQ(ierr);
+  ierr = DMPlexGetDepthLabel(rdm, &label);CHKERRQ(ierr);
+  /* Strata must be created in increasing depth, and points are added in increasing order so each insertion is an append */
+  for (p = vStartNew; p < vEndNew; ++p) {ierr = DMLabelSetValue(label, p, 0);CHKERRQ(ierr);}
+  if (depth > 2) {
+    for (p = eStartNew; p < eEndNew; ++p) {ierr = DMLabelSetValue(label, p, 1);CHKERRQ(ierr);}
+  }
+  if (depth > 1) {
+    for (p = fStartNew; p < fEndNew; ++p) {ierr = DMLabelSetValue(label, p, depth-1);CHKERRQ(ierr);}
+  }
+  for (p = cStartNew; p < cEndNew; ++p) {ierr = DMLabelSetValue(label, p, depth);CHKERRQ(ierr);}
+  ierr = PetscLogEventEnd(DMPLEX_Stratify,rdm,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexRefine_Uniform"
 /* This will only work for interpolated meshes */
@@ -5829,7 +6407,7 @@ PetscErrorCode DMPlexRefine_Uniform(DM dm, CellRefiner cellRefiner, DM *dmRefine
   /* Step 4: Set cones and supports */
   ierr = CellRefinerSetCones(cellRefiner, dm, depthSize, rdm);CHKERRQ(ierr);
   /* Step 5: Stratify */
-  ierr = DMPlexStratify(rdm);CHKERRQ(ierr);
+  ierr = CellRefinerStratify(dm, depthSize, rdm);CHKERRQ(ierr);
   /* Step 6: Set coordinates for vertices */
   ierr = CellRefinerSetCoordinates(cellRefiner, dm, depthSize, rdm);CHKERRQ(ierr);
   /* Step 7: Create pointSF */
@@ -5943,6 +6521,8 @@ PetscErrorCode DMRefine_Plex(DM dm, MPI_Comm comm, DM *dmRefined)
 
     ierr = DMPlexGetCellRefiner_Private(dm, &cellRefiner);CHKERRQ(ierr);
     ierr = DMPlexRefine_Uniform(dm, cellRefiner, dmRefined);CHKERRQ(ierr);
+    /* A uniformly refined mesh is refined uniformly again, so hierarchies can be built by repeated refinement */
+    ierr = DMPlexSetRefinementUniform(*dmRefined, PETSC_TRUE);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
   ierr = DMPlexGetRefinementLimit(dm, &refinementLimit);CHKERRQ(ierr);
@@ -6003,6 +6583,39 @@ PetscErrorCode DMRefine_Plex(DM dm, MPI_Comm comm, DM *dmRefined)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMRefineHierarchy_Plex"
+/*
+  Each level is refined in parallel from the previous one, without redistribution, so the fine meshes inherit the
+  partition of the coarse mesh. With a volume limit instead of uniform refinement, the limit is halved on each level.
+*/
+PetscErrorCode DMRefineHierarchy_Plex(DM dm, PetscInt nlevels, DM dmRefined[])
+{
+  DM             cdm = dm;
+  PetscReal      refinementLimit;
+  PetscBool      isUniform;
+  PetscInt       r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (nlevels < 0) SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "nlevels cannot be negative");
+  if (nlevels == 0) PetscFunctionReturn(0);
+  PetscValidPointer(dmRefined, 3);
+  ierr = DMPlexGetRefinementUniform(dm, &isUniform);CHKERRQ(ierr);
+  ierr = DMPlexGetRefinementLimit(dm, &refinementLimit);CHKERRQ(ierr);
+  for (r = 0; r < nlevels; ++r) {
+    ierr = DMRefine(cdm, PetscObjectComm((PetscObject) dm), &dmRefined[r]);CHKERRQ(ierr);
+    if (!dmRefined[r]) SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_WRONG, "Refinement of level %D produced no mesh, set a refinement limit or use uniform refinement", r);
+    if (!isUniform) {
+      refinementLimit *= 0.5;
+      ierr = DMPlexSetRefinementLimit(dmRefined[r], refinementLimit);CHKERRQ(ierr);
+    }
+    cdm = dmRefined[r];
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexGetDepthLabel"
 /*@
@@ -6181,10 +6794,11 @@ PetscErrorCode DMPlexCreateSectionInitial(DM dm, PetscInt dim, PetscInt numField
 {
   PetscInt      *numDofTot;
   PetscInt       pStart = 0, pEnd = 0;
-  PetscInt       p, d, f;
+  PetscInt       depth, p, d, f;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   ierr = PetscMalloc((dim+1) * sizeof(PetscInt), &numDofTot);CHKERRQ(ierr);
   for (d = 0; d <= dim; ++d) {
     numDofTot[d] = 0;
@@ -6202,7 +6816,13 @@ PetscErrorCode DMPlexCreateSectionInitial(DM dm, PetscInt dim, PetscInt numField
   ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
   ierr = PetscSectionSetChart(*section, pStart, pEnd);CHKERRQ(ierr);
   for (d = 0; d <= dim; ++d) {
-    ierr = DMPlexGetDepthStratum(dm, d, &pStart, &pEnd);CHKERRQ(ierr);
+    if ((d > 0) && (depth > 1) && (depth < dim)) {
+      /* A partially interpolated mesh has points of dimension d at height dim-d, if at all */
+      pStart = pEnd = 0;
+      if (dim-d < depth) {ierr = DMPlexGetHeightStratum(dm, dim-d, &pStart, &pEnd);CHKERRQ(ierr);}
+    } else {
+      ierr = DMPlexGetDepthStratum(dm, d, &pStart, &pEnd);CHKERRQ(ierr);
+    }
     for (p = pStart; p < pEnd; ++p) {
       for (f = 0; f < numFields; ++f) {
         ierr = PetscSectionSetFieldDof(*section, p, f, numDof[f*(dim+1)+d]);CHKERRQ(ierr);
@@ -6431,6 +7051,9 @@ PetscErrorCode DMPlexCreateSectionBCIndices(DM dm, PetscSection section)
   Notes: numDof[f*(dim+1)+d] gives the number of dof for field f on sieve points of dimension d. For instance, numDof[1] is the
   nubmer of dof for field 0 on each edge.
 
+  If lazy interpolation was turned on with DMPlexSetInterpolationLazy(), the faces and edges needed to hold these dof
+  are created first with DMPlexInterpolateHeight().
+
   Level: developer
 
   Fortran Notes:
@@ -6441,9 +7064,20 @@ PetscErrorCode DMPlexCreateSectionBCIndices(DM dm, PetscSection section)
 @*/
 PetscErrorCode DMPlexCreateSection(DM dm, PetscInt dim, PetscInt numFields,const PetscInt numComp[],const PetscInt numDof[], PetscInt numBC,const PetscInt bcField[],const IS bcPoints[], PetscSection *section)
 {
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (mesh->interpolateLazy && (dim > 1)) {
+    PetscInt d, f;
+
+    /* Find the lowest dimension, other than vertices, which carries dof */
+    for (d = 1; d < dim; ++d) {
+      for (f = 0; f < numFields; ++f) if (numDof[f*(dim+1)+d]) break;
+      if (f < numFields) break;
+    }
+    if (d < dim) {ierr = DMPlexInterpolateHeight(dm, dim-d);CHKERRQ(ierr);}
+  }
   ierr = DMPlexCreateSectionInitial(dm, dim, numFields, numComp, numDof, section);CHKERRQ(ierr);
   ierr = DMPlexCreateSectionBCDof(dm, numBC, bcField, bcPoints, PETSC_DETERMINE, *section);CHKERRQ(ierr);
   ierr = PetscSectionSetUp(*section);CHKERRQ(ierr);
@@ -6536,10 +7170,12 @@ PetscErrorCode DMPlexSetCoordinateSection(DM dm, PetscSection section)
 #define __FUNCT__ "DMPlexGetConeSection"
 PetscErrorCode DMPlexGetConeSection(DM dm, PetscSection *section)
 {
-  DM_Plex *mesh = (DM_Plex*) dm->data;
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexCreateConeSection_Private(dm);CHKERRQ(ierr);
   if (section) *section = mesh->coneSection;
   PetscFunctionReturn(0);
 }
@@ -279,3 +279,144 @@ PetscErrorCode DMPlexCreateCGNS(MPI_Comm comm, PetscInt cgid, PetscBool interpol
 #endif
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateCGNSFromFile"
+/*@C
+  DMPlexCreateCGNSFromFile - Create a DMPlex mesh from a CGNS file, with every process reading its own part.
+
+  Collective on comm
+
+  Input Parameters:
++ comm  - The MPI communicator
+. filename - The name of the CGNS file
+- interpolate - Create faces and edges in the mesh
+
+  Output Parameter:
+. dm  - The DM object representing the mesh
+
+  Notes:
+  Each process opens the file and reads a contiguous block of cells and of vertices, so no process ever holds the
+  whole mesh. The result is distributed, but not balanced, and should be given to DMPlexDistribute(). This needs a
+  single unstructured zone with a single section of one cell type. Other files fall back to DMPlexCreateCGNS(),
+  which reads the mesh on the first process.
+
+  Level: beginner
+
+.keywords: mesh,CGNS
+.seealso: DMPlexCreateCGNS(), DMPlexCreateFromCellListParallel(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexCreateCGNSFromFile(MPI_Comm comm, const char filename[], PetscBool interpolate, DM *dm)
+{
+#if defined(PETSC_HAVE_CGNS)
+  PetscSF        sfVert;
+  PetscInt       numGlobalCells, numGlobalVertices, cStart, vStart, nc = PETSC_DECIDE, nv = PETSC_DECIDE, numCorners = 0, c, v;
+  int           *cells;
+  double        *coords, *x[3];
+  cgsize_t      *elements;
+  PetscErrorCode ierr;
+  /* Read from file */
+  char          basename[CGIO_MAX_NAME_LENGTH+1];
+  char          buffer[CGIO_MAX_NAME_LENGTH+1];
+  int           cgid, nbases, nzones, nsections = 0, ngrids, ncoords, nbndry, parentFlag, dim = 0, physDim = 0, d;
+  ZoneType_t    zonetype = Unstructured;
+  ElementType_t cellType = MIXED;
+  DataType_t    datatype;
+  cgsize_t      sizes[3], start, end, range_min[3] = {1, 1, 1}, range_max[3] = {1, 1, 1};
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_CGNS)
+  ierr = cg_open(filename, CG_MODE_READ, &cgid);
+  if (ierr) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_FILE_OPEN, "cg_open(\"%s\",...) failed: %s", filename, cg_get_error());
+  ierr = cg_nbases(cgid, &nbases);CHKERRQ(ierr);
+  if (nbases > 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"CGNS file must have a single base, not %d\n",nbases);
+  ierr = cg_base_read(cgid, 1, basename, &dim, &physDim);CHKERRQ(ierr);
+  ierr = cg_nzones(cgid, 1, &nzones);CHKERRQ(ierr);
+  if (nzones == 1) {
+    ierr = cg_zone_type(cgid, 1, 1, &zonetype);CHKERRQ(ierr);
+    ierr = cg_nsections(cgid, 1, 1, &nsections);CHKERRQ(ierr);
+  }
+  if (nsections == 1) {
+    ierr = cg_section_read(cgid, 1, 1, 1, buffer, &cellType, &start, &end, &nbndry, &parentFlag);CHKERRQ(ierr);
+  }
+  switch (cellType) {
+  case TRI_3:   numCorners = 3;break;
+  case QUAD_4:  numCorners = 4;break;
+  case TETRA_4: numCorners = 4;break;
+  case HEXA_8:  numCorners = 8;break;
+  default:      numCorners = 0;
+  }
+  if ((nzones != 1) || (zonetype != Unstructured) || (nsections != 1) || !numCorners) {
+    ierr = PetscInfo(NULL, "CGNS file is not a single section of one cell type, reading the mesh on the first process\n");CHKERRQ(ierr);
+    ierr = DMPlexCreateCGNS(comm, cgid, interpolate, dm);CHKERRQ(ierr);
+    ierr = cg_close(cgid);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = cg_zone_read(cgid, 1, 1, buffer, sizes);CHKERRQ(ierr);
+  ierr = cg_ngrids(cgid, 1, 1, &ngrids);CHKERRQ(ierr);
+  if (ngrids > 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"CGNS file must have a single grid, not %d\n",ngrids);
+  ierr = cg_ncoords(cgid, 1, 1, &ncoords);CHKERRQ(ierr);
+  if (ncoords != dim) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"CGNS file must have a coordinate array for each dimension, not %d\n",ncoords);
+  /* Each process reads a contiguous block of cells and of vertices */
+  numGlobalVertices = sizes[0];
+  numGlobalCells    = sizes[1];
+  ierr    = PetscSplitOwnership(comm, &nc, &numGlobalCells);CHKERRQ(ierr);
+  ierr    = PetscSplitOwnership(comm, &nv, &numGlobalVertices);CHKERRQ(ierr);
+  ierr    = MPI_Scan(&nc, &cStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr    = MPI_Scan(&nv, &vStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  cStart -= nc;
+  vStart -= nv;
+  ierr = PetscMalloc3(nc*numCorners,cgsize_t,&elements,nc*numCorners,int,&cells,nv*dim,double,&coords);CHKERRQ(ierr);
+  if (nc) {ierr = cg_elements_partial_read(cgid, 1, 1, 1, start+cStart, start+cStart+nc-1, elements, NULL);CHKERRQ(ierr);}
+  /* CGNS uses Fortran-based indexing, and our tetrahedra and hexahedra are inverted */
+  for (c = 0; c < nc; ++c) {
+    int *cone = &cells[c*numCorners], tmp;
+
+    for (v = 0; v < numCorners; ++v) cone[v] = (int) elements[c*numCorners+v]-1;
+    if (cellType == TETRA_4) {tmp = cone[0]; cone[0] = cone[1]; cone[1] = tmp;}
+    if (cellType == HEXA_8)  {tmp = cone[1]; cone[1] = cone[3]; cone[3] = tmp;}
+  }
+  ierr = PetscMalloc3(nv,double,&x[0],nv,double,&x[1],nv,double,&x[2]);CHKERRQ(ierr);
+  if (nv) {
+    range_min[0] = vStart+1;
+    range_max[0] = vStart+nv;
+    for (d = 0; d < dim; ++d) {
+      ierr = cg_coord_info(cgid, 1, 1, d+1, &datatype, buffer);CHKERRQ(ierr);
+      ierr = cg_coord_read(cgid, 1, 1, buffer, RealDouble, range_min, range_max, x[d]);CHKERRQ(ierr);
+    }
+  }
+  for (v = 0; v < nv; ++v) for (d = 0; d < dim; ++d) coords[v*dim+d] = x[d][v];
+  ierr = PetscFree3(x[0],x[1],x[2]);CHKERRQ(ierr);
+  ierr = cg_close(cgid);CHKERRQ(ierr);
+  /* Build the distributed mesh */
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *dm, basename);CHKERRQ(ierr);
+  ierr = DMPlexSetDimension(*dm, dim);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromCellListParallel_Private(*dm, nc, nv, numCorners, cells, &sfVert);CHKERRQ(ierr);
+  for (c = 0; c < nc; ++c) {
+    ierr = DMPlexSetLabelValue(*dm, "zone", c, 1);CHKERRQ(ierr);
+  }
+  if (interpolate) {
+    DM idm;
+
+    ierr = DMPlexInterpolate(*dm, &idm);CHKERRQ(ierr);
+    /* Maintain zone label */
+    {
+      DMLabel label;
+
+      ierr = DMPlexRemoveLabel(*dm, "zone", &label);CHKERRQ(ierr);
+      if (label) {ierr = DMPlexAddLabel(idm, label);CHKERRQ(ierr);}
+    }
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = idm;
+  }
+  ierr = DMPlexBuildCoordinatesParallel_Private(*dm, dim, nc, sfVert, coords);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
+  ierr = PetscFree3(elements,cells,coords);CHKERRQ(ierr);
+#else
+  SETERRQ(comm, PETSC_ERR_SUP, "This method requires CGNS support. Reconfigure using --with-cgns-dir");
+#endif
+  PetscFunctionReturn(0);
+}
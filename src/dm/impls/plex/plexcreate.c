@@ -14,6 +14,8 @@ PetscErrorCode  DMSetFromOptions_Plex(DM dm)
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   ierr = PetscOptionsHead("DMPlex Options");CHKERRQ(ierr);
   /* Handle DMPlex refinement */
+  /* Handle DMPlex interpolation */
+  ierr = PetscOptionsBool("-dm_plex_interpolate_lazy", "Create faces and edges only when a section needs them", "DMPlexSetInterpolationLazy", mesh->interpolateLazy, &mesh->interpolateLazy, NULL);CHKERRQ(ierr);
   /* Handle associated vectors */
   /* Handle viewing */
   ierr = PetscOptionsBool("-dm_plex_print_set_values", "Output all set values info", "DMView", PETSC_FALSE, &mesh->printSetValues, NULL);CHKERRQ(ierr);
@@ -497,10 +499,12 @@ extern PetscErrorCode DMCreateInterpolation_Plex(DM dmCoarse, DM dmFine, Mat *in
 extern PetscErrorCode DMCreateMatrix_Plex(DM dm,  Mat *J);
 extern PetscErrorCode DMCreateCoordinateDM_Plex(DM dm, DM *cdm);
 extern PetscErrorCode DMRefine_Plex(DM dm, MPI_Comm comm, DM *dmRefined);
+extern PetscErrorCode DMRefineHierarchy_Plex(DM dm, PetscInt nlevels, DM dmRefined[]);
 extern PetscErrorCode DMClone_Plex(DM dm, DM *newdm);
 extern PetscErrorCode DMSetUp_Plex(DM dm);
 extern PetscErrorCode DMDestroy_Plex(DM dm);
 extern PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer);
+extern PetscErrorCode DMLoad_Plex(DM dm, PetscViewer viewer);
 extern PetscErrorCode DMCreateSubDM_Plex(DM dm, PetscInt numFields, PetscInt fields[], IS *is, DM *subdm);
 extern PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, IS *cellIS);
 
@@ -535,6 +539,7 @@ PetscErrorCode DMInitialize_Plex(DM dm)
 {
   PetscFunctionBegin;
   dm->ops->view                            = DMView_Plex;
+  dm->ops->load                            = DMLoad_Plex;
   dm->ops->setfromoptions                  = DMSetFromOptions_Plex;
   dm->ops->clone                           = DMClone_Plex;
   dm->ops->setup                           = DMSetUp_Plex;
@@ -551,7 +556,7 @@ PetscErrorCode DMInitialize_Plex(DM dm)
   dm->ops->getinjection                    = 0;
   dm->ops->refine                          = DMRefine_Plex;
   dm->ops->coarsen                         = 0;
-  dm->ops->refinehierarchy                 = 0;
+  dm->ops->refinehierarchy                 = DMRefineHierarchy_Plex;
   dm->ops->coarsenhierarchy                = 0;
   dm->ops->globaltolocalbegin              = NULL;
   dm->ops->globaltolocalend                = NULL;
@@ -608,11 +613,14 @@ PETSC_EXTERN PetscErrorCode DMCreate_Plex(DM dm)
   mesh->maxConeSize       = 0;
   mesh->cones             = NULL;
   mesh->coneOrientations  = NULL;
+  mesh->numConeBlocks     = 0;
+  mesh->coneBlock         = NULL;
   ierr                    = PetscSectionCreate(PetscObjectComm((PetscObject)dm), &mesh->supportSection);CHKERRQ(ierr);
   mesh->maxSupportSize    = 0;
   mesh->supports          = NULL;
   mesh->refinementUniform = PETSC_TRUE;
   mesh->refinementLimit   = -1.0;
+  mesh->interpolateLazy   = PETSC_FALSE;
 
   mesh->facesTmp = NULL;
 
@@ -803,6 +811,196 @@ PetscErrorCode DMPlexCreateFromCellList(MPI_Comm comm, PetscInt dim, PetscInt nu
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexBuildFromCellListParallel_Private"
+/*
+  This takes as input the common mesh generator output, a list of the vertices for each local cell using global vertex
+  numbers. The local vertices are numbered after the cells in increasing global order, and vertexSF maps the owned
+  vertices (roots) onto the local vertices (leaves).
+*/
+PetscErrorCode DMPlexBuildFromCellListParallel_Private(DM dm, PetscInt numCells, PetscInt numVertices, PetscInt numCorners, const int cells[], PetscSF *vertexSF)
+{
+  MPI_Comm       comm;
+  PetscSF        sfPoint;
+  PetscLayout    vLayout;
+  PetscSFNode   *remoteVertices, *rootNodes, *leafNodes, *remotePoints;
+  PetscInt      *vertices, *localPoints, *cone;
+  PetscInt       numVerticesAdj, numLeaves, owner, c, p, v;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  /* Collect the global numbers of the vertices touched by the local cells */
+  numVerticesAdj = numCells*numCorners;
+  ierr = PetscMalloc((numVerticesAdj+1) * sizeof(PetscInt), &vertices);CHKERRQ(ierr);
+  for (p = 0; p < numVerticesAdj; ++p) vertices[p] = cells[p];
+  ierr = PetscSortRemoveDupsInt(&numVerticesAdj, vertices);CHKERRQ(ierr);
+  /* Build the local topology */
+  ierr = DMPlexSetChart(dm, 0, numCells+numVerticesAdj);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    ierr = DMPlexSetConeSize(dm, c, numCorners);CHKERRQ(ierr);
+  }
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, numCorners, PETSC_INT, &cone);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    for (p = 0; p < numCorners; ++p) {
+      ierr = PetscFindInt(cells[c*numCorners+p], numVerticesAdj, vertices, &v);CHKERRQ(ierr);
+      cone[p] = numCells+v;
+    }
+    ierr = DMPlexSetCone(dm, c, cone);CHKERRQ(ierr);
+  }
+  ierr = DMRestoreWorkArray(dm, numCorners, PETSC_INT, &cone);CHKERRQ(ierr);
+  ierr = DMPlexSymmetrize(dm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(dm);CHKERRQ(ierr);
+  /* Vertices are owned in contiguous blocks of the global numbering */
+  ierr = PetscLayoutCreate(comm, &vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vLayout, numVertices);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vLayout);CHKERRQ(ierr);
+  ierr = PetscMalloc(numVerticesAdj * sizeof(PetscSFNode), &remoteVertices);CHKERRQ(ierr);
+  for (v = 0; v < numVerticesAdj; ++v) {
+    ierr = PetscLayoutFindOwner(vLayout, vertices[v], &owner);CHKERRQ(ierr);
+    remoteVertices[v].rank  = owner;
+    remoteVertices[v].index = vertices[v] - vLayout->range[owner];
+  }
+  ierr = PetscLayoutDestroy(&vLayout);CHKERRQ(ierr);
+  ierr = PetscFree(vertices);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, vertexSF);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(*vertexSF);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(*vertexSF, numVertices, numVerticesAdj, NULL, PETSC_OWN_POINTER, remoteVertices, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* The highest rank touching a vertex owns the mesh point, since the owner of the number may not touch it at all */
+  ierr = PetscMalloc2(numVertices,PetscSFNode,&rootNodes,numVerticesAdj,PetscSFNode,&leafNodes);CHKERRQ(ierr);
+  for (v = 0; v < numVertices; ++v) {
+    rootNodes[v].rank  = -1;
+    rootNodes[v].index = -1;
+  }
+  for (v = 0; v < numVerticesAdj; ++v) {
+    leafNodes[v].rank  = rank;
+    leafNodes[v].index = numCells+v;
+  }
+  ierr = PetscSFReduceBegin(*vertexSF, MPIU_2INT, leafNodes, rootNodes, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(*vertexSF, MPIU_2INT, leafNodes, rootNodes, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(*vertexSF, MPIU_2INT, rootNodes, leafNodes);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(*vertexSF, MPIU_2INT, rootNodes, leafNodes);CHKERRQ(ierr);
+  for (v = 0, numLeaves = 0; v < numVerticesAdj; ++v) if (leafNodes[v].rank != rank) ++numLeaves;
+  ierr = PetscMalloc(numLeaves * sizeof(PetscInt), &localPoints);CHKERRQ(ierr);
+  ierr = PetscMalloc(numLeaves * sizeof(PetscSFNode), &remotePoints);CHKERRQ(ierr);
+  for (v = 0, p = 0; v < numVerticesAdj; ++v) {
+    if (leafNodes[v].rank == rank) continue;
+    localPoints[p]        = numCells+v;
+    remotePoints[p].rank  = leafNodes[v].rank;
+    remotePoints[p].index = leafNodes[v].index;
+    ++p;
+  }
+  ierr = PetscFree2(rootNodes,leafNodes);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPoint, numCells+numVerticesAdj, numLeaves, localPoints, PETSC_OWN_POINTER, remotePoints, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexBuildCoordinatesParallel_Private"
+/*
+  This takes as input the coordinates for each owned vertex, and sends them to the local vertices using vertexSF
+*/
+PetscErrorCode DMPlexBuildCoordinatesParallel_Private(DM dm, PetscInt spaceDim, PetscInt numCells, PetscSF vertexSF, const double vertexCoords[])
+{
+  PetscSection   coordSection;
+  Vec            coordinates;
+  PetscScalar   *coords, *rootCoords, *leafCoords;
+  PetscInt       numVertices, numVerticesAdj, coordSize, v, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFGetGraph(vertexSF, &numVertices, &numVerticesAdj, NULL, NULL);CHKERRQ(ierr);
+  ierr = DMPlexGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetNumFields(coordSection, 1);CHKERRQ(ierr);
+  ierr = PetscSectionSetFieldComponents(coordSection, 0, spaceDim);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(coordSection, numCells, numCells + numVerticesAdj);CHKERRQ(ierr);
+  for (v = numCells; v < numCells+numVerticesAdj; ++v) {
+    ierr = PetscSectionSetDof(coordSection, v, spaceDim);CHKERRQ(ierr);
+    ierr = PetscSectionSetFieldDof(coordSection, v, 0, spaceDim);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(coordSection, &coordSize);CHKERRQ(ierr);
+  ierr = VecCreate(PetscObjectComm((PetscObject)dm), &coordinates);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinates, "coordinates");CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinates, coordSize, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetType(coordinates,dm->vectype);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  /* Send one component at a time, since the SF only moves a few basic types */
+  ierr = PetscMalloc2(numVertices,PetscScalar,&rootCoords,numVerticesAdj,PetscScalar,&leafCoords);CHKERRQ(ierr);
+  for (d = 0; d < spaceDim; ++d) {
+    for (v = 0; v < numVertices; ++v) rootCoords[v] = vertexCoords[v*spaceDim+d];
+    ierr = PetscSFBcastBegin(vertexSF, MPIU_SCALAR, rootCoords, leafCoords);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(vertexSF, MPIU_SCALAR, rootCoords, leafCoords);CHKERRQ(ierr);
+    for (v = 0; v < numVerticesAdj; ++v) coords[v*spaceDim+d] = leafCoords[v];
+  }
+  ierr = PetscFree2(rootCoords,leafCoords);CHKERRQ(ierr);
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = DMSetCoordinatesLocal(dm, coordinates);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateFromCellListParallel"
+/*@C
+  DMPlexCreateFromCellListParallel - This takes as input common mesh generator output, a list of the vertices for each cell, distributed over the processes, and produces a DM
+
+  Collective on comm
+
+  Input Parameters:
++ comm - The communicator
+. dim - The topological dimension of the mesh
+. numCells - The number of local cells
+. numVertices - The number of vertices owned by this process, which are a contiguous block of the global numbering
+. numCorners - The number of vertices for each cell
+. interpolate - Flag indicating that intermediate mesh entities (faces, edges) should be created automatically
+. cells - An array of numCells*numCorners numbers, the global vertex numbers for each local cell
+. spaceDim - The spatial dimension used for coordinates
+- vertexCoords - An array of numVertices*spaceDim numbers, the coordinates of each owned vertex
+
+  Output Parameters:
++ vertexSF - (Optional) An SF whose roots are the owned vertices and whose leaves are the local vertices, in increasing global order
+- dm - The DM
+
+  Notes:
+  This is intended for parallel readers, where each process loads a contiguous slab of cells and of vertices. The
+  local vertices are numbered after the local cells in increasing global order, so vertexSF can be used to send any
+  other vertex data, such as labels, from the owning slab to the local vertices. The resulting mesh is distributed,
+  but not balanced, and can be given to DMPlexDistribute() directly.
+
+  Level: beginner
+
+.seealso: DMPlexCreateFromCellList(), DMPlexDistribute(), DMPlexCreate()
+@*/
+PetscErrorCode DMPlexCreateFromCellListParallel(MPI_Comm comm, PetscInt dim, PetscInt numCells, PetscInt numVertices, PetscInt numCorners, PetscBool interpolate, const int cells[], PetscInt spaceDim, const double vertexCoords[], PetscSF *vertexSF, DM *dm)
+{
+  PetscSF        sfVert;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(dm, 11);
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = DMPlexSetDimension(*dm, dim);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromCellListParallel_Private(*dm, numCells, numVertices, numCorners, cells, &sfVert);CHKERRQ(ierr);
+  if (interpolate) {
+    DM idm;
+
+    ierr = DMPlexInterpolate(*dm, &idm);CHKERRQ(ierr);
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = idm;
+  }
+  ierr = DMPlexBuildCoordinatesParallel_Private(*dm, spaceDim, numCells, sfVert, vertexCoords);CHKERRQ(ierr);
+  if (vertexSF) *vertexSF = sfVert;
+  else {ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexCreateFromDAG"
 /*
@@ -1,5 +1,6 @@
 #define PETSCDM_DLL
 #include <petsc-private/dmpleximpl.h>    /*I   "petscdmplex.h"   I*/
+#include <petscsf.h>
 
 #if defined(PETSC_HAVE_EXODUSII)
 #include <netcdf.h>
@@ -232,3 +233,173 @@ PetscErrorCode DMPlexCreateExodus(MPI_Comm comm, PetscInt exoid, PetscBool inter
 #endif
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateExodusFromFile"
+/*@C
+  DMPlexCreateExodusFromFile - Create a DMPlex mesh from an ExodusII file, with every process reading its own part.
+
+  Collective on comm
+
+  Input Parameters:
++ comm  - The MPI communicator
+. filename - The name of the ExodusII file
+- interpolate - Create faces and edges in the mesh
+
+  Output Parameter:
+. dm  - The DM object representing the mesh
+
+  Notes:
+  Each process opens the file and reads a contiguous block of cells and of vertices, so no process ever holds the
+  whole mesh. The result is distributed, but not balanced, and should be given to DMPlexDistribute(). The "Cell Sets"
+  and "Vertex Sets" labels are created, but side sets are not read. If the cell blocks do not all have the same number
+  of vertices per cell, this falls back to DMPlexCreateExodus(), which reads the mesh on the first process.
+
+  Level: beginner
+
+.keywords: mesh,ExodusII
+.seealso: DMPlexCreateExodus(), DMPlexCreateFromCellListParallel(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexCreateExodusFromFile(MPI_Comm comm, const char filename[], PetscBool interpolate, DM *dm)
+{
+#if defined(PETSC_HAVE_EXODUSII)
+  PetscSF        sfVert;
+  PetscInt       numGlobalCells, numGlobalVertices, cStart, vStart, nc = PETSC_DECIDE, nv = PETSC_DECIDE, numCorners = -1, numLeaves, c, v;
+  PetscInt      *cellSet;
+  int           *cs_id, *cells;
+  double        *coords, *x[3];
+  PetscBool      uniform = PETSC_TRUE;
+  PetscErrorCode ierr;
+  /* Read from ex_open() and ex_get_init() */
+  char  title[PETSC_MAX_PATH_LEN+1];
+  int   CPU_word_size = sizeof(double), IO_word_size = 0, exoid, cs, vs, d;
+  float version;
+  int   dim = 0, numVertices = 0, numCells = 0, num_cs = 0, num_vs = 0, num_fs = 0;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_EXODUSII)
+  exoid = ex_open(filename, EX_READ, &CPU_word_size, &IO_word_size, &version);
+  if (exoid <= 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_OPEN, "ex_open(\"%s\",...) did not return a valid file ID", filename);
+  ierr = PetscMemzero(title,(PETSC_MAX_PATH_LEN+1)*sizeof(char));CHKERRQ(ierr);
+  ierr = ex_get_init(exoid, title, &dim, &numVertices, &numCells, &num_cs, &num_vs, &num_fs);
+  if (ierr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"ExodusII ex_get_init() failed with error code %D\n",ierr);
+  if (!num_cs) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Exodus file does not contain any cell set\n");
+  ierr = PetscMalloc(num_cs * sizeof(int), &cs_id);CHKERRQ(ierr);
+  ierr = ex_get_elem_blk_ids(exoid, cs_id);CHKERRQ(ierr);
+  for (cs = 0; cs < num_cs; ++cs) {
+    char buffer[PETSC_MAX_PATH_LEN+1];
+    int  num_cell_in_set, num_vertex_per_cell, num_attr;
+
+    ierr = ex_get_elem_block(exoid, cs_id[cs], buffer, &num_cell_in_set, &num_vertex_per_cell, &num_attr);CHKERRQ(ierr);
+    if (numCorners < 0) numCorners = num_vertex_per_cell;
+    else if (numCorners != num_vertex_per_cell) uniform = PETSC_FALSE;
+  }
+  if (!uniform) {
+    ierr = PetscInfo(NULL, "Cell blocks have different cell shapes, reading the mesh on the first process\n");CHKERRQ(ierr);
+    ierr = DMPlexCreateExodus(comm, exoid, interpolate, dm);CHKERRQ(ierr);
+    ierr = PetscFree(cs_id);CHKERRQ(ierr);
+    ierr = ex_close(exoid);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* Each process reads a contiguous block of cells, which may span several cell sets */
+  numGlobalCells    = numCells;
+  numGlobalVertices = numVertices;
+  ierr    = PetscSplitOwnership(comm, &nc, &numGlobalCells);CHKERRQ(ierr);
+  ierr    = PetscSplitOwnership(comm, &nv, &numGlobalVertices);CHKERRQ(ierr);
+  ierr    = MPI_Scan(&nc, &cStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr    = MPI_Scan(&nv, &vStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  cStart -= nc;
+  vStart -= nv;
+  ierr = PetscMalloc3(nc*numCorners,int,&cells,nc,PetscInt,&cellSet,nv*dim,double,&coords);CHKERRQ(ierr);
+  for (cs = 0, c = 0; cs < num_cs; ++cs) {
+    char     buffer[PETSC_MAX_PATH_LEN+1];
+    int      num_cell_in_set, num_vertex_per_cell, num_attr;
+    PetscInt lo, hi, cc;
+
+    ierr = ex_get_elem_block(exoid, cs_id[cs], buffer, &num_cell_in_set, &num_vertex_per_cell, &num_attr);CHKERRQ(ierr);
+    lo   = PetscMax(cStart, c);
+    hi   = PetscMin(cStart+nc, c+num_cell_in_set);
+    if (lo < hi) {
+      ierr = ex_get_n_elem_conn(exoid, cs_id[cs], (int) (lo-c+1), (int) (hi-lo), &cells[(lo-cStart)*numCorners]);CHKERRQ(ierr);
+      for (cc = lo; cc < hi; ++cc) cellSet[cc-cStart] = cs_id[cs];
+    }
+    c += num_cell_in_set;
+  }
+  ierr = PetscFree(cs_id);CHKERRQ(ierr);
+  /* EXO uses Fortran-based indexing, and our tetrahedra and hexahedra are inverted */
+  for (c = 0; c < nc; ++c) {
+    int *cone = &cells[c*numCorners], tmp;
+
+    for (v = 0; v < numCorners; ++v) --cone[v];
+    if ((dim == 3) && (numCorners == 4)) {tmp = cone[0]; cone[0] = cone[1]; cone[1] = tmp;}
+    if ((dim == 3) && (numCorners == 8)) {tmp = cone[1]; cone[1] = cone[3]; cone[3] = tmp;}
+  }
+  ierr = PetscMalloc3(nv,double,&x[0],nv,double,&x[1],nv,double,&x[2]);CHKERRQ(ierr);
+  if (nv) {ierr = ex_get_n_coord(exoid, (int) (vStart+1), (int) nv, x[0], dim > 1 ? x[1] : NULL, dim > 2 ? x[2] : NULL);CHKERRQ(ierr);}
+  for (v = 0; v < nv; ++v) for (d = 0; d < dim; ++d) coords[v*dim+d] = x[d][v];
+  ierr = PetscFree3(x[0],x[1],x[2]);CHKERRQ(ierr);
+  /* Build the distributed mesh */
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *dm, title);CHKERRQ(ierr);
+  ierr = DMPlexSetDimension(*dm, dim);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromCellListParallel_Private(*dm, nc, nv, numCorners, cells, &sfVert);CHKERRQ(ierr);
+  for (c = 0; c < nc; ++c) {
+    ierr = DMPlexSetLabelValue(*dm, "Cell Sets", c, cellSet[c]);CHKERRQ(ierr);
+  }
+  if (interpolate) {
+    DM idm;
+
+    ierr = DMPlexInterpolate(*dm, &idm);CHKERRQ(ierr);
+    /* Maintain Cell Sets label */
+    {
+      DMLabel label;
+
+      ierr = DMPlexRemoveLabel(*dm, "Cell Sets", &label);CHKERRQ(ierr);
+      if (label) {ierr = DMPlexAddLabel(idm, label);CHKERRQ(ierr);}
+    }
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = idm;
+  }
+  ierr = DMPlexBuildCoordinatesParallel_Private(*dm, dim, nc, sfVert, coords);CHKERRQ(ierr);
+  /* Create vertex set label, marking the owned vertices in each set and sending the marks to the local vertices */
+  ierr = PetscSFGetGraph(sfVert, NULL, &numLeaves, NULL, NULL);CHKERRQ(ierr);
+  if (num_vs > 0) {
+    PetscInt *rootMark, *leafMark;
+    /* Read from ex_get_node_set_ids() */
+    int *vs_id;
+    /* Read from ex_get_node_set_param() */
+    int num_vertex_in_set, num_attr;
+    /* Read from ex_get_node_set() */
+    int *vs_vertex_list;
+
+    ierr = PetscMalloc3(num_vs,int,&vs_id,nv,PetscInt,&rootMark,numLeaves,PetscInt,&leafMark);CHKERRQ(ierr);
+    ierr = ex_get_node_set_ids(exoid, vs_id);CHKERRQ(ierr);
+    for (vs = 0; vs < num_vs; ++vs) {
+      ierr = ex_get_node_set_param(exoid, vs_id[vs], &num_vertex_in_set, &num_attr);CHKERRQ(ierr);
+      ierr = PetscMalloc(num_vertex_in_set * sizeof(int), &vs_vertex_list);CHKERRQ(ierr);
+      ierr = ex_get_node_set(exoid, vs_id[vs], vs_vertex_list);CHKERRQ(ierr);
+      for (v = 0; v < nv; ++v) rootMark[v] = -1;
+      for (v = 0; v < num_vertex_in_set; ++v) {
+        const PetscInt gv = vs_vertex_list[v]-1;
+
+        if ((gv >= vStart) && (gv < vStart+nv)) rootMark[gv-vStart] = vs_id[vs];
+      }
+      ierr = PetscFree(vs_vertex_list);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(sfVert, MPIU_INT, rootMark, leafMark);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sfVert, MPIU_INT, rootMark, leafMark);CHKERRQ(ierr);
+      for (v = 0; v < numLeaves; ++v) {
+        if (leafMark[v] >= 0) {ierr = DMPlexSetLabelValue(*dm, "Vertex Sets", nc+v, leafMark[v]);CHKERRQ(ierr);}
+      }
+    }
+    ierr = PetscFree3(vs_id,rootMark,leafMark);CHKERRQ(ierr);
+  }
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
+  ierr = PetscFree3(cells,cellSet,coords);CHKERRQ(ierr);
+  ierr = ex_close(exoid);CHKERRQ(ierr);
+#else
+  SETERRQ(comm, PETSC_ERR_SUP, "This method requires ExodusII support. Reconfigure using --download-exodusii");
+#endif
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,366 @@
+#define PETSCDM_DLL
+#include <petsc-private/dmpleximpl.h>    /*I   "petscdmplex.h"   I*/
+#include <petscsf.h>
+#include <petscviewerhdf5.h>
+
+/*
+  The native HDF5 layout of a DMPlex mesh is
+
+    /topology/cells           numCells x numCorners global vertex numbers, with integer attribute "cell_dim"
+    /geometry/vertices        numVertices x spaceDim coordinates
+    /labels/<name>/cells      numCells label values, -1 for unlabeled cells
+    /labels/<name>/vertices   numVertices label values, -1 for unlabeled vertices
+
+  Every dataset is written with VecView(), so it is stored as a collective hyperslab and can be read back with
+  VecLoad() by any number of processes, each loading a contiguous slab of cells and vertices.
+*/
+
+#if defined(PETSC_HAVE_HDF5)
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetDatasetSize_HDF5_Private"
+/* Get the number of rows and the row length of a dataset in the current group */
+static PetscErrorCode DMPlexGetDatasetSize_HDF5_Private(PetscViewer viewer, const char name[], PetscInt *N, PetscInt *bs)
+{
+  hid_t          file_id, group, dset_id, filespace;
+  hsize_t        dims[4];
+  int            rdim;
+  herr_t         status;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = PetscViewerHDF5OpenGroup(viewer, &file_id, &group);CHKERRQ(ierr);
+  dset_id = H5Dopen2(group, name, H5P_DEFAULT);
+  if (dset_id == -1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Could not H5Dopen() dataset %s", name);
+  filespace = H5Dget_space(dset_id);
+  if (filespace == -1) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, "Could not H5Dget_space()");
+  rdim = H5Sget_simple_extent_dims(filespace, dims, NULL);
+  if (rdim < 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Dataset %s is empty", name);
+  *N  = (PetscInt) dims[0];
+  *bs = rdim > 1 ? (PetscInt) dims[1] : 1;
+  status = H5Sclose(filespace);CHKERRQ(status);
+  status = H5Dclose(dset_id);CHKERRQ(status);
+  if (group != file_id) {status = H5Gclose(group);CHKERRQ(status);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexWriteIntAttribute_HDF5_Private"
+static PetscErrorCode DMPlexWriteIntAttribute_HDF5_Private(PetscViewer viewer, const char dataset[], const char name[], PetscInt value)
+{
+  hid_t          file_id, dset_id, dataspace, attribute;
+  int            ivalue = (int) value;
+  herr_t         status;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr      = PetscViewerHDF5GetFileId(viewer, &file_id);CHKERRQ(ierr);
+  dset_id   = H5Dopen2(file_id, dataset, H5P_DEFAULT);
+  if (dset_id == -1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_LIB, "Could not H5Dopen() dataset %s", dataset);
+  dataspace = H5Screate(H5S_SCALAR);
+  if (dataspace == -1) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, "Could not H5Screate()");
+  if (H5Aexists(dset_id, name)) {
+    attribute = H5Aopen(dset_id, name, H5P_DEFAULT);
+  } else {
+    attribute = H5Acreate2(dset_id, name, H5T_NATIVE_INT, dataspace, H5P_DEFAULT, H5P_DEFAULT);
+  }
+  if (attribute == -1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_LIB, "Could not create attribute %s", name);
+  status = H5Awrite(attribute, H5T_NATIVE_INT, &ivalue);CHKERRQ(status);
+  status = H5Aclose(attribute);CHKERRQ(status);
+  status = H5Sclose(dataspace);CHKERRQ(status);
+  status = H5Dclose(dset_id);CHKERRQ(status);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexReadIntAttribute_HDF5_Private"
+static PetscErrorCode DMPlexReadIntAttribute_HDF5_Private(PetscViewer viewer, const char dataset[], const char name[], PetscInt *value)
+{
+  hid_t          file_id, dset_id, attribute;
+  int            ivalue;
+  herr_t         status;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr      = PetscViewerHDF5GetFileId(viewer, &file_id);CHKERRQ(ierr);
+  dset_id   = H5Dopen2(file_id, dataset, H5P_DEFAULT);
+  if (dset_id == -1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Could not H5Dopen() dataset %s", dataset);
+  attribute = H5Aopen(dset_id, name, H5P_DEFAULT);
+  if (attribute == -1) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Dataset %s has no attribute %s", dataset, name);
+  status = H5Aread(attribute, H5T_NATIVE_INT, &ivalue);CHKERRQ(status);
+  status = H5Aclose(attribute);CHKERRQ(status);
+  status = H5Dclose(dset_id);CHKERRQ(status);
+  *value = ivalue;
+  PetscFunctionReturn(0);
+}
+
+typedef struct {
+  PetscInt   numNames, maxNames;
+  char     **names;
+} DMPlexLabelNames_HDF5;
+
+/* Called by H5Literate() for each link in the /labels group */
+static herr_t DMPlexAddLabelName_HDF5_Private(hid_t group, const char name[], const H5L_info_t *info, void *ctx)
+{
+  DMPlexLabelNames_HDF5 *labels = (DMPlexLabelNames_HDF5 *) ctx;
+  PetscErrorCode         ierr;
+
+  if (labels->numNames == labels->maxNames) {
+    char **tmp;
+
+    labels->maxNames = PetscMax(2*labels->maxNames, 8);
+    ierr = PetscMalloc(labels->maxNames * sizeof(char *), &tmp);if (ierr) return -1;
+    ierr = PetscMemcpy(tmp, labels->names, labels->numNames * sizeof(char *));if (ierr) return -1;
+    ierr = PetscFree(labels->names);if (ierr) return -1;
+    labels->names = tmp;
+  }
+  ierr = PetscStrallocpy(name, &labels->names[labels->numNames++]);if (ierr) return -1;
+  return 0;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateIntVec_HDF5_Private"
+/* Create a Vec holding n rows of bs integers in a contiguous slab, named for the dataset it stores */
+static PetscErrorCode DMPlexCreateIntVec_HDF5_Private(MPI_Comm comm, const char name[], PetscInt n, PetscInt bs, Vec *v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate(comm, v);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *v, name);CHKERRQ(ierr);
+  ierr = VecSetSizes(*v, n*bs, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(*v, bs);CHKERRQ(ierr);
+  ierr = VecSetType(*v, VECSTANDARD);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexView_HDF5"
+PetscErrorCode DMPlexView_HDF5(DM dm, PetscViewer viewer)
+{
+  MPI_Comm        comm;
+  DMLabel         next;
+  PetscSection    coordSection;
+  Vec             coordinates, cellVec, vertexVec;
+  IS              globalCellNumbers, globalVertexNumbers;
+  const PetscInt *gcell, *gvertex;
+  PetscScalar    *cells, *vertices, *coords;
+  PetscInt       *closure = NULL;
+  PetscInt        dim, spaceDim = 0, cStart, cEnd, vStart, vEnd, numCorners = 0, numOwnedCells, numOwnedVertices, c, v, d;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = DMPlexGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetCellNumbering(dm, &globalCellNumbers);CHKERRQ(ierr);
+  ierr = DMPlexGetVertexNumbering(dm, &globalVertexNumbers);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalCellNumbers, &gcell);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalVertexNumbers, &gvertex);CHKERRQ(ierr);
+  ierr = DMPlexGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  /* All cells must have the same shape */
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt closureSize, numVertices = 0, p;
+
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+    for (p = 0; p < closureSize*2; p += 2) if ((closure[p] >= vStart) && (closure[p] < vEnd)) ++numVertices;
+    if (c == cStart) numCorners = numVertices;
+    else if (numVertices != numCorners) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_SUP, "Cell %D has %D vertices, but HDF5 output needs all cells to have %D", c, numVertices, numCorners);
+  }
+  for (v = vStart; v < vEnd; ++v) {
+    ierr     = PetscSectionGetDof(coordSection, v, &d);CHKERRQ(ierr);
+    spaceDim = PetscMax(spaceDim, d);
+  }
+  ierr = MPI_Allreduce(MPI_IN_PLACE, &numCorners, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(MPI_IN_PLACE, &spaceDim, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  /* Owned points have nonnegative global numbers, and are numbered contiguously in local order */
+  for (c = cStart, numOwnedCells = 0; c < cEnd; ++c) if (gcell[c-cStart] >= 0) ++numOwnedCells;
+  for (v = vStart, numOwnedVertices = 0; v < vEnd; ++v) if (gvertex[v-vStart] >= 0) ++numOwnedVertices;
+  /* Write topology */
+  ierr = DMPlexCreateIntVec_HDF5_Private(comm, "cells", numOwnedCells, numCorners, &cellVec);CHKERRQ(ierr);
+  ierr = VecGetArray(cellVec, &cells);CHKERRQ(ierr);
+  for (c = cStart, v = 0; c < cEnd; ++c) {
+    PetscInt closureSize, p;
+
+    if (gcell[c-cStart] < 0) continue;
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+    for (p = 0; p < closureSize*2; p += 2) {
+      const PetscInt q = closure[p];
+
+      if ((q < vStart) || (q >= vEnd)) continue;
+      cells[v++] = gvertex[q-vStart] < 0 ? -(gvertex[q-vStart]+1) : gvertex[q-vStart];
+    }
+  }
+  if (closure) {ierr = DMPlexRestoreTransitiveClosure(dm, cStart, PETSC_TRUE, NULL, &closure);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(cellVec, &cells);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
+  ierr = VecView(cellVec, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = DMPlexWriteIntAttribute_HDF5_Private(viewer, "/topology/cells", "cell_dim", dim);CHKERRQ(ierr);
+  ierr = VecDestroy(&cellVec);CHKERRQ(ierr);
+  /* Write geometry */
+  ierr = DMPlexCreateIntVec_HDF5_Private(comm, "vertices", numOwnedVertices, spaceDim, &vertexVec);CHKERRQ(ierr);
+  ierr = VecGetArray(vertexVec, &vertices);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  for (v = vStart, c = 0; v < vEnd; ++v) {
+    PetscInt dof, off;
+
+    if (gvertex[v-vStart] < 0) continue;
+    ierr = PetscSectionGetDof(coordSection, v, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(coordSection, v, &off);CHKERRQ(ierr);
+    for (d = 0; d < spaceDim; ++d, ++c) vertices[c] = d < dof ? coords[off+d] : 0.0;
+  }
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecRestoreArray(vertexVec, &vertices);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/geometry");CHKERRQ(ierr);
+  ierr = VecView(vertexVec, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = VecDestroy(&vertexVec);CHKERRQ(ierr);
+  /* Write the labels on cells and vertices, the depth label is rebuilt on load */
+  for (next = ((DM_Plex *) dm->data)->labels; next; next = next->next) {
+    char      group[PETSC_MAX_PATH_LEN];
+    PetscBool isDepth;
+
+    ierr = PetscStrcmp(next->name, "depth", &isDepth);CHKERRQ(ierr);
+    if (isDepth) continue;
+    ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/labels/%s", next->name);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
+    ierr = DMPlexCreateIntVec_HDF5_Private(comm, "cells", numOwnedCells, 1, &cellVec);CHKERRQ(ierr);
+    ierr = VecGetArray(cellVec, &cells);CHKERRQ(ierr);
+    for (c = cStart, v = 0; c < cEnd; ++c) {
+      PetscInt value;
+
+      if (gcell[c-cStart] < 0) continue;
+      ierr       = DMLabelGetValue(next, c, &value);CHKERRQ(ierr);
+      cells[v++] = value;
+    }
+    ierr = VecRestoreArray(cellVec, &cells);CHKERRQ(ierr);
+    ierr = VecView(cellVec, viewer);CHKERRQ(ierr);
+    ierr = VecDestroy(&cellVec);CHKERRQ(ierr);
+    ierr = DMPlexCreateIntVec_HDF5_Private(comm, "vertices", numOwnedVertices, 1, &vertexVec);CHKERRQ(ierr);
+    ierr = VecGetArray(vertexVec, &vertices);CHKERRQ(ierr);
+    for (v = vStart, c = 0; v < vEnd; ++v) {
+      PetscInt value;
+
+      if (gvertex[v-vStart] < 0) continue;
+      ierr          = DMLabelGetValue(next, v, &value);CHKERRQ(ierr);
+      vertices[c++] = value;
+    }
+    ierr = VecRestoreArray(vertexVec, &vertices);CHKERRQ(ierr);
+    ierr = VecView(vertexVec, viewer);CHKERRQ(ierr);
+    ierr = VecDestroy(&vertexVec);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(globalCellNumbers, &gcell);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(globalVertexNumbers, &gvertex);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexLoad_HDF5"
+/*
+  Each process reads a contiguous slab of the cells and of the vertices with collective I/O. The result is a
+  distributed cell-vertex mesh, which is not balanced. Use DMPlexDistribute() to partition it, and DMPlexInterpolate()
+  to create the faces and edges.
+*/
+PetscErrorCode DMPlexLoad_HDF5(DM dm, PetscViewer viewer)
+{
+  MPI_Comm              comm;
+  PetscSF               sfVert;
+  Vec                   cellVec, vertexVec;
+  DMPlexLabelNames_HDF5 labels;
+  hid_t                 file_id;
+  const PetscScalar    *a;
+  int                  *cells;
+  double               *coords;
+  PetscInt              dim, numCells, numVertices, numCorners, spaceDim, nc = PETSC_DECIDE, nv = PETSC_DECIDE, numLeaves, c, v, l;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5GetFileId(viewer, &file_id);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
+  ierr = DMPlexGetDatasetSize_HDF5_Private(viewer, "cells", &numCells, &numCorners);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = DMPlexReadIntAttribute_HDF5_Private(viewer, "/topology/cells", "cell_dim", &dim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/geometry");CHKERRQ(ierr);
+  ierr = DMPlexGetDatasetSize_HDF5_Private(viewer, "vertices", &numVertices, &spaceDim);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = PetscSplitOwnership(comm, &nc, &numCells);CHKERRQ(ierr);
+  ierr = PetscSplitOwnership(comm, &nv, &numVertices);CHKERRQ(ierr);
+  /* Read the slabs */
+  ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
+  ierr = DMPlexCreateIntVec_HDF5_Private(comm, "cells", nc, numCorners, &cellVec);CHKERRQ(ierr);
+  ierr = VecLoad(cellVec, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PushGroup(viewer, "/geometry");CHKERRQ(ierr);
+  ierr = DMPlexCreateIntVec_HDF5_Private(comm, "vertices", nv, spaceDim, &vertexVec);CHKERRQ(ierr);
+  ierr = VecLoad(vertexVec, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nc*numCorners,int,&cells,nv*spaceDim,double,&coords);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(cellVec, &a);CHKERRQ(ierr);
+  for (c = 0; c < nc*numCorners; ++c) cells[c] = (int) PetscRealPart(a[c]);
+  ierr = VecRestoreArrayRead(cellVec, &a);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(vertexVec, &a);CHKERRQ(ierr);
+  for (v = 0; v < nv*spaceDim; ++v) coords[v] = PetscRealPart(a[v]);
+  ierr = VecRestoreArrayRead(vertexVec, &a);CHKERRQ(ierr);
+  ierr = VecDestroy(&cellVec);CHKERRQ(ierr);
+  ierr = VecDestroy(&vertexVec);CHKERRQ(ierr);
+  /* Build the distributed mesh */
+  ierr = DMPlexSetDimension(dm, dim);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromCellListParallel_Private(dm, nc, nv, numCorners, cells, &sfVert);CHKERRQ(ierr);
+  ierr = DMPlexBuildCoordinatesParallel_Private(dm, spaceDim, nc, sfVert, coords);CHKERRQ(ierr);
+  ierr = PetscFree2(cells,coords);CHKERRQ(ierr);
+  /* Read labels, moving the vertex values from the owned slab to the local vertices */
+  labels.numNames = labels.maxNames = 0;
+  labels.names    = NULL;
+  if (H5Lexists(file_id, "/labels", H5P_DEFAULT)) {
+    hid_t  group;
+    herr_t status;
+
+    group  = H5Gopen2(file_id, "/labels", H5P_DEFAULT);
+    if (group < 0) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, "Could not open group /labels");
+    status = H5Literate(group, H5_INDEX_NAME, H5_ITER_INC, NULL, DMPlexAddLabelName_HDF5_Private, &labels);
+    if (status < 0) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, "Could not iterate over group /labels");
+    status = H5Gclose(group);CHKERRQ(status);
+  }
+  ierr = PetscSFGetGraph(sfVert, NULL, &numLeaves, NULL, NULL);CHKERRQ(ierr);
+  for (l = 0; l < labels.numNames; ++l) {
+    char      group[PETSC_MAX_PATH_LEN];
+    PetscInt *rootValues, *leafValues;
+
+    ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/labels/%s", labels.names[l]);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
+    ierr = DMPlexCreateIntVec_HDF5_Private(comm, "cells", nc, 1, &cellVec);CHKERRQ(ierr);
+    ierr = VecLoad(cellVec, viewer);CHKERRQ(ierr);
+    ierr = DMPlexCreateIntVec_HDF5_Private(comm, "vertices", nv, 1, &vertexVec);CHKERRQ(ierr);
+    ierr = VecLoad(vertexVec, viewer);CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+    ierr = DMPlexCreateLabel(dm, labels.names[l]);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(cellVec, &a);CHKERRQ(ierr);
+    for (c = 0; c < nc; ++c) {
+      const PetscInt value = (PetscInt) PetscRealPart(a[c]);
+
+      if (value != -1) {ierr = DMPlexSetLabelValue(dm, labels.names[l], c, value);CHKERRQ(ierr);}
+    }
+    ierr = VecRestoreArrayRead(cellVec, &a);CHKERRQ(ierr);
+    ierr = PetscMalloc2(nv,PetscInt,&rootValues,numLeaves,PetscInt,&leafValues);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(vertexVec, &a);CHKERRQ(ierr);
+    for (v = 0; v < nv; ++v) rootValues[v] = (PetscInt) PetscRealPart(a[v]);
+    ierr = VecRestoreArrayRead(vertexVec, &a);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfVert, MPIU_INT, rootValues, leafValues);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfVert, MPIU_INT, rootValues, leafValues);CHKERRQ(ierr);
+    for (v = 0; v < numLeaves; ++v) {
+      if (leafValues[v] != -1) {ierr = DMPlexSetLabelValue(dm, labels.names[l], nc+v, leafValues[v]);CHKERRQ(ierr);}
+    }
+    ierr = PetscFree2(rootValues,leafValues);CHKERRQ(ierr);
+    ierr = VecDestroy(&cellVec);CHKERRQ(ierr);
+    ierr = VecDestroy(&vertexVec);CHKERRQ(ierr);
+    ierr = PetscFree(labels.names[l]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(labels.names);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
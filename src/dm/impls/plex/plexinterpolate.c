@@ -1,5 +1,6 @@
 #include <petsc-private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
 #include <../src/sys/utils/hash.h>
+#include <petscsf.h>
 
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexGetFaces_Internal"
@@ -265,6 +266,261 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexInterpolatePointSF_Internal"
+/*
+  DMPlexInterpolatePointSF_Internal - Add the shared edges and faces to the point SF of an interpolated mesh
+
+  The point SF of the mesh must already identify the shared vertices. Each edge or face whose vertices are all shared
+  is identified by the sorted global numbers of its vertices, and sent to the process owning the first of these. That
+  process matches the copies, gives ownership to the lowest rank holding the point, and replies to the other holders.
+*/
+PetscErrorCode DMPlexInterpolatePointSF_Internal(DM dm)
+{
+  MPI_Comm           comm;
+  PetscSF            sfPoint;
+  PetscLayout        layout;
+  PetscHashIJKL      pointTable;
+  IS                 globalVertexNumbers;
+  const PetscInt    *gv, *degree, *leaves;
+  const PetscSFNode *remotes;
+  PetscSFNode       *remotePoints;
+  PetscInt          *localPoints, *sendBuf, *recvBuf, *replyBuf, *replyRecvBuf, *closure = NULL;
+  PetscMPIInt       *sendCounts, *sendOffsets, *recvCounts, *recvOffsets, *offsets;
+  PetscInt           depth, d, vStart, vEnd, pStart, pEnd, nroots, nleaves, numOwned, numShared, numRecv, numReplies, numNew, p, l, r;
+  PetscMPIInt        rank, numProcs;
+  PetscBool         *sharedVertex;
+  PetscBT            leafPoints;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  if (numProcs == 1) PetscFunctionReturn(0);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  pStart = PetscMax(pStart, 0);pEnd = PetscMax(pEnd, pStart);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+  if (nroots < 0) PetscFunctionReturn(0);
+  /* A vertex is shared if it is a leaf, or a root which is referenced by another process */
+  ierr = PetscMalloc((pEnd-pStart) * sizeof(PetscBool), &sharedVertex);CHKERRQ(ierr);
+  ierr = PetscMemzero(sharedVertex, (pEnd-pStart) * sizeof(PetscBool));CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeBegin(sfPoint, &degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(sfPoint, &degree);CHKERRQ(ierr);
+  for (p = vStart; p < vEnd; ++p) if (degree[p]) sharedVertex[p-pStart] = PETSC_TRUE;
+  /* Points which are already leaves were matched by an earlier interpolation, and are not sent again */
+  ierr = PetscBTCreate(pEnd-pStart, &leafPoints);CHKERRQ(ierr);
+  ierr = PetscBTMemzero(pEnd-pStart, leafPoints);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    const PetscInt q = leaves ? leaves[l] : l;
+
+    if ((q >= vStart) && (q < vEnd)) sharedVertex[q-pStart] = PETSC_TRUE;
+    if ((q >= pStart) && (q < pEnd)) {ierr = PetscBTSet(leafPoints, q-pStart);CHKERRQ(ierr);}
+  }
+  /* Global vertex numbers, where unowned vertices are encoded as -(g+1) */
+  ierr = DMPlexCreateNumbering_Private(dm, vStart, vEnd, sfPoint, &globalVertexNumbers);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalVertexNumbers, &gv);CHKERRQ(ierr);
+  for (p = vStart, numOwned = 0; p < vEnd; ++p) if (gv[p-vStart] >= 0) ++numOwned;
+  ierr = PetscLayoutCreate(comm, &layout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(layout, numOwned);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(layout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(layout);CHKERRQ(ierr);
+  /* Each process orients its copy of a shared edge independently, so give every copy the vertex order of increasing
+     global number. Otherwise the halves of the edge do not match across processes after refinement. */
+  if (depth > 1) {
+    PetscInt eStart, eEnd, e;
+
+    ierr = DMPlexGetDepthStratum(dm, 1, &eStart, &eEnd);CHKERRQ(ierr);
+    for (e = eStart; e < eEnd; ++e) {
+      const PetscInt *cone, *support;
+      PetscInt        newCone[2], g[2], coneSize, supportSize, s, i;
+
+      ierr = DMPlexGetConeSize(dm, e, &coneSize);CHKERRQ(ierr);
+      if (coneSize != 2) continue;
+      ierr = DMPlexGetCone(dm, e, &cone);CHKERRQ(ierr);
+      if (!sharedVertex[cone[0]-pStart] || !sharedVertex[cone[1]-pStart]) continue;
+      for (i = 0; i < 2; ++i) g[i] = gv[cone[i]-vStart] < 0 ? -(gv[cone[i]-vStart]+1) : gv[cone[i]-vStart];
+      if (g[0] < g[1]) continue;
+      newCone[0] = cone[1];
+      newCone[1] = cone[0];
+      ierr = DMPlexSetCone(dm, e, newCone);CHKERRQ(ierr);
+      /* Reverse the orientation of the edge in each cell containing it */
+      ierr = DMPlexGetSupportSize(dm, e, &supportSize);CHKERRQ(ierr);
+      ierr = DMPlexGetSupport(dm, e, &support);CHKERRQ(ierr);
+      for (s = 0; s < supportSize; ++s) {
+        const PetscInt *scone, *sornt;
+        PetscInt        sconeSize, c;
+
+        ierr = DMPlexGetConeSize(dm, support[s], &sconeSize);CHKERRQ(ierr);
+        ierr = DMPlexGetCone(dm, support[s], &scone);CHKERRQ(ierr);
+        ierr = DMPlexGetConeOrientation(dm, support[s], &sornt);CHKERRQ(ierr);
+        for (c = 0; c < sconeSize; ++c) {
+          if (scone[c] == e) {ierr = DMPlexInsertConeOrientation(dm, support[s], c, sornt[c] == -2 ? 0 : -2);CHKERRQ(ierr);}
+        }
+      }
+    }
+  }
+  /* Pack (key, rank, point) for every candidate edge and face, sorted by destination */
+  ierr = PetscMalloc5(numProcs,PetscMPIInt,&sendCounts,numProcs+1,PetscMPIInt,&sendOffsets,numProcs,PetscMPIInt,&recvCounts,numProcs+1,PetscMPIInt,&recvOffsets,numProcs,PetscMPIInt,&offsets);CHKERRQ(ierr);
+  ierr = PetscMemzero(sendCounts, numProcs * sizeof(PetscMPIInt));CHKERRQ(ierr);
+  ierr = PetscMalloc(((pEnd-pStart)*6+1) * sizeof(PetscInt), &sendBuf);CHKERRQ(ierr);
+  for (d = 1, numShared = 0; d < depth; ++d) {
+    PetscInt sStart, sEnd;
+
+    ierr = DMPlexGetDepthStratum(dm, d, &sStart, &sEnd);CHKERRQ(ierr);
+    for (p = sStart; p < sEnd; ++p) {
+      PetscInt key[4] = {-1, -1, -1, -1};
+      PetscInt closureSize, n = 0, owner, c;
+
+      if (PetscBTLookup(leafPoints, p-pStart)) continue;
+      ierr = DMPlexGetTransitiveClosure(dm, p, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+      for (c = 0; c < closureSize*2; c += 2) {
+        const PetscInt q = closure[c];
+
+        if ((q < vStart) || (q >= vEnd)) continue;
+        if (!sharedVertex[q-pStart]) break;
+        if (n >= 4) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Do not support shared points with more than 4 vertices, point %D", p);
+        key[n++] = gv[q-vStart] < 0 ? -(gv[q-vStart]+1) : gv[q-vStart];
+      }
+      if (c < closureSize*2) continue;
+      ierr = PetscSortInt(n, key);CHKERRQ(ierr);
+      ierr = PetscLayoutFindOwner(layout, key[0], &owner);CHKERRQ(ierr);
+      for (c = 0; c < 4; ++c) sendBuf[numShared*6+c] = key[c];
+      sendBuf[numShared*6+4] = owner; /* Destination, replaced by the rank when packing */
+      sendBuf[numShared*6+5] = p;
+      ++sendCounts[owner];
+      ++numShared;
+    }
+  }
+  if (closure) {ierr = DMPlexRestoreTransitiveClosure(dm, 0, PETSC_TRUE, NULL, &closure);CHKERRQ(ierr);}
+  ierr = ISRestoreIndices(globalVertexNumbers, &gv);CHKERRQ(ierr);
+  ierr = ISDestroy(&globalVertexNumbers);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  ierr = PetscFree(sharedVertex);CHKERRQ(ierr);
+  ierr = PetscBTDestroy(&leafPoints);CHKERRQ(ierr);
+  sendOffsets[0] = 0;
+  for (r = 0; r < numProcs; ++r) {
+    sendOffsets[r+1] = sendOffsets[r] + sendCounts[r]*6;
+    offsets[r]       = sendOffsets[r];
+    sendCounts[r]   *= 6;
+  }
+  ierr = PetscMalloc((numShared*6+1) * sizeof(PetscInt), &recvBuf);CHKERRQ(ierr);
+  for (l = 0; l < numShared; ++l) {
+    const PetscInt owner = sendBuf[l*6+4];
+    PetscInt       c;
+
+    for (c = 0; c < 6; ++c) recvBuf[offsets[owner]+c] = sendBuf[l*6+c];
+    recvBuf[offsets[owner]+4] = rank;
+    offsets[owner] += 6;
+  }
+  ierr = PetscFree(sendBuf);CHKERRQ(ierr);
+  sendBuf = recvBuf;
+  ierr = MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, comm);CHKERRQ(ierr);
+  recvOffsets[0] = 0;
+  for (r = 0; r < numProcs; ++r) recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
+  numRecv = recvOffsets[numProcs]/6;
+  ierr = PetscMalloc((numRecv*6+1) * sizeof(PetscInt), &recvBuf);CHKERRQ(ierr);
+  ierr = MPI_Alltoallv(sendBuf, sendCounts, sendOffsets, MPIU_INT, recvBuf, recvCounts, recvOffsets, MPIU_INT, comm);CHKERRQ(ierr);
+  ierr = PetscFree(sendBuf);CHKERRQ(ierr);
+  /* Records arrive ordered by rank, so the first copy of a key belongs to the lowest rank and becomes the owner */
+  ierr = PetscHashIJKLCreate(&pointTable);CHKERRQ(ierr);
+  ierr = PetscHashIJKLSetMultivalued(pointTable, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = PetscMemzero(sendCounts, numProcs * sizeof(PetscMPIInt));CHKERRQ(ierr);
+  ierr = PetscMalloc((numRecv*4+1) * sizeof(PetscInt), &replyBuf);CHKERRQ(ierr);
+  for (l = 0, numReplies = 0; l < numRecv; ++l) {
+    PetscHashIJKLKey key;
+    PetscInt         first;
+
+    key.i = recvBuf[l*6+0];key.j = recvBuf[l*6+1];key.k = recvBuf[l*6+2];key.l = recvBuf[l*6+3];
+    ierr  = PetscHashIJKLGet(pointTable, key, &first);CHKERRQ(ierr);
+    if (first < 0) {
+      ierr = PetscHashIJKLAdd(pointTable, key, l);CHKERRQ(ierr);
+      continue;
+    }
+    /* Reply (destination, leaf point, owner rank, owner point), the destination is dropped when packing */
+    replyBuf[numReplies*4+0] = recvBuf[l*6+4];
+    replyBuf[numReplies*4+1] = recvBuf[l*6+5];
+    replyBuf[numReplies*4+2] = recvBuf[first*6+4];
+    replyBuf[numReplies*4+3] = recvBuf[first*6+5];
+    ++sendCounts[recvBuf[l*6+4]];
+    ++numReplies;
+  }
+  ierr = PetscHashIJKLDestroy(&pointTable);CHKERRQ(ierr);
+  sendOffsets[0] = 0;
+  for (r = 0; r < numProcs; ++r) {
+    sendOffsets[r+1] = sendOffsets[r] + sendCounts[r]*3;
+    offsets[r]       = sendOffsets[r];
+    sendCounts[r]   *= 3;
+  }
+  ierr = PetscMalloc((numReplies*3+1) * sizeof(PetscInt), &sendBuf);CHKERRQ(ierr);
+  for (l = 0; l < numReplies; ++l) {
+    const PetscInt dest = replyBuf[l*4+0];
+    PetscInt       c;
+
+    for (c = 0; c < 3; ++c) sendBuf[offsets[dest]+c] = replyBuf[l*4+1+c];
+    offsets[dest] += 3;
+  }
+  ierr = PetscFree(replyBuf);CHKERRQ(ierr);
+  ierr = PetscFree(recvBuf);CHKERRQ(ierr);
+  ierr = MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, comm);CHKERRQ(ierr);
+  recvOffsets[0] = 0;
+  for (r = 0; r < numProcs; ++r) recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
+  numNew = recvOffsets[numProcs]/3;
+  ierr = PetscMalloc((numNew*3+1) * sizeof(PetscInt), &replyRecvBuf);CHKERRQ(ierr);
+  ierr = MPI_Alltoallv(sendBuf, sendCounts, sendOffsets, MPIU_INT, replyRecvBuf, recvCounts, recvOffsets, MPIU_INT, comm);CHKERRQ(ierr);
+  ierr = PetscFree(sendBuf);CHKERRQ(ierr);
+  ierr = PetscFree5(sendCounts,sendOffsets,recvCounts,recvOffsets,offsets);CHKERRQ(ierr);
+  /* Append the new leaves to the existing ones */
+  ierr = PetscMalloc((nleaves+numNew) * sizeof(PetscInt), &localPoints);CHKERRQ(ierr);
+  ierr = PetscMalloc((nleaves+numNew) * sizeof(PetscSFNode), &remotePoints);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    localPoints[l]        = leaves ? leaves[l] : l;
+    remotePoints[l].rank  = remotes[l].rank;
+    remotePoints[l].index = remotes[l].index;
+  }
+  for (l = 0; l < numNew; ++l) {
+    localPoints[nleaves+l]        = replyRecvBuf[l*3+0];
+    remotePoints[nleaves+l].rank  = replyRecvBuf[l*3+1];
+    remotePoints[nleaves+l].index = replyRecvBuf[l*3+2];
+  }
+  ierr = PetscFree(replyRecvBuf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPoint, pEnd-pStart, nleaves+numNew, localPoints, PETSC_OWN_POINTER, remotePoints, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexInterpolateSF_Private"
+/* Points of dm keep their numbers in idm, so the shared points carry over and the new shared points are added */
+static PetscErrorCode DMPlexInterpolateSF_Private(DM dm, DM idm)
+{
+  PetscSF            sfPoint, sfPointInt;
+  const PetscInt    *leaves;
+  const PetscSFNode *remotes;
+  PetscSFNode       *remotePoints;
+  PetscInt          *localPoints, nroots, nleaves, pEnd, l;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+  if (nroots < 0) PetscFunctionReturn(0);
+  ierr = DMPlexGetChart(idm, NULL, &pEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc(nleaves * sizeof(PetscInt), &localPoints);CHKERRQ(ierr);
+  ierr = PetscMalloc(nleaves * sizeof(PetscSFNode), &remotePoints);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    localPoints[l]        = leaves ? leaves[l] : l;
+    remotePoints[l].rank  = remotes[l].rank;
+    remotePoints[l].index = remotes[l].index;
+  }
+  ierr = DMGetPointSF(idm, &sfPointInt);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPointInt, PetscMax(pEnd, 0), nleaves, localPoints, PETSC_OWN_POINTER, remotePoints, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = DMPlexInterpolatePointSF_Internal(idm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexInterpolate"
 /*@
@@ -278,10 +534,13 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
   Output Parameter:
 . dmB - The complete DMPlex object
 
+  Note: If the mesh is already interpolated, it is returned with an extra reference. A mesh interpolated
+  only to some height by DMPlexInterpolateHeight() receives the missing strata.
+
   Level: intermediate
 
 .keywords: mesh
-.seealso: DMPlexCreateFromCellList()
+.seealso: DMPlexCreateFromCellList(), DMPlexInterpolateHeight()
 @*/
 PetscErrorCode DMPlexInterpolate(DM dm, DM *dmInt)
 {
@@ -292,11 +551,13 @@ PetscErrorCode DMPlexInterpolate(DM dm, DM *dmInt)
   PetscFunctionBegin;
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   ierr = DMPlexGetDimension(dm, &dim);CHKERRQ(ierr);
-  if (dim <= 1) {
-    ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
-    idm  = dm;
+  if ((dim <= 1) || (depth >= dim)) {
+    ierr   = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+    *dmInt = dm;
+    PetscFunctionReturn(0);
   }
-  for (d = 1; d < dim; ++d) {
+  /* A partially interpolated mesh only needs the missing strata */
+  for (d = PetscMax(depth, 1); d < dim; ++d) {
     /* Create interpolated mesh */
     ierr = DMCreate(PetscObjectComm((PetscObject)dm), &idm);CHKERRQ(ierr);
     ierr = DMSetType(idm, DMPLEX);CHKERRQ(ierr);
@@ -305,10 +566,181 @@ PetscErrorCode DMPlexInterpolate(DM dm, DM *dmInt)
     if (odm != dm) {ierr = DMDestroy(&odm);CHKERRQ(ierr);}
     odm  = idm;
   }
+  ierr   = DMPlexInterpolateSF_Private(dm, idm);CHKERRQ(ierr);
   *dmInt = idm;
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexReplaceTopology_Private"
+/* Move the topology, depth label and point SF of idm into dm, leaving the old ones in idm to be destroyed */
+static PetscErrorCode DMPlexReplaceTopology_Private(DM dm, DM idm)
+{
+  DM_Plex           *mesh  = (DM_Plex*) dm->data;
+  DM_Plex           *imesh = (DM_Plex*) idm->data;
+  DM_Plex            tmp;
+  DMLabel            depthLabel;
+  PetscSF            sfPoint, sfPointInt;
+  const PetscInt    *leaves;
+  const PetscSFNode *remotes;
+  PetscSFNode       *remotePoints;
+  PetscInt          *localPoints, nroots, nleaves, l;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  tmp.coneSection      = mesh->coneSection;      mesh->coneSection      = imesh->coneSection;      imesh->coneSection      = tmp.coneSection;
+  tmp.cones            = mesh->cones;            mesh->cones            = imesh->cones;            imesh->cones            = tmp.cones;
+  tmp.coneOrientations = mesh->coneOrientations; mesh->coneOrientations = imesh->coneOrientations; imesh->coneOrientations = tmp.coneOrientations;
+  tmp.supportSection   = mesh->supportSection;   mesh->supportSection   = imesh->supportSection;   imesh->supportSection   = tmp.supportSection;
+  tmp.supports         = mesh->supports;         mesh->supports         = imesh->supports;         imesh->supports         = tmp.supports;
+  mesh->maxConeSize    = imesh->maxConeSize;
+  mesh->maxSupportSize = imesh->maxSupportSize;
+  tmp.coneBlock        = mesh->coneBlock;        mesh->coneBlock        = imesh->coneBlock;        imesh->coneBlock        = tmp.coneBlock;
+  tmp.numConeBlocks    = mesh->numConeBlocks;    mesh->numConeBlocks    = imesh->numConeBlocks;    imesh->numConeBlocks    = tmp.numConeBlocks;
+  ierr = PetscMemcpy(mesh->coneBlockStart, imesh->coneBlockStart, (DMPLEX_MAX_CONE_BLOCKS+1) * sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMemcpy(mesh->coneBlockSize, imesh->coneBlockSize, DMPLEX_MAX_CONE_BLOCKS * sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMemcpy(mesh->coneBlockOffset, imesh->coneBlockOffset, DMPLEX_MAX_CONE_BLOCKS * sizeof(PetscInt));CHKERRQ(ierr);
+  /* The other labels stay valid since old points keep their numbers */
+  ierr = DMPlexRemoveLabel(dm, "depth", &depthLabel);CHKERRQ(ierr);
+  ierr = DMLabelDestroy(&depthLabel);CHKERRQ(ierr);
+  ierr = DMPlexRemoveLabel(idm, "depth", &depthLabel);CHKERRQ(ierr);
+  ierr = DMPlexAddLabel(dm, depthLabel);CHKERRQ(ierr);
+  mesh->depthLabel  = depthLabel;
+  imesh->depthLabel = NULL;
+  /* Overwrite the graph rather than the SF, which is shared with clones such as the coordinate DM */
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = DMGetPointSF(idm, &sfPointInt);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPointInt, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+  if (nroots >= 0) {
+    ierr = PetscMalloc(nleaves * sizeof(PetscInt), &localPoints);CHKERRQ(ierr);
+    ierr = PetscMalloc(nleaves * sizeof(PetscSFNode), &remotePoints);CHKERRQ(ierr);
+    for (l = 0; l < nleaves; ++l) {
+      localPoints[l]        = leaves ? leaves[l] : l;
+      remotePoints[l].rank  = remotes[l].rank;
+      remotePoints[l].index = remotes[l].index;
+    }
+    ierr = PetscSFSetGraph(sfPoint, nroots, nleaves, localPoints, PETSC_OWN_POINTER, remotePoints, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexInterpolateHeight"
+/*@
+  DMPlexInterpolateHeight - Create, in place, the faces, edges, etc. of a mesh down to the given height
+
+  Collective on DM
+
+  Input Parameters:
++ dm     - The DMPlex object
+- height - The lowest height of points to create, 1 for faces only, and dim-1 for all intermediate points
+
+  Notes:
+  Existing points keep their numbers, and the new points are numbered after them, so labels, coordinates and the
+  point SF remain valid. The DM shares its new topology with its clones, such as the coordinate DM. Sections
+  created before this call do not cover the new points. Strata which already exist are not rebuilt.
+
+  This is used by DMPlexCreateSection() when lazy interpolation has been turned on with
+  DMPlexSetInterpolationLazy(), so that cell-vertex discretizations never pay for faces and edges.
+
+  Level: intermediate
+
+.keywords: mesh
+.seealso: DMPlexInterpolate(), DMPlexSetInterpolationLazy(), DMPlexCreateSection()
+@*/
+PetscErrorCode DMPlexInterpolateHeight(DM dm, PetscInt height)
+{
+  DM             idm;
+  PetscInt       locDepth, depth, dim;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexGetDimension(dm, &dim);CHKERRQ(ierr);
+  if ((height < 0) || (height >= PetscMax(dim, 1))) SETERRQ2(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_OUTOFRANGE, "Height %D must be in [0, %D)", height, PetscMax(dim, 1));
+  /* Processes without cells must take part in the same number of passes */
+  ierr = DMPlexGetDepth(dm, &locDepth);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&locDepth, &depth, 1, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  /* A mesh of depth d has cells and d-1 lower strata, besides the vertices */
+  for (depth = PetscMax(depth, 1); depth <= height; ++depth, ++locDepth) {
+    if (locDepth <= 0) {
+      /* Nothing to interpolate, but the point SF is matched collectively */
+      ierr = DMPlexInterpolatePointSF_Internal(dm);CHKERRQ(ierr);
+      continue;
+    }
+    ierr = DMCreate(PetscObjectComm((PetscObject) dm), &idm);CHKERRQ(ierr);
+    ierr = DMSetType(idm, DMPLEX);CHKERRQ(ierr);
+    ierr = DMPlexSetDimension(idm, dim);CHKERRQ(ierr);
+    ierr = DMPlexInterpolateFaces_Internal(dm, 1, idm);CHKERRQ(ierr);
+    ierr = DMPlexInterpolateSF_Private(dm, idm);CHKERRQ(ierr);
+    ierr = DMPlexReplaceTopology_Private(dm, idm);CHKERRQ(ierr);
+    ierr = DMDestroy(&idm);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexSetInterpolationLazy"
+/*@
+  DMPlexSetInterpolationLazy - Create faces and edges only when a section places unknowns on them
+
+  Logically Collective on DM
+
+  Input Parameters:
++ dm   - The DMPlex object
+- lazy - PETSC_TRUE to interpolate on demand in DMPlexCreateSection()
+
+  Options Database:
+. -dm_plex_interpolate_lazy - Turn on lazy interpolation
+
+  Note: The mesh should be created without interpolation. DMPlexCreateSection() then calls DMPlexInterpolateHeight()
+  for the lowest dimension carrying unknowns, so a P1 discretization keeps only cells and vertices, and a scheme
+  with unknowns on faces creates faces but not edges.
+
+  Level: intermediate
+
+.keywords: mesh
+.seealso: DMPlexGetInterpolationLazy(), DMPlexInterpolateHeight(), DMPlexCreateSection()
+@*/
+PetscErrorCode DMPlexSetInterpolationLazy(DM dm, PetscBool lazy)
+{
+  DM_Plex *mesh = (DM_Plex*) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  mesh->interpolateLazy = lazy;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetInterpolationLazy"
+/*@
+  DMPlexGetInterpolationLazy - Check whether faces and edges are created only when a section places unknowns on them
+
+  Not Collective
+
+  Input Parameter:
+. dm   - The DMPlex object
+
+  Output Parameter:
+. lazy - PETSC_TRUE if DMPlexCreateSection() interpolates on demand
+
+  Level: intermediate
+
+.keywords: mesh
+.seealso: DMPlexSetInterpolationLazy(), DMPlexInterpolateHeight()
+@*/
+PetscErrorCode DMPlexGetInterpolationLazy(DM dm, PetscBool *lazy)
+{
+  DM_Plex *mesh = (DM_Plex*) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(lazy, 2);
+  *lazy = mesh->interpolateLazy;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexCopyCoordinates"
 /*@
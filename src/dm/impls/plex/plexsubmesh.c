@@ -1859,8 +1859,7 @@ static PetscErrorCode DMPlexInsertFace_Internal(DM dm, DM subdm, PetscInt numFac
     for (f = firstFace; f < *newFacePoint; ++f) {
       PetscInt dof, off, d;
 
-      ierr = PetscSectionGetDof(submesh->coneSection, f, &dof);CHKERRQ(ierr);
-      ierr = PetscSectionGetOffset(submesh->coneSection, f, &off);CHKERRQ(ierr);
+      ierr = DMPlexGetConeOffset_Private(submesh, f, &dof, &off);CHKERRQ(ierr);
       /* Yes, I know this is quadratic, but I expect the sizes to be <5 */
       for (d = 0; d < dof; ++d) {
         const PetscInt p = submesh->cones[off+d];
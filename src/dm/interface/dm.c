@@ -2774,6 +2774,8 @@ PetscErrorCode  DMRegister(const char sname[],PetscErrorCode (*function)(DM))
 
   Notes:
    The type is determined by the data in the file, any type set into the DM before this call is ignored.
+   An HDF5 file always produces a DMPLEX. Each process reads a contiguous piece of the mesh, so the result
+   should be partitioned with DMPlexDistribute().
 
   Notes for advanced users:
   Most users should not need to know the details of the binary storage
@@ -2789,7 +2791,7 @@ PetscErrorCode  DMRegister(const char sname[],PetscErrorCode (*function)(DM))
 PetscErrorCode  DMLoad(DM newdm, PetscViewer viewer)
 {
   PetscErrorCode ierr;
-  PetscBool      isbinary;
+  PetscBool      isbinary, ishdf5;
   PetscInt       classid;
   char           type[256];
 
@@ -2797,7 +2799,14 @@ PetscErrorCode  DMLoad(DM newdm, PetscViewer viewer)
   PetscValidHeaderSpecific(newdm,DM_CLASSID,1);
   PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary);CHKERRQ(ierr);
-  if (!isbinary) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Invalid viewer; open viewer with PetscViewerBinaryOpen()");
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERHDF5,&ishdf5);CHKERRQ(ierr);
+  if (ishdf5) {
+    /* HDF5 files only hold unstructured meshes */
+    ierr = DMSetType(newdm, DMPLEX);CHKERRQ(ierr);
+    ierr = (*newdm->ops->load)(newdm,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (!isbinary) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Invalid viewer; open viewer with PetscViewerBinaryOpen() or PetscViewerHDF5Open()");
 
   ierr = PetscViewerBinaryRead(viewer,&classid,1,PETSC_INT);CHKERRQ(ierr);
   if (classid != DM_FILE_CLASSID) SETERRQ(PetscObjectComm((PetscObject)newdm),PETSC_ERR_ARG_WRONG,"Not DM next in file");
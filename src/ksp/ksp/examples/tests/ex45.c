@@ -0,0 +1,111 @@
+
+static char help[] = "Solves a linear system whose nodes have different numbers of unknowns with PCVPBJACOBI or ILU(0)\n\
+on an AIJ matrix with variable block sizes.\n\
+  -n <n>         : number of nodes per process\n\
+  -no_vblocks    : do not call MatSetVariableBlockSizes()\n\
+  -decoupled     : no coupling between nodes, so PCVPBJACOBI is a direct solver\n\
+  -view_inodes   : print the inode sizes of the first nodes (one process only)\n\n";
+
+#include <petscksp.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **args)
+{
+  KSP            ksp;
+  Mat            A;
+  Vec            x,b,u;
+  PetscErrorCode ierr;
+  PetscInt       n = 20,i,j,k,l,nrows = 0,rstart,*bsizes,*nstart,nsize[4] = {1,3,4,6},ncols,cols[18],node_count,*sizes,limit;
+  PetscScalar    v[18];
+  PetscReal      norm;
+  PetscBool      novblocks = PETSC_FALSE,viewinodes = PETSC_FALSE,decoupled = PETSC_FALSE;
+  PetscMPIInt    rank,size;
+
+  PetscInitialize(&argc,&args,(char*)0,help);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-no_vblocks",&novblocks,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-view_inodes",&viewinodes,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-decoupled",&decoupled,NULL);CHKERRQ(ierr);
+
+  /* a chain of nodes with 1, 3, 4 and 6 unknowns, each node is coupled to its neighbors, including across processes */
+  ierr = PetscMalloc2(n,PetscInt,&bsizes,n+2,PetscInt,&nstart);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    bsizes[i] = nsize[(rank*n + i) % 4];
+    nrows    += bsizes[i];
+  }
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,nrows,nrows,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,18,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,18,NULL,6,NULL);CHKERRQ(ierr);
+  if (!novblocks) {ierr = MatSetVariableBlockSizes(A,n,bsizes);CHKERRQ(ierr);}
+  ierr = MatGetOwnershipRange(A,&rstart,NULL);CHKERRQ(ierr);
+
+  /* nstart[k] is the first row of node k-1, so that nstart[0] and nstart[n+1] are the neighbors on other processes */
+  nstart[1] = rstart;
+  for (i=0; i<n; i++) nstart[i+2] = nstart[i+1] + bsizes[i];
+  nstart[0] = rstart - nsize[(rank*n + 3) % 4];
+  for (i=0; i<n; i++) {
+    for (j=0; j<bsizes[i]; j++) {
+      PetscInt row = nstart[i+1] + j,nb[3],nbs[3];
+
+      nb[0] = nstart[i];   nbs[0] = nsize[(rank*n + i + 3) % 4];
+      nb[1] = nstart[i+1]; nbs[1] = bsizes[i];
+      nb[2] = nstart[i+2]; nbs[2] = nsize[(rank*n + i + 1) % 4];
+      ncols = 0;
+      for (k=0; k<3; k++) {
+        if (k == 0 && !rank && !i) continue;
+        if (k == 2 && rank == size-1 && i == n-1) continue;
+        if (k != 1 && decoupled) continue;
+        for (l=0; l<nbs[k]; l++) {
+          cols[ncols] = nb[k] + l;
+          if (k == 1) v[ncols] = (l == j) ? 2.0*bsizes[i] + 2.0 : 1.0/(1.0 + PetscAbsInt(l - j));
+          else        v[ncols] = -0.5/(1.0 + l);
+          ncols++;
+        }
+      }
+      ierr = MatSetValues(A,1,&row,ncols,cols,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  if (viewinodes && size == 1) {
+    ierr = MatInodeGetInodeSizes(A,&node_count,&sizes,&limit);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Inode sizes:");CHKERRQ(ierr);
+    for (i=0; i<PetscMin(node_count,10); i++) {ierr = PetscPrintf(PETSC_COMM_SELF," %D",sizes[i]);CHKERRQ(ierr);}
+    ierr = PetscPrintf(PETSC_COMM_SELF,"\n");CHKERRQ(ierr);
+  }
+
+  ierr = MatGetVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u);CHKERRQ(ierr);
+  ierr = VecSet(u,1.0);CHKERRQ(ierr);
+  ierr = MatMult(A,u,b);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,1.e-10,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+
+  ierr = VecAXPY(x,-1.0,u);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&norm);CHKERRQ(ierr);
+  if (norm > 1.e-8) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Norm of error %G\n",norm);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Norm of error < 1.e-8\n");CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree2(bsizes,nstart);CHKERRQ(ierr);
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -14,6 +14,9 @@ with boundary conditions
 
    Can also be run with -pc_type exotic -ksp_type fgmres
 
+   With -dm_mat_type shell the operators on all levels are applied matrix-free from the stencil and so is
+   the interpolation between the levels; the smoothers and the coarse solver then can only use the diagonal
+
 */
 
 static char help[] = "Solves 3D Laplacian using multigrid.\n\n";
@@ -24,6 +27,8 @@ static char help[] = "Solves 3D Laplacian using multigrid.\n\n";
 extern PetscErrorCode ComputeMatrix(KSP,Mat,Mat,MatStructure*,void*);
 extern PetscErrorCode ComputeRHS(KSP,Vec,void*);
 extern PetscErrorCode ComputeInitialGuess(KSP,Vec,void*);
+extern PetscErrorCode MatMult_Laplacian(Mat,Vec,Vec);
+extern PetscErrorCode MatGetDiagonal_Laplacian(Mat,Vec);
 
 #undef __FUNCT__
 #define __FUNCT__ "main"
@@ -118,8 +123,17 @@ PetscErrorCode ComputeMatrix(KSP ksp,Mat jac,Mat B,MatStructure *stflg,void *ctx
   PetscInt       i,j,k,mx,my,mz,xm,ym,zm,xs,ys,zs;
   PetscScalar    v[7],Hx,Hy,Hz,HxHydHz,HyHzdHx,HxHzdHy;
   MatStencil     row,col[7];
+  PetscBool      shell;
 
   PetscFunctionBeginUser;
+  ierr = PetscObjectTypeCompare((PetscObject)B,MATSHELL,&shell);CHKERRQ(ierr);
+  if (shell) {
+    /* matrix-free: the stencil is applied from the DMDA of the matrix */
+    ierr   = MatShellSetOperation(B,MATOP_MULT,(void (*)(void))MatMult_Laplacian);CHKERRQ(ierr);
+    ierr   = MatShellSetOperation(B,MATOP_GET_DIAGONAL,(void (*)(void))MatGetDiagonal_Laplacian);CHKERRQ(ierr);
+    *stflg = SAME_NONZERO_PATTERN;
+    PetscFunctionReturn(0);
+  }
   ierr    = KSPGetDM(ksp,&da);CHKERRQ(ierr);
   ierr    = DMDAGetInfo(da,0,&mx,&my,&mz,0,0,0,0,0,0,0,0,0);CHKERRQ(ierr);
   Hx      = 1.0 / (PetscReal)(mx-1); Hy = 1.0 / (PetscReal)(my-1); Hz = 1.0 / (PetscReal)(mz-1);
@@ -151,3 +165,61 @@ PetscErrorCode ComputeMatrix(KSP ksp,Mat jac,Mat B,MatStructure *stflg,void *ctx
   *stflg = SAME_NONZERO_PATTERN;
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMult_Laplacian"
+PetscErrorCode MatMult_Laplacian(Mat A,Vec x,Vec y)
+{
+  DM             da;
+  Vec            xlocal;
+  PetscErrorCode ierr;
+  PetscInt       i,j,k,mx,my,mz,xm,ym,zm,xs,ys,zs;
+  PetscScalar    Hx,Hy,Hz,HxHydHz,HyHzdHx,HxHzdHy,***xa,***ya;
+
+  PetscFunctionBeginUser;
+  ierr    = MatGetDM(A,&da);CHKERRQ(ierr);
+  ierr    = DMDAGetInfo(da,0,&mx,&my,&mz,0,0,0,0,0,0,0,0,0);CHKERRQ(ierr);
+  Hx      = 1.0 / (PetscReal)(mx-1); Hy = 1.0 / (PetscReal)(my-1); Hz = 1.0 / (PetscReal)(mz-1);
+  HxHydHz = Hx*Hy/Hz; HxHzdHy = Hx*Hz/Hy; HyHzdHx = Hy*Hz/Hx;
+  ierr    = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+  ierr    = DMGetLocalVector(da,&xlocal);CHKERRQ(ierr);
+  ierr    = DMGlobalToLocalBegin(da,x,INSERT_VALUES,xlocal);CHKERRQ(ierr);
+  ierr    = DMGlobalToLocalEnd(da,x,INSERT_VALUES,xlocal);CHKERRQ(ierr);
+  ierr    = DMDAVecGetArray(da,xlocal,&xa);CHKERRQ(ierr);
+  ierr    = DMDAVecGetArray(da,y,&ya);CHKERRQ(ierr);
+  for (k=zs; k<zs+zm; k++) {
+    for (j=ys; j<ys+ym; j++) {
+      for (i=xs; i<xs+xm; i++) {
+        if (i==0 || j==0 || k==0 || i==mx-1 || j==my-1 || k==mz-1) {
+          ya[k][j][i] = 2.0*(HxHydHz + HxHzdHy + HyHzdHx)*xa[k][j][i];
+        } else {
+          ya[k][j][i] = 2.0*(HxHydHz + HxHzdHy + HyHzdHx)*xa[k][j][i]
+                        - HxHydHz*(xa[k-1][j][i] + xa[k+1][j][i])
+                        - HxHzdHy*(xa[k][j-1][i] + xa[k][j+1][i])
+                        - HyHzdHx*(xa[k][j][i-1] + xa[k][j][i+1]);
+        }
+      }
+    }
+  }
+  ierr = DMDAVecRestoreArray(da,y,&ya);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(da,xlocal,&xa);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(da,&xlocal);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetDiagonal_Laplacian"
+PetscErrorCode MatGetDiagonal_Laplacian(Mat A,Vec d)
+{
+  DM             da;
+  PetscErrorCode ierr;
+  PetscInt       mx,my,mz;
+  PetscScalar    Hx,Hy,Hz;
+
+  PetscFunctionBeginUser;
+  ierr = MatGetDM(A,&da);CHKERRQ(ierr);
+  ierr = DMDAGetInfo(da,0,&mx,&my,&mz,0,0,0,0,0,0,0,0,0);CHKERRQ(ierr);
+  Hx   = 1.0 / (PetscReal)(mx-1); Hy = 1.0 / (PetscReal)(my-1); Hz = 1.0 / (PetscReal)(mz-1);
+  ierr = VecSet(d,2.0*(Hx*Hy/Hz + Hx*Hz/Hy + Hy*Hz/Hx));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -134,10 +134,149 @@ static PetscErrorCode KSPChebyshevEstEigSetRandom_Chebyshev(KSP ksp,PetscRandom
 #define __FUNCT__ "KSPChebyshevSetNewMatrix_Chebyshev"
 static PetscErrorCode  KSPChebyshevSetNewMatrix_Chebyshev(KSP ksp)
 {
-  KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp->data;
+  KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode   ierr;
+  Mat              Amat,Pmat;
+  PetscObjectId    amatid,pmatid;
+  PetscObjectState amatstate,pmatstate;
 
   PetscFunctionBegin;
-  cheb->estimate_current = PETSC_FALSE;
+  if (!cheb->estimate_current) PetscFunctionReturn(0);
+  /* the operators are often set again without being changed, for example between time steps; keep the estimate then */
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat,NULL);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
+  if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) cheb->estimate_current = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* the diagonals of PCJACOBI: diagonal entry, row maximum or row sum, each possibly with absolute values */
+#define KSP_CHEBYSHEV_EST_EIG_KEYS 6
+static PetscInt KSPChebyshevEstEigMinId[KSP_CHEBYSHEV_EST_EIG_KEYS] = {-1,-1,-1,-1,-1,-1};
+static PetscInt KSPChebyshevEstEigMaxId[KSP_CHEBYSHEV_EST_EIG_KEYS] = {-1,-1,-1,-1,-1,-1};
+
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevEstEigCacheKey"
+/*@
+   KSPChebyshevEstEigCacheKey - Gets the key under which eigenvalue estimates of the operator preconditioned
+   with a given preconditioner are stored by KSPChebyshevEstEigCacheSet()
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner, or NULL for point Jacobi with the diagonal entries of the matrix
+
+   Output Parameter:
+.  key - the key, or -1 if the estimates for this preconditioner are not cached
+
+   Notes:
+   Only estimates of D^{-1} A are cached, the key tells apart the diagonals D that PCJACOBI can use, see
+   PCJacobiSetUseRowMax(), PCJacobiSetUseRowSum() and PCJacobiSetUseAbs().
+
+   Level: developer
+
+.seealso: KSPChebyshevEstEigCacheSet(), KSPChebyshevEstEigCacheGet()
+@*/
+PetscErrorCode KSPChebyshevEstEigCacheKey(PC pc,PetscInt *key)
+{
+  PetscErrorCode ierr;
+  PetscBool      jacobi,rowmax,rowsum,useabs;
+
+  PetscFunctionBegin;
+  PetscValidPointer(key,2);
+  *key = 0;
+  if (!pc) PetscFunctionReturn(0);
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)pc,PCJACOBI,&jacobi);CHKERRQ(ierr);
+  if (!jacobi) {
+    *key = -1;
+    PetscFunctionReturn(0);
+  }
+  ierr = PCJacobiGetUseRowMax(pc,&rowmax);CHKERRQ(ierr);
+  ierr = PCJacobiGetUseRowSum(pc,&rowsum);CHKERRQ(ierr);
+  ierr = PCJacobiGetUseAbs(pc,&useabs);CHKERRQ(ierr);
+  *key = (rowmax ? 1 : (rowsum ? 2 : 0)) + (useabs ? 3 : 0);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevEstEigCacheSet"
+/*@
+   KSPChebyshevEstEigCacheSet - Stores estimates of the extreme eigenvalues of the Jacobi preconditioned
+   operator D^{-1} A with the matrix, so other solvers using the same matrix can share them
+
+   Not Collective
+
+   Input Parameters:
++  A - the matrix
+.  key - the key of the diagonal D from KSPChebyshevEstEigCacheKey(), nothing is stored if it is -1
+.  emin - estimate of the smallest eigenvalue of D^{-1} A
+-  emax - estimate of the largest eigenvalue of D^{-1} A
+
+   Notes:
+   The estimates are kept as composed data of the matrix, so they are discarded as soon as the matrix is changed.
+   KSPCHEBYSHEV with PCJACOBI uses them in place of its own eigenvalue estimation. Only eigenvalue estimates
+   may be stored, not the extreme singular values that some estimates, such as the one of PCGAMG, compute.
+
+   Level: developer
+
+.seealso: KSPChebyshevEstEigCacheGet(), KSPChebyshevEstEigCacheKey(), KSPChebyshevSetEstimateEigenvalues()
+@*/
+PetscErrorCode KSPChebyshevEstEigCacheSet(Mat A,PetscInt key,PetscReal emin,PetscReal emax)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  if (key < 0) PetscFunctionReturn(0);
+  if (key >= KSP_CHEBYSHEV_EST_EIG_KEYS) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Invalid key %D",key);
+  if (KSPChebyshevEstEigMaxId[key] == -1) {
+    ierr = PetscObjectComposedDataRegister(&KSPChebyshevEstEigMinId[key]);CHKERRQ(ierr);
+    ierr = PetscObjectComposedDataRegister(&KSPChebyshevEstEigMaxId[key]);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectComposedDataSetReal((PetscObject)A,KSPChebyshevEstEigMinId[key],emin);CHKERRQ(ierr);
+  ierr = PetscObjectComposedDataSetReal((PetscObject)A,KSPChebyshevEstEigMaxId[key],emax);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevEstEigCacheGet"
+/*@
+   KSPChebyshevEstEigCacheGet - Gets estimates of the extreme eigenvalues of the Jacobi preconditioned
+   operator D^{-1} A stored with KSPChebyshevEstEigCacheSet()
+
+   Not Collective
+
+   Input Parameters:
++  A - the matrix
+-  key - the key of the diagonal D from KSPChebyshevEstEigCacheKey()
+
+   Output Parameters:
++  emin - estimate of the smallest eigenvalue of D^{-1} A
+.  emax - estimate of the largest eigenvalue of D^{-1} A
+-  flg - PETSC_TRUE if estimates for the current values of the matrix and this diagonal are available
+
+   Level: developer
+
+.seealso: KSPChebyshevEstEigCacheSet(), KSPChebyshevEstEigCacheKey()
+@*/
+PetscErrorCode KSPChebyshevEstEigCacheGet(Mat A,PetscInt key,PetscReal *emin,PetscReal *emax,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+  PetscBool      flgmin;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidPointer(flg,5);
+  *flg = PETSC_FALSE;
+  if (key < 0) PetscFunctionReturn(0);
+  if (key >= KSP_CHEBYSHEV_EST_EIG_KEYS) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Invalid key %D",key);
+  if (KSPChebyshevEstEigMaxId[key] == -1) PetscFunctionReturn(0);
+  ierr = PetscObjectComposedDataGetReal((PetscObject)A,KSPChebyshevEstEigMinId[key],*emin,flgmin);CHKERRQ(ierr);
+  ierr = PetscObjectComposedDataGetReal((PetscObject)A,KSPChebyshevEstEigMaxId[key],*emax,*flg);CHKERRQ(ierr);
+  *flg = (PetscBool)(*flg && flgmin);
   PetscFunctionReturn(0);
 }
 
@@ -393,32 +532,46 @@ PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
   if (cheb->kspest && !cheb->estimate_current) {
     PetscReal max,min;
     Vec       X,B;
-    
-    if (hybrid && purification) {
-      X = ksp->vec_sol;
-    } else {
-      X = ksp->work[0];
+    PetscBool cached = PETSC_FALSE;
+    PetscInt  key    = -1;
+
+    ierr = PCGetOperators(ksp->pc,&Amat,&Pmat,NULL);CHKERRQ(ierr);
+    if (!hybrid && Amat == Pmat) {
+      /* estimates of D^{-1} A may have been computed by another solver for these matrix values */
+      ierr = KSPChebyshevEstEigCacheKey(ksp->pc,&key);CHKERRQ(ierr);
+      ierr = KSPChebyshevEstEigCacheGet(Amat,key,&min,&max,&cached);CHKERRQ(ierr);
     }
+    if (!cached) {
+      if (hybrid && purification) {
+        X = ksp->vec_sol;
+      } else {
+        X = ksp->work[0];
+      }
 
-    if (cheb->random) {
-      B    = ksp->work[1];
-      ierr = VecSetRandom(B,cheb->random);CHKERRQ(ierr);
-    } else {
-      B = ksp->vec_rhs;
-    }
-    ierr = KSPSolve(cheb->kspest,B,X);CHKERRQ(ierr);
-    if (hybrid) {
-      cheb->its = 0; /* initialize Chebyshev iteration associated to kspest */
-      ierr      = KSPSetInitialGuessNonzero(cheb->kspest,PETSC_TRUE);CHKERRQ(ierr); 
-    } else if (ksp->guess_zero) {
-      ierr = VecZeroEntries(X);CHKERRQ(ierr);
+      if (cheb->random) {
+        B    = ksp->work[1];
+        ierr = VecSetRandom(B,cheb->random);CHKERRQ(ierr);
+      } else {
+        B = ksp->vec_rhs;
+      }
+      ierr = KSPSolve(cheb->kspest,B,X);CHKERRQ(ierr);
+      if (hybrid) {
+        cheb->its = 0; /* initialize Chebyshev iteration associated to kspest */
+        ierr      = KSPSetInitialGuessNonzero(cheb->kspest,PETSC_TRUE);CHKERRQ(ierr); 
+      } else if (ksp->guess_zero) {
+        ierr = VecZeroEntries(X);CHKERRQ(ierr);
+      }
+      ierr = KSPChebyshevComputeExtremeEigenvalues_Private(cheb->kspest,&min,&max);CHKERRQ(ierr);
+      ierr = KSPChebyshevEstEigCacheSet(Amat,key,min,max);CHKERRQ(ierr);
     }
-    ierr = KSPChebyshevComputeExtremeEigenvalues_Private(cheb->kspest,&min,&max);CHKERRQ(ierr);
-
     cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
     cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
 
     cheb->estimate_current = PETSC_TRUE;
+    ierr = PetscObjectGetId((PetscObject)Amat,&cheb->amatid);CHKERRQ(ierr);
+    ierr = PetscObjectGetId((PetscObject)Pmat,&cheb->pmatid);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject)Amat,&cheb->amatstate);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject)Pmat,&cheb->pmatstate);CHKERRQ(ierr);
   }
 
   ksp->its = 0;
@@ -632,6 +785,9 @@ PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           Chebyshev is configured as a smoother by default, targetting the "upper" part of the spectrum.
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
+          Eigenvalue estimates are only recomputed when the operators have changed. With PCJACOBI the estimates
+          are shared with other solvers of the same matrix, see KSPChebyshevEstEigCacheSet().
+
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
            KSPChebyshevSetEigenvalues(), KSPChebyshevSetEstimateEigenvalues(), KSPRICHARDSON, KSPCG, PCMG
 
@@ -11,6 +11,8 @@ typedef struct {
   PC        pcnone;       /* Dummy PC to drop in so PCSetFromOptions doesn't get called extra times */
   PetscReal tform[4];     /* transform from Krylov estimates to Chebyshev bounds */
   PetscBool estimate_current;
+  PetscObjectId    amatid,pmatid;       /* operators the current estimate was computed for */
+  PetscObjectState amatstate,pmatstate;
   PetscBool hybrid;       /* flag for using Hybrid Chebyshev */
   PetscInt  chebysteps;   /* number of Chebyshev steps in Hybrid Chebyshev */
   PetscInt  eststeps;     /* number of adaptive/est steps in Hybrid Chebyshev */
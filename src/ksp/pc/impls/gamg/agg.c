@@ -11,6 +11,7 @@ typedef struct {
   PetscInt  nsmooths;
   PetscBool sym_graph;
   PetscBool square_graph;
+  char      coarsen_type[256]; /* MatCoarsenType, empty for the MatCoarsen default */
 } PC_GAMG_AGG;
 
 #undef __FUNCT__
@@ -139,6 +140,55 @@ PetscErrorCode PCGAMGSetSquareGraph_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetCoarsenType"
+/*@C
+   PCGAMGSetCoarsenType - Set the MatCoarsen method used to form the aggregates
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  type - the MatCoarsenType, MATCOARSENMIS (default), MATCOARSENHEM, MATCOARSENMIS2 or MATCOARSENPAIRWISE
+
+   Options Database Key:
+.  -pc_gamg_coarsen_type <mis,hem,mis2,pairwise>
+
+   Notes:
+   MATCOARSENMIS2 and MATCOARSENPAIRWISE make aggregates of distance 2 directly, so the graph is never
+   squared with them (-pc_gamg_square_graph is ignored).
+
+   Level: intermediate
+
+   Concepts: Aggregation AMG preconditioner
+
+.seealso: PCGAMGSetSquareGraph(), MatCoarsenSetType()
+@*/
+PetscErrorCode PCGAMGSetCoarsenType(PC pc, MatCoarsenType type)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  ierr = PetscTryMethod(pc,"PCGAMGSetCoarsenType_C",(PC,MatCoarsenType),(pc,type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetCoarsenType_GAMG"
+PetscErrorCode PCGAMGSetCoarsenType_GAMG(PC pc, MatCoarsenType type)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg          = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg     = (PC_GAMG*)mg->innerctx;
+  PC_GAMG_AGG    *pc_gamg_agg = (PC_GAMG_AGG*)pc_gamg->subctx;
+
+  PetscFunctionBegin;
+  ierr = PetscStrncpy(pc_gamg_agg->coarsen_type,type,sizeof(pc_gamg_agg->coarsen_type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCSetFromOptions_GAMG_AGG
@@ -189,6 +239,16 @@ PetscErrorCode PCSetFromOptions_GAMG_AGG(PC pc)
                             pc_gamg_agg->square_graph,
                             &pc_gamg_agg->square_graph,
                             &flag);CHKERRQ(ierr);
+
+    /* -pc_gamg_coarsen_type */
+    ierr = PetscOptionsList("-pc_gamg_coarsen_type",
+                            "Method to form the aggregates",
+                            "PCGAMGSetCoarsenType",
+                            MatCoarsenList,
+                            pc_gamg_agg->coarsen_type[0] ? pc_gamg_agg->coarsen_type : MATCOARSENMIS,
+                            pc_gamg_agg->coarsen_type,
+                            sizeof(pc_gamg_agg->coarsen_type),
+                            &flag);CHKERRQ(ierr);
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -967,7 +1027,7 @@ PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **agg_lis
   IS             perm;
   PetscInt       Ii,nloc,bs,n,m;
   PetscInt       *permute;
-  PetscBool      *bIndexSet;
+  PetscBool      *bIndexSet,dist2;
   MatCoarsen     crs;
   MPI_Comm       comm;
   PetscMPIInt    rank,size;
@@ -984,7 +1044,15 @@ PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **agg_lis
   if (bs != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"bs %D must be 1",bs);
   nloc = n/bs;
 
-  if (pc_gamg_agg->square_graph) {
+  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
+  if (pc_gamg_agg->coarsen_type[0]) {
+    ierr = MatCoarsenSetType(crs, pc_gamg_agg->coarsen_type);CHKERRQ(ierr);
+  }
+  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
+  /* distance 2 aggregation without the squared graph */
+  ierr = PetscObjectTypeCompareAny((PetscObject)crs,&dist2,MATCOARSENMIS2,MATCOARSENPAIRWISE,"");CHKERRQ(ierr);
+
+  if (pc_gamg_agg->square_graph && !dist2) {
     if (verbose > 1) PetscPrintf(comm,"[%d]%s square graph\n",rank,__FUNCT__);
     /* ierr = MatMatTransposeMult(Gmat1, Gmat1, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Gmat2); */
     ierr = MatTransposeMatMult(Gmat1, Gmat1, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Gmat2);CHKERRQ(ierr);
@@ -1023,9 +1091,6 @@ PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **agg_lis
 #if defined PETSC_GAMG_USE_LOG
   ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET4],0,0,0,0);CHKERRQ(ierr);
 #endif
-  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
-  /* ierr = MatCoarsenSetType(crs, MATCOARSENMIS);CHKERRQ(ierr); */
-  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
   ierr = MatCoarsenSetGreedyOrdering(crs, perm);CHKERRQ(ierr);
   ierr = MatCoarsenSetAdjacency(crs, Gmat2);CHKERRQ(ierr);
   ierr = MatCoarsenSetVerbose(crs, pc_gamg->verbose);CHKERRQ(ierr);
@@ -1246,6 +1311,7 @@ PetscErrorCode PCGAMGOptprol_AGG(PC pc,const Mat Amat,Mat *a_P)
 #endif
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  if (pc_gamg->reuse_prol && pc_gamg->resmooth_prol && pc_gamg_agg->nsmooths > 1) SETERRQ1(comm,PETSC_ERR_SUP,"Resmoothing reused prolongators supports one smoothing step, not %D",pc_gamg_agg->nsmooths);
 
   /* smooth P0 */
   for (jj = 0; jj < pc_gamg_agg->nsmooths; jj++) {
@@ -1256,70 +1322,20 @@ PetscErrorCode PCGAMGOptprol_AGG(PC pc,const Mat Amat,Mat *a_P)
     ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET9],0,0,0,0);CHKERRQ(ierr);
 #endif
     if (jj == 0) {
-      KSP eksp;
-      Vec bb, xx;
-      PC  epc;
-      ierr = MatGetVecs(Amat, &bb, 0);CHKERRQ(ierr);
-      ierr = MatGetVecs(Amat, &xx, 0);CHKERRQ(ierr);
-      {
-        PetscRandom rctx;
-        ierr = PetscRandomCreate(comm,&rctx);CHKERRQ(ierr);
-        ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
-        ierr = VecSetRandom(bb,rctx);CHKERRQ(ierr);
-        ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
-      }
-
-      /* zeroing out BC rows -- needed for crazy matrices */
-      {
-        PetscInt    Istart,Iend,ncols,jj,Ii;
-        PetscScalar zero = 0.0;
-        ierr = MatGetOwnershipRange(Amat, &Istart, &Iend);CHKERRQ(ierr);
-        for (Ii = Istart, jj = 0; Ii < Iend; Ii++, jj++) {
-          ierr = MatGetRow(Amat,Ii,&ncols,0,0);CHKERRQ(ierr);
-          if (ncols <= 1) {
-            ierr = VecSetValues(bb, 1, &Ii, &zero, INSERT_VALUES);CHKERRQ(ierr);
-          }
-          ierr = MatRestoreRow(Amat,Ii,&ncols,0,0);CHKERRQ(ierr);
-        }
-        ierr = VecAssemblyBegin(bb);CHKERRQ(ierr);
-        ierr = VecAssemblyEnd(bb);CHKERRQ(ierr);
-      }
-
-      ierr = KSPCreate(comm,&eksp);CHKERRQ(ierr);
-      ierr = KSPSetTolerances(eksp,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT,10);CHKERRQ(ierr);
-      ierr = KSPSetNormType(eksp, KSP_NORM_NONE);CHKERRQ(ierr);
-      ierr = KSPSetOptionsPrefix(eksp,((PetscObject)pc)->prefix);CHKERRQ(ierr);
-      ierr = KSPAppendOptionsPrefix(eksp, "gamg_est_");CHKERRQ(ierr);
-      ierr = KSPSetFromOptions(eksp);CHKERRQ(ierr);
-
-      ierr = KSPSetInitialGuessNonzero(eksp, PETSC_FALSE);CHKERRQ(ierr);
-      ierr = KSPSetOperators(eksp, Amat, Amat, SAME_NONZERO_PATTERN);CHKERRQ(ierr);
-      ierr = KSPSetComputeSingularValues(eksp,PETSC_TRUE);CHKERRQ(ierr);
-
-      ierr = KSPGetPC(eksp, &epc);CHKERRQ(ierr);
-      ierr = PCSetType(epc, PCJACOBI);CHKERRQ(ierr);  /* smoother in smoothed agg. */
-
-      /* solve - keep stuff out of logging */
-      ierr = PetscLogEventDeactivate(KSP_Solve);CHKERRQ(ierr);
-      ierr = PetscLogEventDeactivate(PC_Apply);CHKERRQ(ierr);
-      ierr = KSPSolve(eksp, bb, xx);CHKERRQ(ierr);
-      ierr = PetscLogEventActivate(KSP_Solve);CHKERRQ(ierr);
-      ierr = PetscLogEventActivate(PC_Apply);CHKERRQ(ierr);
-
-      ierr = KSPComputeExtremeSingularValues(eksp, &emax, &emin);CHKERRQ(ierr);
+      ierr = PCGAMGEstimateEigenvalues(pc, Amat, NULL, &emax, &emin);CHKERRQ(ierr);
       if (verbose > 0) {
         PetscPrintf(comm,"\t\t\t%s smooth P0: max eigen=%e min=%e PC=%s\n",
                     __FUNCT__,emax,emin,PCJACOBI);
       }
-      ierr = VecDestroy(&xx);CHKERRQ(ierr);
-      ierr = VecDestroy(&bb);CHKERRQ(ierr);
-      ierr = KSPDestroy(&eksp);CHKERRQ(ierr);
 
       if (pc_gamg->emax_id == -1) {
         ierr = PetscObjectComposedDataRegister(&pc_gamg->emax_id);CHKERRQ(ierr);
         if (pc_gamg->emax_id == -1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"pc_gamg->emax_id == -1");
       }
-      ierr = PetscObjectComposedDataSetScalar((PetscObject)Amat, pc_gamg->emax_id, emax);CHKERRQ(ierr);
+      /* singular values of D^{-1}A, not eigenvalues, so kept out of KSPChebyshevEstEigCacheSet() */
+      ierr = PetscObjectComposedDataSetReal((PetscObject)Amat, pc_gamg->emax_id, emax);CHKERRQ(ierr);
+      /* the tentative prolongator is never changed, so keep the estimate with it for PCGAMGOptprolReuse_AGG() */
+      ierr = PetscObjectComposedDataSetReal((PetscObject)Prol, pc_gamg->emax_id, emax);CHKERRQ(ierr);
     }
 
     /* smooth P1 := (I - omega/lam D^{-1}A)P0 */
@@ -1344,6 +1360,53 @@ PetscErrorCode PCGAMGOptprol_AGG(PC pc,const Mat Amat,Mat *a_P)
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+/*
+   PCGAMGOptprolReuse_AGG - recompute the values of a prolongator made by
+     PCGAMGOptprol_AGG() for new values of Amat, with its old nonzero pattern
+     and eigenvalue estimate
+
+  Input Parameter:
+   . pc - this
+   . Amat - matrix on this fine level, same nonzero pattern as when Prol was made
+   . Ptent - tentative prolongator that was smoothed into Prol
+ In/Output Parameter:
+   . Prol - smoothed prolongator, the product of MatMatMult() in PCGAMGOptprol_AGG()
+*/
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGOptprolReuse_AGG"
+PetscErrorCode PCGAMGOptprolReuse_AGG(PC pc,const Mat Amat,const Mat Ptent,Mat Prol)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg          = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg     = (PC_GAMG*)mg->innerctx;
+  PC_GAMG_AGG    *pc_gamg_agg = (PC_GAMG_AGG*)pc_gamg->subctx;
+  Vec            diag;
+  PetscReal      emax;
+  PetscBool      flag;
+
+  PetscFunctionBegin;
+  if (!pc_gamg_agg->nsmooths) PetscFunctionReturn(0);
+#if defined PETSC_USE_LOG
+  ierr = PetscLogEventBegin(PC_GAMGOptprol_AGG,0,0,0,0);CHKERRQ(ierr);
+#endif
+  ierr = PetscObjectComposedDataGetReal((PetscObject)Ptent, pc_gamg->emax_id, emax, flag);CHKERRQ(ierr);
+  if (!flag) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_PLIB,"Eigenvalue estimate of the prolongator smoother not found");
+
+  /* smooth P1 := (I - omega/lam D^{-1}A)P0, in the product matrix of the first setup */
+  ierr = MatMatMult(Amat, Ptent, MAT_REUSE_MATRIX, PETSC_DEFAULT, &Prol);CHKERRQ(ierr);
+  ierr = MatGetVecs(Amat, &diag, 0);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(Amat, diag);CHKERRQ(ierr);
+  ierr = VecReciprocal(diag);CHKERRQ(ierr);
+  ierr = MatDiagonalScale(Prol, diag, 0);CHKERRQ(ierr);
+  ierr = VecDestroy(&diag);CHKERRQ(ierr);
+  ierr = MatAYPX(Prol, -1.4/emax, Ptent, SUBSET_NONZERO_PATTERN);CHKERRQ(ierr);
+#if defined PETSC_USE_LOG
+  ierr = PetscLogEventEnd(PC_GAMGOptprol_AGG,0,0,0,0);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCCreateGAMG_AGG
@@ -1370,13 +1433,15 @@ PetscErrorCode  PCCreateGAMG_AGG(PC pc)
   /* reset does not do anything; setup not virtual */
 
   /* set internal function pointers */
-  pc_gamg->ops->graph       = PCGAMGgraph_AGG;
-  pc_gamg->ops->coarsen     = PCGAMGCoarsen_AGG;
-  pc_gamg->ops->prolongator = PCGAMGProlongator_AGG;
-  pc_gamg->ops->optprol     = PCGAMGOptprol_AGG;
+  pc_gamg->ops->graph        = PCGAMGgraph_AGG;
+  pc_gamg->ops->coarsen      = PCGAMGCoarsen_AGG;
+  pc_gamg->ops->prolongator  = PCGAMGProlongator_AGG;
+  pc_gamg->ops->optprol      = PCGAMGOptprol_AGG;
+  pc_gamg->ops->optprolreuse = PCGAMGOptprolReuse_AGG;
 
   pc_gamg->ops->createdefaultdata = PCSetData_AGG;
 
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSetCoordinates_C",PCSetCoordinates_AGG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarsenType_C",PCGAMGSetCoarsenType_GAMG);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
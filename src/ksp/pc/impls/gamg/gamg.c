@@ -20,8 +20,6 @@ PetscLogEvent PC_GAMGProlongator_GEO;
 PetscLogEvent PC_GAMGOptprol_AGG;
 #endif
 
-#define GAMG_MAXLEVELS 30
-
 /* #define GAMG_STAGES */
 #if (defined PETSC_GAMG_USE_LOG && defined GAMG_STAGES)
 static PetscLogStage gamg_stages[GAMG_MAXLEVELS];
@@ -31,6 +29,25 @@ static PetscFunctionList GAMGList = 0;
 static PetscBool PCGAMGPackageInitialized;
 
 /* ----------------------------------------------------------------------------- */
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGResetReuse_Private"
+static PetscErrorCode PCGAMGResetReuse_Private(PC_GAMG *pc_gamg)
+{
+  PetscErrorCode ierr;
+  PetscInt       level;
+
+  PetscFunctionBegin;
+  for (level=0; level<GAMG_MAXLEVELS; level++) {
+    pc_gamg->has_ptap[level] = PETSC_FALSE;
+    ierr = MatDestroy(&pc_gamg->Ptent[level]);CHKERRQ(ierr);
+    ierr = MatDestroy(&pc_gamg->Psmooth[level]);CHKERRQ(ierr);
+    ierr = ISDestroy(&pc_gamg->Pcols[level]);CHKERRQ(ierr);
+    ierr = MatDestroy(&pc_gamg->Afull[level]);CHKERRQ(ierr);
+    ierr = MatDestroy(&pc_gamg->Pfull[level]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PCReset_GAMG"
 PetscErrorCode PCReset_GAMG(PC pc)
@@ -49,6 +66,7 @@ PetscErrorCode PCReset_GAMG(PC pc)
   if (pc_gamg->orig_data) {
     ierr = PetscFree(pc_gamg->orig_data);CHKERRQ(ierr);
   }
+  ierr = PCGAMGResetReuse_Private(pc_gamg);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -68,12 +86,13 @@ PetscErrorCode PCReset_GAMG(PC pc)
    . a_nactive_proc - number of active procs
    Output Parameter:
    . a_Amat_crs - coarse matrix that is created (k-1)
+   . a_eq_indices - (optional) new coarse equations of this process when repartitioned, otherwise NULL
 */
 
 #undef __FUNCT__
 #define __FUNCT__ "createLevel"
 static PetscErrorCode createLevel(const PC pc,const Mat Amat_fine,const PetscInt cr_bs,const PetscBool isLast,
-                                  Mat *a_P_inout,Mat *a_Amat_crs,PetscMPIInt *a_nactive_proc)
+                                  Mat *a_P_inout,Mat *a_Amat_crs,PetscMPIInt *a_nactive_proc,IS *a_eq_indices)
 {
   PetscErrorCode  ierr;
   PC_MG           *mg         = (PC_MG*)pc->data;
@@ -86,6 +105,7 @@ static PetscErrorCode createLevel(const PC pc,const Mat Amat_fine,const PetscInt
   PetscInt        ncrs_eq,ncrs_prim,f_bs;
 
   PetscFunctionBegin;
+  if (a_eq_indices) *a_eq_indices = NULL;
   ierr = PetscObjectGetComm((PetscObject)Amat_fine,&comm);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
@@ -103,9 +123,9 @@ static PetscErrorCode createLevel(const PC pc,const Mat Amat_fine,const PetscInt
     PetscInt ncrs_eq_glob;
     ierr     = MatGetSize(Cmat, &ncrs_eq_glob, NULL);CHKERRQ(ierr);
     new_size = (PetscMPIInt)((float)ncrs_eq_glob/(float)min_eq_proc + 0.5); /* hardwire min. number of eq/proc */
-    if (new_size == 0 || ncrs_eq_glob < coarse_max) new_size = 1;
+    if (new_size == 0 || (ncrs_eq_glob < coarse_max && !pc_gamg->coarse_redundant)) new_size = 1;
     else if (new_size >= nactive) new_size = nactive; /* no change, rare */
-    if (isLast) new_size = 1;
+    if (isLast && !pc_gamg->coarse_redundant) new_size = 1; /* a redundant coarse solve gathers the grid itself */
   }
 
   if (!repart && new_size==nactive) *a_Amat_crs = Cmat; /* output - no repartitioning or reduction - could bail here */
@@ -419,7 +439,10 @@ static PetscErrorCode createLevel(const PC pc,const Mat Amat_fine,const PetscInt
       /* output - repartitioned */
       *a_P_inout = Pnew;
     }
-    ierr = ISDestroy(&new_eq_indices);CHKERRQ(ierr);
+    if (a_eq_indices) *a_eq_indices = new_eq_indices;
+    else {
+      ierr = ISDestroy(&new_eq_indices);CHKERRQ(ierr);
+    }
 
     *a_nactive_proc = new_size; /* output */
   }
@@ -443,6 +466,110 @@ static PetscErrorCode createLevel(const PC pc,const Mat Amat_fine,const PetscInt
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+/*
+   createSubcomms: move the coarse levels that live on fewer processes than the next
+     finer level onto a communicator of these processes. The other processes are grouped
+     on a second communicator on which the level is empty, so PCMG skips it for them.
+
+   Input Parameter:
+   . pc - the preconditioner context
+   . Nlevels - number of levels
+   In/Output Parameter:
+   . Aarr - operators (0 is finest), moved to the level communicators
+   . Parr - prolongators (Parr[k] into level k-1), moved to the communicator of level k-1
+   Output Parameter:
+   . comms - communicators of the levels in the PCMG numbering (0 is coarsest)
+*/
+#undef __FUNCT__
+#define __FUNCT__ "createSubcomms"
+static PetscErrorCode createSubcomms(PC pc,PetscInt Nlevels,Mat Aarr[],Mat Parr[],MPI_Comm comms[])
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  MPI_Comm       comm,lcomm[GAMG_MAXLEVELS];
+  PetscSubcomm   psubcomm[GAMG_MAXLEVELS];
+  PetscMPIInt    rank,flags[2*GAMG_MAXLEVELS],counts[2*GAMG_MAXLEVELS];
+  PetscInt       level,nloc;
+  PetscBool      active = PETSC_TRUE;
+  Mat            B;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+
+  /* a process is active on a coarse level if it owns rows of it, all processes are active on the finest level;
+     the active processes of each level must be active on the finer levels */
+  flags[0] = 1;
+  flags[1] = 0;
+  for (level=1; level<Nlevels; level++) {
+    ierr = MatGetLocalSize(Aarr[level],&nloc,NULL);CHKERRQ(ierr);
+    flags[2*level]   = (PetscMPIInt)(nloc > 0);
+    flags[2*level+1] = (PetscMPIInt)(nloc > 0 && !active);
+    active           = (PetscBool)(nloc > 0);
+  }
+  ierr = MPI_Allreduce(flags,counts,2*Nlevels,MPI_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  for (level=1; level<Nlevels; level++) {
+    if (counts[2*level+1]) {
+      ierr = PetscInfo1(pc,"Level %D is not owned by a subset of the processes of the finer level, not using subcommunicators\n",level);CHKERRQ(ierr);
+      for (level=0; level<Nlevels; level++) comms[level] = comm;
+      PetscFunctionReturn(0);
+    }
+  }
+
+  /* the processes active on the finer level split its communicator, the others stay on theirs (where the level is empty) */
+  lcomm[0] = comm;
+  for (level=1; level<Nlevels; level++) {
+    psubcomm[level] = NULL;
+    lcomm[level]    = lcomm[level-1];
+    if (counts[2*level] < counts[2*(level-1)]) {
+      if (flags[2*(level-1)]) {
+        PetscMPIInt color = flags[2*level] ? 0 : 1,subrank,ranks[2],sendbuf[2];
+
+        /* rank among the processes of the same color, keeps the order of the rows */
+        sendbuf[0] = (PetscMPIInt)!color;
+        sendbuf[1] = color;
+        ierr       = MPI_Scan(sendbuf,ranks,2,MPI_INT,MPI_SUM,lcomm[level-1]);CHKERRQ(ierr);
+        subrank    = ranks[color] - 1;
+
+        ierr = PetscSubcommCreate(lcomm[level-1],&psubcomm[level]);CHKERRQ(ierr);
+        ierr = PetscSubcommSetNumber(psubcomm[level],2);CHKERRQ(ierr);
+        ierr = PetscSubcommSetTypeGeneral(psubcomm[level],color,subrank);CHKERRQ(ierr);
+        lcomm[level] = psubcomm[level]->comm;
+      }
+      if (pc_gamg->verbose) {
+        ierr = PetscPrintf(comm,"\t[%d]%s level %d on a subcommunicator of %d processes\n",rank,__FUNCT__,(int)level,counts[2*level]);CHKERRQ(ierr);
+      }
+    }
+  }
+
+  for (level=1; level<Nlevels; level++) {
+    if (lcomm[level] != comm) {
+      ierr = MatGetMultiProcBlock(Aarr[level],lcomm[level],MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+      if (pc_gamg->reuse_prol) pc_gamg->Afull[level] = Aarr[level];
+      else {
+        ierr = MatDestroy(&Aarr[level]);CHKERRQ(ierr);
+      }
+      Aarr[level] = B;
+    }
+    if (lcomm[level-1] != comm) {
+      ierr = MatGetMultiProcBlock(Parr[level],lcomm[level-1],MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+      if (pc_gamg->reuse_prol) pc_gamg->Pfull[level] = Parr[level];
+      else {
+        ierr = MatDestroy(&Parr[level]);CHKERRQ(ierr);
+      }
+      Parr[level] = B;
+    }
+  }
+  for (level=0; level<Nlevels; level++) comms[Nlevels-1-level] = lcomm[level];
+  /* the matrices created on the communicators keep them alive */
+  for (level=1; level<Nlevels; level++) {
+    ierr = PetscSubcommDestroy(&psubcomm[level]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCSetUp_GAMG - Prepares for the use of the GAMG preconditioner
@@ -474,6 +601,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   PetscLogDouble nnz0=0.,nnztot=0.;
   MatInfo        info;
   PetscBool      redo_mesh_setup = (PetscBool)(!pc_gamg->reuse_prol);
+  PetscBool      keep_prol       = (PetscBool)(pc_gamg->reuse_prol && pc_gamg->resmooth_prol && pc_gamg->ops->optprol && pc_gamg->ops->optprolreuse);
 
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
@@ -486,10 +614,11 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     if (redo_mesh_setup) {
       /* reset everything */
       ierr = PCReset_MG(pc);CHKERRQ(ierr);
+      ierr = PCGAMGResetReuse_Private(pc_gamg);CHKERRQ(ierr);
       pc->setupcalled = 0;
     } else {
       PC_MG_Levels **mglevels = mg->levels;
-      /* just do Galerkin grids */
+      /* just do Galerkin grids, and optionally new values of the smoothed prolongators, with the old nonzero patterns */
       Mat          B,dA,dB;
 
      if (!pc->setupcalled) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PCSetUp() has not been called yet");
@@ -500,18 +629,63 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
         ierr = KSPSetOperators(mglevels[pc_gamg->Nlevels-1]->smoothd,dA,dB,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
 
         for (level=pc_gamg->Nlevels-2; level>=0; level--) {
-          /* the first time through the matrix structure has changed from repartitioning */
-          if (pc_gamg->setup_count==2) {
-            ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_INITIAL_MATRIX,1.0,&B);CHKERRQ(ierr);
-            ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr);
+          const PetscInt pidx = pc_gamg->Nlevels-1-level; /* prolongator to this level, in setup numbering */
+          Mat            P    = pc_gamg->Pfull[pidx] ? pc_gamg->Pfull[pidx] : mglevels[level+1]->interpolate;
 
-            mglevels[level]->A = B;
+          if (pc_gamg->Ptent[pidx]) {
+            if (pc_gamg->verbose) {
+              ierr = PetscPrintf(comm,"\t[%d]%s smooth the reused prolongator of level %d again\n",rank,__FUNCT__,(int)pidx);CHKERRQ(ierr);
+            }
+            ierr = pc_gamg->ops->optprolreuse(pc,dB,pc_gamg->Ptent[pidx],pc_gamg->Psmooth[pidx]);CHKERRQ(ierr);
+            if (pc_gamg->Pcols[pidx]) { /* move the columns as was done by the repartitioning */
+              IS       findices;
+              PetscInt Istart,Iend,f_bs;
+
+              ierr = MatGetBlockSize(dB,&f_bs);CHKERRQ(ierr);
+              ierr = MatGetOwnershipRange(pc_gamg->Psmooth[pidx],&Istart,&Iend);CHKERRQ(ierr);
+              ierr = ISCreateStride(comm,Iend-Istart,Istart,1,&findices);CHKERRQ(ierr);
+              ierr = ISSetBlockSize(findices,f_bs);CHKERRQ(ierr);
+              ierr = MatGetSubMatrix(pc_gamg->Psmooth[pidx],findices,pc_gamg->Pcols[pidx],MAT_REUSE_MATRIX,&P);CHKERRQ(ierr);
+              ierr = ISDestroy(&findices);CHKERRQ(ierr);
+            }
+            if (pc_gamg->Pfull[pidx]) {
+              Mat Psub = mglevels[level+1]->interpolate;
+              ierr = MatGetMultiProcBlock(P,PetscObjectComm((PetscObject)Psub),MAT_REUSE_MATRIX,&Psub);CHKERRQ(ierr);
+            }
+          }
+          if (!pc_gamg->has_ptap[pidx]) {
+            /* the coarse operator of a repartitioned level was not created by MatPtAP(), so do it once here */
+            ierr = MatPtAP(dB,P,MAT_INITIAL_MATRIX,1.0,&B);CHKERRQ(ierr);
+            if (pc_gamg->Afull[pidx]) {
+              ierr = MatDestroy(&pc_gamg->Afull[pidx]);CHKERRQ(ierr);
+              pc_gamg->Afull[pidx] = B;
+            } else {
+              ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr);
+              mglevels[level]->A = B;
+            }
+          } else if (pc_gamg->Afull[pidx]) {
+            B    = pc_gamg->Afull[pidx];
+            ierr = MatPtAP(dB,P,MAT_REUSE_MATRIX,1.0,&B);CHKERRQ(ierr);
           } else {
             ierr = KSPGetOperators(mglevels[level]->smoothd,NULL,&B,NULL);CHKERRQ(ierr);
-            ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_REUSE_MATRIX,1.0,&B);CHKERRQ(ierr);
+            ierr = MatPtAP(dB,P,MAT_REUSE_MATRIX,1.0,&B);CHKERRQ(ierr);
+          }
+          if (pc_gamg->Afull[pidx]) { /* update the copy of the operator on the level's subcommunicator */
+            Mat Bsub;
+            ierr = KSPGetOperators(mglevels[level]->smoothd,NULL,&Bsub,NULL);CHKERRQ(ierr);
+            if (!pc_gamg->has_ptap[pidx]) {
+              ierr = MatGetMultiProcBlock(B,PetscObjectComm((PetscObject)Bsub),MAT_INITIAL_MATRIX,&Bsub);CHKERRQ(ierr);
+              ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr);
+              mglevels[level]->A = Bsub;
+            } else {
+              ierr = MatGetMultiProcBlock(B,PetscObjectComm((PetscObject)Bsub),MAT_REUSE_MATRIX,&Bsub);CHKERRQ(ierr);
+            }
+            ierr = KSPSetOperators(mglevels[level]->smoothd,Bsub,Bsub,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+          } else {
+            ierr = KSPSetOperators(mglevels[level]->smoothd,B,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
           }
-          ierr = KSPSetOperators(mglevels[level]->smoothd,B,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
-          dB   = B;
+          pc_gamg->has_ptap[pidx] = PETSC_TRUE;
+          dB = B;
         }
       }
 
@@ -593,6 +767,10 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
         ierr = MatGetBlockSizes(Prol11, NULL, &bs);CHKERRQ(ierr);
 
         if (pc_gamg->ops->optprol) {
+          if (keep_prol) { /* keep the tentative prolongator to smooth it again in later setups */
+            ierr = PetscObjectReference((PetscObject)Prol11);CHKERRQ(ierr);
+            pc_gamg->Ptent[level1] = Prol11;
+          }
           /* smooth */
           ierr = pc_gamg->ops->optprol(pc, Aarr[level], &Prol11);CHKERRQ(ierr);
         }
@@ -610,7 +788,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
 #if defined PETSC_GAMG_USE_LOG
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET1],0,0,0,0);CHKERRQ(ierr);
 #endif
-    /* cache eigen estimate */
+    /* cache eigen estimate, Aarr[level] may be replaced before the smoothers are set up */
     if (pc_gamg->emax_id != -1) {
       PetscBool flag;
       ierr = PetscObjectComposedDataGetReal((PetscObject)Aarr[level], pc_gamg->emax_id, emaxs[level], flag);CHKERRQ(ierr);
@@ -627,8 +805,21 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET2],0,0,0,0);CHKERRQ(ierr);
 #endif
 
-    ierr = createLevel(pc, Aarr[level], bs, (PetscBool)(level==pc_gamg->Nlevels-2),
-                       &Parr[level1], &Aarr[level1], &nactivepe);CHKERRQ(ierr);
+    if (keep_prol) {
+      ierr = PetscObjectReference((PetscObject)Parr[level1]);CHKERRQ(ierr);
+      pc_gamg->Psmooth[level1] = Parr[level1];
+    }
+    {
+      IS eq_indices;
+      ierr = createLevel(pc, Aarr[level], bs, (PetscBool)(level==pc_gamg->Nlevels-2),
+                         &Parr[level1], &Aarr[level1], &nactivepe, &eq_indices);CHKERRQ(ierr);
+      /* the coarse operator is the product from MatPtAP() unless it was repartitioned */
+      pc_gamg->has_ptap[level1] = (PetscBool)!eq_indices;
+      if (keep_prol) pc_gamg->Pcols[level1] = eq_indices;
+      else {
+        ierr = ISDestroy(&eq_indices);CHKERRQ(ierr);
+      }
+    }
 
 #if defined PETSC_GAMG_USE_LOG
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET2],0,0,0,0);CHKERRQ(ierr);
@@ -668,7 +859,13 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   if (pc_gamg->verbose) PetscPrintf(comm,"\t[%d]%s %d levels, grid complexity = %g\n",0,__FUNCT__,level+1,nnztot/nnz0);
   pc_gamg->Nlevels = level + 1;
   fine_level       = level;
-  ierr             = PCMGSetLevels(pc,pc_gamg->Nlevels,NULL);CHKERRQ(ierr);
+  if (pc_gamg->use_subcomm && size > 1 && pc_gamg->Nlevels > 1) {
+    MPI_Comm comms[GAMG_MAXLEVELS];
+    ierr = createSubcomms(pc,pc_gamg->Nlevels,Aarr,Parr,comms);CHKERRQ(ierr);
+    ierr = PCMGSetLevels(pc,pc_gamg->Nlevels,comms);CHKERRQ(ierr);
+  } else {
+    ierr = PCMGSetLevels(pc,pc_gamg->Nlevels,NULL);CHKERRQ(ierr);
+  }
 
   /* simple setup */
   if (!PETSC_TRUE) {
@@ -737,24 +934,30 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     }
     {
       /* coarse grid */
-      KSP smoother,*k2; PC subpc,pc2; PetscInt ii,first;
+      KSP smoother,*k2; PC subpc,pc2; PetscInt ii,first; PetscMPIInt csize;
       Mat Lmat = Aarr[(level=pc_gamg->Nlevels-1)]; lidx = 0;
       ierr = PCMGGetSmoother(pc, lidx, &smoother);CHKERRQ(ierr);
       ierr = KSPSetOperators(smoother, Lmat, Lmat, SAME_NONZERO_PATTERN);CHKERRQ(ierr);
       ierr = KSPSetNormType(smoother, KSP_NORM_NONE);CHKERRQ(ierr);
       ierr = KSPGetPC(smoother, &subpc);CHKERRQ(ierr);
-      ierr = PCSetType(subpc, PCBJACOBI);CHKERRQ(ierr);
-      ierr = PCSetUp(subpc);CHKERRQ(ierr);
-      ierr = PCBJacobiGetSubKSP(subpc,&ii,&first,&k2);CHKERRQ(ierr);
-      if (ii != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"ii %D is not one",ii);
-      ierr = KSPGetPC(k2[0],&pc2);CHKERRQ(ierr);
-      ierr = PCSetType(pc2, PCLU);CHKERRQ(ierr);
-      ierr = PCFactorSetShiftType(pc2,MAT_SHIFT_INBLOCKS);CHKERRQ(ierr);
-      ierr = KSPSetTolerances(k2[0],PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT,1);CHKERRQ(ierr);
-      /* This flag gets reset by PCBJacobiGetSubKSP(), but our BJacobi really does the same algorithm everywhere (and in
-       * fact, all but one process will have zero dofs), so we reset the flag to avoid having PCView_BJacobi attempt to
-       * view every subdomain as though they were different. */
-      ((PC_BJacobi*)subpc->data)->same_local_solves = PETSC_TRUE;
+      ierr = MPI_Comm_size(PetscObjectComm((PetscObject)Lmat),&csize);CHKERRQ(ierr);
+      if (pc_gamg->coarse_redundant && csize > 1) {
+        /* every process of the coarse grid factors (LU) and solves the whole coarse problem */
+        ierr = PCSetType(subpc, PCREDUNDANT);CHKERRQ(ierr);
+      } else {
+        ierr = PCSetType(subpc, PCBJACOBI);CHKERRQ(ierr);
+        ierr = PCSetUp(subpc);CHKERRQ(ierr);
+        ierr = PCBJacobiGetSubKSP(subpc,&ii,&first,&k2);CHKERRQ(ierr);
+        if (ii != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"ii %D is not one",ii);
+        ierr = KSPGetPC(k2[0],&pc2);CHKERRQ(ierr);
+        ierr = PCSetType(pc2, PCLU);CHKERRQ(ierr);
+        ierr = PCFactorSetShiftType(pc2,MAT_SHIFT_INBLOCKS);CHKERRQ(ierr);
+        ierr = KSPSetTolerances(k2[0],PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT,1);CHKERRQ(ierr);
+        /* This flag gets reset by PCBJacobiGetSubKSP(), but our BJacobi really does the same algorithm everywhere (and in
+         * fact, all but one process will have zero dofs), so we reset the flag to avoid having PCView_BJacobi attempt to
+         * view every subdomain as though they were different. */
+        ((PC_BJacobi*)subpc->data)->same_local_solves = PETSC_TRUE;
+      }
     }
 
     /* should be called in PCSetFromOptions_GAMG(), but cannot be called prior to PCMGSetLevels() */
@@ -778,66 +981,11 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       ierr = PetscObjectTypeCompare((PetscObject)smoother, KSPCHEBYSHEV, &flag);CHKERRQ(ierr);
       if (flag) {
         PetscReal emax, emin;
-        ierr = PetscObjectTypeCompare((PetscObject)subpc, PCJACOBI, &flag);CHKERRQ(ierr);
-        if (flag && emaxs[level] > 0.0) emax=emaxs[level]; /* eigen estimate only for diagnal PC */
+        PetscInt  key;
+        ierr = KSPChebyshevEstEigCacheKey(subpc, &key);CHKERRQ(ierr);
+        if (!key && emaxs[level] > 0.0) emax=emaxs[level]; /* eigen estimate only for the diagonal of Jacobi */
         else { /* eigen estimate 'emax' */
-          KSP eksp;
-          Mat Lmat = Aarr[level];
-          Vec bb, xx;
-
-          ierr = MatGetVecs(Lmat, &bb, 0);CHKERRQ(ierr);
-          ierr = MatGetVecs(Lmat, &xx, 0);CHKERRQ(ierr);
-          {
-            PetscRandom rctx;
-            ierr = PetscRandomCreate(comm,&rctx);CHKERRQ(ierr);
-            ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
-            ierr = VecSetRandom(bb,rctx);CHKERRQ(ierr);
-            ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
-          }
-
-          /* zeroing out BC rows -- needed for crazy matrices */
-          {
-            PetscInt    Istart,Iend,ncols,jj,Ii;
-            PetscScalar zero = 0.0;
-            ierr = MatGetOwnershipRange(Lmat, &Istart, &Iend);CHKERRQ(ierr);
-            for (Ii = Istart, jj = 0; Ii < Iend; Ii++, jj++) {
-              ierr = MatGetRow(Lmat,Ii,&ncols,0,0);CHKERRQ(ierr);
-              if (ncols <= 1) {
-                ierr = VecSetValues(bb, 1, &Ii, &zero, INSERT_VALUES);CHKERRQ(ierr);
-              }
-              ierr = MatRestoreRow(Lmat,Ii,&ncols,0,0);CHKERRQ(ierr);
-            }
-            ierr = VecAssemblyBegin(bb);CHKERRQ(ierr);
-            ierr = VecAssemblyEnd(bb);CHKERRQ(ierr);
-          }
-
-          ierr = KSPCreate(comm, &eksp);CHKERRQ(ierr);
-          ierr = KSPSetTolerances(eksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 10);CHKERRQ(ierr);
-          ierr = KSPSetNormType(eksp, KSP_NORM_NONE);CHKERRQ(ierr);
-          ierr = KSPSetOptionsPrefix(eksp,((PetscObject)pc)->prefix);CHKERRQ(ierr);
-          ierr = KSPAppendOptionsPrefix(eksp, "gamg_est_");CHKERRQ(ierr);
-          ierr = KSPSetFromOptions(eksp);CHKERRQ(ierr);
-
-          ierr = KSPSetInitialGuessNonzero(eksp, PETSC_FALSE);CHKERRQ(ierr);
-          ierr = KSPSetOperators(eksp, Lmat, Lmat, SAME_NONZERO_PATTERN);CHKERRQ(ierr);
-          ierr = KSPSetComputeSingularValues(eksp,PETSC_TRUE);CHKERRQ(ierr);
-
-          /* set PC type to be same as smoother */
-          ierr = KSPSetPC(eksp, subpc);CHKERRQ(ierr);
-
-          /* solve - keep stuff out of logging */
-          ierr = PetscLogEventDeactivate(KSP_Solve);CHKERRQ(ierr);
-          ierr = PetscLogEventDeactivate(PC_Apply);CHKERRQ(ierr);
-          ierr = KSPSolve(eksp, bb, xx);CHKERRQ(ierr);
-          ierr = PetscLogEventActivate(KSP_Solve);CHKERRQ(ierr);
-          ierr = PetscLogEventActivate(PC_Apply);CHKERRQ(ierr);
-
-          ierr = KSPComputeExtremeSingularValues(eksp, &emax, &emin);CHKERRQ(ierr);
-
-          ierr = VecDestroy(&xx);CHKERRQ(ierr);
-          ierr = VecDestroy(&bb);CHKERRQ(ierr);
-          ierr = KSPDestroy(&eksp);CHKERRQ(ierr);
-
+          ierr = PCGAMGEstimateEigenvalues(pc, Aarr[level], subpc, &emax, &emin);CHKERRQ(ierr);
           if (pc_gamg->verbose > 0) {
             PetscInt N1, tt;
             ierr = MatGetSize(Aarr[level], &N1, &tt);CHKERRQ(ierr);
@@ -1047,17 +1195,21 @@ static PetscErrorCode PCGAMGSetRepartitioning_GAMG(PC pc, PetscBool n)
    Collective on PC
 
    Input Parameters:
-.  pc - the preconditioner context
-
++  pc - the preconditioner context
+-  n - PETSC_TRUE to keep the prolongators of the first setup
 
    Options Database Key:
 .  -pc_gamg_reuse_interpolation
 
+   Notes: Later setups only recompute the Galerkin coarse grid operators, numerically, with the nonzero
+   patterns and symbolic MatPtAP() data of the first setup.  Use PCGAMGSetResmoothProl() to also update
+   the values of smoothed prolongators.
+
    Level: intermediate
 
    Concepts: Unstructured multrigrid preconditioner
 
-.seealso: ()
+.seealso: PCGAMGSetResmoothProl()
 @*/
 PetscErrorCode PCGAMGSetReuseProl(PC pc, PetscBool n)
 {
@@ -1081,6 +1233,146 @@ static PetscErrorCode PCGAMGSetReuseProl_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetResmoothProl"
+/*@
+   PCGAMGSetResmoothProl - Recompute the values of the smoothed prolongators when they are reused
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE to smooth the tentative prolongators again with the new operators
+
+   Options Database Key:
+.  -pc_gamg_resmooth_interpolation
+
+   Notes: Only has an effect with PCGAMGSetReuseProl().  The aggregates, the tentative prolongators, the
+   nonzero patterns of the smoothed prolongators, the repartitioning and the eigenvalue estimates used for
+   smoothing are those of the first setup; only numerical products are computed in later setups.
+
+   Level: intermediate
+
+   Concepts: Unstructured multrigrid preconditioner
+
+.seealso: PCGAMGSetReuseProl()
+@*/
+PetscErrorCode PCGAMGSetResmoothProl(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  ierr = PetscTryMethod(pc,"PCGAMGSetResmoothProl_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetResmoothProl_GAMG"
+static PetscErrorCode PCGAMGSetResmoothProl_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->resmooth_prol = n;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetUseSubcomm"
+/*@
+   PCGAMGSetUseSubcomm - Solve the coarse levels that were reduced to fewer processes on subcommunicators
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE to put each reduced level on a communicator of the processes that own it
+
+   Options Database Key:
+.  -pc_gamg_use_subcomm
+
+   Notes: Without this the coarse levels live on the communicator of the PC, so every process takes part
+   in the reductions of the coarse grid smoothers and solver even if it owns none of the coarse equations.
+   With it, processes that own no part of a level skip that level and all coarser ones in the V-cycle; the
+   restriction and interpolation still run on the communicator of the finer level.  Only supported with the
+   multiplicative cycle.
+
+   Level: intermediate
+
+   Concepts: Unstructured multrigrid preconditioner
+
+.seealso: PCGAMGSetProcEqLim(), PCGAMGSetCoarseRedundant(), PCMGSetLevels()
+@*/
+PetscErrorCode PCGAMGSetUseSubcomm(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  ierr = PetscTryMethod(pc,"PCGAMGSetUseSubcomm_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetUseSubcomm_GAMG"
+static PetscErrorCode PCGAMGSetUseSubcomm_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->use_subcomm = n;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetCoarseRedundant"
+/*@
+   PCGAMGSetCoarseRedundant - Solve the coarse grid redundantly instead of gathering it on one process
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE to use a redundant LU coarse grid solver
+
+   Options Database Key:
+.  -pc_gamg_coarse_redundant
+
+   Notes: By default the coarsest grid is moved to one process and solved there with LU.  With this option it
+   stays on the processes given by PCGAMGSetProcEqLim() and each of them factors the whole coarse
+   matrix (see PCREDUNDANT), which replaces the gather to one process by an all-gather of the right hand side.
+
+   Level: intermediate
+
+   Concepts: Unstructured multrigrid preconditioner
+
+.seealso: PCGAMGSetUseSubcomm(), PCGAMGSetCoarseEqLim(), PCREDUNDANT
+@*/
+PetscErrorCode PCGAMGSetCoarseRedundant(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  ierr = PetscTryMethod(pc,"PCGAMGSetCoarseRedundant_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGSetCoarseRedundant_GAMG"
+static PetscErrorCode PCGAMGSetCoarseRedundant_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->coarse_redundant = n;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PCGAMGSetUseASMAggs"
 /*@
@@ -1301,6 +1593,27 @@ PetscErrorCode PCSetFromOptions_GAMG(PC pc)
                             pc_gamg->reuse_prol,
                             &pc_gamg->reuse_prol,
                             &flag);CHKERRQ(ierr);
+    /* -pc_gamg_resmooth_interpolation */
+    ierr = PetscOptionsBool("-pc_gamg_resmooth_interpolation",
+                            "Recompute values of reused smoothed prolongation operator (false)",
+                            "PCGAMGSetResmoothProl",
+                            pc_gamg->resmooth_prol,
+                            &pc_gamg->resmooth_prol,
+                            &flag);CHKERRQ(ierr);
+    /* -pc_gamg_use_subcomm */
+    ierr = PetscOptionsBool("-pc_gamg_use_subcomm",
+                            "Put coarse levels that live on fewer processes on subcommunicators (false)",
+                            "PCGAMGSetUseSubcomm",
+                            pc_gamg->use_subcomm,
+                            &pc_gamg->use_subcomm,
+                            &flag);CHKERRQ(ierr);
+    /* -pc_gamg_coarse_redundant */
+    ierr = PetscOptionsBool("-pc_gamg_coarse_redundant",
+                            "Solve the coarse grid redundantly instead of on one process (false)",
+                            "PCGAMGSetCoarseRedundant",
+                            pc_gamg->coarse_redundant,
+                            &pc_gamg->coarse_redundant,
+                            &flag);CHKERRQ(ierr);
     /* -pc_gamg_use_agg_gasm */
     ierr = PetscOptionsBool("-pc_gamg_use_agg_gasm",
                             "Use aggregation agragates for GASM smoother (false)",
@@ -1413,12 +1726,18 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseEqLim_C",PCGAMGSetCoarseEqLim_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRepartitioning_C",PCGAMGSetRepartitioning_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseProl_C",PCGAMGSetReuseProl_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetResmoothProl_C",PCGAMGSetResmoothProl_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseSubcomm_C",PCGAMGSetUseSubcomm_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseRedundant_C",PCGAMGSetCoarseRedundant_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseASMAggs_C",PCGAMGSetUseASMAggs_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetThreshold_C",PCGAMGSetThreshold_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetType_C",PCGAMGSetType_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNlevels_C",PCGAMGSetNlevels_GAMG);CHKERRQ(ierr);
   pc_gamg->repart           = PETSC_FALSE;
   pc_gamg->reuse_prol       = PETSC_FALSE;
+  pc_gamg->resmooth_prol    = PETSC_FALSE;
+  pc_gamg->use_subcomm      = PETSC_FALSE;
+  pc_gamg->coarse_redundant = PETSC_FALSE;
   pc_gamg->use_aggs_in_gasm = PETSC_FALSE;
   pc_gamg->min_eq_proc      = 50;
   pc_gamg->coarse_eq_limit  = 800;
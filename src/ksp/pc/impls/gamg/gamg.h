@@ -10,23 +10,29 @@ struct _PCGAMGOps {
   PetscErrorCode (*coarsen)(PC, Mat*, PetscCoarsenData**);
   PetscErrorCode (*prolongator)(PC, const Mat, const Mat, PetscCoarsenData*, Mat*);
   PetscErrorCode (*optprol)(PC, const Mat, Mat*);
+  PetscErrorCode (*optprolreuse)(PC, const Mat, const Mat, Mat); /* recompute smoothed prolongator values in place */
   PetscErrorCode (*createdefaultdata)(PC, Mat); /* for data methods that have a default (SA) */
   PetscErrorCode (*setfromoptions)(PC);
   PetscErrorCode (*destroy)(PC);
 };
 
+#define GAMG_MAXLEVELS 30
+
 /* Private context for the GAMG preconditioner */
 typedef struct gamg_TAG {
   PetscInt  Nlevels;
   PetscInt  setup_count;
   PetscBool repart;
   PetscBool reuse_prol;
+  PetscBool resmooth_prol;
+  PetscBool use_subcomm;
+  PetscBool coarse_redundant;
   PetscBool use_aggs_in_gasm;
   PetscInt  min_eq_proc;
   PetscInt  coarse_eq_limit;
   PetscReal threshold;      /* common quatity to many AMG methods so keep it up here */
   PetscInt  verbose;
-  PetscInt  emax_id;      /* stashing places */
+  PetscInt  emax_id;      /* stashing place for the prolongator smoothing eigenvalue estimate on tentative prolongators */
 
   /* these 4 are all related to the method data and should be in the subctx */
   PetscInt  data_sz;      /* nloc*data_rows*data_cols */
@@ -38,6 +44,14 @@ typedef struct gamg_TAG {
   PetscReal *data;          /* [data_sz] blocked vector of vertex data on fine grid (coordinates/nullspace) */
   PetscReal *orig_data;          /* cache data */
 
+  /* kept across PCSetUp() calls when the prolongators are reused, indexed like the prolongators (1 is finest) */
+  PetscBool has_ptap[GAMG_MAXLEVELS]; /* coarse operator carries the symbolic data of MatPtAP() */
+  Mat       Ptent[GAMG_MAXLEVELS];    /* tentative (unsmoothed) prolongators */
+  Mat       Psmooth[GAMG_MAXLEVELS];  /* smoothed prolongators before repartitioning */
+  IS        Pcols[GAMG_MAXLEVELS];    /* repartitioned coarse equations, NULL if not repartitioned */
+  Mat       Afull[GAMG_MAXLEVELS];    /* operators and prolongators of levels moved to subcommunicators, */
+  Mat       Pfull[GAMG_MAXLEVELS];    /* as they are on the PC communicator */
+
   struct _PCGAMGOps *ops;
   char *gamg_type_name;
 
@@ -59,6 +73,7 @@ PetscErrorCode PCDestroy_GAMG(PC pc);
 PetscErrorCode PCGAMGCreateGraph(const Mat, Mat*);
 PetscErrorCode PCGAMGFilterGraph(Mat*, const PetscReal, const PetscBool, const PetscInt);
 PetscErrorCode PCGAMGGetDataWithGhosts(const Mat a_Gmat, const PetscInt a_data_sz, const PetscReal a_data_in[],PetscInt *a_stride, PetscReal **a_data_out);
+PetscErrorCode PCGAMGEstimateEigenvalues(PC, const Mat, PC, PetscReal*, PetscReal*);
 
 #if defined PETSC_USE_LOG
 /* #define PETSC_GAMG_USE_LOG */
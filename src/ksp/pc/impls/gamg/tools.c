@@ -262,6 +262,104 @@ PetscErrorCode PCGAMGGetDataWithGhosts(const Mat Gmat,const PetscInt data_sz,con
 }
 
 
+/* -------------------------------------------------------------------------- */
+/*
+   PCGAMGEstimateEigenvalues - estimate the extreme eigenvalues of a preconditioned
+     level operator with a few Krylov iterations on a random right hand side
+
+   Input Parameter:
+   . pc - this
+   . Amat - level operator
+   . epc - preconditioner to estimate with, NULL for point Jacobi
+   Output Parameter:
+   . a_emax - estimate of the largest eigenvalue
+   . a_emin - estimate of the smallest eigenvalue
+
+   These are the extreme singular values computed by the Krylov method, so they are not stored
+   with KSPChebyshevEstEigCacheSet(), which holds eigenvalue estimates.  The estimate uses CG
+   (Lanczos) when Amat is known to be symmetric and the preconditioner is point Jacobi or none,
+   so the preconditioned operator is symmetric too; otherwise GMRES. It can be changed with
+   -pc_gamg_est_ksp_type.
+*/
+#undef __FUNCT__
+#define __FUNCT__ "PCGAMGEstimateEigenvalues"
+PetscErrorCode PCGAMGEstimateEigenvalues(PC pc,const Mat Amat,PC epc,PetscReal *a_emax,PetscReal *a_emin)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  KSP            eksp;
+  Vec            bb, xx;
+  PetscBool      symmpc = PETSC_TRUE,set,sym = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Amat,&comm);CHKERRQ(ierr);
+  if (epc) {ierr = PetscObjectTypeCompareAny((PetscObject)epc, &symmpc, PCJACOBI, PCNONE, "");CHKERRQ(ierr);}
+
+  ierr = MatGetVecs(Amat, &bb, 0);CHKERRQ(ierr);
+  ierr = MatGetVecs(Amat, &xx, 0);CHKERRQ(ierr);
+  {
+    PetscRandom rctx;
+    ierr = PetscRandomCreate(comm,&rctx);CHKERRQ(ierr);
+    ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+    ierr = VecSetRandom(bb,rctx);CHKERRQ(ierr);
+    ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  }
+
+  /* zeroing out BC rows -- needed for crazy matrices */
+  {
+    PetscInt    Istart,Iend,ncols,Ii;
+    PetscScalar zero = 0.0;
+    ierr = MatGetOwnershipRange(Amat, &Istart, &Iend);CHKERRQ(ierr);
+    for (Ii = Istart; Ii < Iend; Ii++) {
+      ierr = MatGetRow(Amat,Ii,&ncols,0,0);CHKERRQ(ierr);
+      if (ncols <= 1) {
+        ierr = VecSetValues(bb, 1, &Ii, &zero, INSERT_VALUES);CHKERRQ(ierr);
+      }
+      ierr = MatRestoreRow(Amat,Ii,&ncols,0,0);CHKERRQ(ierr);
+    }
+    ierr = VecAssemblyBegin(bb);CHKERRQ(ierr);
+    ierr = VecAssemblyEnd(bb);CHKERRQ(ierr);
+  }
+
+  ierr = KSPCreate(comm,&eksp);CHKERRQ(ierr);
+  ierr = MatIsSymmetricKnown(Amat, &set, &sym);CHKERRQ(ierr);
+  if (symmpc && ((set && sym) || (Amat->spd_set && Amat->spd))) {
+    ierr = KSPSetType(eksp, KSPCG);CHKERRQ(ierr); /* Lanczos, no orthogonalization */
+  }
+  ierr = KSPSetTolerances(eksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 10);CHKERRQ(ierr);
+  ierr = KSPSetNormType(eksp, KSP_NORM_NONE);CHKERRQ(ierr);
+  ierr = KSPSetOptionsPrefix(eksp,((PetscObject)pc)->prefix);CHKERRQ(ierr);
+  ierr = KSPAppendOptionsPrefix(eksp, "gamg_est_");CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(eksp);CHKERRQ(ierr);
+
+  ierr = KSPSetInitialGuessNonzero(eksp, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = KSPSetOperators(eksp, Amat, Amat, SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = KSPSetComputeSingularValues(eksp,PETSC_TRUE);CHKERRQ(ierr);
+
+  if (epc) {
+    ierr = KSPSetPC(eksp, epc);CHKERRQ(ierr);
+  } else {
+    PC jpc;
+    ierr = KSPGetPC(eksp, &jpc);CHKERRQ(ierr);
+    ierr = PCSetType(jpc, PCJACOBI);CHKERRQ(ierr);
+  }
+
+  /* solve - keep stuff out of logging */
+  ierr = PetscLogEventDeactivate(KSP_Solve);CHKERRQ(ierr);
+  ierr = PetscLogEventDeactivate(PC_Apply);CHKERRQ(ierr);
+  ierr = KSPSolve(eksp, bb, xx);CHKERRQ(ierr);
+  ierr = PetscLogEventActivate(KSP_Solve);CHKERRQ(ierr);
+  ierr = PetscLogEventActivate(PC_Apply);CHKERRQ(ierr);
+
+  ierr = KSPComputeExtremeSingularValues(eksp, a_emax, a_emin);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&xx);CHKERRQ(ierr);
+  ierr = VecDestroy(&bb);CHKERRQ(ierr);
+  ierr = KSPDestroy(&eksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+
 /* hash table stuff - simple, not dymanic, key >= 0, has table
  *
  *  GAMGTableCreate
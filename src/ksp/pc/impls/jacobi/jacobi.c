@@ -99,6 +99,39 @@ static PetscErrorCode  PCJacobiSetUseAbs_Jacobi(PC pc)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PCJacobiGetUseRowMax_Jacobi"
+static PetscErrorCode  PCJacobiGetUseRowMax_Jacobi(PC pc,PetscBool *flg)
+{
+  PC_Jacobi *j = (PC_Jacobi*)pc->data;
+
+  PetscFunctionBegin;
+  *flg = j->userowmax;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCJacobiGetUseRowSum_Jacobi"
+static PetscErrorCode  PCJacobiGetUseRowSum_Jacobi(PC pc,PetscBool *flg)
+{
+  PC_Jacobi *j = (PC_Jacobi*)pc->data;
+
+  PetscFunctionBegin;
+  *flg = j->userowsum;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCJacobiGetUseAbs_Jacobi"
+static PetscErrorCode  PCJacobiGetUseAbs_Jacobi(PC pc,PetscBool *flg)
+{
+  PC_Jacobi *j = (PC_Jacobi*)pc->data;
+
+  PetscFunctionBegin;
+  *flg = j->useabs;
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCSetUp_Jacobi - Prepares for the use of the Jacobi preconditioner
@@ -433,6 +466,9 @@ PETSC_EXTERN PetscErrorCode PCCreate_Jacobi(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCJacobiSetUseRowMax_C",PCJacobiSetUseRowMax_Jacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCJacobiSetUseRowSum_C",PCJacobiSetUseRowSum_Jacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCJacobiSetUseAbs_C",PCJacobiSetUseAbs_Jacobi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCJacobiGetUseRowMax_C",PCJacobiGetUseRowMax_Jacobi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCJacobiGetUseRowSum_C",PCJacobiGetUseRowSum_Jacobi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCJacobiGetUseAbs_C",PCJacobiGetUseAbs_Jacobi);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -532,3 +568,88 @@ PetscErrorCode  PCJacobiSetUseRowSum(PC pc)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PCJacobiGetUseAbs"
+/*@
+   PCJacobiGetUseAbs - Determines if the Jacobi preconditioner uses the absolute value of the diagonal
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the absolute values are used
+
+   Level: intermediate
+
+.seealso: PCJacobiSetUseAbs(), PCJacobiGetUseRowMax(), PCJacobiGetUseRowSum()
+@*/
+PetscErrorCode  PCJacobiGetUseAbs(PC pc,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidPointer(flg,2);
+  ierr = PetscUseMethod(pc,"PCJacobiGetUseAbs_C",(PC,PetscBool*),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCJacobiGetUseRowMax"
+/*@
+   PCJacobiGetUseRowMax - Determines if the Jacobi preconditioner uses the maximum entry in each row
+      instead of the diagonal entry
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the row maximums are used
+
+   Level: intermediate
+
+.seealso: PCJacobiSetUseRowMax(), PCJacobiGetUseAbs(), PCJacobiGetUseRowSum()
+@*/
+PetscErrorCode  PCJacobiGetUseRowMax(PC pc,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidPointer(flg,2);
+  ierr = PetscUseMethod(pc,"PCJacobiGetUseRowMax_C",(PC,PetscBool*),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCJacobiGetUseRowSum"
+/*@
+   PCJacobiGetUseRowSum - Determines if the Jacobi preconditioner uses the sum of each row
+      instead of the diagonal entry
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the row sums are used
+
+   Level: intermediate
+
+.seealso: PCJacobiSetUseRowSum(), PCJacobiGetUseAbs(), PCJacobiGetUseRowMax()
+@*/
+PetscErrorCode  PCJacobiGetUseRowSum(PC pc,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidPointer(flg,2);
+  ierr = PetscUseMethod(pc,"PCJacobiGetUseRowSum_C",(PC,PetscBool*),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
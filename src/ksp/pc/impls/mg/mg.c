@@ -12,7 +12,7 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
   PC_MG          *mg = (PC_MG*)pc->data;
   PC_MG_Levels   *mgc,*mglevels = *mglevelsin;
   PetscErrorCode ierr;
-  PetscInt       cycles = (mglevels->level == 1) ? 1 : (PetscInt) mglevels->cycles;
+  PetscInt       cycles = (mglevels->level == 1) ? 1 : (PetscInt) mglevels->cycles,N;
 
   PetscFunctionBegin;
   if (mglevels->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
@@ -41,14 +41,36 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
 
     mgc = *(mglevelsin - 1);
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatRestrict(mglevels->restrct,mglevels->r,mgc->b);CHKERRQ(ierr);
+    if (mgc->bp) {
+      /* the coarser level lives on a smaller communicator, restrict into a view of its rhs on this level's communicator */
+      PetscScalar *array;
+      ierr = VecGetArray(mgc->b,&array);CHKERRQ(ierr);
+      ierr = VecPlaceArray(mgc->bp,array);CHKERRQ(ierr);
+      ierr = MatRestrict(mglevels->restrct,mglevels->r,mgc->bp);CHKERRQ(ierr);
+      ierr = VecResetArray(mgc->bp);CHKERRQ(ierr);
+      ierr = VecRestoreArray(mgc->b,&array);CHKERRQ(ierr);
+    } else {
+      ierr = MatRestrict(mglevels->restrct,mglevels->r,mgc->b);CHKERRQ(ierr);
+    }
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
     ierr = VecSet(mgc->x,0.0);CHKERRQ(ierr);
-    while (cycles--) {
-      ierr = PCMGMCycle_Private(pc,mglevelsin-1,reason);CHKERRQ(ierr);
+    ierr = VecGetSize(mgc->x,&N);CHKERRQ(ierr);
+    if (N) { /* processes for which the coarser levels are empty have nothing to do there */
+      while (cycles--) {
+        ierr = PCMGMCycle_Private(pc,mglevelsin-1,reason);CHKERRQ(ierr);
+      }
     }
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatInterpolateAdd(mglevels->interpolate,mgc->x,mglevels->x,mglevels->x);CHKERRQ(ierr);
+    if (mgc->xp) {
+      const PetscScalar *array;
+      ierr = VecGetArrayRead(mgc->x,&array);CHKERRQ(ierr);
+      ierr = VecPlaceArray(mgc->xp,array);CHKERRQ(ierr);
+      ierr = MatInterpolateAdd(mglevels->interpolate,mgc->xp,mglevels->x,mglevels->x);CHKERRQ(ierr);
+      ierr = VecResetArray(mgc->xp);CHKERRQ(ierr);
+      ierr = VecRestoreArrayRead(mgc->x,&array);CHKERRQ(ierr);
+    } else {
+      ierr = MatInterpolateAdd(mglevels->interpolate,mgc->x,mglevels->x,mglevels->x);CHKERRQ(ierr);
+    }
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
     if (mglevels->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
     ierr = KSPSolve(mglevels->smoothu,mglevels->b,mglevels->x);CHKERRQ(ierr);    /* post smooth */
@@ -121,6 +143,8 @@ PetscErrorCode PCReset_MG(PC pc)
       ierr = VecDestroy(&mglevels[i+1]->r);CHKERRQ(ierr);
       ierr = VecDestroy(&mglevels[i]->b);CHKERRQ(ierr);
       ierr = VecDestroy(&mglevels[i]->x);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->bp);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->xp);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i+1]->restrct);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i+1]->interpolate);CHKERRQ(ierr);
       ierr = VecDestroy(&mglevels[i+1]->rscale);CHKERRQ(ierr);
@@ -157,6 +181,13 @@ PetscErrorCode PCReset_MG(PC pc)
      If the number of levels is one then the multigrid uses the -mg_levels prefix
   for setting the level options rather than the -mg_coarse prefix.
 
+     Each communicator in comms must be a subset of the communicator of the next finer level, the
+  vectors of a level keep the local sizes they have on the finer level. Processes that own no part of a
+  level may be grouped in their own communicator, on which that level (and all coarser ones) is empty;
+  such levels are skipped in the cycle so those processes take no part in the coarse grid work. This is
+  only supported for the multiplicative cycle. When comms is given the levels are always rebuilt, even
+  if their number does not change.
+
 .keywords: MG, set, levels, multigrid
 
 .seealso: PCMGSetType(), PCMGGetLevels()
@@ -177,7 +208,7 @@ PetscErrorCode  PCMGSetLevels(PC pc,PetscInt levels,MPI_Comm *comms)
   PetscValidHeaderSpecific(pc,PC_CLASSID,1);
   PetscValidLogicalCollectiveInt(pc,levels,2);
   ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
-  if (mg->nlevels == levels) PetscFunctionReturn(0);
+  if (mg->nlevels == levels && !comms) PetscFunctionReturn(0);
   if (mglevels) {
     /* changing the number of levels so free up the previous stuff */
     ierr = PCReset_MG(pc);CHKERRQ(ierr);
@@ -442,6 +473,42 @@ PetscErrorCode PCSetFromOptions_MG(PC pc)
 const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","PCMGType","PC_MG",0};
 const char *const PCMGCycleTypes[] = {"invalid","v","w","PCMGCycleType","PC_MG_CYCLE",0};
 
+#undef __FUNCT__
+#define __FUNCT__ "PCMGKSPView_Private"
+/*
+   Views the solver of one level; a level may live on a smaller communicator than the PC,
+   then only the processes on which it is not empty print it.
+*/
+static PetscErrorCode PCMGKSPView_Private(PC pc,KSP ksp,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    flg;
+  PetscViewer    sviewer;
+  PetscBool      set;
+  PetscInt       N = 1;
+  Mat            A;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)ksp,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_compare(comm,PetscObjectComm((PetscObject)pc),&flg);CHKERRQ(ierr);
+  if (flg == MPI_IDENT || flg == MPI_CONGRUENT) {
+    ierr = KSPView(ksp,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = KSPGetOperatorsSet(ksp,NULL,&set);CHKERRQ(ierr);
+  if (set) {
+    ierr = KSPGetOperators(ksp,NULL,&A,NULL);CHKERRQ(ierr);
+    ierr = MatGetSize(A,&N,NULL);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerGetSubcomm(viewer,comm,&sviewer);CHKERRQ(ierr);
+  if (N) {
+    ierr = KSPView(ksp,sviewer);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerRestoreSubcomm(viewer,comm,&sviewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #include <petscdraw.h>
 #undef __FUNCT__
 #define __FUNCT__ "PCView_MG"
@@ -475,14 +542,14 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
         ierr = PetscViewerASCIIPrintf(viewer,"Down solver (pre-smoother) on level %D -------------------------------\n",i);CHKERRQ(ierr);
       }
       ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
-      ierr = KSPView(mglevels[i]->smoothd,viewer);CHKERRQ(ierr);
+      ierr = PCMGKSPView_Private(pc,mglevels[i]->smoothd,viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
       if (i && mglevels[i]->smoothd == mglevels[i]->smoothu) {
         ierr = PetscViewerASCIIPrintf(viewer,"Up solver (post-smoother) same as down solver (pre-smoother)\n");CHKERRQ(ierr);
       } else if (i) {
         ierr = PetscViewerASCIIPrintf(viewer,"Up solver (post-smoother) on level %D -------------------------------\n",i);CHKERRQ(ierr);
         ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
-        ierr = KSPView(mglevels[i]->smoothu,viewer);CHKERRQ(ierr);
+        ierr = PCMGKSPView_Private(pc,mglevels[i]->smoothu,viewer);CHKERRQ(ierr);
         ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
       }
     }
@@ -704,6 +771,24 @@ PetscErrorCode PCSetUp_MG(PC pc)
         ierr = VecDestroy(&tvec);CHKERRQ(ierr);
       }
     }
+    for (i=0; i<n-1; i++) {
+      MPI_Comm    ccomm,fcomm;
+      PetscMPIInt flg;
+
+      ierr = PetscObjectGetComm((PetscObject)mglevels[i]->smoothd,&ccomm);CHKERRQ(ierr);
+      ierr = PetscObjectGetComm((PetscObject)mglevels[i+1]->smoothd,&fcomm);CHKERRQ(ierr);
+      ierr = MPI_Comm_compare(ccomm,fcomm,&flg);CHKERRQ(ierr);
+      if (flg != MPI_IDENT && flg != MPI_CONGRUENT && !mglevels[i]->bp) {
+        /* level i lives on a smaller communicator; the transfers see its vectors through these, which share the arrays */
+        PetscInt bs,nlocal;
+
+        if (mg->am != PC_MG_MULTIPLICATIVE) SETERRQ(fcomm,PETSC_ERR_SUP,"Levels on smaller communicators are only supported with the multiplicative cycle");
+        ierr = VecGetBlockSize(mglevels[i]->b,&bs);CHKERRQ(ierr);
+        ierr = VecGetLocalSize(mglevels[i]->b,&nlocal);CHKERRQ(ierr);
+        ierr = VecCreateMPIWithArray(fcomm,bs,nlocal,PETSC_DECIDE,NULL,&mglevels[i]->bp);CHKERRQ(ierr);
+        ierr = VecCreateMPIWithArray(fcomm,bs,nlocal,PETSC_DECIDE,NULL,&mglevels[i]->xp);CHKERRQ(ierr);
+      }
+    }
     if (n != 1 && !mglevels[n-1]->r) {
       /* PCMGSetR() on the finest level if user did not supply it */
       Vec *vec;
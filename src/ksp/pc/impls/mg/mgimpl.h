@@ -17,6 +17,8 @@ typedef struct {
   Vec      b;                                  /* Right hand side */
   Vec      x;                                  /* Solution */
   Vec      r;                                  /* Residual */
+  Vec      bp;                                 /* b and x seen on the communicator of the next finer level, */
+  Vec      xp;                                 /* only used when this level lives on a smaller communicator */
 
   PetscErrorCode (*residual)(Mat,Vec,Vec,Vec);
 
@@ -0,0 +1,197 @@
+/*
+   Include files needed for the variable size point block Jacobi preconditioner:
+     pcimpl.h - private include file intended for use by all preconditioners
+*/
+
+#include <petsc-private/matimpl.h>
+#include <petsc-private/pcimpl.h>   /*I "petscpc.h" I*/
+
+/*
+   Private context (data structure) for the VPBJacobi preconditioner.
+*/
+typedef struct {
+  PetscScalar *diag;            /* the inverses of the diagonal blocks, one after the other, each column major */
+  PetscInt    nblocks,*bsizes;  /* copy of the block sizes used to compute diag */
+  PetscInt    ndiag;            /* allocated length of diag */
+} PC_VPBJacobi;
+
+#undef __FUNCT__
+#define __FUNCT__ "PCApply_VPBJacobi"
+static PetscErrorCode PCApply_VPBJacobi(PC pc,Vec x,Vec y)
+{
+  PC_VPBJacobi      *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode    ierr;
+  PetscInt          i,j,k,bs,nblocks = jac->nblocks;
+  const PetscInt    *bsizes = jac->bsizes;
+  const PetscScalar *diag = jac->diag,*xx;
+  PetscScalar       *yy,x0,x1,x2,x3,x4,sum;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yy);CHKERRQ(ierr);
+  for (i=0; i<nblocks; i++) {
+    bs = bsizes[i];
+    switch (bs) {
+    case 1:
+      yy[0] = diag[0]*xx[0];
+      break;
+    case 2:
+      x0    = xx[0]; x1 = xx[1];
+      yy[0] = diag[0]*x0 + diag[2]*x1;
+      yy[1] = diag[1]*x0 + diag[3]*x1;
+      break;
+    case 3:
+      x0    = xx[0]; x1 = xx[1]; x2 = xx[2];
+      yy[0] = diag[0]*x0 + diag[3]*x1 + diag[6]*x2;
+      yy[1] = diag[1]*x0 + diag[4]*x1 + diag[7]*x2;
+      yy[2] = diag[2]*x0 + diag[5]*x1 + diag[8]*x2;
+      break;
+    case 4:
+      x0    = xx[0]; x1 = xx[1]; x2 = xx[2]; x3 = xx[3];
+      yy[0] = diag[0]*x0 + diag[4]*x1 + diag[8]*x2  + diag[12]*x3;
+      yy[1] = diag[1]*x0 + diag[5]*x1 + diag[9]*x2  + diag[13]*x3;
+      yy[2] = diag[2]*x0 + diag[6]*x1 + diag[10]*x2 + diag[14]*x3;
+      yy[3] = diag[3]*x0 + diag[7]*x1 + diag[11]*x2 + diag[15]*x3;
+      break;
+    case 5:
+      x0    = xx[0]; x1 = xx[1]; x2 = xx[2]; x3 = xx[3]; x4 = xx[4];
+      yy[0] = diag[0]*x0 + diag[5]*x1 + diag[10]*x2 + diag[15]*x3 + diag[20]*x4;
+      yy[1] = diag[1]*x0 + diag[6]*x1 + diag[11]*x2 + diag[16]*x3 + diag[21]*x4;
+      yy[2] = diag[2]*x0 + diag[7]*x1 + diag[12]*x2 + diag[17]*x3 + diag[22]*x4;
+      yy[3] = diag[3]*x0 + diag[8]*x1 + diag[13]*x2 + diag[18]*x3 + diag[23]*x4;
+      yy[4] = diag[4]*x0 + diag[9]*x1 + diag[14]*x2 + diag[19]*x3 + diag[24]*x4;
+      break;
+    default:
+      for (j=0; j<bs; j++) {
+        sum = 0.0;
+        for (k=0; k<bs; k++) sum += diag[k*bs+j]*xx[k];
+        yy[j] = sum;
+      }
+    }
+    xx   += bs;
+    yy   += bs;
+    diag += bs*bs;
+  }
+  ierr = VecRestoreArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*(jac->ndiag) - pc->pmat->rmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+/* -------------------------------------------------------------------------- */
+#undef __FUNCT__
+#define __FUNCT__ "PCSetUp_VPBJacobi"
+static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  Mat            A = pc->pmat;
+  PetscInt       i,nblocks,bs,ndiag = 0;
+  const PetscInt *bsizes;
+
+  PetscFunctionBegin;
+  if (A->rmap->n != A->cmap->n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Supported only for square matrices and square storage");
+
+  ierr = MatGetVariableBlockSizes(A,&nblocks,&bsizes);CHKERRQ(ierr);
+  ierr = PetscFree(jac->bsizes);CHKERRQ(ierr);
+  if (bsizes) {
+    ierr = PetscMalloc(nblocks*sizeof(PetscInt),&jac->bsizes);CHKERRQ(ierr);
+    ierr = PetscMemcpy(jac->bsizes,bsizes,nblocks*sizeof(PetscInt));CHKERRQ(ierr);
+  } else {
+    /* no variable block sizes were provided, use the block size of the matrix */
+    ierr    = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+    nblocks = A->rmap->n/bs;
+    ierr    = PetscMalloc(nblocks*sizeof(PetscInt),&jac->bsizes);CHKERRQ(ierr);
+    for (i=0; i<nblocks; i++) jac->bsizes[i] = bs;
+  }
+  jac->nblocks = nblocks;
+  for (i=0; i<nblocks; i++) ndiag += jac->bsizes[i]*jac->bsizes[i];
+  if (ndiag > jac->ndiag) {
+    ierr = PetscFree(jac->diag);CHKERRQ(ierr);
+    ierr = PetscMalloc(ndiag*sizeof(PetscScalar),&jac->diag);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)pc,(ndiag-jac->ndiag)*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  jac->ndiag = ndiag;
+  ierr       = MatInvertVariableBlockDiagonal(A,nblocks,jac->bsizes,jac->diag);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+/* -------------------------------------------------------------------------- */
+#undef __FUNCT__
+#define __FUNCT__ "PCDestroy_VPBJacobi"
+static PetscErrorCode PCDestroy_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(jac->diag);CHKERRQ(ierr);
+  ierr = PetscFree(jac->bsizes);CHKERRQ(ierr);
+  ierr = PetscFree(pc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCView_VPBJacobi"
+static PetscErrorCode PCView_VPBJacobi(PC pc,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscBool      iascii;
+  PetscInt       i,bsmin = PETSC_MAX_INT,bsmax = 0,nblocks,gbsmin,gbsmax;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    for (i=0; i<jac->nblocks; i++) {
+      bsmin = PetscMin(bsmin,jac->bsizes[i]);
+      bsmax = PetscMax(bsmax,jac->bsizes[i]);
+    }
+    ierr = MPI_Allreduce(&jac->nblocks,&nblocks,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+    ierr = MPI_Allreduce(&bsmin,&gbsmin,1,MPIU_INT,MPI_MIN,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+    ierr = MPI_Allreduce(&bsmax,&gbsmax,1,MPIU_INT,MPI_MAX,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  variable point-block Jacobi: %D blocks of sizes %D to %D\n",nblocks,gbsmin,gbsmax);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*MC
+     PCVPBJACOBI - Variable size point block Jacobi, inverts the diagonal blocks of the sizes given with
+       MatSetVariableBlockSizes(), for example the unknowns of nodes carrying different numbers of fields
+
+   Notes:
+     If MatSetVariableBlockSizes() was not called the block size of the matrix is used, as in PCPBJACOBI.
+
+     Only implemented for AIJ matrices.
+
+   Level: beginner
+
+  Concepts: variable point block Jacobi
+
+
+.seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCPBJACOBI, MatSetVariableBlockSizes(),
+           MatInvertVariableBlockDiagonal()
+
+M*/
+
+#undef __FUNCT__
+#define __FUNCT__ "PCCreate_VPBJacobi"
+PETSC_EXTERN PetscErrorCode PCCreate_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscNewLog(pc,PC_VPBJacobi,&jac);CHKERRQ(ierr);
+  pc->data = (void*)jac;
+
+  pc->ops->apply               = PCApply_VPBJacobi;
+  pc->ops->applytranspose      = 0;
+  pc->ops->setup               = PCSetUp_VPBJacobi;
+  pc->ops->destroy             = PCDestroy_VPBJacobi;
+  pc->ops->setfromoptions      = 0;
+  pc->ops->view                = PCView_VPBJacobi;
+  pc->ops->applyrichardson     = 0;
+  pc->ops->applysymmetricleft  = 0;
+  pc->ops->applysymmetricright = 0;
+  PetscFunctionReturn(0);
+}
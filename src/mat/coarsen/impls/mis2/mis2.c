@@ -0,0 +1,392 @@
+#include <petsc-private/matimpl.h>    /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+/* -------------------------------------------------------------------------- */
+/*
+   maxAdj - y_i = max(x_i, max_{j adjacent to i} x_j), one communication with the ghost scatter of the graph
+
+   Input Parameter:
+   . Gmat - graph (AIJ), only the nonzero pattern is used
+   . x - vector with the row layout of Gmat
+   Output Parameter:
+   . y - vector with the row layout of Gmat, may not be x
+*/
+#undef __FUNCT__
+#define __FUNCT__ "maxAdj"
+static PetscErrorCode maxAdj(Mat Gmat,Vec x,Vec y)
+{
+  PetscErrorCode    ierr;
+  PetscBool         isMPI;
+  Mat_SeqAIJ        *matA,*matB = NULL;
+  Mat_MPIAIJ        *mpimat     = NULL;
+  const PetscScalar *xa,*ga = NULL;
+  PetscScalar       *ya;
+  PetscInt          lid,j;
+  PetscReal         m;
+  const PetscInt    nloc = Gmat->rmap->n;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+    ierr   = VecScatterBegin(mpimat->Mvctx,x,mpimat->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr   = VecScatterEnd(mpimat->Mvctx,x,mpimat->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr   = VecGetArrayRead(mpimat->lvec,&ga);CHKERRQ(ierr);
+  } else matA = (Mat_SeqAIJ*)Gmat->data;
+  ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&ya);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    m = PetscRealPart(xa[lid]);
+    for (j=matA->i[lid]; j<matA->i[lid+1]; j++) m = PetscMax(m,PetscRealPart(xa[matA->j[j]]));
+    if (matB) {
+      for (j=matB->i[lid]; j<matB->i[lid+1]; j++) m = PetscMax(m,PetscRealPart(ga[matB->j[j]]));
+    }
+    ya[lid] = m;
+  }
+  ierr = VecRestoreArray(y,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+  if (mpimat) {
+    ierr = VecRestoreArrayRead(mpimat->lvec,&ga);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*
+   strongestAdj - join the strongest connected neighbor j of each vertex i with a_i < 0 and x_j >= 0: a_i = x_j
+
+   Input Parameter:
+   . Gmat - graph (AIJ), the absolute values of the entries are the connection strengths
+   . x - vector with the row layout of Gmat
+   In/Output Parameter:
+   . a_agg - [nloc] entries < 0 are set with the x value of the strongest neighbor with x >= 0, if any
+*/
+#undef __FUNCT__
+#define __FUNCT__ "strongestAdj"
+static PetscErrorCode strongestAdj(Mat Gmat,Vec x,PetscInt a_agg[])
+{
+  PetscErrorCode    ierr;
+  PetscBool         isMPI;
+  Mat_SeqAIJ        *matA,*matB = NULL;
+  Mat_MPIAIJ        *mpimat     = NULL;
+  const PetscScalar *xa,*ga = NULL;
+  PetscInt          lid,j,best;
+  PetscReal         w,wbest;
+  const PetscInt    nloc = Gmat->rmap->n;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+    ierr   = VecScatterBegin(mpimat->Mvctx,x,mpimat->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr   = VecScatterEnd(mpimat->Mvctx,x,mpimat->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr   = VecGetArrayRead(mpimat->lvec,&ga);CHKERRQ(ierr);
+  } else matA = (Mat_SeqAIJ*)Gmat->data;
+  ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    if (a_agg[lid] >= 0) continue;
+    best = -1; wbest = -1.;
+    for (j=matA->i[lid]; j<matA->i[lid+1]; j++) {
+      PetscInt xj = (PetscInt)PetscRealPart(xa[matA->j[j]]);
+      w = PetscAbsScalar(matA->a[j]);
+      if (matA->j[j] != lid && xj >= 0 && w > wbest) {best = xj; wbest = w;}
+    }
+    if (matB) {
+      for (j=matB->i[lid]; j<matB->i[lid+1]; j++) {
+        PetscInt xj = (PetscInt)PetscRealPart(ga[matB->j[j]]);
+        w = PetscAbsScalar(matB->a[j]);
+        if (xj >= 0 && w > wbest) {best = xj; wbest = w;}
+      }
+    }
+    a_agg[lid] = best;
+  }
+  ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+  if (mpimat) {
+    ierr = VecRestoreArrayRead(mpimat->lvec,&ga);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*
+   maxIndSet2Agg - parallel distance 2 maximal independent set (MIS-2) and aggregation around it,
+     without forming the squared graph. MatAIJ specific!!!
+
+   Every vertex gets a unique key, a random permutation (perm) of the local vertices interleaved over the
+   processes.  In each round the keys are maximized twice over the neighbors of the vertices, so each
+   vertex sees the largest key within distance 2.  Undecided vertices that see their own key are selected,
+   undecided vertices that see a selected key are deleted.  Selected keys are larger than undecided ones,
+   which are larger than deleted ones.
+
+   The aggregates are the selected vertices, their strongest connected neighbors and then the vertices
+   at distance 2, which join the aggregate of their strongest connected neighbor.  The members of the
+   aggregates are collected with a matrix (row: selected vertex, columns: members), which is also
+   returned for the ghost information of the aggregates.
+
+   Input Parameter:
+   . perm - serial permutation of rows of local to process in MIS
+   . Gmat - glabal matrix of graph
+   . verbose -
+   Output Parameter:
+   . a_locals_llist - array of list of global ids of nodes rooted at selected nodes
+*/
+#undef __FUNCT__
+#define __FUNCT__ "maxIndSet2Agg"
+static PetscErrorCode maxIndSet2Agg(IS perm,Mat Gmat,PetscInt verbose,PetscCoarsenData **a_locals_llist)
+{
+  PetscErrorCode   ierr;
+  PetscBool        isMPI;
+  Mat_SeqAIJ       *matA,*matB = NULL;
+  Mat_MPIAIJ       *mpimat     = NULL;
+  MPI_Comm         comm;
+  PetscMPIInt      rank,size;
+  Vec              key,tkey;
+  PetscScalar      *ka,*ta;
+  const PetscInt   *perm_ix;
+  const PetscInt   nloc = Gmat->rmap->n;
+  PetscInt         my0,Iend,kk,lid,j,nremoved = 0,nselected = 0,nundone,iter = 0,nsingle = 0,t1[3],t2[3];
+  PetscInt         *agg,*d_nnz,*o_nnz;
+  PetscReal        M,*lkey;
+  PetscBool        *removed;
+  Mat              aggmat;
+  PetscCoarsenData *agg_lists;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+  } else {
+    PetscBool isAIJ;
+    ierr = PetscObjectTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ(comm,PETSC_ERR_SUP,"MIS-2 coarsening requires an AIJ graph");
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+
+  /* keys: deleted 0, undecided M + p, selected 2M + p, with unique p in [1,M) */
+  ierr = MPI_Allreduce((void*)&nloc,&kk,1,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  M    = (PetscReal)(kk*size + 1);
+  ierr = PetscMalloc3(nloc,PetscReal,&lkey,nloc,PetscInt,&agg,nloc,PetscBool,&removed);CHKERRQ(ierr);
+  ierr = ISGetIndices(perm, &perm_ix);CHKERRQ(ierr);
+  for (kk=0; kk<nloc; kk++) {
+    PetscInt nadj = 0;
+    lid  = perm_ix[kk];
+    for (j=matA->i[lid]; j<matA->i[lid+1]; j++) if (matA->j[j] != lid) nadj++;
+    if (matB) nadj += matB->i[lid+1] - matB->i[lid];
+    removed[lid] = (PetscBool)(nadj == 0); /* singleton, not aggregated */
+    if (removed[lid]) nremoved++;
+    lkey[lid] = removed[lid] ? 0. : M + (PetscReal)(kk*size + rank + 1);
+  }
+  ierr = ISRestoreIndices(perm,&perm_ix);CHKERRQ(ierr);
+
+  ierr = MatGetVecs(Gmat,&key,NULL);CHKERRQ(ierr);
+  ierr = VecDuplicate(key,&tkey);CHKERRQ(ierr);
+  /* MIS-2 */
+  do {
+    iter++;
+    ierr = VecGetArray(key,&ka);CHKERRQ(ierr);
+    for (lid=0; lid<nloc; lid++) ka[lid] = lkey[lid];
+    ierr = VecRestoreArray(key,&ka);CHKERRQ(ierr);
+    ierr = maxAdj(Gmat,key,tkey);CHKERRQ(ierr);
+    ierr = maxAdj(Gmat,tkey,key);CHKERRQ(ierr);
+    ierr = VecGetArray(key,&ka);CHKERRQ(ierr);
+    for (lid=0,nundone=0; lid<nloc; lid++) {
+      PetscReal k2 = PetscRealPart(ka[lid]);
+      if (lkey[lid] <= 0. || lkey[lid] >= 2.*M) continue; /* done */
+      if (k2 == lkey[lid]) {                          /* largest key within distance 2: select */
+        lkey[lid] += M;
+        nselected++;
+      } else if (k2 >= 2.*M) lkey[lid] = 0.;          /* selected vertex within distance 2: delete */
+      else nundone++;
+    }
+    ierr = VecRestoreArray(key,&ka);CHKERRQ(ierr);
+    ierr = MPI_Allreduce(&nundone,&kk,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  } while (kk);
+
+  /* aggregate: selected vertices, then distance 1 and distance 2 vertices to their strongest neighbor */
+  ierr = VecGetArray(key,&ka);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    agg[lid] = (lkey[lid] >= 2.*M) ? my0 + lid : -1;
+    ka[lid]  = (PetscScalar)agg[lid];
+  }
+  ierr = VecRestoreArray(key,&ka);CHKERRQ(ierr);
+  ierr = strongestAdj(Gmat,key,agg);CHKERRQ(ierr);
+  ierr = VecGetArray(tkey,&ta);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) ta[lid] = (PetscScalar)agg[lid];
+  ierr = VecRestoreArray(tkey,&ta);CHKERRQ(ierr);
+  ierr = strongestAdj(Gmat,tkey,agg);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    if (removed[lid]) agg[lid] = -1;
+    else if (agg[lid] < 0) { /* only connected to removed vertices, keep it alone */
+      agg[lid] = my0 + lid;
+      nsingle++;
+    }
+  }
+  ierr = VecDestroy(&tkey);CHKERRQ(ierr);
+
+  /* collect the aggregates on the processes of their selected vertices, preallocated with the sizes of the aggregates */
+  ierr = PetscMalloc2(nloc,PetscInt,&d_nnz,nloc,PetscInt,&o_nnz);CHKERRQ(ierr);
+  ierr = PetscMemzero(d_nnz,nloc*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = VecSet(key,0.0);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    if (agg[lid] >= my0 && agg[lid] < Iend) d_nnz[agg[lid]-my0]++;
+    else if (agg[lid] >= 0) { /* a member of an aggregate of another process */
+      PetscScalar one = 1.0;
+      ierr = VecSetValues(key,1,&agg[lid],&one,ADD_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecAssemblyBegin(key);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(key);CHKERRQ(ierr);
+  ierr = VecGetArray(key,&ka);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) o_nnz[lid] = (PetscInt)PetscRealPart(ka[lid]);
+  ierr = VecRestoreArray(key,&ka);CHKERRQ(ierr);
+  ierr = VecDestroy(&key);CHKERRQ(ierr);
+  ierr = MatCreateAIJ(comm,nloc,nloc,PETSC_DETERMINE,PETSC_DETERMINE,0,d_nnz,0,o_nnz,&aggmat);CHKERRQ(ierr);
+  ierr = PetscFree2(d_nnz,o_nnz);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    if (agg[lid] >= 0) {
+      PetscInt    gid = my0 + lid;
+      PetscScalar one = 1.0;
+      ierr = MatSetValues(aggmat,1,&agg[lid],1,&gid,&one,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(aggmat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(aggmat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = PetscCDCreate(nloc, &agg_lists);CHKERRQ(ierr);
+  *a_locals_llist = agg_lists;
+  for (lid=0; lid<nloc; lid++) {
+    PetscInt       ncols,gid = my0 + lid;
+    const PetscInt *cols;
+    ierr = MatGetRow(aggmat,gid,&ncols,&cols,NULL);CHKERRQ(ierr);
+    for (j=0; j<ncols; j++) {
+      ierr = PetscCDAppendID(agg_lists, lid, cols[j]);CHKERRQ(ierr);
+    }
+    ierr = MatRestoreRow(aggmat,gid,&ncols,&cols,NULL);CHKERRQ(ierr);
+  }
+  if (size > 1) {
+    ierr = PetscCDSetMat(agg_lists, aggmat);CHKERRQ(ierr); /* ghosts of the aggregates, replaces the graph */
+  } else {
+    ierr = MatDestroy(&aggmat);CHKERRQ(ierr);
+  }
+
+  if (verbose) {
+    t1[0] = nremoved; t1[1] = nselected + nsingle; t1[2] = nsingle;
+    ierr  = MPI_Allreduce(t1,t2,3,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    ierr  = MatGetSize(Gmat,&kk,&j);CHKERRQ(ierr);
+    ierr  = PetscPrintf(comm,"\t[%d]%s removed %d of %d vertices, %d aggregates (%d singletons) in %d rounds\n",rank,__FUNCT__,t2[0],kk,t2[1],t2[2],iter);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(lkey,agg,removed);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+typedef struct {
+  int dummy;
+} MatCoarsen_MIS2;
+/*
+   MIS-2 coarsen
+*/
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenApply_MIS2"
+static PetscErrorCode MatCoarsenApply_MIS2(MatCoarsen coarse)
+{
+  PetscErrorCode ierr;
+  Mat            mat = coarse->graph;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  if (!coarse->strict_aggs) SETERRQ(PetscObjectComm((PetscObject)coarse),PETSC_ERR_SUP,"MIS-2 coarsening makes strict aggregates only");
+  if (!coarse->perm) {
+    IS       perm;
+    PetscInt n,m;
+
+    ierr = MatGetLocalSize(mat, &m, &n);CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_SELF, m, 0, 1, &perm);CHKERRQ(ierr);
+    ierr = maxIndSet2Agg(perm, mat, coarse->verbose, &coarse->agg_lists);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  } else {
+    ierr = maxIndSet2Agg(coarse->perm, mat, coarse->verbose, &coarse->agg_lists);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenView_MIS2"
+PetscErrorCode MatCoarsenView_MIS2(MatCoarsen coarse,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)coarse),&rank);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] MIS-2 aggregator\n",rank);CHKERRQ(ierr);
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedAllow(viewer,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenDestroy_MIS2"
+PetscErrorCode MatCoarsenDestroy_MIS2(MatCoarsen coarse)
+{
+  MatCoarsen_MIS2 *MIS2 = (MatCoarsen_MIS2*)coarse->subctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscFree(MIS2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENMIS2 - Creates a coarsen context that aggregates around a distance 2 maximal independent set
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  coarse - the coarsen context
+
+   Notes:
+   The independent set is computed on the graph itself, with two neighbor exchanges per round, so unlike
+   MATCOARSENMIS on a squared graph the product A^T A is never formed.  Only strict aggregates
+   (MatCoarsenSetStrictAggs()) are supported.
+
+   Level: beginner
+
+.keywords: Coarsen, create, context
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MATCOARSENMIS, MATCOARSENPAIRWISE
+
+M*/
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenCreate_MIS2"
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS2(MatCoarsen coarse)
+{
+  PetscErrorCode  ierr;
+  MatCoarsen_MIS2 *MIS2;
+
+  PetscFunctionBegin;
+  ierr           = PetscNewLog(coarse, MatCoarsen_MIS2, &MIS2);CHKERRQ(ierr);
+  coarse->subctx = (void*)MIS2;
+
+  coarse->ops->apply   = MatCoarsenApply_MIS2;
+  coarse->ops->view    = MatCoarsenView_MIS2;
+  coarse->ops->destroy = MatCoarsenDestroy_MIS2;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,263 @@
+#include <petsc-private/matimpl.h>    /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+typedef struct {
+  PetscInt npasses;  /* number of pairwise matching passes, 2 for double pairwise aggregation */
+} MatCoarsen_Pairwise;
+
+/* -------------------------------------------------------------------------- */
+/*
+   pairwiseAgg - repeated pairwise matching of the aggregates along their strongest connection, process local.
+     MatAIJ specific!!!
+
+   The first pass matches vertices, in the order of perm, with their strongest unmatched neighbor.  Each
+   further pass matches the aggregates of the previous pass in the same way, with the sum of the connections
+   between their members as the strength, so npasses passes give aggregates of up to 2^npasses vertices.
+   Only the diagonal block is used so the aggregates never cross processes.
+
+   Input Parameter:
+   . perm - serial permutation of rows of local to process
+   . Gmat - glabal matrix of graph
+   . npasses - number of matching passes
+   . verbose -
+   Output Parameter:
+   . a_locals_llist - array of list of global ids of nodes rooted at the first member of each aggregate
+*/
+#undef __FUNCT__
+#define __FUNCT__ "pairwiseAgg"
+static PetscErrorCode pairwiseAgg(IS perm,Mat Gmat,PetscInt npasses,PetscInt verbose,PetscCoarsenData **a_locals_llist)
+{
+  PetscErrorCode   ierr;
+  PetscBool        isMPI;
+  Mat_SeqAIJ       *matA,*matB = NULL;
+  MPI_Comm         comm;
+  PetscMPIInt      rank;
+  const PetscInt   *perm_ix;
+  const PetscInt   nloc = Gmat->rmap->n;
+  PetscInt         my0,Iend,kk,lid,j,a,b,v,best,pass,nagg = 0,nnew,ntouched,nremoved = 0,t1[2],t2[2];
+  PetscInt         *aggid,*head,*tail,*next,*newid,*nhead,*ntail,*touched;
+  PetscReal        *w,wbest;
+  PetscCoarsenData *agg_lists;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    Mat_MPIAIJ *mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA = (Mat_SeqAIJ*)mpimat->A->data;
+    matB = (Mat_SeqAIJ*)mpimat->B->data;
+  } else {
+    PetscBool isAIJ;
+    ierr = PetscObjectTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ(comm,PETSC_ERR_SUP,"Pairwise coarsening requires an AIJ graph");
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+  ierr = PetscMalloc5(nloc,PetscInt,&aggid,nloc,PetscInt,&head,nloc,PetscInt,&tail,nloc,PetscInt,&next,nloc,PetscInt,&newid);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nloc,PetscInt,&nhead,nloc,PetscInt,&ntail,nloc,PetscInt,&touched,nloc,PetscReal,&w);CHKERRQ(ierr);
+
+  /* vertices without any neighbors are removed (-2), not aggregated */
+  for (lid=0; lid<nloc; lid++) {
+    PetscInt nadj = 0;
+    for (j=matA->i[lid]; j<matA->i[lid+1]; j++) if (matA->j[j] != lid) nadj++;
+    if (matB) nadj += matB->i[lid+1] - matB->i[lid];
+    aggid[lid] = nadj ? -1 : -2;
+    if (!nadj) nremoved++;
+    next[lid] = -1;
+  }
+
+  /* first pass: match vertices */
+  ierr = ISGetIndices(perm, &perm_ix);CHKERRQ(ierr);
+  for (kk=0; kk<nloc; kk++) {
+    lid = perm_ix[kk];
+    if (aggid[lid] != -1) continue;
+    best = -1; wbest = -1.;
+    for (j=matA->i[lid]; j<matA->i[lid+1]; j++) {
+      PetscInt  cid = matA->j[j];
+      PetscReal wj  = PetscAbsScalar(matA->a[j]);
+      if (cid != lid && aggid[cid] == -1 && wj > wbest) {best = cid; wbest = wj;}
+    }
+    aggid[lid] = nagg; head[nagg] = tail[nagg] = lid;
+    if (best >= 0) {
+      aggid[best] = nagg; next[lid] = best; tail[nagg] = best;
+    }
+    nagg++;
+  }
+  ierr = ISRestoreIndices(perm,&perm_ix);CHKERRQ(ierr);
+
+  /* further passes: match aggregates, in the order they were made */
+  for (a=0; a<nloc; a++) w[a] = -1.;
+  for (pass=1; pass<npasses; pass++) {
+    for (a=0; a<nagg; a++) newid[a] = -1;
+    for (a=0,nnew=0; a<nagg; a++) {
+      if (newid[a] >= 0) continue;
+      ntouched = 0;
+      for (v=head[a]; v>=0; v=next[v]) {
+        for (j=matA->i[v]; j<matA->i[v+1]; j++) {
+          b = aggid[matA->j[j]];
+          if (b < 0 || b == a || newid[b] >= 0) continue;
+          if (w[b] < 0.) {w[b] = 0.; touched[ntouched++] = b;}
+          w[b] += PetscAbsScalar(matA->a[j]);
+        }
+      }
+      best = -1; wbest = -1.;
+      for (kk=0; kk<ntouched; kk++) {
+        b = touched[kk];
+        if (w[b] > wbest) {best = b; wbest = w[b];}
+        w[b] = -1.;
+      }
+      newid[a]    = nnew;
+      nhead[nnew] = head[a]; ntail[nnew] = tail[a];
+      if (best >= 0) {
+        newid[best] = nnew;
+        next[tail[a]] = head[best]; ntail[nnew] = tail[best];
+      }
+      nnew++;
+    }
+    for (lid=0; lid<nloc; lid++) if (aggid[lid] >= 0) aggid[lid] = newid[aggid[lid]];
+    for (a=0; a<nnew; a++) {head[a] = nhead[a]; tail[a] = ntail[a];}
+    if (nnew == nagg) break; /* nothing matched */
+    nagg = nnew;
+  }
+
+  /* the first member is the root of the aggregate */
+  ierr = PetscCDCreate(nloc, &agg_lists);CHKERRQ(ierr);
+  *a_locals_llist = agg_lists;
+  for (a=0; a<nagg; a++) {
+    for (v=head[a]; v>=0; v=next[v]) {
+      ierr = PetscCDAppendID(agg_lists, head[a], my0+v);CHKERRQ(ierr);
+    }
+  }
+
+  if (verbose) {
+    t1[0] = nremoved; t1[1] = nagg;
+    ierr  = MPI_Allreduce(t1,t2,2,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    ierr  = MatGetSize(Gmat,&kk,&j);CHKERRQ(ierr);
+    ierr  = PetscPrintf(comm,"\t[%d]%s removed %d of %d vertices, %d aggregates after %d passes\n",rank,__FUNCT__,t2[0],kk,t2[1],npasses);CHKERRQ(ierr);
+  }
+  ierr = PetscFree5(aggid,head,tail,next,newid);CHKERRQ(ierr);
+  ierr = PetscFree4(nhead,ntail,touched,w);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Pairwise coarsen
+*/
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenApply_Pairwise"
+static PetscErrorCode MatCoarsenApply_Pairwise(MatCoarsen coarse)
+{
+  PetscErrorCode      ierr;
+  Mat                 mat       = coarse->graph;
+  MatCoarsen_Pairwise *pairwise = (MatCoarsen_Pairwise*)coarse->subctx;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  if (!coarse->strict_aggs) SETERRQ(PetscObjectComm((PetscObject)coarse),PETSC_ERR_SUP,"Pairwise coarsening makes strict aggregates only");
+  if (!coarse->perm) {
+    IS       perm;
+    PetscInt n,m;
+
+    ierr = MatGetLocalSize(mat, &m, &n);CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_SELF, m, 0, 1, &perm);CHKERRQ(ierr);
+    ierr = pairwiseAgg(perm, mat, pairwise->npasses, coarse->verbose, &coarse->agg_lists);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  } else {
+    ierr = pairwiseAgg(coarse->perm, mat, pairwise->npasses, coarse->verbose, &coarse->agg_lists);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenSetFromOptions_Pairwise"
+static PetscErrorCode MatCoarsenSetFromOptions_Pairwise(MatCoarsen coarse)
+{
+  PetscErrorCode      ierr;
+  MatCoarsen_Pairwise *pairwise = (MatCoarsen_Pairwise*)coarse->subctx;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead("Pairwise coarsening options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_coarsen_pairwise_passes","Number of pairwise matching passes (2: double pairwise aggregation)","None",pairwise->npasses,&pairwise->npasses,NULL);CHKERRQ(ierr);
+  if (pairwise->npasses < 1) SETERRQ1(PetscObjectComm((PetscObject)coarse),PETSC_ERR_ARG_OUTOFRANGE,"Number of passes %D must be positive",pairwise->npasses);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenView_Pairwise"
+PetscErrorCode MatCoarsenView_Pairwise(MatCoarsen coarse,PetscViewer viewer)
+{
+  PetscErrorCode      ierr;
+  MatCoarsen_Pairwise *pairwise = (MatCoarsen_Pairwise*)coarse->subctx;
+  PetscMPIInt         rank;
+  PetscBool           iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)coarse),&rank);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] pairwise aggregator, %D passes\n",rank,pairwise->npasses);CHKERRQ(ierr);
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedAllow(viewer,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenDestroy_Pairwise"
+PetscErrorCode MatCoarsenDestroy_Pairwise(MatCoarsen coarse)
+{
+  MatCoarsen_Pairwise *pairwise = (MatCoarsen_Pairwise*)coarse->subctx;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscFree(pairwise);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENPAIRWISE - Creates a coarsen context that aggregates by repeated pairwise matching
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  coarse - the coarsen context
+
+   Options Database Keys:
+.  -mat_coarsen_pairwise_passes <2> - number of matching passes, aggregates have at most 2^passes vertices
+
+   Notes:
+   Each pass matches every aggregate with its strongest connected unmatched neighbor; the default of two
+   passes is the double pairwise aggregation of Notay's AGMG.  The aggregates are local to each process.
+   Only strict aggregates (MatCoarsenSetStrictAggs()) are supported.
+
+   Level: beginner
+
+.keywords: Coarsen, create, context
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MATCOARSENMIS, MATCOARSENMIS2
+
+M*/
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenCreate_Pairwise"
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_Pairwise(MatCoarsen coarse)
+{
+  PetscErrorCode      ierr;
+  MatCoarsen_Pairwise *pairwise;
+
+  PetscFunctionBegin;
+  ierr              = PetscNewLog(coarse, MatCoarsen_Pairwise, &pairwise);CHKERRQ(ierr);
+  pairwise->npasses = 2;
+  coarse->subctx    = (void*)pairwise;
+
+  coarse->ops->apply          = MatCoarsenApply_Pairwise;
+  coarse->ops->setfromoptions = MatCoarsenSetFromOptions_Pairwise;
+  coarse->ops->view           = MatCoarsenView_Pairwise;
+  coarse->ops->destroy        = MatCoarsenDestroy_Pairwise;
+  PetscFunctionReturn(0);
+}
@@ -3,6 +3,8 @@
 
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS(MatCoarsen);
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_HEM(MatCoarsen);
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS2(MatCoarsen);
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_Pairwise(MatCoarsen);
 
 #undef __FUNCT__
 #define __FUNCT__ "MatCoarsenRegisterAll"
@@ -37,6 +39,8 @@ PetscErrorCode  MatCoarsenRegisterAll(void)
 
   ierr = MatCoarsenRegister(MATCOARSENMIS,MatCoarsenCreate_MIS);CHKERRQ(ierr);
   ierr = MatCoarsenRegister(MATCOARSENHEM,MatCoarsenCreate_HEM);CHKERRQ(ierr);
+  ierr = MatCoarsenRegister(MATCOARSENMIS2,MatCoarsenCreate_MIS2);CHKERRQ(ierr);
+  ierr = MatCoarsenRegister(MATCOARSENPAIRWISE,MatCoarsenCreate_Pairwise);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
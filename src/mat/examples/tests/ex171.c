@@ -0,0 +1,183 @@
+static char help[] = "Compares the -matmatmult_via and -matptap_via algorithms for SeqAIJ matrices on algebraic multigrid-like operators.\n\
+  -m <m>          : number of grid points in each direction\n\
+  -dim <d>        : spatial dimension, 2 or 3\n\
+  -box            : use a box stencil (9 or 27 points) instead of a star stencil\n\
+  -agg <a>        : aggregate size in each direction for the tentative prolongator\n\
+  -smooth         : smooth the tentative prolongator with one damped Jacobi step, as smoothed aggregation does\n\
+  -nrepeat <n>    : number of numeric products to time for each algorithm\n\
+  -print_times    : print the timings (omit for reproducible output)\n\n";
+
+/*
+   Example of usage: ./ex171 -m 60 -dim 3 -box -smooth -nrepeat 5 -print_times
+*/
+
+#include <petscdmda.h>
+#include <petsctime.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "CreateProlongator"
+/* Piecewise constant interpolation from aggregates of agg^dim grid points, optionally smoothed with P = (I - 2/3 D^{-1} A) P */
+static PetscErrorCode CreateProlongator(DM da,Mat A,PetscInt agg,PetscBool smooth,Mat *P)
+{
+  PetscErrorCode ierr;
+  PetscInt       dim,M,N,K,Mc,Nc,Kc,i,j,k,row,col;
+  Mat            Pt,DA;
+  Vec            diag;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetInfo(da,&dim,&M,&N,&K,0,0,0,0,0,0,0,0,0);CHKERRQ(ierr);
+  Mc   = (M+agg-1)/agg; Nc = (N+agg-1)/agg; Kc = dim == 3 ? (K+agg-1)/agg : 1;
+  if (dim == 2) K = 1;
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,M*N*K,Mc*Nc*Kc,1,NULL,&Pt);CHKERRQ(ierr);
+  for (k=0; k<K; k++) {
+    for (j=0; j<N; j++) {
+      for (i=0; i<M; i++) {
+        row  = i + M*(j + N*k);
+        col  = i/agg + Mc*(j/agg + Nc*(k/agg));
+        ierr = MatSetValue(Pt,row,col,1.0,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(Pt,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(Pt,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (!smooth) {
+    *P = Pt;
+    PetscFunctionReturn(0);
+  }
+  ierr = MatDuplicate(A,MAT_COPY_VALUES,&DA);CHKERRQ(ierr);
+  ierr = MatGetVecs(A,&diag,NULL);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,diag);CHKERRQ(ierr);
+  ierr = VecReciprocal(diag);CHKERRQ(ierr);
+  ierr = MatDiagonalScale(DA,diag,NULL);CHKERRQ(ierr);
+  ierr = MatScale(DA,-2.0/3.0);CHKERRQ(ierr);
+  ierr = MatShift(DA,1.0);CHKERRQ(ierr);
+  ierr = MatMatMult(DA,Pt,MAT_INITIAL_MATRIX,2.0,P);CHKERRQ(ierr);
+  ierr = VecDestroy(&diag);CHKERRQ(ierr);
+  ierr = MatDestroy(&DA);CHKERRQ(ierr);
+  ierr = MatDestroy(&Pt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "RunProduct"
+/* Computes C = A*P (ptap false) or C = P^T*A*P (ptap true) with the algorithm selected by option=value, and compares it with Cref */
+static PetscErrorCode RunProduct(Mat A,Mat P,PetscBool ptap,const char option[],const char value[],PetscInt nrepeat,PetscBool print_times,Mat Cref)
+{
+  PetscErrorCode ierr;
+  Mat            C;
+  PetscLogDouble t0,t1,t2;
+  PetscReal      norm;
+  PetscInt       i;
+  MatInfo        info;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsSetValue(option,value);CHKERRQ(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  if (ptap) {
+    ierr = MatPtAP(A,P,MAT_INITIAL_MATRIX,2.0,&C);CHKERRQ(ierr);
+  } else {
+    ierr = MatMatMult(A,P,MAT_INITIAL_MATRIX,2.0,&C);CHKERRQ(ierr);
+  }
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<nrepeat; i++) {
+    if (ptap) {
+      ierr = MatPtAP(A,P,MAT_REUSE_MATRIX,2.0,&C);CHKERRQ(ierr);
+    } else {
+      ierr = MatMatMult(A,P,MAT_REUSE_MATRIX,2.0,&C);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  ierr = PetscOptionsClearValue(option);CHKERRQ(ierr);
+
+  ierr = MatGetInfo(C,MAT_LOCAL,&info);CHKERRQ(ierr);
+  ierr = MatAXPY(C,-1.0,Cref,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(C,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"%s %-14s nnz %8D %s",option,value,(PetscInt)info.nz_used,norm < 1.e-10 ? "ok" : "wrong");CHKERRQ(ierr);
+  if (print_times) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"  first %9.3e numeric %9.3e",t1-t0,nrepeat ? (t2-t1)/nrepeat : 0.0);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_SELF,"\n");CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+  PetscInt       m=20,dim=2,agg=3,nrepeat=3,i,am,pn;
+  PetscBool      box=PETSC_FALSE,smooth=PETSC_FALSE,print_times=PETSC_FALSE;
+  DM             da;
+  Mat            A,P,AP,PtAP;
+  MatInfo        info;
+  const char     *mmTypes[]   = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","hash"};
+  const char     *ptapTypes[] = {"scalable","nonscalable","hash"};
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  if (size != 1) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_SUP,"This is a uniprocessor example only");
+  ierr = PetscOptionsGetInt(NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-dim",&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-agg",&agg,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-nrepeat",&nrepeat,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-box",&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-smooth",&smooth,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-print_times",&print_times,NULL);CHKERRQ(ierr);
+
+  /* the fine grid operator; only its nonzero structure and diagonal matter for the products */
+  if (dim == 2) {
+    ierr = DMDACreate2d(PETSC_COMM_WORLD,DMDA_BOUNDARY_NONE,DMDA_BOUNDARY_NONE,box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR,m,m,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&da);CHKERRQ(ierr);
+  } else if (dim == 3) {
+    ierr = DMDACreate3d(PETSC_COMM_WORLD,DMDA_BOUNDARY_NONE,DMDA_BOUNDARY_NONE,DMDA_BOUNDARY_NONE,box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR,m,m,m,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+  } else SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"Dimension %D must be 2 or 3",dim);
+  ierr = DMSetMatType(da,MATAIJ);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&A);CHKERRQ(ierr);
+  {
+    PetscInt          row,ncols,j;
+    const PetscInt    *cols;
+    const PetscScalar *vals;
+    PetscScalar       *v;
+    Mat               B;
+
+    /* assign -1 to the off-diagonal entries of each row and the number of entries in the row to the diagonal */
+    ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&B);CHKERRQ(ierr);
+    ierr = PetscMalloc(125*sizeof(PetscScalar),&v);CHKERRQ(ierr);
+    ierr = MatGetSize(A,&am,NULL);CHKERRQ(ierr);
+    for (row=0; row<am; row++) {
+      ierr = MatGetRow(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+      for (j=0; j<ncols; j++) v[j] = (cols[j] == row) ? (PetscScalar)ncols : -1.0;
+      ierr = MatSetValues(B,1,&row,ncols,cols,v,INSERT_VALUES);CHKERRQ(ierr);
+      ierr = MatRestoreRow(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(v);CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatDestroy(&A);CHKERRQ(ierr);
+    A    = B;
+  }
+  ierr = CreateProlongator(da,A,agg,smooth,&P);CHKERRQ(ierr);
+  ierr = MatGetSize(P,NULL,&pn);CHKERRQ(ierr);
+  ierr = MatGetInfo(P,MAT_LOCAL,&info);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"A: %D rows; P: %D columns, %D nonzeros\n",am,pn,(PetscInt)info.nz_used);CHKERRQ(ierr);
+
+  /* reference products with the default algorithms */
+  ierr = MatMatMult(A,P,MAT_INITIAL_MATRIX,2.0,&AP);CHKERRQ(ierr);
+  ierr = MatPtAP(A,P,MAT_INITIAL_MATRIX,2.0,&PtAP);CHKERRQ(ierr);
+
+  for (i=0; i<(PetscInt)(sizeof(mmTypes)/sizeof(mmTypes[0])); i++) {
+    ierr = RunProduct(A,P,PETSC_FALSE,"-matmatmult_via",mmTypes[i],nrepeat,print_times,AP);CHKERRQ(ierr);
+  }
+  for (i=0; i<(PetscInt)(sizeof(ptapTypes)/sizeof(ptapTypes[0])); i++) {
+    ierr = RunProduct(A,P,PETSC_TRUE,"-matptap_via",ptapTypes[i],nrepeat,print_times,PtAP);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&AP);CHKERRQ(ierr);
+  ierr = MatDestroy(&PtAP);CHKERRQ(ierr);
+  ierr = MatDestroy(&P);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
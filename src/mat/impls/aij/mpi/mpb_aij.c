@@ -69,13 +69,10 @@ PetscErrorCode  MatGetMultiProcBlock_MPIAIJ(Mat mat, MPI_Comm subComm, MatReuse
 
     ierr = PetscObjectReference((PetscObject)aij->A);CHKERRQ(ierr);
   } else if (((Mat_MPIAIJ*)(*subMat)->data)->A != aij->A) {
-    PetscObject obj = (PetscObject)((Mat_MPIAIJ*)((*subMat)->data))->A;
-
-    ierr = PetscObjectReference((PetscObject)obj);CHKERRQ(ierr);
+    ierr = PetscObjectReference((PetscObject)aij->A);CHKERRQ(ierr);
+    ierr = MatDestroy(&((Mat_MPIAIJ*)((*subMat)->data))->A);CHKERRQ(ierr);
 
     ((Mat_MPIAIJ*)((*subMat)->data))->A = aij->A;
-
-    ierr = PetscObjectReference((PetscObject)aij->A);CHKERRQ(ierr);
   }
 
   /* Now traverse aij->B and insert values into subMat */
@@ -27,6 +27,7 @@ typedef struct { /* used by MatPtAP_MPIAIJ_MPIAIJ() and MatMatMult_MPIAIJ_MPIAIJ
   Mat         A_loc;           /* used by MatTransposeMatMult(), contains api and apj */
   Mat         Pt;              /* used by MatTransposeMatMult(), Pt = P^T */
   PetscBool   scalable;        /* flag determines scalable or non-scalable implementation */
+  PetscBool   allatonce;       /* flag for the all-at-once MatPtAP(), which stores neither A*P nor P^T */
 
   Mat_Merge_SeqsToMPI *merge;
   PetscErrorCode (*destroy)(Mat);
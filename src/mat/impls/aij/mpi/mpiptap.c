@@ -8,6 +8,7 @@
 #include <../src/mat/utils/freespace.h>
 #include <../src/mat/impls/aij/mpi/mpiaij.h>
 #include <petscbt.h>
+#include <../src/sys/utils/hash.h>
 #include <petsctime.h>
 
 /* #define PTAP_PROFILE */
@@ -71,6 +72,523 @@ PetscErrorCode MatDuplicate_MPIAIJ_MatPtAP(Mat A, MatDuplicateOption op, Mat *M)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "MatPtAPSymbolicSendCo_MPIAIJ_Private"
+/*
+   Sends the structure of Co = (p->B)^T*A*P, the rows of C owned by other processors, to their owners.
+   The message pattern and the received structure are kept in merge for MatPtAPNumericSendCo_MPIAIJ_Private().
+*/
+static PetscErrorCode MatPtAPSymbolicSendCo_MPIAIJ_Private(Mat P,PetscInt *coi,PetscInt *coj,Mat_Merge_SeqsToMPI *merge)
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *p=(Mat_MPIAIJ*)P->data;
+  PetscInt       *prmap=p->garray,pon=(p->B)->cmap->n,pn=P->cmap->n;
+  PetscInt       *owners,*owners_co,**buf_rj,**buf_ri,*buf_s,*buf_si,*buf_si_i;
+  PetscInt       i,k,len,proc,nrows,nzi;
+  MPI_Comm       comm;
+  PetscMPIInt    size,tagi,tagj,*len_si,*len_s,*len_ri,icompleted=0;
+  MPI_Request    *swaits,*rwaits;
+  MPI_Status     *sstatus,rstatus;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)P,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+
+  /* determine row ownership */
+  ierr = PetscLayoutCreate(comm,&merge->rowmap);CHKERRQ(ierr);
+  merge->rowmap->n  = pn;
+  merge->rowmap->bs = 1;
+
+  ierr   = PetscLayoutSetUp(merge->rowmap);CHKERRQ(ierr);
+  owners = merge->rowmap->range;
+
+  /* determine the number of messages to send, their lengths */
+  ierr = PetscMalloc2(size,PetscMPIInt,&len_si,size,MPI_Status,&sstatus);CHKERRQ(ierr);
+  ierr = PetscMemzero(len_si,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
+  ierr = PetscMalloc(size*sizeof(PetscMPIInt),&merge->len_s);CHKERRQ(ierr);
+
+  len_s        = merge->len_s;
+  merge->nsend = 0;
+
+  ierr = PetscMalloc((size+2)*sizeof(PetscInt),&owners_co);CHKERRQ(ierr);
+  ierr = PetscMemzero(len_s,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
+
+  proc = 0;
+  for (i=0; i<pon; i++) {
+    while (prmap[i] >= owners[proc+1]) proc++;
+    len_si[proc]++;  /* num of rows in Co to be sent to [proc] */
+    len_s[proc] += coi[i+1] - coi[i];
+  }
+
+  len          = 0; /* max length of buf_si[] */
+  owners_co[0] = 0;
+  for (proc=0; proc<size; proc++) {
+    owners_co[proc+1] = owners_co[proc] + len_si[proc];
+    if (len_si[proc]) {
+      merge->nsend++;
+      len_si[proc] = 2*(len_si[proc] + 1);
+      len         += len_si[proc];
+    }
+  }
+
+  /* determine the number and length of messages to receive for coi and coj  */
+  ierr = PetscGatherNumberOfMessages(comm,NULL,len_s,&merge->nrecv);CHKERRQ(ierr);
+  ierr = PetscGatherMessageLengths2(comm,merge->nsend,merge->nrecv,len_s,len_si,&merge->id_r,&merge->len_r,&len_ri);CHKERRQ(ierr);
+
+  /* post the Irecv and Isend of coj */
+  ierr = PetscCommGetNewTag(comm,&tagj);CHKERRQ(ierr);
+  ierr = PetscPostIrecvInt(comm,tagj,merge->nrecv,merge->id_r,merge->len_r,&buf_rj,&rwaits);CHKERRQ(ierr);
+  ierr = PetscMalloc((merge->nsend+1)*sizeof(MPI_Request),&swaits);CHKERRQ(ierr);
+  for (proc=0, k=0; proc<size; proc++) {
+    if (!len_s[proc]) continue;
+    i    = owners_co[proc];
+    ierr = MPI_Isend(coj+coi[i],len_s[proc],MPIU_INT,proc,tagj,comm,swaits+k);CHKERRQ(ierr);
+    k++;
+  }
+
+  /* receives and sends of coj are complete */
+  for (i=0; i<merge->nrecv; i++) {
+    ierr = MPI_Waitany(merge->nrecv,rwaits,&icompleted,&rstatus);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(rwaits);CHKERRQ(ierr);
+  if (merge->nsend) {ierr = MPI_Waitall(merge->nsend,swaits,sstatus);CHKERRQ(ierr);}
+
+  /* send and recv coi */
+  /*-------------------*/
+  ierr   = PetscCommGetNewTag(comm,&tagi);CHKERRQ(ierr);
+  ierr   = PetscPostIrecvInt(comm,tagi,merge->nrecv,merge->id_r,len_ri,&buf_ri,&rwaits);CHKERRQ(ierr);
+  ierr   = PetscMalloc((len+1)*sizeof(PetscInt),&buf_s);CHKERRQ(ierr);
+  buf_si = buf_s;  /* points to the beginning of k-th msg to be sent */
+  for (proc=0,k=0; proc<size; proc++) {
+    if (!len_s[proc]) continue;
+    /* form outgoing message for i-structure:
+         buf_si[0]:                 nrows to be sent
+               [1:nrows]:           row index (global)
+               [nrows+1:2*nrows+1]: i-structure index
+    */
+    /*-------------------------------------------*/
+    nrows       = len_si[proc]/2 - 1;
+    buf_si_i    = buf_si + nrows+1;
+    buf_si[0]   = nrows;
+    buf_si_i[0] = 0;
+    nrows       = 0;
+    for (i=owners_co[proc]; i<owners_co[proc+1]; i++) {
+      nzi = coi[i+1] - coi[i];
+
+      buf_si_i[nrows+1] = buf_si_i[nrows] + nzi; /* i-structure */
+      buf_si[nrows+1]   = prmap[i] -owners[proc]; /* local row index */
+      nrows++;
+    }
+    ierr = MPI_Isend(buf_si,len_si[proc],MPIU_INT,proc,tagi,comm,swaits+k);CHKERRQ(ierr);
+    k++;
+    buf_si += len_si[proc];
+  }
+  i = merge->nrecv;
+  while (i--) {
+    ierr = MPI_Waitany(merge->nrecv,rwaits,&icompleted,&rstatus);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(rwaits);CHKERRQ(ierr);
+  if (merge->nsend) {ierr = MPI_Waitall(merge->nsend,swaits,sstatus);CHKERRQ(ierr);}
+
+  ierr = PetscFree2(len_si,sstatus);CHKERRQ(ierr);
+  ierr = PetscFree(len_ri);CHKERRQ(ierr);
+  ierr = PetscFree(swaits);CHKERRQ(ierr);
+  ierr = PetscFree(buf_s);CHKERRQ(ierr);
+
+  merge->buf_ri    = buf_ri;
+  merge->buf_rj    = buf_rj;
+  merge->owners_co = owners_co;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatPtAPNumericSendCo_MPIAIJ_Private"
+/*
+   Sends the values coa of Co to their owners, then inserts the local rows ba of C together with the received values into C
+*/
+static PetscErrorCode MatPtAPNumericSendCo_MPIAIJ_Private(Mat C,MatScalar *coa,MatScalar *ba)
+{
+  PetscErrorCode      ierr;
+  Mat_MPIAIJ          *c=(Mat_MPIAIJ*)C->data;
+  Mat_Merge_SeqsToMPI *merge=c->ptap->merge;
+  PetscInt            *coi=merge->coi,*bi=merge->bi,*bj=merge->bj,*owners=merge->rowmap->range,cm=C->rmap->n;
+  PetscInt            i,j,k,row,proc,nrows,cnz,bnz,nextcj,*cj,*bj_i,**buf_ri_k,**nextrow,**nextci,**buf_ri,**buf_rj;
+  MatScalar           **abuf_r,*ba_i,*ca;
+  MPI_Comm            comm;
+  PetscMPIInt         size,rank,taga,*len_s;
+  MPI_Request         *s_waits,*r_waits;
+  MPI_Status          *status;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)C,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+
+  buf_ri = merge->buf_ri;
+  buf_rj = merge->buf_rj;
+  len_s  = merge->len_s;
+  ierr   = PetscCommGetNewTag(comm,&taga);CHKERRQ(ierr);
+  ierr   = PetscPostIrecvScalar(comm,taga,merge->nrecv,merge->id_r,merge->len_r,&abuf_r,&r_waits);CHKERRQ(ierr);
+
+  ierr = PetscMalloc2(merge->nsend+1,MPI_Request,&s_waits,size,MPI_Status,&status);CHKERRQ(ierr);
+  for (proc=0,k=0; proc<size; proc++) {
+    if (!len_s[proc]) continue;
+    i    = merge->owners_co[proc];
+    ierr = MPI_Isend(coa+coi[i],len_s[proc],MPIU_MATSCALAR,proc,taga,comm,s_waits+k);CHKERRQ(ierr);
+    k++;
+  }
+  if (merge->nrecv) {ierr = MPI_Waitall(merge->nrecv,r_waits,status);CHKERRQ(ierr);}
+  if (merge->nsend) {ierr = MPI_Waitall(merge->nsend,s_waits,status);CHKERRQ(ierr);}
+
+  ierr = PetscFree2(s_waits,status);CHKERRQ(ierr);
+  ierr = PetscFree(r_waits);CHKERRQ(ierr);
+
+  /* 4) insert local Cseq and received values into Cmpi */
+  /*------------------------------------------------------*/
+  ierr = PetscMalloc3(merge->nrecv,PetscInt**,&buf_ri_k,merge->nrecv,PetscInt*,&nextrow,merge->nrecv,PetscInt*,&nextci);CHKERRQ(ierr);
+  for (k=0; k<merge->nrecv; k++) {
+    buf_ri_k[k] = buf_ri[k]; /* beginning of k-th recved i-structure */
+    nrows       = *(buf_ri_k[k]);
+    nextrow[k]  = buf_ri_k[k]+1;  /* next row number of k-th recved i-structure */
+    nextci[k]   = buf_ri_k[k] + (nrows + 1); /* poins to the next i-structure of k-th recved i-structure  */
+  }
+
+  for (i=0; i<cm; i++) {
+    row  = owners[rank] + i; /* global row index of C_seq */
+    bj_i = bj + bi[i];  /* col indices of the i-th row of C */
+    ba_i = ba + bi[i];
+    bnz  = bi[i+1] - bi[i];
+    /* add received vals into ba */
+    for (k=0; k<merge->nrecv; k++) { /* k-th received message */
+      /* i-th row */
+      if (i == *nextrow[k]) {
+        cnz    = *(nextci[k]+1) - *nextci[k];
+        cj     = buf_rj[k] + *(nextci[k]);
+        ca     = abuf_r[k] + *(nextci[k]);
+        nextcj = 0;
+        for (j=0; nextcj<cnz; j++) {
+          if (bj_i[j] == cj[nextcj]) { /* bcol == ccol */
+            ba_i[j] += ca[nextcj++];
+          }
+        }
+        nextrow[k]++; nextci[k]++;
+        ierr = PetscLogFlops(2.0*cnz);CHKERRQ(ierr);
+      }
+    }
+    ierr = MatSetValues(C,1,&row,bnz,bj_i,ba_i,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = PetscFree(abuf_r[0]);CHKERRQ(ierr);
+  ierr = PetscFree(abuf_r);CHKERRQ(ierr);
+  ierr = PetscFree3(buf_ri_k,nextrow,nextci);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce"
+/*
+   All-at-once algorithm: each row of AP = A_loc*P is formed from A and P, scattered into the rows of C it
+   contributes to, and discarded, so neither AP nor P^T is stored. Row i of AP contributes P[i,c]*AP[i,:] to row c
+   of C; the nonzero columns of each local row of C and of each row of Co = (p->B)^T*A*P are accumulated in hash sets.
+*/
+static PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(Mat A,Mat P,PetscReal fill,Mat *C)
+{
+  PetscErrorCode      ierr;
+  Mat                 Cmpi;
+  Mat_PtAPMPI         *ptap;
+  Mat_Merge_SeqsToMPI *merge;
+  Mat_MPIAIJ          *a =(Mat_MPIAIJ*)A->data,*p=(Mat_MPIAIJ*)P->data,*c;
+  Mat_SeqAIJ          *ad=(Mat_SeqAIJ*)(a->A)->data,*ao=(Mat_SeqAIJ*)(a->B)->data;
+  Mat_SeqAIJ          *pd=(Mat_SeqAIJ*)(p->A)->data,*po=(Mat_SeqAIJ*)(p->B)->data;
+  Mat_SeqAIJ          *p_loc,*p_oth;
+  PetscInt            *pi_loc,*pj_loc,*pi_oth,*pj_oth,*adi=ad->i,*aoi=ao->i,*aj;
+  PetscInt            am=A->rmap->n,pn=P->cmap->n,pon=(p->B)->cmap->n;
+  PetscInt            i,j,k,row,nzi,pnz,apnz,rmax=0,*apj,*Jptr,*dnz,*onz,*owners;
+  PetscInt            *coi,*coj,*bi,*bj,**buf_ri,**buf_rj,nrows,*rows,*ci;
+  PetscHashI          *hta,*hto;
+  MPI_Comm            comm;
+  PetscMPIInt         rank;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+
+  /* create struct Mat_PtAPMPI and attached it to C later */
+  ierr            = PetscNew(Mat_PtAPMPI,&ptap);CHKERRQ(ierr);
+  ierr            = PetscNew(Mat_Merge_SeqsToMPI,&merge);CHKERRQ(ierr);
+  ptap->merge     = merge;
+  ptap->reuse     = MAT_INITIAL_MATRIX;
+  ptap->allatonce = PETSC_TRUE;
+
+  /* get P_oth by taking rows of P (= non-zero cols of local A) from other processors */
+  ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_INITIAL_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&ptap->P_oth);CHKERRQ(ierr);
+
+  /* get P_loc by taking all local rows of P */
+  ierr = MatMPIAIJGetLocalMat(P,MAT_INITIAL_MATRIX,&ptap->P_loc);CHKERRQ(ierr);
+
+  p_loc  = (Mat_SeqAIJ*)(ptap->P_loc)->data;
+  p_oth  = (Mat_SeqAIJ*)(ptap->P_oth)->data;
+  pi_loc = p_loc->i; pj_loc = p_loc->j;
+  pi_oth = p_oth->i; pj_oth = p_oth->j;
+
+  /* rmax: max num of (possibly repeated) column indices gathered for a row of AP */
+  for (i=0; i<am; i++) {
+    apnz = 0;
+    for (j=adi[i]; j<adi[i+1]; j++) {row = ad->j[j]; apnz += pi_loc[row+1] - pi_loc[row];}
+    for (j=aoi[i]; j<aoi[i+1]; j++) {row = ao->j[j]; apnz += pi_oth[row+1] - pi_oth[row];}
+    if (apnz > rmax) rmax = apnz;
+  }
+  ierr = PetscMalloc((rmax+1)*sizeof(PetscInt),&apj);CHKERRQ(ierr);
+
+  /* accumulate the nonzero columns of Cd = (p->A)^T*AP and Co = (p->B)^T*AP one row of AP at a time */
+  /*---------------------------------------------------------------------------------------------------*/
+  ierr = PetscMalloc2(pn,PetscHashI,&hta,pon,PetscHashI,&hto);CHKERRQ(ierr);
+  for (i=0; i<pn; i++) PetscHashICreate(hta[i]);
+  for (i=0; i<pon; i++) PetscHashICreate(hto[i]);
+  for (i=0; i<am; i++) {
+    /* form the column indices of the i-th row of AP = Ad*P_loc + Ao*P_oth */
+    apnz = 0;
+    nzi  = adi[i+1] - adi[i];
+    aj   = ad->j + adi[i];
+    for (j=0; j<nzi; j++) {
+      row  = aj[j];
+      pnz  = pi_loc[row+1] - pi_loc[row];
+      Jptr = pj_loc + pi_loc[row];
+      for (k=0; k<pnz; k++) apj[apnz++] = Jptr[k];
+    }
+    nzi = aoi[i+1] - aoi[i];
+    aj  = ao->j + aoi[i];
+    for (j=0; j<nzi; j++) {
+      row  = aj[j];
+      pnz  = pi_oth[row+1] - pi_oth[row];
+      Jptr = pj_oth + pi_oth[row];
+      for (k=0; k<pnz; k++) apj[apnz++] = Jptr[k];
+    }
+    ierr = PetscSortRemoveDupsInt(&apnz,apj);CHKERRQ(ierr);
+
+    /* AP[i,:] contributes to the rows of C given by the column indices of P[i,:] */
+    for (j=pd->i[i]; j<pd->i[i+1]; j++) {
+      row = pd->j[j];
+      for (k=0; k<apnz; k++) PetscHashIAdd(hta[row],apj[k],0);
+    }
+    for (j=po->i[i]; j<po->i[i+1]; j++) {
+      row = po->j[j];
+      for (k=0; k<apnz; k++) PetscHashIAdd(hto[row],apj[k],0);
+    }
+  }
+
+  /* form Co and send it to the owners of its rows */
+  /*-----------------------------------------------*/
+  ierr   = PetscMalloc((pon+1)*sizeof(PetscInt),&coi);CHKERRQ(ierr);
+  coi[0] = 0;
+  for (i=0; i<pon; i++) {
+    PetscHashISize(hto[i],nzi);
+    coi[i+1] = coi[i] + nzi;
+  }
+  ierr = PetscMalloc((coi[pon]+1)*sizeof(PetscInt),&coj);CHKERRQ(ierr);
+  for (i=0; i<pon; i++) {
+    nzi = coi[i];
+    if (coi[i+1] > coi[i]) PetscHashIGetKeys(hto[i],nzi,coj);
+    ierr = PetscSortInt(coi[i+1]-coi[i],coj+coi[i]);CHKERRQ(ierr);
+    PetscHashIDestroy(hto[i]);
+  }
+
+  ierr   = MatPtAPSymbolicSendCo_MPIAIJ_Private(P,coi,coj,merge);CHKERRQ(ierr);
+  owners = merge->rowmap->range;
+  buf_ri = merge->buf_ri;
+  buf_rj = merge->buf_rj;
+
+  /* add the received rows of Co into the local rows of C */
+  for (k=0; k<merge->nrecv; k++) {
+    nrows = *buf_ri[k];
+    rows  = buf_ri[k] + 1;
+    ci    = buf_ri[k] + (nrows + 1);
+    for (i=0; i<nrows; i++) {
+      row = rows[i];
+      for (j=ci[i]; j<ci[i+1]; j++) PetscHashIAdd(hta[row],buf_rj[k][j],0);
+    }
+  }
+
+  /* form the local rows of C */
+  /*--------------------------*/
+  ierr  = PetscMalloc((pn+1)*sizeof(PetscInt),&bi);CHKERRQ(ierr);
+  bi[0] = 0;
+  for (i=0; i<pn; i++) {
+    PetscHashISize(hta[i],nzi);
+    bi[i+1] = bi[i] + nzi;
+  }
+  ierr = PetscMalloc((bi[pn]+1)*sizeof(PetscInt),&bj);CHKERRQ(ierr);
+  ierr = MatPreallocateInitialize(comm,pn,pn,dnz,onz);CHKERRQ(ierr);
+  for (i=0; i<pn; i++) {
+    nzi = bi[i];
+    if (bi[i+1] > bi[i]) PetscHashIGetKeys(hta[i],nzi,bj);
+    PetscHashIDestroy(hta[i]);
+    ierr = PetscSortInt(bi[i+1]-bi[i],bj+bi[i]);CHKERRQ(ierr);
+    ierr = MatPreallocateSet(i+owners[rank],bi[i+1]-bi[i],bj+bi[i],dnz,onz);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(hta,hto);CHKERRQ(ierr);
+
+  /* create symbolic parallel matrix Cmpi */
+  /*--------------------------------------*/
+  ierr = MatCreate(comm,&Cmpi);CHKERRQ(ierr);
+  ierr = MatSetSizes(Cmpi,pn,pn,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetBlockSizes(Cmpi,P->cmap->bs,P->cmap->bs);CHKERRQ(ierr);
+  ierr = MatSetType(Cmpi,MATMPIAIJ);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(Cmpi,0,dnz,0,onz);CHKERRQ(ierr);
+  ierr = MatPreallocateFinalize(dnz,onz);CHKERRQ(ierr);
+
+  merge->bi        = bi;       /* Cseq->i */
+  merge->bj        = bj;       /* Cseq->j */
+  merge->coi       = coi;      /* Co->i   */
+  merge->coj       = coj;      /* Co->j   */
+  merge->destroy   = Cmpi->ops->destroy;
+  merge->duplicate = Cmpi->ops->duplicate;
+
+  /* Cmpi is not ready for use - assembly will be done by MatPtAPNumeric() */
+  Cmpi->assembled      = PETSC_FALSE;
+  Cmpi->ops->destroy   = MatDestroy_MPIAIJ_PtAP;
+  Cmpi->ops->duplicate = MatDuplicate_MPIAIJ_MatPtAP;
+
+  /* attach the supporting struct to Cmpi for reuse; apj and apa hold a single row of AP */
+  c          = (Mat_MPIAIJ*)Cmpi->data;
+  c->ptap    = ptap;
+  ptap->apj  = apj;
+  ptap->rmax = rmax;
+  ierr       = PetscMalloc((rmax+1)*sizeof(PetscScalar),&ptap->apa);CHKERRQ(ierr);
+  *C         = Cmpi;
+
+#if defined(PETSC_USE_INFO)
+  if (bi[pn] != 0) {
+    ierr = PetscInfo2(Cmpi,"All-at-once PtAP: nnz(Cseq) %D, nnz(Co) %D\n",bi[pn],coi[pon]);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo(Cmpi,"Empty matrix product\n");CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce"
+static PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce(Mat A,Mat P,Mat C)
+{
+  PetscErrorCode      ierr;
+  Mat_MPIAIJ          *a =(Mat_MPIAIJ*)A->data,*p=(Mat_MPIAIJ*)P->data,*c=(Mat_MPIAIJ*)C->data;
+  Mat_SeqAIJ          *ad=(Mat_SeqAIJ*)(a->A)->data,*ao=(Mat_SeqAIJ*)(a->B)->data;
+  Mat_SeqAIJ          *pd=(Mat_SeqAIJ*)(p->A)->data,*po=(Mat_SeqAIJ*)(p->B)->data;
+  Mat_SeqAIJ          *p_loc,*p_oth;
+  Mat_PtAPMPI         *ptap=c->ptap;
+  Mat_Merge_SeqsToMPI *merge=ptap->merge;
+  PetscInt            *adi=ad->i,*aoi=ao->i,*pi_loc,*pj_loc,*pi_oth,*pj_oth,*pj,*apj=ptap->apj;
+  PetscInt            am=A->rmap->n,cm=C->rmap->n,pon=(p->B)->cmap->n;
+  PetscInt            i,j,k,row,anz,pnz,apnz,nextap,*coi,*coj,*bi,*bj,*cj,*pJ;
+  PetscScalar         *apa=ptap->apa;
+  MatScalar           *ada,*aoa,*pa,*pa_loc,*pa_oth,*pA,*ca,*coa,*ba,valtmp;
+
+  PetscFunctionBegin;
+  /* 1) get P_oth = ptap->P_oth  and P_loc = ptap->P_loc */
+  /*--------------------------------------------------*/
+  if (ptap->reuse == MAT_INITIAL_MATRIX) {
+    ptap->reuse = MAT_REUSE_MATRIX;
+  } else { /* update numerical values of P_oth and P_loc */
+    ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_REUSE_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&ptap->P_oth);CHKERRQ(ierr);
+    ierr = MatMPIAIJGetLocalMat(P,MAT_REUSE_MATRIX,&ptap->P_loc);CHKERRQ(ierr);
+  }
+  p_loc  = (Mat_SeqAIJ*)(ptap->P_loc)->data;
+  p_oth  = (Mat_SeqAIJ*)(ptap->P_oth)->data;
+  pi_loc = p_loc->i; pj_loc = p_loc->j; pa_loc = p_loc->a;
+  pi_oth = p_oth->i; pj_oth = p_oth->j; pa_oth = p_oth->a;
+
+  coi  = merge->coi; coj = merge->coj;
+  ierr = PetscMalloc((coi[pon]+1)*sizeof(MatScalar),&coa);CHKERRQ(ierr);
+  ierr = PetscMemzero(coa,coi[pon]*sizeof(MatScalar));CHKERRQ(ierr);
+  bi   = merge->bi; bj = merge->bj;
+  ierr = PetscMalloc((bi[cm]+1)*sizeof(MatScalar),&ba);CHKERRQ(ierr);
+  ierr = PetscMemzero(ba,bi[cm]*sizeof(MatScalar));CHKERRQ(ierr);
+
+  /* 2) compute Cseq = (p->A)^T*AP and Co = (p->B)^T*AP one row of AP at a time */
+  /*-----------------------------------------------------------------------------*/
+  for (i=0; i<am; i++) {
+    /* gather the products forming the i-th row of AP = Ad*P_loc + Ao*P_oth */
+    apnz = 0;
+    anz  = adi[i+1] - adi[i];
+    ada  = ad->a + adi[i];
+    for (j=0; j<anz; j++) {
+      row    = ad->j[adi[i]+j];
+      pnz    = pi_loc[row+1] - pi_loc[row];
+      pj     = pj_loc + pi_loc[row];
+      pa     = pa_loc + pi_loc[row];
+      valtmp = ada[j];
+      for (k=0; k<pnz; k++) {
+        apj[apnz]   = pj[k];
+        apa[apnz++] = valtmp*pa[k];
+      }
+    }
+    anz = aoi[i+1] - aoi[i];
+    aoa = ao->a + aoi[i];
+    for (j=0; j<anz; j++) {
+      row    = ao->j[aoi[i]+j];
+      pnz    = pi_oth[row+1] - pi_oth[row];
+      pj     = pj_oth + pi_oth[row];
+      pa     = pa_oth + pi_oth[row];
+      valtmp = aoa[j];
+      for (k=0; k<pnz; k++) {
+        apj[apnz]   = pj[k];
+        apa[apnz++] = valtmp*pa[k];
+      }
+    }
+    /* sort the products by column and sum the duplicates */
+    ierr = PetscSortIntWithScalarArray(apnz,apj,apa);CHKERRQ(ierr);
+    for (j=0,k=0; j<apnz; j++) {
+      if (k && apj[k-1] == apj[j]) apa[k-1] += apa[j];
+      else {
+        apj[k]   = apj[j];
+        apa[k++] = apa[j];
+      }
+    }
+    ierr = PetscLogFlops(apnz+(apnz-k));CHKERRQ(ierr);
+    apnz = k;
+
+    /* put P[i,:]^T*AP[i,:] into Co (off-diagonal part, send to others) and Cseq (diagonal part) */
+    pnz = po->i[i+1] - po->i[i];
+    pJ  = po->j + po->i[i];
+    pA  = po->a + po->i[i];
+    for (j=0; j<pnz; j++) {
+      row    = pJ[j];
+      cj     = coj + coi[row];
+      ca     = coa + coi[row];
+      valtmp = pA[j];
+      nextap = 0;
+      for (k=0; nextap<apnz; k++) {
+        if (cj[k] == apj[nextap]) ca[k] += valtmp*apa[nextap++];
+      }
+    }
+    ierr = PetscLogFlops(2.0*pnz*apnz);CHKERRQ(ierr);
+    pnz  = pd->i[i+1] - pd->i[i];
+    pJ   = pd->j + pd->i[i];
+    pA   = pd->a + pd->i[i];
+    for (j=0; j<pnz; j++) {
+      row    = pJ[j];
+      cj     = bj + bi[row];
+      ca     = ba + bi[row];
+      valtmp = pA[j];
+      nextap = 0;
+      for (k=0; nextap<apnz; k++) {
+        if (cj[k] == apj[nextap]) ca[k] += valtmp*apa[nextap++];
+      }
+    }
+    ierr = PetscLogFlops(2.0*pnz*apnz);CHKERRQ(ierr);
+  }
+
+  /* 3) send and recv matrix values coa, then insert local Cseq and received values into Cmpi */
+  /*------------------------------------------------------------------------------------------*/
+  ierr = MatPtAPNumericSendCo_MPIAIJ_Private(C,coa,ba);CHKERRQ(ierr);
+  ierr = PetscFree(coa);CHKERRQ(ierr);
+  ierr = PetscFree(ba);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatPtAP_MPIAIJ_MPIAIJ"
 PetscErrorCode MatPtAP_MPIAIJ_MPIAIJ(Mat A,Mat P,MatReuse scall,PetscReal fill,Mat *C)
@@ -102,21 +620,20 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ(Mat A,Mat P,PetscReal fill,Mat *C)
   Mat_SeqAIJ          *p_loc,*p_oth;
   PetscInt            *pi_loc,*pj_loc,*pi_oth,*pj_oth,*pdti,*pdtj,*poti,*potj,*ptJ;
   PetscInt            *adi=ad->i,*aj,*aoi=ao->i,nnz;
-  PetscInt            *lnk,*owners_co,*coi,*coj,i,k,pnz,row;
+  PetscInt            *lnk,*coi,*coj,i,k,pnz,row;
   PetscInt            am=A->rmap->n,pN=P->cmap->N,pm=P->rmap->n,pn=P->cmap->n;
   PetscBT             lnkbt;
   MPI_Comm            comm;
-  PetscMPIInt         size,rank,tagi,tagj,*len_si,*len_s,*len_ri,icompleted=0;
+  PetscMPIInt         size,rank;
   PetscInt            **buf_rj,**buf_ri,**buf_ri_k;
-  PetscInt            len,proc,*dnz,*onz,*owners;
+  PetscInt            *dnz,*onz,*owners;
   PetscInt            nzi,*pti,*ptj;
-  PetscInt            nrows,*buf_s,*buf_si,*buf_si_i,**nextrow,**nextci;
-  MPI_Request         *swaits,*rwaits;
-  MPI_Status          *sstatus,rstatus;
+  PetscInt            nrows,**nextrow,**nextci;
   Mat_Merge_SeqsToMPI *merge;
-  PetscInt            *api,*apj,*Jptr,apnz,*prmap=p->garray,pon,nspacedouble=0,j,ap_rmax=0;
+  PetscInt            *api,*apj,*Jptr,apnz,pon,nspacedouble=0,j,ap_rmax=0;
   PetscReal           afill=1.0,afill_tmp;
-  PetscInt            rmax;
+  PetscInt            rmax,alg=0;
+  const char          *algTypes[3] = {"scalable","nonscalable","allatonce"};
 #if defined(PTAP_PROFILE)
   PetscLogDouble t0,t1,t2,t3,t4;
 #endif
@@ -135,6 +652,16 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ(Mat A,Mat P,PetscReal fill,Mat *C)
     SETERRQ4(comm,PETSC_ERR_ARG_SIZ,"Matrix local dimensions are incompatible, Acol (%D, %D) != Prow (%D,%D)",A->cmap->rstart,A->cmap->rend,P->rmap->rstart,P->rmap->rend);
   }
 
+  /* "scalable" and "nonscalable" both use the symbolic product below, its numeric product is chosen by -matptap_scalable;
+       "allatonce": form, use and discard each row of A*P; neither A*P nor P^T is stored */
+  ierr = PetscObjectOptionsBegin((PetscObject)A);CHKERRQ(ierr);
+  ierr = PetscOptionsEList("-matptap_via","Algorithmic approach","MatPtAP",algTypes,3,algTypes[0],&alg,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (alg == 2) {
+    ierr = MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(A,P,fill,C);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
 
@@ -270,106 +797,10 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ(Mat A,Mat P,PetscReal fill,Mat *C)
 
   /* send j-array (coj) of Co to other processors */
   /*----------------------------------------------*/
-  /* determine row ownership */
-  ierr = PetscLayoutCreate(comm,&merge->rowmap);CHKERRQ(ierr);
-  merge->rowmap->n  = pn;
-  merge->rowmap->bs = 1;
-
-  ierr   = PetscLayoutSetUp(merge->rowmap);CHKERRQ(ierr);
+  ierr   = MatPtAPSymbolicSendCo_MPIAIJ_Private(P,coi,coj,merge);CHKERRQ(ierr);
   owners = merge->rowmap->range;
-
-  /* determine the number of messages to send, their lengths */
-  ierr = PetscMalloc2(size,PetscMPIInt,&len_si,size,MPI_Status,&sstatus);CHKERRQ(ierr);
-  ierr = PetscMemzero(len_si,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
-  ierr = PetscMalloc(size*sizeof(PetscMPIInt),&merge->len_s);CHKERRQ(ierr);
-
-  len_s        = merge->len_s;
-  merge->nsend = 0;
-
-  ierr = PetscMalloc((size+2)*sizeof(PetscInt),&owners_co);CHKERRQ(ierr);
-  ierr = PetscMemzero(len_s,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
-
-  proc = 0;
-  for (i=0; i<pon; i++) {
-    while (prmap[i] >= owners[proc+1]) proc++;
-    len_si[proc]++;  /* num of rows in Co to be sent to [proc] */
-    len_s[proc] += coi[i+1] - coi[i];
-  }
-
-  len          = 0; /* max length of buf_si[] */
-  owners_co[0] = 0;
-  for (proc=0; proc<size; proc++) {
-    owners_co[proc+1] = owners_co[proc] + len_si[proc];
-    if (len_si[proc]) {
-      merge->nsend++;
-      len_si[proc] = 2*(len_si[proc] + 1);
-      len         += len_si[proc];
-    }
-  }
-
-  /* determine the number and length of messages to receive for coi and coj  */
-  ierr = PetscGatherNumberOfMessages(comm,NULL,len_s,&merge->nrecv);CHKERRQ(ierr);
-  ierr = PetscGatherMessageLengths2(comm,merge->nsend,merge->nrecv,len_s,len_si,&merge->id_r,&merge->len_r,&len_ri);CHKERRQ(ierr);
-
-  /* post the Irecv and Isend of coj */
-  ierr = PetscCommGetNewTag(comm,&tagj);CHKERRQ(ierr);
-  ierr = PetscPostIrecvInt(comm,tagj,merge->nrecv,merge->id_r,merge->len_r,&buf_rj,&rwaits);CHKERRQ(ierr);
-  ierr = PetscMalloc((merge->nsend+1)*sizeof(MPI_Request),&swaits);CHKERRQ(ierr);
-  for (proc=0, k=0; proc<size; proc++) {
-    if (!len_s[proc]) continue;
-    i    = owners_co[proc];
-    ierr = MPI_Isend(coj+coi[i],len_s[proc],MPIU_INT,proc,tagj,comm,swaits+k);CHKERRQ(ierr);
-    k++;
-  }
-
-  /* receives and sends of coj are complete */
-  for (i=0; i<merge->nrecv; i++) {
-    ierr = MPI_Waitany(merge->nrecv,rwaits,&icompleted,&rstatus);CHKERRQ(ierr);
-  }
-  ierr = PetscFree(rwaits);CHKERRQ(ierr);
-  if (merge->nsend) {ierr = MPI_Waitall(merge->nsend,swaits,sstatus);CHKERRQ(ierr);}
-
-  /* send and recv coi */
-  /*-------------------*/
-  ierr   = PetscCommGetNewTag(comm,&tagi);CHKERRQ(ierr);
-  ierr   = PetscPostIrecvInt(comm,tagi,merge->nrecv,merge->id_r,len_ri,&buf_ri,&rwaits);CHKERRQ(ierr);
-  ierr   = PetscMalloc((len+1)*sizeof(PetscInt),&buf_s);CHKERRQ(ierr);
-  buf_si = buf_s;  /* points to the beginning of k-th msg to be sent */
-  for (proc=0,k=0; proc<size; proc++) {
-    if (!len_s[proc]) continue;
-    /* form outgoing message for i-structure:
-         buf_si[0]:                 nrows to be sent
-               [1:nrows]:           row index (global)
-               [nrows+1:2*nrows+1]: i-structure index
-    */
-    /*-------------------------------------------*/
-    nrows       = len_si[proc]/2 - 1;
-    buf_si_i    = buf_si + nrows+1;
-    buf_si[0]   = nrows;
-    buf_si_i[0] = 0;
-    nrows       = 0;
-    for (i=owners_co[proc]; i<owners_co[proc+1]; i++) {
-      nzi = coi[i+1] - coi[i];
-
-      buf_si_i[nrows+1] = buf_si_i[nrows] + nzi; /* i-structure */
-      buf_si[nrows+1]   = prmap[i] -owners[proc]; /* local row index */
-      nrows++;
-    }
-    ierr = MPI_Isend(buf_si,len_si[proc],MPIU_INT,proc,tagi,comm,swaits+k);CHKERRQ(ierr);
-    k++;
-    buf_si += len_si[proc];
-  }
-  i = merge->nrecv;
-  while (i--) {
-    ierr = MPI_Waitany(merge->nrecv,rwaits,&icompleted,&rstatus);CHKERRQ(ierr);
-  }
-  ierr = PetscFree(rwaits);CHKERRQ(ierr);
-  if (merge->nsend) {ierr = MPI_Waitall(merge->nsend,swaits,sstatus);CHKERRQ(ierr);}
-
-  ierr = PetscFree2(len_si,sstatus);CHKERRQ(ierr);
-  ierr = PetscFree(len_ri);CHKERRQ(ierr);
-  ierr = PetscFree(swaits);CHKERRQ(ierr);
-  ierr = PetscFree(buf_s);CHKERRQ(ierr);
+  buf_ri = merge->buf_ri;
+  buf_rj = merge->buf_rj;
 
 #if defined(PTAP_PROFILE)
   ierr = PetscTime(&t3);CHKERRQ(ierr);
@@ -458,9 +889,6 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ(Mat A,Mat P,PetscReal fill,Mat *C)
   merge->bj        = ptj;      /* Cseq->j */
   merge->coi       = coi;      /* Co->i   */
   merge->coj       = coj;      /* Co->j   */
-  merge->buf_ri    = buf_ri;
-  merge->buf_rj    = buf_rj;
-  merge->owners_co = owners_co;
   merge->destroy   = Cmpi->ops->destroy;
   merge->duplicate = Cmpi->ops->duplicate;
 
@@ -525,18 +953,14 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A,Mat P,Mat C)
   MatScalar           *ada,*aoa,*apa,*pa,*ca,*pa_loc,*pa_oth,valtmp;
   PetscInt            am  =A->rmap->n,cm=C->rmap->n,pon=(p->B)->cmap->n;
   MPI_Comm            comm;
-  PetscMPIInt         size,rank,taga,*len_s;
-  PetscInt            *owners,proc,nrows,**buf_ri_k,**nextrow,**nextci;
-  PetscInt            **buf_ri,**buf_rj;
-  PetscInt            cnz=0,*bj_i,*bi,*bj,bnz,nextcj;  /* bi,bj,ba: local array of C(mpi mat) */
-  MPI_Request         *s_waits,*r_waits;
-  MPI_Status          *status;
-  MatScalar           **abuf_r,*ba_i,*pA,*coa,*ba;
+  PetscMPIInt         size,rank;
+  PetscInt            cnz=0,*bi,*bj;  /* bi,bj,ba: local array of C(mpi mat) */
+  MatScalar           *pA,*coa,*ba;
   PetscInt            *api,*apj,*coi,*coj;
   PetscInt            *poJ=po->j,*pdJ=pd->j,pcstart=P->cmap->rstart,pcend=P->cmap->rend;
   PetscBool           scalable;
 #if defined(PTAP_PROFILE)
-  PetscLogDouble t0,t1,t2,t3,t4,et2_AP=0.0,et2_PtAP=0.0,t2_0,t2_1,t2_2;
+  PetscLogDouble t0,t1,t2,t4,et2_AP=0.0,et2_PtAP=0.0,t2_0,t2_1,t2_2;
 #endif
 
   PetscFunctionBegin;
@@ -549,6 +973,10 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A,Mat P,Mat C)
 
   ptap = c->ptap;
   if (!ptap) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_INCOMP,"MatPtAP() has not been called to create matrix C yet, cannot use MAT_REUSE_MATRIX");
+  if (ptap->allatonce) {
+    ierr = MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce(A,P,C);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   merge    = ptap->merge;
   apa      = ptap->apa;
   scalable = ptap->scalable;
@@ -578,10 +1006,9 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A,Mat P,Mat C)
   ierr = PetscMalloc((coi[pon]+1)*sizeof(MatScalar),&coa);CHKERRQ(ierr);
   ierr = PetscMemzero(coa,coi[pon]*sizeof(MatScalar));CHKERRQ(ierr);
 
-  bi     = merge->bi; bj = merge->bj;
-  owners = merge->rowmap->range;
-  ierr   = PetscMalloc((bi[cm]+1)*sizeof(MatScalar),&ba);CHKERRQ(ierr);  /* ba: Cseq->a */
-  ierr   = PetscMemzero(ba,bi[cm]*sizeof(MatScalar));CHKERRQ(ierr);
+  bi   = merge->bi; bj = merge->bj;
+  ierr = PetscMalloc((bi[cm]+1)*sizeof(MatScalar),&ba);CHKERRQ(ierr);  /* ba: Cseq->a */
+  ierr = PetscMemzero(ba,bi[cm]*sizeof(MatScalar));CHKERRQ(ierr);
 
   api = ptap->api; apj = ptap->apj;
 
@@ -767,75 +1194,14 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A,Mat P,Mat C)
   ierr = PetscTime(&t2);CHKERRQ(ierr);
 #endif
 
-  /* 3) send and recv matrix values coa */
-  /*------------------------------------*/
-  buf_ri = merge->buf_ri;
-  buf_rj = merge->buf_rj;
-  len_s  = merge->len_s;
-  ierr   = PetscCommGetNewTag(comm,&taga);CHKERRQ(ierr);
-  ierr   = PetscPostIrecvScalar(comm,taga,merge->nrecv,merge->id_r,merge->len_r,&abuf_r,&r_waits);CHKERRQ(ierr);
-
-  ierr = PetscMalloc2(merge->nsend+1,MPI_Request,&s_waits,size,MPI_Status,&status);CHKERRQ(ierr);
-  for (proc=0,k=0; proc<size; proc++) {
-    if (!len_s[proc]) continue;
-    i    = merge->owners_co[proc];
-    ierr = MPI_Isend(coa+coi[i],len_s[proc],MPIU_MATSCALAR,proc,taga,comm,s_waits+k);CHKERRQ(ierr);
-    k++;
-  }
-  if (merge->nrecv) {ierr = MPI_Waitall(merge->nrecv,r_waits,status);CHKERRQ(ierr);}
-  if (merge->nsend) {ierr = MPI_Waitall(merge->nsend,s_waits,status);CHKERRQ(ierr);}
-
-  ierr = PetscFree2(s_waits,status);CHKERRQ(ierr);
-  ierr = PetscFree(r_waits);CHKERRQ(ierr);
+  /* 3) send and recv matrix values coa, then insert local Cseq and received values into Cmpi */
+  /*------------------------------------------------------------------------------------------*/
+  ierr = MatPtAPNumericSendCo_MPIAIJ_Private(C,coa,ba);CHKERRQ(ierr);
   ierr = PetscFree(coa);CHKERRQ(ierr);
-#if defined(PTAP_PROFILE)
-  ierr = PetscTime(&t3);CHKERRQ(ierr);
-#endif
-
-  /* 4) insert local Cseq and received values into Cmpi */
-  /*------------------------------------------------------*/
-  ierr = PetscMalloc3(merge->nrecv,PetscInt**,&buf_ri_k,merge->nrecv,PetscInt*,&nextrow,merge->nrecv,PetscInt*,&nextci);CHKERRQ(ierr);
-  for (k=0; k<merge->nrecv; k++) {
-    buf_ri_k[k] = buf_ri[k]; /* beginning of k-th recved i-structure */
-    nrows       = *(buf_ri_k[k]);
-    nextrow[k]  = buf_ri_k[k]+1;  /* next row number of k-th recved i-structure */
-    nextci[k]   = buf_ri_k[k] + (nrows + 1); /* poins to the next i-structure of k-th recved i-structure  */
-  }
-
-  for (i=0; i<cm; i++) {
-    row  = owners[rank] + i; /* global row index of C_seq */
-    bj_i = bj + bi[i];  /* col indices of the i-th row of C */
-    ba_i = ba + bi[i];
-    bnz  = bi[i+1] - bi[i];
-    /* add received vals into ba */
-    for (k=0; k<merge->nrecv; k++) { /* k-th received message */
-      /* i-th row */
-      if (i == *nextrow[k]) {
-        cnz    = *(nextci[k]+1) - *nextci[k];
-        cj     = buf_rj[k] + *(nextci[k]);
-        ca     = abuf_r[k] + *(nextci[k]);
-        nextcj = 0;
-        for (j=0; nextcj<cnz; j++) {
-          if (bj_i[j] == cj[nextcj]) { /* bcol == ccol */
-            ba_i[j] += ca[nextcj++];
-          }
-        }
-        nextrow[k]++; nextci[k]++;
-        ierr = PetscLogFlops(2.0*cnz);CHKERRQ(ierr);
-      }
-    }
-    ierr = MatSetValues(C,1,&row,bnz,bj_i,ba_i,INSERT_VALUES);CHKERRQ(ierr);
-  }
-  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
-  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
-
   ierr = PetscFree(ba);CHKERRQ(ierr);
-  ierr = PetscFree(abuf_r[0]);CHKERRQ(ierr);
-  ierr = PetscFree(abuf_r);CHKERRQ(ierr);
-  ierr = PetscFree3(buf_ri_k,nextrow,nextci);CHKERRQ(ierr);
 #if defined(PTAP_PROFILE)
   ierr = PetscTime(&t4);CHKERRQ(ierr);
-  if (rank==1) PetscPrintf(MPI_COMM_SELF,"  [%d] PtAPNum %g/P + %g/PtAP( %g + %g ) + %g/comm + %g/Cloc = %g\n\n",rank,t1-t0,t2-t1,et2_AP,et2_PtAP,t3-t2,t4-t3,t4-t0);CHKERRQ(ierr);
+  if (rank==1) PetscPrintf(MPI_COMM_SELF,"  [%d] PtAPNum %g/P + %g/PtAP( %g + %g ) + %g/comm+Cloc = %g\n\n",rank,t1-t0,t2-t1,et2_AP,et2_PtAP,t4-t2,t4-t0);CHKERRQ(ierr);
 #endif
   PetscFunctionReturn(0);
 }
@@ -990,6 +990,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqsbaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqbaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijperm_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijdelta_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatIsTranspose_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
@@ -3147,6 +3148,78 @@ PetscErrorCode  MatInvertBlockDiagonal_SeqAIJ(Mat A,const PetscScalar **values)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "MatInvertVariableBlockDiagonal_SeqAIJ"
+PetscErrorCode  MatInvertVariableBlockDiagonal_SeqAIJ(Mat A,PetscInt nblocks,const PetscInt *bsizes,PetscScalar *idiag)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*) A->data;
+  PetscErrorCode  ierr;
+  PetscInt        i,k,row,bs,bsmax = 0,start = 0,ncnt = 0,ipvt[5],*v_pivots = NULL;
+  const PetscInt  *ai = a->i,*aj = a->j;
+  const MatScalar *aa = a->a;
+  MatScalar       *diag = idiag,work[25],*v_work = NULL;
+  PetscReal       shift = 0.0;
+
+  PetscFunctionBegin;
+  for (i=0; i<nblocks; i++) {
+    ncnt += bsizes[i];
+    bsmax = PetscMax(bsmax,bsizes[i]);
+  }
+  if (ncnt != A->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Sum of block sizes %D does not equal number of rows %D",ncnt,A->rmap->n);
+  if (bsmax > 7) {
+    ierr = PetscMalloc2(bsmax,MatScalar,&v_work,bsmax,PetscInt,&v_pivots);CHKERRQ(ierr);
+  }
+  for (i=0; i<nblocks; i++) {
+    bs = bsizes[i];
+    /* copy the diagonal block, row major, directly out of the sorted rows */
+    ierr = PetscMemzero(diag,bs*bs*sizeof(MatScalar));CHKERRQ(ierr);
+    for (row=start; row<start+bs; row++) {
+      for (k=ai[row]; k<ai[row+1] && aj[k] < start+bs; k++) {
+        if (aj[k] >= start) diag[(row-start)*bs + aj[k]-start] = aa[k];
+      }
+    }
+    switch (bs) {
+    case 1:
+      if (diag[0] == 0.0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot, row %D",start);
+      diag[0] = 1.0/(diag[0] + shift);
+      break;
+    case 2:
+      ierr = PetscKernel_A_gets_inverse_A_2(diag,shift);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_2(diag);CHKERRQ(ierr);
+      break;
+    case 3:
+      ierr = PetscKernel_A_gets_inverse_A_3(diag,shift);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_3(diag);CHKERRQ(ierr);
+      break;
+    case 4:
+      ierr = PetscKernel_A_gets_inverse_A_4(diag,shift);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_4(diag);CHKERRQ(ierr);
+      break;
+    case 5:
+      ierr = PetscKernel_A_gets_inverse_A_5(diag,ipvt,work,shift);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_5(diag);CHKERRQ(ierr);
+      break;
+    case 6:
+      ierr = PetscKernel_A_gets_inverse_A_6(diag,shift);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_6(diag);CHKERRQ(ierr);
+      break;
+    case 7:
+      ierr = PetscKernel_A_gets_inverse_A_7(diag,shift);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_7(diag);CHKERRQ(ierr);
+      break;
+    default:
+      ierr = PetscKernel_A_gets_inverse_A(bs,diag,v_pivots,v_work);CHKERRQ(ierr);
+      ierr = PetscKernel_A_gets_transpose_A_N(diag,bs);CHKERRQ(ierr);
+    }
+    diag  += bs*bs;
+    start += bs;
+  }
+  if (bsmax > 7) {
+    ierr = PetscFree2(v_work,v_pivots);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatSetRandom_SeqAIJ"
 static PetscErrorCode  MatSetRandom_SeqAIJ(Mat x,PetscRandom rctx)
@@ -3315,7 +3388,8 @@ static struct _MatOps MatOps_Values = { MatSetValues_SeqAIJ,
                                         MatRARtNumeric_SeqAIJ_SeqAIJ,
                                  /*139*/0,
                                         0,
-                                        0
+                                        0,
+                                 /*142*/MatInvertVariableBlockDiagonal_SeqAIJ
 };
 
 #undef __FUNCT__
@@ -3636,6 +3710,27 @@ PetscErrorCode  MatSeqAIJSetPreallocation(Mat B,PetscInt nz,const PetscInt nnz[]
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_THREADCOMM_ACTIVE)
+/*
+   The values and column indices of the rows of each thread are written first by that thread, so their
+   pages are placed on its NUMA node, where the threaded MatMult() reads them
+*/
+PetscErrorCode MatSeqAIJFirstTouch_Kernel(PetscInt thread_id,Mat A)
+{
+  PetscErrorCode ierr;
+  PetscInt       *trstarts=A->rmap->trstarts;
+  PetscInt       n,start,end;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+
+  start = trstarts[thread_id];
+  end   = trstarts[thread_id+1];
+  n     = a->i[end] - a->i[start];
+  ierr  = PetscMemzero(a->a+a->i[start],n*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr  = PetscMemzero(a->j+a->i[start],n*sizeof(PetscInt));CHKERRQ(ierr);
+  return 0;
+}
+#endif
+
 #undef __FUNCT__
 #define __FUNCT__ "MatSeqAIJSetPreallocation_SeqAIJ"
 PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscInt *nnz)
@@ -3697,8 +3792,10 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
     b->free_a       = PETSC_TRUE;
     b->free_ij      = PETSC_TRUE;
 #if defined(PETSC_THREADCOMM_ACTIVE)
-    ierr = MatZeroEntries_SeqAIJ(B);CHKERRQ(ierr);
+    ierr = PetscThreadCommRunKernel(PetscObjectComm((PetscObject)B),(PetscThreadKernel)MatSeqAIJFirstTouch_Kernel,1,B);CHKERRQ(ierr);
 #endif
+    ierr = PetscMallocPlacementInfo((PetscObject)B,"values",b->a,nz*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMallocPlacementInfo((PetscObject)B,"column indices",b->j,nz*sizeof(PetscInt));CHKERRQ(ierr);
   } else {
     b->free_a  = PETSC_FALSE;
     b->free_ij = PETSC_FALSE;
@@ -4108,6 +4205,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqsbaij_C",MatConvert_SeqAIJ_SeqSBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqbaij_C",MatConvert_SeqAIJ_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijperm_C",MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijdelta_C",MatConvert_SeqAIJ_SeqAIJDelta);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijcrl_C",MatConvert_SeqAIJ_SeqAIJCRL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsTranspose_C",MatIsTranspose_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsHermitianTranspose_C",MatIsTranspose_SeqAIJ);CHKERRQ(ierr);
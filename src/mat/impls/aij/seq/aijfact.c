@@ -1757,6 +1757,8 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
     if (a->inode.size) {
       fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
     }
+    /* the factor has the nonzero structure of A so its inodes for MatSolve() can follow the same variable blocks */
+    if (A->bsizes) {ierr = MatSetVariableBlockSizes(fact,A->nblocks,A->bsizes);CHKERRQ(ierr);}
     PetscFunctionReturn(0);
   }
 
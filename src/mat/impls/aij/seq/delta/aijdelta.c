@@ -0,0 +1,559 @@
+/*
+  Defines basic operations for the MATSEQAIJDELTA matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage, but additionally stores the column indices
+  of each row as the smallest column of the row plus a 16 bit (or, if
+  the rows are too wide for that, 32 bit) offset from it.  The
+  matrix-vector products and SOR sweeps read these narrow offsets instead
+  of the full PetscInt column indices, reducing the memory traffic of
+  these bandwidth limited kernels.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscInt       bits;    /* smallest offset width the user allows, 16 or 32 */
+  PetscInt       width;   /* width of the offsets in use, 16 or 32, or 0 if the offsets are not used */
+  PetscInt       nz;      /* length of dj16[] or dj32[] */
+  PetscInt       *jbase;  /* smallest column of each row */
+  unsigned short *dj16;   /* column offsets from jbase[] for each nonzero, if width is 16 */
+  unsigned int   *dj32;   /* column offsets from jbase[] for each nonzero, if width is 32 */
+} Mat_SeqAIJDelta;
+
+/*
+   sum += (or -=) v[l]*x[jbase[row] + dj[k+l]] for l = 0,...,n-1, where dj is the offset array in use.
+   The row base is added to x once so the inner loop is PetscSparseDensePlusDot() with the narrow offsets as indices.
+*/
+#define MatSeqAIJDeltaPlusDot(ad,sum,x,row,v,k,n) do {                                                             \
+    const PetscScalar *_xb = (x) + (ad)->jbase[row];                                                               \
+    if ((ad)->width == 16) {const unsigned short *_dj = (ad)->dj16 + (k); PetscSparseDensePlusDot(sum,_xb,v,_dj,n);} \
+    else                   {const unsigned int   *_dj = (ad)->dj32 + (k); PetscSparseDensePlusDot(sum,_xb,v,_dj,n);} \
+  } while (0)
+
+#define MatSeqAIJDeltaMinusDot(ad,sum,x,row,v,k,n) do {                                                             \
+    const PetscScalar *_xb = (x) + (ad)->jbase[row];                                                                \
+    if ((ad)->width == 16) {const unsigned short *_dj = (ad)->dj16 + (k); PetscSparseDenseMinusDot(sum,_xb,v,_dj,n);} \
+    else                   {const unsigned int   *_dj = (ad)->dj32 + (k); PetscSparseDenseMinusDot(sum,_xb,v,_dj,n);} \
+  } while (0)
+
+static PetscErrorCode MatMult_SeqAIJDelta(Mat,Vec,Vec);
+static PetscErrorCode MatMultAdd_SeqAIJDelta(Mat,Vec,Vec,Vec);
+static PetscErrorCode MatSOR_SeqAIJDelta(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSeqAIJDelta_FreeDeltas"
+static PetscErrorCode MatSeqAIJDelta_FreeDeltas(Mat A)
+{
+  Mat_SeqAIJDelta *ad = (Mat_SeqAIJDelta*)A->spptr;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr      = PetscFree(ad->jbase);CHKERRQ(ierr);
+  ierr      = PetscFree(ad->dj16);CHKERRQ(ierr);
+  ierr      = PetscFree(ad->dj32);CHKERRQ(ierr);
+  ad->width = 0;
+  ad->nz    = 0;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSeqAIJDelta_CreateDeltas"
+/*
+   Computes the row bases and column offsets from the assembled a->i and a->j; if some row spans more
+   columns than the widest offset can represent, the plain SeqAIJ kernels are used instead.
+*/
+static PetscErrorCode MatSeqAIJDelta_CreateDeltas(Mat A)
+{
+  Mat_SeqAIJ      *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta *ad = (Mat_SeqAIJDelta*)A->spptr;
+  PetscErrorCode  ierr;
+  PetscInt        i,k,m = A->rmap->n,nz = a->i[m],cmin,cmax,span = 0;
+  const PetscInt  *ai = a->i,*aj = a->j;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDelta_FreeDeltas(A);CHKERRQ(ierr);
+  ierr = PetscMalloc(m*sizeof(PetscInt),&ad->jbase);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    cmin = cmax = 0;
+    if (ai[i+1] > ai[i]) {
+      cmin = cmax = aj[ai[i]];
+      for (k=ai[i]+1; k<ai[i+1]; k++) {
+        cmin = PetscMin(cmin,aj[k]);
+        cmax = PetscMax(cmax,aj[k]);
+      }
+    }
+    ad->jbase[i] = cmin;
+    span         = PetscMax(span,cmax - cmin);
+  }
+
+  if (ad->bits <= 16 && span <= 65535) ad->width = 16;
+#if defined(PETSC_USE_64BIT_INDICES)
+  else if (span <= 4294967295) ad->width = 32;
+#else
+  else ad->width = 32;
+#endif
+
+  if (ad->width == 16) {
+    ierr = PetscMalloc(nz*sizeof(unsigned short),&ad->dj16);CHKERRQ(ierr);
+    for (i=0; i<m; i++) {
+      for (k=ai[i]; k<ai[i+1]; k++) ad->dj16[k] = (unsigned short)(aj[k] - ad->jbase[i]);
+    }
+  } else if (ad->width == 32) {
+    ierr = PetscMalloc(nz*sizeof(unsigned int),&ad->dj32);CHKERRQ(ierr);
+    for (i=0; i<m; i++) {
+      for (k=ai[i]; k<ai[i+1]; k++) ad->dj32[k] = (unsigned int)(aj[k] - ad->jbase[i]);
+    }
+  } else {
+    ierr = PetscFree(ad->jbase);CHKERRQ(ierr);
+  }
+  ad->nz = nz;
+
+  if (ad->width) {
+    ierr = PetscInfo4(A,"Using %D bit column offsets, widest row spans %D columns, %D bytes of column indices read per product instead of %D\n",ad->width,span+1,(PetscInt)((a->compressedrow.use ? a->compressedrow.nrows : m)*sizeof(PetscInt) + nz*ad->width/8),(PetscInt)(nz*sizeof(PetscInt)));CHKERRQ(ierr);
+    A->ops->mult    = MatMult_SeqAIJDelta;
+    A->ops->multadd = MatMultAdd_SeqAIJDelta;
+    A->ops->sor     = MatSOR_SeqAIJDelta;
+  } else {
+    ierr = PetscInfo1(A,"Widest row spans %D columns, too many for 32 bit column offsets; using the SeqAIJ kernels\n",span+1);CHKERRQ(ierr);
+    A->ops->mult    = MatMult_SeqAIJ;
+    A->ops->multadd = MatMultAdd_SeqAIJ;
+    A->ops->sor     = MatSOR_SeqAIJ;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatConvert_SeqAIJDelta_SeqAIJ"
+PETSC_EXTERN PetscErrorCode MatConvert_SeqAIJDelta_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJDELTA to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->zerorows    = MatZeroRows_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+
+  ierr = MatSeqAIJDelta_FreeDeltas(B);CHKERRQ(ierr);
+  ierr = PetscFree(B->spptr);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijdelta_seqaij_C",NULL);CHKERRQ(ierr);
+
+  /* Change the type of B to MATSEQAIJ. */
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDestroy_SeqAIJDelta"
+static PetscErrorCode MatDestroy_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (A->spptr) {
+    ierr = MatSeqAIJDelta_FreeDeltas(A);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaijdelta_seqaij_C",NULL);CHKERRQ(ierr);
+
+  /* Change the type of A back to SEQAIJ and use MatDestroy_SeqAIJ() to destroy everything that remains. */
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDuplicate_SeqAIJDelta"
+static PetscErrorCode MatDuplicate_SeqAIJDelta(Mat A,MatDuplicateOption op,Mat *M)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJDelta *ad = (Mat_SeqAIJDelta*)A->spptr;
+
+  PetscFunctionBegin;
+  /* creates a MATSEQAIJDELTA matrix since it uses the type name of A */
+  ierr = MatDuplicate_SeqAIJ(A,op,M);CHKERRQ(ierr);
+  ((Mat_SeqAIJDelta*)(*M)->spptr)->bits = ad->bits;
+  if (A->assembled) {
+    ierr = MatSeqAIJDelta_CreateDeltas(*M);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatAssemblyEnd_SeqAIJDelta"
+static PetscErrorCode MatAssemblyEnd_SeqAIJDelta(Mat A,MatAssemblyType mode)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+
+  /* the inode routines would replace the multiply and SOR kernels */
+  a->inode.use = PETSC_FALSE;
+  ierr         = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  ierr         = MatSeqAIJDelta_CreateDeltas(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatZeroRows_SeqAIJDelta"
+static PetscErrorCode MatZeroRows_SeqAIJDelta(Mat A,PetscInt N,const PetscInt rows[],PetscScalar diag,Vec x,Vec b)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* MatZeroRows_SeqAIJ() may squeeze out the zeroed rows, moving the column indices */
+  ierr = MatZeroRows_SeqAIJ(A,N,rows,diag,x,b);CHKERRQ(ierr);
+  ierr = MatSeqAIJDelta_CreateDeltas(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMult_SeqAIJDelta"
+static PetscErrorCode MatMult_SeqAIJDelta(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *ad = (Mat_SeqAIJDelta*)A->spptr;
+  PetscScalar       *y,sum;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n,n,i;
+  const PetscInt    *ii,*ridx;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    ierr = PetscMemzero(y,m*sizeof(PetscScalar));CHKERRQ(ierr);
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (i=0; i<m; i++) {
+      n   = ii[i+1] - ii[i];
+      aa  = a->a + ii[i];
+      sum = 0.0;
+      MatSeqAIJDeltaPlusDot(ad,sum,x,ridx[i],aa,ii[i],n);
+      y[ridx[i]] = sum;
+    }
+  } else {
+    ii = a->i;
+    for (i=0; i<m; i++) {
+      n   = ii[i+1] - ii[i];
+      aa  = a->a + ii[i];
+      sum = 0.0;
+      MatSeqAIJDeltaPlusDot(ad,sum,x,i,aa,ii[i],n);
+      y[i] = sum;
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultAdd_SeqAIJDelta"
+static PetscErrorCode MatMultAdd_SeqAIJDelta(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *ad = (Mat_SeqAIJDelta*)A->spptr;
+  PetscScalar       *y,*z,sum;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n,n,i;
+  const PetscInt    *ii,*ridx;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  if (zz != yy) {
+    ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  } else {
+    z = y;
+  }
+  if (a->compressedrow.use) {
+    if (zz != yy) {
+      ierr = PetscMemcpy(z,y,m*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (i=0; i<m; i++) {
+      n   = ii[i+1] - ii[i];
+      aa  = a->a + ii[i];
+      sum = y[ridx[i]];
+      MatSeqAIJDeltaPlusDot(ad,sum,x,ridx[i],aa,ii[i],n);
+      z[ridx[i]] = sum;
+    }
+  } else {
+    ii = a->i;
+    for (i=0; i<m; i++) {
+      n   = ii[i+1] - ii[i];
+      aa  = a->a + ii[i];
+      sum = y[i];
+      MatSeqAIJDeltaPlusDot(ad,sum,x,i,aa,ii[i],n);
+      z[i] = sum;
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  if (zz != yy) {
+    ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSOR_SeqAIJDelta"
+/*
+   The sweeps of MatSOR_SeqAIJ() with the column offsets; the rarely used SOR_APPLY_UPPER and
+   Eisenstat variants are left to MatSOR_SeqAIJ()
+*/
+static PetscErrorCode MatSOR_SeqAIJDelta(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *ad = (Mat_SeqAIJDelta*)A->spptr;
+  PetscScalar       *x,sum,*t;
+  const MatScalar   *v,*idiag,*mdiag;
+  const PetscScalar *b,*xb;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n,i,n;
+  const PetscInt    *diag,*ai = a->i;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & SOR_EISENSTAT)) {
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  its = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        n   = diag[i] - ai[i];
+        v   = a->a + ai[i];
+        sum = b[i];
+        MatSeqAIJDeltaMinusDot(ad,sum,x,i,v,ai[i],n);
+        t[i] = sum;
+        x[i] = sum*idiag[i];
+      }
+      xb   = t;
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        n   = ai[i+1] - diag[i] - 1;
+        v   = a->a + diag[i] + 1;
+        sum = xb[i];
+        MatSeqAIJDeltaMinusDot(ad,sum,x,i,v,diag[i]+1,n);
+        if (xb == b) {
+          x[i] = sum*idiag[i];
+        } else {
+          x[i] = (1-omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        /* lower */
+        n   = diag[i] - ai[i];
+        v   = a->a + ai[i];
+        sum = b[i];
+        MatSeqAIJDeltaMinusDot(ad,sum,x,i,v,ai[i],n);
+        t[i] = sum;             /* save application of the lower-triangular part */
+        /* upper */
+        n   = ai[i+1] - diag[i] - 1;
+        v   = a->a + diag[i] + 1;
+        MatSeqAIJDeltaMinusDot(ad,sum,x,i,v,diag[i]+1,n);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      xb   = t;
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        sum = xb[i];
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          n   = ai[i+1] - ai[i];
+          v   = a->a + ai[i];
+          MatSeqAIJDeltaMinusDot(ad,sum,x,i,v,ai[i],n);
+          x[i] = (1. - omega)*x[i] + (sum + mdiag[i]*x[i])*idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          n   = ai[i+1] - diag[i] - 1;
+          v   = a->a + diag[i] + 1;
+          MatSeqAIJDeltaMinusDot(ad,sum,x,i,v,diag[i]+1,n);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+      } else {
+        ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJDelta converts a SeqAIJ matrix into a
+ * SeqAIJDelta matrix.  This routine is called by the MatCreate_SeqAIJDelta()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJDelta one. */
+#undef __FUNCT__
+#define __FUNCT__ "MatConvert_SeqAIJ_SeqAIJDelta"
+PETSC_EXTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode  ierr;
+  Mat             B = *newmat;
+  Mat_SeqAIJDelta *ad;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  ierr     = PetscNewLog(B,Mat_SeqAIJDelta,&ad);CHKERRQ(ierr);
+  B->spptr = (void*)ad;
+  ad->bits = 16;
+  ierr     = PetscOptionsGetInt(((PetscObject)B)->prefix,"-mat_aijdelta_bits",&ad->bits,NULL);CHKERRQ(ierr);
+  if (ad->bits != 16 && ad->bits != 32) SETERRQ1(PetscObjectComm((PetscObject)B),PETSC_ERR_ARG_OUTOFRANGE,"Column offsets must have 16 or 32 bits, not %D",ad->bits);
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJDelta;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJDelta;
+  B->ops->destroy     = MatDestroy_SeqAIJDelta;
+  B->ops->zerorows    = MatZeroRows_SeqAIJDelta;
+
+  /* If A has already been assembled, compute the offsets; this also sets the multiply and SOR kernels. */
+  if (A->assembled) {
+    Mat_SeqAIJ *b = (Mat_SeqAIJ*)B->data;
+
+    /* drop the inode routines Mat_CheckInode() may have installed */
+    b->inode.use              = PETSC_FALSE;
+    B->ops->getrowij          = MatGetRowIJ_SeqAIJ;
+    B->ops->restorerowij      = MatRestoreRowIJ_SeqAIJ;
+    B->ops->getcolumnij       = MatGetColumnIJ_SeqAIJ;
+    B->ops->restorecolumnij   = MatRestoreColumnIJ_SeqAIJ;
+    B->ops->coloringpatch     = 0;
+    B->ops->multdiagonalblock = 0;
+
+    ierr = MatSeqAIJDelta_CreateDeltas(B);CHKERRQ(ierr);
+  }
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijdelta_seqaij_C",MatConvert_SeqAIJDelta_SeqAIJ);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJDELTA);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCreateSeqAIJDelta"
+/*@C
+   MatCreateSeqAIJDelta - Creates a sparse matrix of type SEQAIJDELTA.
+   This type inherits from AIJ, but stores the column indices used by the matrix-vector
+   products and SOR as a base column per row plus 16 bit (or 32 bit) offsets from it,
+   reducing the memory traffic of these operations.
+
+   Collective on MPI_Comm
+
+   Input Parameters:
++  comm - MPI communicator, set to PETSC_COMM_SELF
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows)
+-  nnz - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or NULL
+
+   Output Parameter:
+.  A - the matrix
+
+   Notes:
+   If nnz is given then nz is ignored
+
+   Level: intermediate
+
+.keywords: matrix, sparse, compressed, index
+
+.seealso: MatCreate(), MatCreateMPIAIJDelta(), MatSetValues(), MATSEQAIJDELTA
+@*/
+PetscErrorCode  MatCreateSeqAIJDelta(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,const PetscInt nnz[],Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,n,m,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJDELTA);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(*A,nz,nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATSEQAIJDELTA - MATSEQAIJDELTA = "seqaijdelta" - A sequential AIJ matrix that additionally stores each
+   column index as the smallest column of its row plus a 16 bit offset from it, or a 32 bit offset if some
+   row spans 65536 or more columns.  MatMult(), MatMultAdd() and MatSOR() read these offsets instead of the
+   PetscInt column indices, which for matrices with narrow rows (for example from PDEs on well ordered
+   meshes) cuts the index traffic by a factor of two to four.  All other operations are those of MATSEQAIJ.
+
+   Options Database Keys:
++ -mat_type seqaijdelta - sets the matrix type to "seqaijdelta" during a call to MatSetFromOptions()
+- -mat_aijdelta_bits <16,32> - use 32 bit offsets even when 16 bits would suffice
+
+   Notes:
+   The PetscInt column indices are kept for the other operations, so the matrix uses more memory than MATSEQAIJ.
+   Inodes are not used with this format.
+
+   Level: beginner
+
+.seealso: MatCreateSeqAIJDelta(), MATAIJDELTA, MATMPIAIJDELTA, MATSEQAIJ
+M*/
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCreate_SeqAIJDelta"
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJDelta(A,MATSEQAIJDELTA,MAT_REUSE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -4065,9 +4065,22 @@ PetscErrorCode MatMultDiagonalBlock_SeqAIJ_Inode(Mat A,Vec bb,Vec xx)
   PetscFunctionReturn(0);
 }
 
+/*
+    Inode size limit inside a variable block of size bs: a block larger than the limit is split into
+    pieces of nearly equal size, a block of 6 gives two inodes of 3 rather than 5 and 1
+*/
+PETSC_STATIC_INLINE PetscInt Mat_InodeBlockLimit(PetscInt bs,PetscInt limit)
+{
+  PetscInt npieces = (bs + limit - 1)/limit;
+  return (bs + npieces - 1)/npieces;
+}
+
 /*
     samestructure indicates that the matrix has not changed its nonzero structure so we
     do not need to recompute the inodes
+
+    If variable block sizes were provided with MatSetVariableBlockSizes() an inode never
+    crosses a block boundary, so the inodes match the physical nodes of the problem
 */
 #undef __FUNCT__
 #define __FUNCT__ "Mat_CheckInode"
@@ -4075,7 +4088,7 @@ PetscErrorCode Mat_CheckInode(Mat A,PetscBool samestructure)
 {
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
   PetscErrorCode ierr;
-  PetscInt       i,j,m,nzx,nzy,*idx,*idy,*ns,*ii,node_count,blk_size;
+  PetscInt       i,j,m,nzx,nzy,*idx,*idy,*ns,*ii,node_count,blk_size,blk = 0,blk_end,limit;
   PetscBool      flag;
 
   PetscFunctionBegin;
@@ -4093,10 +4106,17 @@ PetscErrorCode Mat_CheckInode(Mat A,PetscBool samestructure)
   node_count = 0;
   idx        = a->j;
   ii         = a->i;
+  blk_end    = A->nblocks ? A->bsizes[0] : m;
+  limit      = A->nblocks ? Mat_InodeBlockLimit(A->bsizes[0],a->inode.limit) : a->inode.limit;
   while (i < m) {                /* For each row */
+    if (i == blk_end) {
+      blk++;
+      blk_end += A->bsizes[blk];
+      limit    = Mat_InodeBlockLimit(A->bsizes[blk],a->inode.limit);
+    }
     nzx = ii[i+1] - ii[i];       /* Number of nonzeros */
     /* Limits the number of elements in a node to 'a->inode.limit' */
-    for (j=i+1,idy=idx,blk_size=1; j<m && blk_size <a->inode.limit; ++j,++blk_size) {
+    for (j=i+1,idy=idx,blk_size=1; j<blk_end && blk_size <limit; ++j,++blk_size) {
       nzy = ii[j+1] - ii[j];     /* Same number of nonzeros */
       if (nzy != nzx) break;
       idy += nzx;              /* Same nonzero pattern */
@@ -4218,7 +4238,7 @@ PetscErrorCode Mat_CheckInode_FactorLU(Mat A,PetscBool samestructure)
 {
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
   PetscErrorCode ierr;
-  PetscInt       i,j,m,nzl1,nzu1,nzl2,nzu2,nzx,nzy,node_count,blk_size;
+  PetscInt       i,j,m,nzl1,nzu1,nzl2,nzu2,nzx,nzy,node_count,blk_size,blk = 0,blk_end,limit;
   PetscInt       *cols1,*cols2,*ns,*ai = a->i,*aj = a->j, *adiag = a->diag;
   PetscBool      flag;
 
@@ -4234,7 +4254,14 @@ PetscErrorCode Mat_CheckInode_FactorLU(Mat A,PetscBool samestructure)
 
   i          = 0;
   node_count = 0;
+  blk_end    = A->nblocks ? A->bsizes[0] : m;
+  limit      = A->nblocks ? Mat_InodeBlockLimit(A->bsizes[0],a->inode.limit) : a->inode.limit;
   while (i < m) {                /* For each row */
+    if (i == blk_end) {
+      blk++;
+      blk_end += A->bsizes[blk];
+      limit    = Mat_InodeBlockLimit(A->bsizes[blk],a->inode.limit);
+    }
     nzl1 = ai[i+1] - ai[i];       /* Number of nonzeros in L */
     nzu1 = adiag[i] - adiag[i+1] - 1; /* Number of nonzeros in U excluding diagonal*/
     nzx  = nzl1 + nzu1 + 1;
@@ -4242,7 +4269,7 @@ PetscErrorCode Mat_CheckInode_FactorLU(Mat A,PetscBool samestructure)
     MatGetRow_FactoredLU(cols1,nzl1,nzu1,nzx,ai,aj,adiag,i);
 
     /* Limits the number of elements in a node to 'a->inode.limit' */
-    for (j=i+1,blk_size=1; j<m && blk_size <a->inode.limit; ++j,++blk_size) {
+    for (j=i+1,blk_size=1; j<blk_end && blk_size <limit; ++j,++blk_size) {
       nzl2 = ai[j+1] - ai[j];
       nzu2 = adiag[j] - adiag[j+1] - 1;
       nzy  = nzl2 + nzu2 + 1;
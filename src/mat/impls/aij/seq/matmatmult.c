@@ -7,7 +7,11 @@
 #include <../src/mat/impls/aij/seq/aij.h> /*I "petscmat.h" I*/
 #include <../src/mat/utils/freespace.h>
 #include <../src/mat/utils/petscheap.h>
+#include <../src/sys/utils/hash.h>
 #include <petscbt.h>
+#if defined(PETSC_THREADCOMM_ACTIVE)
+#include <petscthreadcomm.h>
+#endif
 #include <../src/mat/impls/dense/seq/dense.h>
 #include <petsctime.h>
 
@@ -18,13 +22,13 @@ static PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat,Mat,Petsc
 PetscErrorCode MatMatMult_SeqAIJ_SeqAIJ(Mat A,Mat B,MatReuse scall,PetscReal fill,Mat *C)
 {
   PetscErrorCode ierr;
-  const char     *algTypes[6] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed"};
+  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","hash"};
   PetscInt       alg=0; /* set default algorithm */
 
   PetscFunctionBegin;
   if (scall == MAT_INITIAL_MATRIX) {
     ierr = PetscObjectOptionsBegin((PetscObject)A);CHKERRQ(ierr);
-    ierr = PetscOptionsEList("-matmatmult_via","Algorithmic approach","MatMatMult",algTypes,6,algTypes[0],&alg,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsEList("-matmatmult_via","Algorithmic approach","MatMatMult",algTypes,7,algTypes[0],&alg,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsEnd();CHKERRQ(ierr);
     ierr = PetscLogEventBegin(MAT_MatMultSymbolic,A,B,0,0);CHKERRQ(ierr);
     switch (alg) {
@@ -43,6 +47,9 @@ PetscErrorCode MatMatMult_SeqAIJ_SeqAIJ(Mat A,Mat B,MatReuse scall,PetscReal fil
     case 5:
       ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(A,B,fill,C);CHKERRQ(ierr);
       break;
+    case 6:
+      ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(A,B,fill,C);CHKERRQ(ierr);
+      break;
     default:
       ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(A,B,fill,C);CHKERRQ(ierr);
      break;
@@ -719,6 +726,189 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat A,Mat B,PetscReal fil
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash"
+/* accumulate the column indices of each row of C in a hash set, then sort them */
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,PetscReal fill,Mat *C)
+{
+  PetscErrorCode     ierr;
+  Mat_SeqAIJ         *a  = (Mat_SeqAIJ*)A->data,*b=(Mat_SeqAIJ*)B->data,*c;
+  const PetscInt     *ai = a->i,*bi=b->i,*aj=a->j,*bj=b->j;
+  PetscInt           *ci,*cj;
+  PetscInt           am=A->rmap->N,bn=B->cmap->N,bm=B->rmap->N;
+  MatScalar          *ca;
+  PetscReal          afill;
+  PetscInt           i,j,k,brow,cnzi,ndouble=0;
+  PetscFreeSpaceList free_space=NULL,current_space=NULL;
+  PetscHashI         ht;
+
+  PetscFunctionBegin;
+  /* Allocate arrays for fill computation and free space for accumulating nonzero column */
+  ierr  = PetscMalloc(((am+1)+1)*sizeof(PetscInt),&ci);CHKERRQ(ierr);
+  ci[0] = 0;
+
+  /* Initial FreeSpace size is fill*(nnz(A)+nnz(B)) */
+  ierr          = PetscFreeSpaceGet((PetscInt)(fill*(ai[am]+bi[bm])),&free_space);CHKERRQ(ierr);
+  current_space = free_space;
+
+  PetscHashICreate(ht);
+  /* Determine ci and cj */
+  for (i=0; i<am; i++) {
+    PetscHashIClear(ht);
+    for (j=ai[i]; j<ai[i+1]; j++) {
+      brow = aj[j];
+      for (k=bi[brow]; k<bi[brow+1]; k++) PetscHashIAdd(ht,bj[k],0);
+    }
+    PetscHashISize(ht,cnzi);
+
+    /* If free space is not available, make more free space */
+    /* Double the amount of total space in the list */
+    if (current_space->local_remaining<cnzi) {
+      ierr = PetscFreeSpaceGet(cnzi+current_space->total_array_size,&current_space);CHKERRQ(ierr);
+      ndouble++;
+    }
+
+    /* Copy the hashed column indices into free space and sort them */
+    if (cnzi) {
+      k = 0;
+      PetscHashIGetKeys(ht,k,current_space->array);
+      ierr = PetscSortInt(cnzi,current_space->array);CHKERRQ(ierr);
+    }
+
+    current_space->array           += cnzi;
+    current_space->local_used      += cnzi;
+    current_space->local_remaining -= cnzi;
+
+    ci[i+1] = ci[i] + cnzi;
+  }
+  PetscHashIDestroy(ht);
+
+  /* Column indices are in the list of free space */
+  /* Allocate space for cj, initialize cj, and */
+  /* destroy list of free space and other temporary array(s) */
+  ierr = PetscMalloc((ci[am]+1)*sizeof(PetscInt),&cj);CHKERRQ(ierr);
+  ierr = PetscFreeSpaceContiguous(&free_space,cj);CHKERRQ(ierr);
+
+  /* Allocate space for ca */
+  /*-----------------------*/
+  ierr = PetscMalloc((ci[am]+1)*sizeof(MatScalar),&ca);CHKERRQ(ierr);
+  ierr = PetscMemzero(ca,(ci[am]+1)*sizeof(MatScalar));CHKERRQ(ierr);
+
+  /* put together the new symbolic matrix */
+  ierr = MatCreateSeqAIJWithArrays(PetscObjectComm((PetscObject)A),am,bn,ci,cj,ca,C);CHKERRQ(ierr);
+
+  (*C)->rmap->bs = A->rmap->bs;
+  (*C)->cmap->bs = B->cmap->bs;
+
+  /* MatCreateSeqAIJWithArrays flags matrix so PETSc doesn't free the user's arrays. */
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ*)((*C)->data);
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  (*C)->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am]/(ai[am]+bi[bm]) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                     = ci[am];
+  c->nz                        = ci[am];
+  (*C)->info.mallocs           = ndouble;
+  (*C)->info.fill_ratio_given  = fill;
+  (*C)->info.fill_ratio_needed = afill;
+
+#if defined(PETSC_USE_INFO)
+  if (ci[am]) {
+    ierr = PetscInfo3((*C),"Reallocs %D; Fill ratio: given %G needed %G.\n",ndouble,fill,afill);CHKERRQ(ierr);
+    ierr = PetscInfo1((*C),"Use MatMatMult(A,B,MatReuse,%G,&C) for best performance.;\n",afill);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo((*C),"Empty matrix product\n");CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash_Private"
+/*
+   Computes rows [start,end) of C = A*B; the hash table ht maps the column indices of a row of C to
+   their location in the row. Rows are independent, so disjoint row ranges may be computed concurrently.
+*/
+static PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash_Private(Mat A,Mat B,Mat C,PetscInt start,PetscInt end,PetscHashI ht)
+{
+  Mat_SeqAIJ  *a = (Mat_SeqAIJ*)A->data,*b=(Mat_SeqAIJ*)B->data,*c=(Mat_SeqAIJ*)C->data;
+  PetscInt    *ai=a->i,*aj=a->j,*bi=b->i,*bj=b->j,*ci=c->i,*cj=c->j,*bjj,*cjj;
+  PetscInt    i,j,k,brow,bnzi,cnzi,loc;
+  PetscScalar *aa=a->a,*ba=b->a,*baj,*ca=c->a,*caj,valtmp;
+
+  for (i=start; i<end; i++) {
+    cnzi = ci[i+1] - ci[i];
+    cjj  = cj + ci[i];
+    caj  = ca + ci[i];
+    PetscHashIClear(ht);
+    for (k=0; k<cnzi; k++) {
+      caj[k] = 0.0;
+      PetscHashIAdd(ht,cjj[k],k);
+    }
+    for (j=ai[i]; j<ai[i+1]; j++) {
+      brow   = aj[j];
+      bnzi   = bi[brow+1] - bi[brow];
+      bjj    = bj + bi[brow];
+      baj    = ba + bi[brow];
+      valtmp = aa[j];
+      for (k=0; k<bnzi; k++) {
+        PetscHashIMap(ht,bjj[k],loc);
+        caj[loc] += valtmp*baj[k];
+      }
+    }
+  }
+  return 0;
+}
+
+#if defined(PETSC_THREADCOMM_ACTIVE)
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash_Kernel(PetscInt thread_id,Mat A,Mat B,Mat C)
+{
+  PetscErrorCode ierr;
+  PetscInt       *trstarts=C->rmap->trstarts;
+  PetscHashI     ht;
+
+  PetscHashICreate(ht);
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash_Private(A,B,C,trstarts[thread_id],trstarts[thread_id+1],ht);CHKERRQ(ierr);
+  PetscHashIDestroy(ht);
+  return 0;
+}
+#endif
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash"
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode ierr;
+  PetscLogDouble flops=0.0;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b=(Mat_SeqAIJ*)B->data;
+  PetscInt       *ai=a->i,*aj=a->j,*bi=b->i;
+  PetscInt       am=A->rmap->N,j;
+#if !defined(PETSC_THREADCOMM_ACTIVE)
+  PetscHashI     ht;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_THREADCOMM_ACTIVE)
+  ierr = PetscThreadCommRunKernel(PetscObjectComm((PetscObject)C),(PetscThreadKernel)MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash_Kernel,3,A,B,C);CHKERRQ(ierr);
+#else
+  PetscHashICreate(ht);
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash_Private(A,B,C,0,am,ht);CHKERRQ(ierr);
+  PetscHashIDestroy(ht);
+#endif
+  for (j=0; j<ai[am]; j++) flops += 2*(bi[aj[j]+1] - bi[aj[j]]);
+
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatMatMultSymbolic_SeqAIJ_SeqAIJ"
 /* concatenate unique entries and then sort */
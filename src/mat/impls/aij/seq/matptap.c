@@ -6,6 +6,7 @@
 
 #include <../src/mat/impls/aij/seq/aij.h>   /*I "petscmat.h" I*/
 #include <../src/mat/utils/freespace.h>
+#include <../src/sys/utils/hash.h>
 #include <petscbt.h>
 #include <petsctime.h>
 
@@ -14,7 +15,7 @@
 PetscErrorCode MatPtAP_SeqAIJ_SeqAIJ(Mat A,Mat P,MatReuse scall,PetscReal fill,Mat *C)
 {
   PetscErrorCode ierr;
-  const char     *algTypes[2] = {"scalable","nonscalable"};
+  const char     *algTypes[4] = {"scalable","nonscalable","allatonce","hash"};
   PetscInt       alg=0; /* set default algorithm */
 
   PetscFunctionBegin;
@@ -23,15 +24,20 @@ PetscErrorCode MatPtAP_SeqAIJ_SeqAIJ(Mat A,Mat P,MatReuse scall,PetscReal fill,M
      Alg 'scalable' determines which implementations to be used:
        "nonscalable": do dense axpy in MatPtAPNumeric() - fastest, but requires storage of struct A*P;
        "scalable":    do two sparse axpy in MatPtAPNumeric() - might slow, does not store structure of A*P. 
+       "allatonce":   same as "scalable" for sequential matrices, selects the all-at-once algorithm for MPIAIJ.
+       "hash":        accumulate rows of A*P and C in hash tables - stores neither A*P nor P^T.
      */
     ierr = PetscObjectOptionsBegin((PetscObject)A);CHKERRQ(ierr);
-    ierr = PetscOptionsEList("-matptap_via","Algorithmic approach","MatPtAP",algTypes,2,algTypes[0],&alg,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsEList("-matptap_via","Algorithmic approach","MatPtAP",algTypes,4,algTypes[0],&alg,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsEnd();CHKERRQ(ierr);
     ierr = PetscLogEventBegin(MAT_PtAPSymbolic,A,P,0,0);CHKERRQ(ierr);
     switch (alg) {
     case 1:
       ierr = MatPtAPSymbolic_SeqAIJ_SeqAIJ_DenseAxpy(A,P,fill,C);CHKERRQ(ierr);
       break;
+    case 3:
+      ierr = MatPtAPSymbolic_SeqAIJ_SeqAIJ_Hash(A,P,fill,C);CHKERRQ(ierr);
+      break;
     default:
       ierr = MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(A,P,fill,C);CHKERRQ(ierr);
       break;
@@ -334,6 +340,182 @@ PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_DenseAxpy(Mat A,Mat P,PetscReal fil
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "MatPtAPSymbolic_SeqAIJ_SeqAIJ_Hash"
+/*
+   Forms one row of A*P at a time in a hash set and adds its column indices to the hash sets of the rows of C
+   given by the column indices of the corresponding row of P; neither A*P nor P^T is stored.
+*/
+PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Hash(Mat A,Mat P,PetscReal fill,Mat *C)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*p = (Mat_SeqAIJ*)P->data,*c;
+  PetscInt       *ai=a->i,*aj=a->j,*pi=p->i,*pj=p->j,*ci,*cj,*apj;
+  PetscInt       am=A->rmap->N,pn=P->cmap->N,pm=P->rmap->N;
+  PetscInt       i,j,k,prow,crow,apnz,rmax=0,cnzi;
+  PetscHashI     ht,*htc;
+  MatScalar      *ca;
+  Mat_PtAP       *ptap;
+  PetscReal      afill;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc(pn*sizeof(PetscHashI),&htc);CHKERRQ(ierr);
+  for (i=0; i<pn; i++) PetscHashICreate(htc[i]);
+  PetscHashICreate(ht);
+  apj = NULL;
+  for (i=0; i<am; i++) {
+    /* column indices of the i-th row of A*P */
+    PetscHashIClear(ht);
+    for (j=ai[i]; j<ai[i+1]; j++) {
+      prow = aj[j];
+      for (k=pi[prow]; k<pi[prow+1]; k++) PetscHashIAdd(ht,pj[k],0);
+    }
+    PetscHashISize(ht,apnz);
+    if (!apnz) continue;
+    if (apnz > rmax) {
+      rmax = PetscMax(apnz,2*rmax);
+      ierr = PetscFree(apj);CHKERRQ(ierr);
+      ierr = PetscMalloc(rmax*sizeof(PetscInt),&apj);CHKERRQ(ierr);
+    }
+    k = 0;
+    PetscHashIGetKeys(ht,k,apj);
+    /* (A*P)[i,:] contributes to the rows of C given by P[i,:] */
+    for (j=pi[i]; j<pi[i+1]; j++) {
+      crow = pj[j];
+      for (k=0; k<apnz; k++) PetscHashIAdd(htc[crow],apj[k],0);
+    }
+  }
+  PetscHashIDestroy(ht);
+  ierr = PetscFree(apj);CHKERRQ(ierr);
+
+  ierr  = PetscMalloc((pn+1)*sizeof(PetscInt),&ci);CHKERRQ(ierr);
+  ci[0] = 0;
+  for (i=0; i<pn; i++) {
+    PetscHashISize(htc[i],cnzi);
+    ci[i+1] = ci[i] + cnzi;
+  }
+  ierr = PetscMalloc((ci[pn]+1)*sizeof(PetscInt),&cj);CHKERRQ(ierr);
+  for (i=0; i<pn; i++) {
+    k = ci[i];
+    if (ci[i+1] > ci[i]) PetscHashIGetKeys(htc[i],k,cj);
+    PetscHashIDestroy(htc[i]);
+    ierr = PetscSortInt(ci[i+1]-ci[i],cj+ci[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(htc);CHKERRQ(ierr);
+
+  /* Allocate space for ca */
+  ierr = PetscMalloc((ci[pn]+1)*sizeof(MatScalar),&ca);CHKERRQ(ierr);
+  ierr = PetscMemzero(ca,(ci[pn]+1)*sizeof(MatScalar));CHKERRQ(ierr);
+
+  /* put together the new matrix */
+  ierr = MatCreateSeqAIJWithArrays(PetscObjectComm((PetscObject)A),pn,pn,ci,cj,ca,C);CHKERRQ(ierr);
+
+  (*C)->rmap->bs = P->cmap->bs;
+  (*C)->cmap->bs = P->cmap->bs;
+
+  /* MatCreateSeqAIJWithArrays flags matrix so PETSc doesn't free the user's arrays. */
+  /* Since these are PETSc arrays, change flags to free them as necessary. */
+  c          = (Mat_SeqAIJ*)((*C)->data);
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  /* Create a supporting struct for reuse by MatPtAPNumeric(): apj and apa hold one row of A*P */
+  ierr = PetscNew(Mat_PtAP,&ptap);CHKERRQ(ierr);
+
+  c->ptap            = ptap;
+  ptap->destroy      = (*C)->ops->destroy;
+  (*C)->ops->destroy = MatDestroy_SeqAIJ_PtAP;
+
+  ierr = PetscMalloc((rmax+1)*sizeof(PetscInt),&ptap->apj);CHKERRQ(ierr);
+  ierr = PetscMalloc((rmax+1)*sizeof(PetscScalar),&ptap->apa);CHKERRQ(ierr);
+
+  (*C)->ops->ptapnumeric = MatPtAPNumeric_SeqAIJ_SeqAIJ_Hash;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[pn]/(ai[am]+pi[pm] + 1.e-5);
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                     = ci[pn];
+  c->nz                        = ci[pn];
+  (*C)->info.mallocs           = 0;
+  (*C)->info.fill_ratio_given  = fill;
+  (*C)->info.fill_ratio_needed = afill;
+#if defined(PETSC_USE_INFO)
+  if (ci[pn] != 0) {
+    ierr = PetscInfo2((*C),"Fill ratio: given %G needed %G.\n",fill,afill);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo((*C),"Empty matrix product\n");CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatPtAPNumeric_SeqAIJ_SeqAIJ_Hash"
+PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Hash(Mat A,Mat P,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*) A->data;
+  Mat_SeqAIJ     *p = (Mat_SeqAIJ*) P->data;
+  Mat_SeqAIJ     *c = (Mat_SeqAIJ*) C->data;
+  Mat_PtAP       *ptap = c->ptap;
+  PetscInt       *ai=a->i,*aj=a->j,*pi=p->i,*pj=p->j,*ci=c->i,*cj=c->j,*cjj,*apj=ptap->apj;
+  PetscInt       am=A->rmap->N,cm=C->rmap->N;
+  PetscInt       i,j,k,prow,crow,apnz,nextap,loc;
+  MatScalar      *aa=a->a,*pa=p->a,*ca=c->a,*caj,valtmp;
+  PetscScalar    *apa=ptap->apa;
+  PetscLogDouble flops=0.0;
+  PetscHashI     ht;
+
+  PetscFunctionBegin;
+  /* Clear old values in C */
+  ierr = PetscMemzero(ca,ci[cm]*sizeof(MatScalar));CHKERRQ(ierr);
+
+  PetscHashICreate(ht);
+  for (i=0; i<am; i++) {
+    /* Form sparse row of A*P, the hash table maps a column index to its location in apj and apa */
+    PetscHashIClear(ht);
+    apnz = 0;
+    for (j=ai[i]; j<ai[i+1]; j++) {
+      prow   = aj[j];
+      valtmp = aa[j];
+      for (k=pi[prow]; k<pi[prow+1]; k++) {
+        PetscHashIMap(ht,pj[k],loc);
+        if (loc < 0) {
+          PetscHashIAdd(ht,pj[k],apnz);
+          loc      = apnz++;
+          apj[loc] = pj[k];
+          apa[loc] = 0.0;
+        }
+        apa[loc] += valtmp*pa[k];
+      }
+      flops += 2.0*(pi[prow+1] - pi[prow]);
+    }
+    ierr = PetscSortIntWithScalarArray(apnz,apj,apa);CHKERRQ(ierr);
+
+    /* Compute P^T*A*P using outer product (P^T)[:,i]*(A*P)[i,:]. */
+    for (j=pi[i]; j<pi[i+1]; j++) {
+      crow   = pj[j];
+      cjj    = cj + ci[crow];
+      caj    = ca + ci[crow];
+      valtmp = pa[j];
+      nextap = 0;
+      /* Perform sparse axpy operation.  Note cjj includes apj. */
+      for (k=0; nextap<apnz; k++) {
+        if (cjj[k] == apj[nextap]) caj[k] += valtmp*apa[nextap++];
+      }
+      flops += 2.0*apnz;
+    }
+  }
+  PetscHashIDestroy(ht);
+
+  /* Assemble the final matrix */
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* #define PROFILE_MatPtAPNumeric */
 #undef __FUNCT__
 #define __FUNCT__ "MatPtAPNumeric_SeqAIJ_SeqAIJ"
@@ -2913,6 +2913,12 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
   b    = (Mat_SeqBAIJ*)B->data;
   ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),NULL,"Optimize options for SEQBAIJ matrix 2 ","Mat");CHKERRQ(ierr);
   ierr = PetscOptionsBool("-mat_no_unroll","Do not optimize for block size (slow)",NULL,PETSC_FALSE,&flg,NULL);CHKERRQ(ierr);
+#if defined(MATSEQBAIJ_SIMD)
+#if defined(__AVX__)
+  b->usesimd = (bs >= 6) ? PETSC_TRUE : PETSC_FALSE; /* for smaller blocks the unrolled scalar kernels are as fast */
+#endif
+  ierr = PetscOptionsBool("-mat_baij_simd","Use the SIMD kernels for block sizes 2 to 8","MatCreateSeqBAIJ",b->usesimd,&b->usesimd,NULL);CHKERRQ(ierr);
+#endif
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
 
   if (!flg) {
@@ -2954,6 +2960,14 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
       B->ops->multadd = MatMultAdd_SeqBAIJ_N;
       break;
     }
+#if defined(MATSEQBAIJ_SIMD)
+    if (b->usesimd && bs >= 2 && bs <= 8) {
+      B->ops->mult             = MatMult_SeqBAIJ_SIMD;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_SIMD;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_SIMD;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_SIMD;
+    }
+#endif
   }
   B->ops->sor = MatSOR_SeqBAIJ;
   b->mbs = mbs;
@@ -3204,6 +3218,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqBAIJ(Mat C,Mat A,MatDuplicateOption cpval
   c->bs2         = a->bs2;
   c->mbs         = a->mbs;
   c->nbs         = a->nbs;
+  c->usesimd     = a->usesimd;
 
   if (a->diag) {
     if (cpvalues == MAT_SHARE_NONZERO_PATTERN) {
@@ -3440,6 +3455,8 @@ PetscErrorCode MatLoad_SeqBAIJ(Mat newmat,PetscViewer viewer)
    Options Database Keys:
 .   -mat_no_unroll - uses code that does not unroll the loops in the
                      block calculations (much slower)
+.   -mat_baij_simd <true,false> - use SSE2/AVX/AVX-512 kernels for block sizes 2 to 8, including the LU/ILU
+                     factorization and solve (default true for bs >= 6 when PETSc is compiled for AVX)
 .    -mat_block_size - size of the blocks to use
 
    Level: intermediate
@@ -3495,6 +3512,8 @@ PetscErrorCode  MatCreateSeqBAIJ(MPI_Comm comm,PetscInt bs,PetscInt m,PetscInt n
    Options Database Keys:
 .   -mat_no_unroll - uses code that does not unroll the loops in the
                      block calculations (much slower)
+.   -mat_baij_simd <true,false> - use SSE2/AVX/AVX-512 kernels for block sizes 2 to 8, including the LU/ILU
+                     factorization and solve (default true for bs >= 6 when PETSc is compiled for AVX)
 .    -mat_block_size - size of the blocks to use
 
    Level: intermediate
@@ -28,6 +28,7 @@
 typedef struct {
   SEQAIJHEADER(MatScalar);
   SEQBAIJHEADER;
+  PetscBool usesimd;                 /* use the SIMD kernels of baijsimd.c for 2 <= bs <= 8 */
 } Mat_SeqBAIJ;
 
 PETSC_EXTERN PetscErrorCode MatSeqBAIJSetPreallocation_SeqBAIJ(Mat,PetscInt,PetscInt,PetscInt*);
@@ -211,6 +212,20 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_6(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_7(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_N(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatLoad_SeqBAIJ(Mat,PetscViewer);
+
+/*
+   SIMD kernels for block sizes 2 to 8 (baijsimd.c); they are compiled when the compiler targets
+   SSE2, AVX or AVX-512 and the matrix entries are real doubles
+*/
+#if !defined(PETSC_USE_COMPLEX) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_REAL_MAT_SINGLE) && (defined(__SSE2__) || defined(__AVX__) || defined(__AVX512F__))
+#define MATSEQBAIJ_SIMD
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultTranspose_SeqBAIJ_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqBAIJ_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_SIMD_NaturalOrdering(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqBAIJ_SIMD(Mat,Mat,const MatFactorInfo*);
+#endif
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization_inplace(Mat,PetscBool);
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat,PetscBool);
 
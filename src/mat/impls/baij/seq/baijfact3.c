@@ -13,6 +13,12 @@
 PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat fact,PetscBool natural)
 {
   PetscFunctionBegin;
+#if defined(MATSEQBAIJ_SIMD)
+  if (((Mat_SeqBAIJ*)fact->data)->usesimd && fact->rmap->bs >= 2 && fact->rmap->bs <= 8) {
+    fact->ops->lufactornumeric = MatLUFactorNumeric_SeqBAIJ_SIMD;
+    PetscFunctionReturn(0);
+  }
+#endif
   if (natural) {
     switch (fact->rmap->bs) {
     case 1:
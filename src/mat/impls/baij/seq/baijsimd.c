@@ -0,0 +1,584 @@
+
+/*
+    SIMD versions of the SeqBAIJ matrix-vector products, triangular solves and LU/ILU
+    numeric factorization for block sizes 2 to 8.
+
+    A block is stored column major, so each block column is a contiguous vector of bs entries.
+    All the kernels are written as column updates y += A(:,c)*x(c) (or dot products with block
+    columns for the transpose) on ceil(bs/width) SIMD registers, the last one loaded and stored
+    with a mask (AVX, AVX-512) or as a single double (SSE2) when bs is not a multiple of the
+    register width. Every public routine switches on the block size and calls an inlined kernel
+    with a literal bs so that the compiler can fully unroll each instance.
+
+    The instruction set is chosen at compile time, the widest of AVX-512F, AVX and SSE2 that the
+    compiler targets; see MATSEQBAIJ_SIMD in baij.h.
+*/
+#include <../src/mat/impls/baij/seq/baij.h>
+#include <petsc-private/kernels/blockinvert.h>
+#include <petscthreadcomm.h>
+
+#if defined(MATSEQBAIJ_SIMD)
+
+#if defined(__AVX__) || defined(__AVX512F__)
+#  include <immintrin.h>
+#else
+#  include <emmintrin.h>
+#endif
+
+#if defined(__AVX512F__)
+#define BAIJSIMD_WIDTH 8
+typedef __m512d BAIJSIMDVec;
+#define BAIJSIMDZero()            _mm512_setzero_pd()
+#define BAIJSIMDSet1(a)           _mm512_set1_pd(a)
+#define BAIJSIMDMultAdd(a,b,c)    _mm512_fmadd_pd(a,b,c)
+#define BAIJSIMDMultSub(a,b,c)    _mm512_fnmadd_pd(a,b,c)
+PETSC_STATIC_INLINE BAIJSIMDVec BAIJSIMDLoad(const PetscScalar *p,PetscInt n)
+{
+  if (n == 8) return _mm512_loadu_pd(p);
+  return _mm512_maskz_loadu_pd((__mmask8)((1 << n) - 1),p);
+}
+PETSC_STATIC_INLINE void BAIJSIMDStore(PetscScalar *p,BAIJSIMDVec a,PetscInt n)
+{
+  if (n == 8) _mm512_storeu_pd(p,a);
+  else _mm512_mask_storeu_pd(p,(__mmask8)((1 << n) - 1),a);
+}
+#elif defined(__AVX__)
+#define BAIJSIMD_WIDTH 4
+typedef __m256d BAIJSIMDVec;
+#define BAIJSIMDZero()            _mm256_setzero_pd()
+#define BAIJSIMDSet1(a)           _mm256_set1_pd(a)
+#if defined(__FMA__)
+#define BAIJSIMDMultAdd(a,b,c)    _mm256_fmadd_pd(a,b,c)
+#define BAIJSIMDMultSub(a,b,c)    _mm256_fnmadd_pd(a,b,c)
+#else
+#define BAIJSIMDMultAdd(a,b,c)    _mm256_add_pd(c,_mm256_mul_pd(a,b))
+#define BAIJSIMDMultSub(a,b,c)    _mm256_sub_pd(c,_mm256_mul_pd(a,b))
+#endif
+PETSC_STATIC_INLINE __m256i BAIJSIMDMask(PetscInt n)
+{
+  return _mm256_set_epi64x(0,n > 2 ? -1 : 0,n > 1 ? -1 : 0,-1);
+}
+PETSC_STATIC_INLINE BAIJSIMDVec BAIJSIMDLoad(const PetscScalar *p,PetscInt n)
+{
+  if (n == 4) return _mm256_loadu_pd(p);
+  return _mm256_maskload_pd(p,BAIJSIMDMask(n));
+}
+PETSC_STATIC_INLINE void BAIJSIMDStore(PetscScalar *p,BAIJSIMDVec a,PetscInt n)
+{
+  if (n == 4) _mm256_storeu_pd(p,a);
+  else _mm256_maskstore_pd(p,BAIJSIMDMask(n),a);
+}
+#else
+#define BAIJSIMD_WIDTH 2
+typedef __m128d BAIJSIMDVec;
+#define BAIJSIMDZero()            _mm_setzero_pd()
+#define BAIJSIMDSet1(a)           _mm_set1_pd(a)
+#define BAIJSIMDMultAdd(a,b,c)    _mm_add_pd(c,_mm_mul_pd(a,b))
+#define BAIJSIMDMultSub(a,b,c)    _mm_sub_pd(c,_mm_mul_pd(a,b))
+PETSC_STATIC_INLINE BAIJSIMDVec BAIJSIMDLoad(const PetscScalar *p,PetscInt n)
+{
+  if (n == 2) return _mm_loadu_pd(p);
+  return _mm_load_sd(p);
+}
+PETSC_STATIC_INLINE void BAIJSIMDStore(PetscScalar *p,BAIJSIMDVec a,PetscInt n)
+{
+  if (n == 2) _mm_storeu_pd(p,a);
+  else _mm_store_sd(p,a);
+}
+#endif
+
+/* number of registers holding a block column and the number of entries in the k-th of them */
+#define BAIJSIMD_MAXREG   (8/BAIJSIMD_WIDTH)
+#define BAIJSIMDNReg(bs)  (((bs)+BAIJSIMD_WIDTH-1)/BAIJSIMD_WIDTH)
+#define BAIJSIMDLen(bs,k) PetscMin(BAIJSIMD_WIDTH,(bs)-(k)*BAIJSIMD_WIDTH)
+
+PETSC_STATIC_INLINE PetscScalar BAIJSIMDSum(BAIJSIMDVec a)
+{
+  PetscScalar t[BAIJSIMD_WIDTH],s = 0.0;
+  PetscInt    i;
+
+  BAIJSIMDStore(t,a,BAIJSIMD_WIDTH);
+  for (i=0; i<BAIJSIMD_WIDTH; i++) s += t[i];
+  return s;
+}
+
+/*
+   BAIJSIMDRow - z = y - sum_j A_j x(idx[j]) (sub) or z = y + sum_j A_j x(idx[j]), over the n blocks A_j of
+   a block row; y may be NULL for zero and may equal z
+*/
+PETSC_STATIC_INLINE void BAIJSIMDRow(const PetscInt bs,PetscInt n,const PetscInt *idx,const MatScalar *v,const PetscScalar *x,const PetscScalar *y,PetscScalar *z,PetscBool sub)
+{
+  const PetscInt    nreg = BAIJSIMDNReg(bs);
+  BAIJSIMDVec       acc[BAIJSIMD_MAXREG],xc;
+  const PetscScalar *xb;
+  PetscInt          j,c,k;
+
+  for (k=0; k<nreg; k++) acc[k] = y ? BAIJSIMDLoad(y+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k)) : BAIJSIMDZero();
+  for (j=0; j<n; j++) {
+    xb = x + bs*idx[j];
+    for (c=0; c<bs; c++) {
+      xc = BAIJSIMDSet1(xb[c]);
+      if (sub) {
+        for (k=0; k<nreg; k++) acc[k] = BAIJSIMDMultSub(BAIJSIMDLoad(v+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k)),xc,acc[k]);
+      } else {
+        for (k=0; k<nreg; k++) acc[k] = BAIJSIMDMultAdd(BAIJSIMDLoad(v+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k)),xc,acc[k]);
+      }
+      v += bs;
+    }
+  }
+  for (k=0; k<nreg; k++) BAIJSIMDStore(z+k*BAIJSIMD_WIDTH,acc[k],BAIJSIMDLen(bs,k));
+}
+
+/* BAIJSIMDBlockMult - z = A x (sub false) or z = y - A x (sub true) for a single block; z may equal y but not x */
+PETSC_STATIC_INLINE void BAIJSIMDBlockMult(const PetscInt bs,const MatScalar *v,const PetscScalar *x,const PetscScalar *y,PetscScalar *z,PetscBool sub)
+{
+  const PetscInt nreg = BAIJSIMDNReg(bs);
+  BAIJSIMDVec    acc[BAIJSIMD_MAXREG],xc;
+  PetscInt       c,k;
+
+  for (k=0; k<nreg; k++) acc[k] = sub ? BAIJSIMDLoad(y+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k)) : BAIJSIMDZero();
+  for (c=0; c<bs; c++) {
+    xc = BAIJSIMDSet1(x[c]);
+    if (sub) {
+      for (k=0; k<nreg; k++) acc[k] = BAIJSIMDMultSub(BAIJSIMDLoad(v+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k)),xc,acc[k]);
+    } else {
+      for (k=0; k<nreg; k++) acc[k] = BAIJSIMDMultAdd(BAIJSIMDLoad(v+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k)),xc,acc[k]);
+    }
+    v += bs;
+  }
+  for (k=0; k<nreg; k++) BAIJSIMDStore(z+k*BAIJSIMD_WIDTH,acc[k],BAIJSIMDLen(bs,k));
+}
+
+/* BAIJSIMDBlockMultTransposeAdd - z += A^T x for a single block */
+PETSC_STATIC_INLINE void BAIJSIMDBlockMultTransposeAdd(const PetscInt bs,const MatScalar *v,const BAIJSIMDVec *xr,PetscScalar *z)
+{
+  const PetscInt nreg = BAIJSIMDNReg(bs);
+  BAIJSIMDVec    acc;
+  PetscInt       c,k;
+
+  for (c=0; c<bs; c++) {
+    acc = BAIJSIMDZero();
+    for (k=0; k<nreg; k++) acc = BAIJSIMDMultAdd(BAIJSIMDLoad(v+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k)),xr[k],acc);
+    z[c] += BAIJSIMDSum(acc);
+    v    += bs;
+  }
+}
+
+/* ------------------------------------------------------------------------------------------*/
+
+PETSC_STATIC_INLINE void MatMult_SeqBAIJ_SIMD_Private(const PetscInt bs,PetscInt mbs,const PetscInt *ii,const PetscInt *idx,const PetscInt *ridx,const MatScalar *aa,const PetscScalar *x,PetscScalar *z,PetscBool add)
+{
+  const PetscInt bs2 = bs*bs;
+  PetscScalar    *zb;
+  PetscInt       i,n;
+
+  for (i=0; i<mbs; i++) {
+    n  = ii[i+1] - ii[i];
+    zb = z + bs*(ridx ? ridx[i] : i);
+    PetscPrefetchBlock(idx+ii[i+1],n,0,PETSC_PREFETCH_HINT_NTA);          /* Indices for the next row (assumes same size as this one) */
+    PetscPrefetchBlock(aa+bs2*ii[i+1],bs2*n,0,PETSC_PREFETCH_HINT_NTA);   /* Entries for the next row */
+    BAIJSIMDRow(bs,n,idx+ii[i],aa+bs2*ii[i],x,add ? zb : NULL,zb,PETSC_FALSE);
+  }
+}
+
+/* one case per supported block size so that each kernel instance sees a constant bs */
+#define MatMult_SeqBAIJ_SIMD_Switch(bs,mbs,ii,idx,ridx,aa,x,z,add) \
+  switch (bs) { \
+  case 2: MatMult_SeqBAIJ_SIMD_Private(2,mbs,ii,idx,ridx,aa,x,z,add); break; \
+  case 3: MatMult_SeqBAIJ_SIMD_Private(3,mbs,ii,idx,ridx,aa,x,z,add); break; \
+  case 4: MatMult_SeqBAIJ_SIMD_Private(4,mbs,ii,idx,ridx,aa,x,z,add); break; \
+  case 5: MatMult_SeqBAIJ_SIMD_Private(5,mbs,ii,idx,ridx,aa,x,z,add); break; \
+  case 6: MatMult_SeqBAIJ_SIMD_Private(6,mbs,ii,idx,ridx,aa,x,z,add); break; \
+  case 7: MatMult_SeqBAIJ_SIMD_Private(7,mbs,ii,idx,ridx,aa,x,z,add); break; \
+  case 8: MatMult_SeqBAIJ_SIMD_Private(8,mbs,ii,idx,ridx,aa,x,z,add); break; \
+  default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Block size %D not supported by the SIMD kernels",bs); \
+  }
+
+#if defined(PETSC_THREADCOMM_ACTIVE)
+PetscErrorCode MatMult_SeqBAIJ_SIMD_Kernel(PetscInt thread_id,Mat A,Vec xx,Vec zz)
+{
+  PetscErrorCode    ierr;
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z;
+  const PetscScalar *x;
+  PetscInt          *trstarts=A->rmap->trstarts,bs=A->rmap->bs;
+  PetscInt          start,end;
+
+  ierr  = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr  = VecGetArray(zz,&z);CHKERRQ(ierr);
+  start = trstarts[thread_id] / bs;
+  end   = trstarts[thread_id+1] / bs;
+  MatMult_SeqBAIJ_SIMD_Switch(bs,end-start,a->i+start,a->j,NULL,a->a,x,z+bs*start,PETSC_FALSE);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  return 0;
+}
+#endif
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMult_SeqBAIJ_SIMD"
+PetscErrorCode MatMult_SeqBAIJ_SIMD(Mat A,Vec xx,Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          bs = A->rmap->bs;
+
+  PetscFunctionBegin;
+#if defined(PETSC_THREADCOMM_ACTIVE)
+  if (!a->compressedrow.use) {
+    ierr = PetscThreadCommRunKernel(PetscObjectComm((PetscObject)A),(PetscThreadKernel)MatMult_SeqBAIJ_SIMD_Kernel,3,A,xx,zz);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz*a->bs2 - bs*a->nonzerorowcnt);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    ierr = PetscMemzero(z,A->rmap->n*sizeof(PetscScalar));CHKERRQ(ierr);
+    MatMult_SeqBAIJ_SIMD_Switch(bs,a->compressedrow.nrows,a->compressedrow.i,a->j,a->compressedrow.rindex,a->a,x,z,PETSC_FALSE);
+  } else {
+    MatMult_SeqBAIJ_SIMD_Switch(bs,a->mbs,a->i,a->j,NULL,a->a,x,z,PETSC_FALSE);
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz*a->bs2 - bs*a->nonzerorowcnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultAdd_SeqBAIJ_SIMD"
+PetscErrorCode MatMultAdd_SeqBAIJ_SIMD(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          bs = A->rmap->bs;
+
+  PetscFunctionBegin;
+  if (yy != zz) {ierr = VecCopy(yy,zz);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    MatMult_SeqBAIJ_SIMD_Switch(bs,a->compressedrow.nrows,a->compressedrow.i,a->j,a->compressedrow.rindex,a->a,x,z,PETSC_TRUE);
+  } else {
+    MatMult_SeqBAIJ_SIMD_Switch(bs,a->mbs,a->i,a->j,NULL,a->a,x,z,PETSC_TRUE);
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz*a->bs2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* ------------------------------------------------------------------------------------------*/
+
+PETSC_STATIC_INLINE void MatMultTransposeAdd_SeqBAIJ_SIMD_Private(const PetscInt bs,PetscInt mbs,const PetscInt *ii,const PetscInt *idx,const PetscInt *ridx,const MatScalar *aa,const PetscScalar *x,PetscScalar *z)
+{
+  const PetscInt    nreg = BAIJSIMDNReg(bs),bs2 = bs*bs;
+  const PetscScalar *xb;
+  const MatScalar   *v;
+  BAIJSIMDVec       xr[BAIJSIMD_MAXREG];
+  PetscInt          i,j,k,n;
+
+  for (i=0; i<mbs; i++) {
+    xb = x + bs*(ridx ? ridx[i] : i);
+    for (k=0; k<nreg; k++) xr[k] = BAIJSIMDLoad(xb+k*BAIJSIMD_WIDTH,BAIJSIMDLen(bs,k));
+    n = ii[i+1] - ii[i];
+    v = aa + bs2*ii[i];
+    for (j=0; j<n; j++) {
+      BAIJSIMDBlockMultTransposeAdd(bs,v,xr,z+bs*idx[ii[i]+j]);
+      v += bs2;
+    }
+  }
+}
+
+#define MatMultTransposeAdd_SeqBAIJ_SIMD_Switch(bs,mbs,ii,idx,ridx,aa,x,z) \
+  switch (bs) { \
+  case 2: MatMultTransposeAdd_SeqBAIJ_SIMD_Private(2,mbs,ii,idx,ridx,aa,x,z); break; \
+  case 3: MatMultTransposeAdd_SeqBAIJ_SIMD_Private(3,mbs,ii,idx,ridx,aa,x,z); break; \
+  case 4: MatMultTransposeAdd_SeqBAIJ_SIMD_Private(4,mbs,ii,idx,ridx,aa,x,z); break; \
+  case 5: MatMultTransposeAdd_SeqBAIJ_SIMD_Private(5,mbs,ii,idx,ridx,aa,x,z); break; \
+  case 6: MatMultTransposeAdd_SeqBAIJ_SIMD_Private(6,mbs,ii,idx,ridx,aa,x,z); break; \
+  case 7: MatMultTransposeAdd_SeqBAIJ_SIMD_Private(7,mbs,ii,idx,ridx,aa,x,z); break; \
+  case 8: MatMultTransposeAdd_SeqBAIJ_SIMD_Private(8,mbs,ii,idx,ridx,aa,x,z); break; \
+  default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Block size %D not supported by the SIMD kernels",bs); \
+  }
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultTransposeAdd_SeqBAIJ_SIMD"
+PetscErrorCode MatMultTransposeAdd_SeqBAIJ_SIMD(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          bs = A->rmap->bs;
+
+  PetscFunctionBegin;
+  if (yy != zz) {ierr = VecCopy(yy,zz);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    MatMultTransposeAdd_SeqBAIJ_SIMD_Switch(bs,a->compressedrow.nrows,a->compressedrow.i,a->j,a->compressedrow.rindex,a->a,x,z);
+  } else {
+    MatMultTransposeAdd_SeqBAIJ_SIMD_Switch(bs,a->mbs,a->i,a->j,NULL,a->a,x,z);
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz*a->bs2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultTranspose_SeqBAIJ_SIMD"
+PetscErrorCode MatMultTranspose_SeqBAIJ_SIMD(Mat A,Vec xx,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(zz,0.0);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd_SeqBAIJ_SIMD(A,xx,zz,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* ------------------------------------------------------------------------------------------*/
+
+/*
+   Solve with the factor computed by MatLUFactorNumeric_SeqBAIJ_SIMD() (or any of the non in-place
+   factorizations) in natural ordering. Since no permutation is applied, both sweeps work directly
+   in x: the forward solve overwrites x(i) only after reading b(i) and the backward solve only uses
+   x(j), j > i, which are already final.
+*/
+PETSC_STATIC_INLINE void MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(const PetscInt bs,PetscInt n,const PetscInt *ai,const PetscInt *aj,const PetscInt *adiag,const MatScalar *aa,const PetscScalar *b,PetscScalar *x,PetscScalar *t)
+{
+  const PetscInt bs2 = bs*bs;
+  PetscInt       i;
+
+  /* forward solve the lower triangular */
+  for (i=0; i<n; i++) {
+    BAIJSIMDRow(bs,ai[i+1]-ai[i],aj+ai[i],aa+bs2*ai[i],x,b+bs*i,x+bs*i,PETSC_TRUE);
+  }
+  /* backward solve the upper triangular, the diagonal blocks hold their inverses */
+  for (i=n-1; i>=0; i--) {
+    BAIJSIMDRow(bs,adiag[i]-adiag[i+1]-1,aj+adiag[i+1]+1,aa+bs2*(adiag[i+1]+1),x,x+bs*i,t,PETSC_TRUE);
+    BAIJSIMDBlockMult(bs,aa+bs2*adiag[i],t,NULL,x+bs*i,PETSC_FALSE);
+  }
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSolve_SeqBAIJ_SIMD_NaturalOrdering"
+PetscErrorCode MatSolve_SeqBAIJ_SIMD_NaturalOrdering(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscInt          bs = A->rmap->bs,n = a->mbs;
+  PetscScalar       *x,t[8];
+  const PetscScalar *b;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  switch (bs) {
+  case 2: MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(2,n,a->i,a->j,a->diag,a->a,b,x,t); break;
+  case 3: MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(3,n,a->i,a->j,a->diag,a->a,b,x,t); break;
+  case 4: MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(4,n,a->i,a->j,a->diag,a->a,b,x,t); break;
+  case 5: MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(5,n,a->i,a->j,a->diag,a->a,b,x,t); break;
+  case 6: MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(6,n,a->i,a->j,a->diag,a->a,b,x,t); break;
+  case 7: MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(7,n,a->i,a->j,a->diag,a->a,b,x,t); break;
+  case 8: MatSolve_SeqBAIJ_SIMD_NaturalOrdering_Private(8,n,a->i,a->j,a->diag,a->a,b,x,t); break;
+  default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Block size %D not supported by the SIMD kernels",bs);
+  }
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->bs2*a->nz - bs*A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* ------------------------------------------------------------------------------------------*/
+
+/* A = A*B using the work array W, all bs by bs column major */
+PETSC_STATIC_INLINE void BAIJSIMD_A_gets_A_times_B(const PetscInt bs,MatScalar *A,const MatScalar *B,MatScalar *W)
+{
+  PetscInt j;
+
+  for (j=0; j<bs*bs; j++) W[j] = A[j];
+  for (j=0; j<bs; j++) BAIJSIMDBlockMult(bs,W,B+j*bs,NULL,A+j*bs,PETSC_FALSE);
+}
+
+/* A = A - B*C, all bs by bs column major */
+PETSC_STATIC_INLINE void BAIJSIMD_A_gets_A_minus_B_times_C(const PetscInt bs,MatScalar *A,const MatScalar *B,const MatScalar *C)
+{
+  PetscInt j;
+
+  for (j=0; j<bs; j++) BAIJSIMDBlockMult(bs,B,C+j*bs,A+j*bs,A+j*bs,PETSC_TRUE);
+}
+
+/*
+   The elimination loop of MatLUFactorNumeric_SeqBAIJ_N() with the block products done by the SIMD
+   kernels; it works for any ordering and for both the LU and ILU(k) data structures.
+*/
+PETSC_STATIC_INLINE void MatLUFactorNumeric_SeqBAIJ_SIMD_Row(const PetscInt bs,const PetscInt *bjtmp,PetscInt nzL,const PetscInt *bj,const PetscInt *bdiag,const MatScalar *ba,MatScalar *rtmp,MatScalar *mwork,PetscLogDouble *flops)
+{
+  const PetscInt  bs2 = bs*bs;
+  const MatScalar *pv;
+  const PetscInt  *pj;
+  MatScalar       *pc;
+  PetscInt        j,k,nz,row,flg;
+
+  for (k=0; k<nzL; k++) {
+    row = bjtmp[k];
+    pc  = rtmp + bs2*row;
+    for (flg=0,j=0; j<bs2; j++) {
+      if (pc[j]!=0.0) {
+        flg = 1;
+        break;
+      }
+    }
+    if (flg) {
+      BAIJSIMD_A_gets_A_times_B(bs,pc,ba+bs2*bdiag[row],mwork); /* *pc = *pc * (*pv); */
+      pj = bj + bdiag[row+1]+1;                                 /* begining of U(row,:) */
+      pv = ba + bs2*(bdiag[row+1]+1);
+      nz = bdiag[row] - bdiag[row+1] - 1;                       /* num of entries inU(row,:), excluding diag */
+      for (j=0; j<nz; j++) {
+        BAIJSIMD_A_gets_A_minus_B_times_C(bs,rtmp+bs2*pj[j],pc,pv+bs2*j);
+      }
+      *flops += 2*bs2*bs*(nz+1)-bs2;
+    }
+  }
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatLUFactorNumeric_SeqBAIJ_SIMD"
+PetscErrorCode MatLUFactorNumeric_SeqBAIJ_SIMD(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat            C     =B;
+  Mat_SeqBAIJ    *a    =(Mat_SeqBAIJ*)A->data,*b=(Mat_SeqBAIJ*)C->data;
+  IS             isrow = b->row,isicol = b->icol;
+  PetscErrorCode ierr;
+  const PetscInt *r,*ic;
+  PetscInt       i,j,n=a->mbs,*ai=a->i,*aj=a->j,*bi=b->i,*bj=b->j;
+  PetscInt       *ajtmp,*bjtmp,nz,nzL,*bdiag=b->diag,*pj;
+  MatScalar      *rtmp,*mwork,*v,*pv,*aa=a->a;
+  PetscInt       bs=A->rmap->bs,bs2 = a->bs2,v_pivots[8];
+  MatScalar      v_work[64];
+  PetscReal      shift = info->shiftamount;
+  PetscLogDouble flops = 0.0;
+  PetscBool      col_identity,row_identity,both_identity;
+
+  PetscFunctionBegin;
+  ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(isicol,&ic);CHKERRQ(ierr);
+
+  /* generate work space needed by the factorization */
+  ierr = PetscMalloc2(bs2*n,MatScalar,&rtmp,bs2,MatScalar,&mwork);CHKERRQ(ierr);
+  ierr = PetscMemzero(rtmp,bs2*n*sizeof(MatScalar));CHKERRQ(ierr);
+
+  for (i=0; i<n; i++) {
+    /* zero rtmp */
+    /* L part */
+    nz    = bi[i+1] - bi[i];
+    bjtmp = bj + bi[i];
+    for  (j=0; j<nz; j++) {
+      ierr = PetscMemzero(rtmp+bs2*bjtmp[j],bs2*sizeof(MatScalar));CHKERRQ(ierr);
+    }
+
+    /* U part */
+    nz    = bdiag[i] - bdiag[i+1];
+    bjtmp = bj + bdiag[i+1]+1;
+    for  (j=0; j<nz; j++) {
+      ierr = PetscMemzero(rtmp+bs2*bjtmp[j],bs2*sizeof(MatScalar));CHKERRQ(ierr);
+    }
+
+    /* load in initial (unfactored row) */
+    nz    = ai[r[i]+1] - ai[r[i]];
+    ajtmp = aj + ai[r[i]];
+    v     = aa + bs2*ai[r[i]];
+    for (j=0; j<nz; j++) {
+      ierr = PetscMemcpy(rtmp+bs2*ic[ajtmp[j]],v+bs2*j,bs2*sizeof(MatScalar));CHKERRQ(ierr);
+    }
+
+    /* elimination */
+    bjtmp = bj + bi[i];
+    nzL   = bi[i+1] - bi[i];
+    switch (bs) {
+    case 2: MatLUFactorNumeric_SeqBAIJ_SIMD_Row(2,bjtmp,nzL,bj,bdiag,b->a,rtmp,mwork,&flops); break;
+    case 3: MatLUFactorNumeric_SeqBAIJ_SIMD_Row(3,bjtmp,nzL,bj,bdiag,b->a,rtmp,mwork,&flops); break;
+    case 4: MatLUFactorNumeric_SeqBAIJ_SIMD_Row(4,bjtmp,nzL,bj,bdiag,b->a,rtmp,mwork,&flops); break;
+    case 5: MatLUFactorNumeric_SeqBAIJ_SIMD_Row(5,bjtmp,nzL,bj,bdiag,b->a,rtmp,mwork,&flops); break;
+    case 6: MatLUFactorNumeric_SeqBAIJ_SIMD_Row(6,bjtmp,nzL,bj,bdiag,b->a,rtmp,mwork,&flops); break;
+    case 7: MatLUFactorNumeric_SeqBAIJ_SIMD_Row(7,bjtmp,nzL,bj,bdiag,b->a,rtmp,mwork,&flops); break;
+    case 8: MatLUFactorNumeric_SeqBAIJ_SIMD_Row(8,bjtmp,nzL,bj,bdiag,b->a,rtmp,mwork,&flops); break;
+    default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Block size %D not supported by the SIMD kernels",bs);
+    }
+
+    /* finished row so stick it into b->a */
+    /* L part */
+    pv = b->a + bs2*bi[i];
+    pj = b->j + bi[i];
+    nz = bi[i+1] - bi[i];
+    for (j=0; j<nz; j++) {
+      ierr = PetscMemcpy(pv+bs2*j,rtmp+bs2*pj[j],bs2*sizeof(MatScalar));CHKERRQ(ierr);
+    }
+
+    /* Mark diagonal and invert diagonal for simplier triangular solves */
+    pv   = b->a + bs2*bdiag[i];
+    pj   = b->j + bdiag[i];
+    ierr = PetscMemcpy(pv,rtmp+bs2*pj[0],bs2*sizeof(MatScalar));CHKERRQ(ierr);
+    switch (bs) {
+    case 2: ierr = PetscKernel_A_gets_inverse_A_2(pv,shift);CHKERRQ(ierr); break;
+    case 3: ierr = PetscKernel_A_gets_inverse_A_3(pv,shift);CHKERRQ(ierr); break;
+    case 4: ierr = PetscKernel_A_gets_inverse_A_4(pv,shift);CHKERRQ(ierr); break;
+    case 5: ierr = PetscKernel_A_gets_inverse_A_5(pv,v_pivots,v_work,shift);CHKERRQ(ierr); break;
+    case 6: ierr = PetscKernel_A_gets_inverse_A_6(pv,shift);CHKERRQ(ierr); break;
+    case 7: ierr = PetscKernel_A_gets_inverse_A_7(pv,shift);CHKERRQ(ierr); break;
+    default: ierr = PetscKernel_A_gets_inverse_A(bs,pv,v_pivots,v_work);CHKERRQ(ierr); break;
+    }
+
+    /* U part */
+    pv = b->a + bs2*(bdiag[i+1]+1);
+    pj = b->j + bdiag[i+1]+1;
+    nz = bdiag[i] - bdiag[i+1] - 1;
+    for (j=0; j<nz; j++) {
+      ierr = PetscMemcpy(pv+bs2*j,rtmp+bs2*pj[j],bs2*sizeof(MatScalar));CHKERRQ(ierr);
+    }
+  }
+
+  ierr = PetscFree2(rtmp,mwork);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(isicol,&ic);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
+
+  ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
+  ierr = ISIdentity(isicol,&col_identity);CHKERRQ(ierr);
+
+  both_identity = (PetscBool) (row_identity && col_identity);
+  if (both_identity) {
+    C->ops->solve = MatSolve_SeqBAIJ_SIMD_NaturalOrdering;
+    switch (bs) {
+    case 2:  C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_2_NaturalOrdering; break;
+    case 3:  C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_3_NaturalOrdering; break;
+    case 4:  C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_4_NaturalOrdering; break;
+    case 5:  C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_5_NaturalOrdering; break;
+    case 6:  C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_6_NaturalOrdering; break;
+    case 7:  C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_7_NaturalOrdering; break;
+    default: C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_N; break;
+    }
+  } else {
+    switch (bs) {
+    case 2:  C->ops->solve = MatSolve_SeqBAIJ_2; C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_2; break;
+    case 3:  C->ops->solve = MatSolve_SeqBAIJ_3; C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_3; break;
+    case 4:  C->ops->solve = MatSolve_SeqBAIJ_4; C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_4; break;
+    case 5:  C->ops->solve = MatSolve_SeqBAIJ_5; C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_5; break;
+    case 6:  C->ops->solve = MatSolve_SeqBAIJ_6; C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_6; break;
+    case 7:  C->ops->solve = MatSolve_SeqBAIJ_7; C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_7; break;
+    default: C->ops->solve = MatSolve_SeqBAIJ_N; C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_N; break;
+    }
+  }
+  C->assembled = PETSC_TRUE;
+
+  ierr = PetscLogFlops(flops + 1.333333333333*bs*bs2*n);CHKERRQ(ierr); /* the last term from inverting diagonal blocks */
+  PetscFunctionReturn(0);
+}
+
+#endif
@@ -1024,6 +1024,7 @@ PetscErrorCode  MatDestroy(Mat *A)
   if ((*A)->ops->destroy) {
     ierr = (*(*A)->ops->destroy)(*A);CHKERRQ(ierr);
   }
+  ierr = PetscFree((*A)->bsizes);CHKERRQ(ierr);
   ierr = MatNullSpaceDestroy(&(*A)->nullsp);CHKERRQ(ierr);
   ierr = MatNullSpaceDestroy(&(*A)->nearnullsp);CHKERRQ(ierr);
   ierr = PetscLayoutDestroy(&(*A)->rmap);CHKERRQ(ierr);
@@ -4125,6 +4126,9 @@ PetscErrorCode  MatDuplicate(Mat mat,MatDuplicateOption op,Mat *M)
 
   B->nooffproczerorows = mat->nooffproczerorows;
   B->nooffprocentries  = mat->nooffprocentries;
+  if (mat->bsizes) {
+    ierr = MatSetVariableBlockSizes(B,mat->nblocks,mat->bsizes);CHKERRQ(ierr);
+  }
 
   ierr = PetscLogEventEnd(MAT_Convert,mat,0,0,0);CHKERRQ(ierr);
   ierr = PetscObjectStateIncrease((PetscObject)B);CHKERRQ(ierr);
@@ -6827,6 +6831,84 @@ PetscErrorCode  MatSetBlockSizes(Mat mat,PetscInt rbs,PetscInt cbs)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "MatSetVariableBlockSizes"
+/*@C
+   MatSetVariableBlockSizes - Sets the sizes of the diagonal blocks of a matrix whose blocks are not all the same size,
+   for example the unknowns of nodes carrying different physics
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  mat - the matrix
+.  nblocks - the number of blocks on this process
+-  bsizes - the block sizes, they must add up to the local number of rows
+
+   Notes:
+     Currently used by PCVPBJACOBI, for AIJ matrices the blocks are also used as the inodes of the matrix
+     (the block size of the matrix, MatSetBlockSizes(), remains 1). Blocks larger than the inode limit, or whose rows
+     have different nonzero structure, are split into several inodes. Call this before the matrix is assembled
+     for the inodes to use the blocks.
+
+     The array is copied so it may be freed after this call.
+
+   Level: intermediate
+
+   Concepts: matrices^block size
+
+.seealso: MatCreateSeqBAIJ(), MatCreateBAIJ(), MatGetBlockSize(), MatSetBlockSizes(), MatGetVariableBlockSizes(), PCVPBJACOBI,
+          MatInvertVariableBlockDiagonal()
+@*/
+PetscErrorCode  MatSetVariableBlockSizes(Mat mat,PetscInt nblocks,const PetscInt bsizes[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i,ncnt = 0;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  if (nblocks < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of blocks %D cannot be negative",nblocks);
+  if (nblocks) PetscValidIntPointer(bsizes,3);
+  for (i=0; i<nblocks; i++) {
+    if (bsizes[i] < 1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Block %D has size %D, must be positive",i,bsizes[i]);
+    ncnt += bsizes[i];
+  }
+  if (ncnt != mat->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Sum of local block sizes %D does not equal local number of rows %D",ncnt,mat->rmap->n);
+  ierr = PetscFree(mat->bsizes);CHKERRQ(ierr);
+  mat->nblocks = nblocks;
+  ierr = PetscMalloc(nblocks*sizeof(PetscInt),&mat->bsizes);CHKERRQ(ierr);
+  ierr = PetscMemcpy(mat->bsizes,bsizes,nblocks*sizeof(PetscInt));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetVariableBlockSizes"
+/*@C
+   MatGetVariableBlockSizes - Gets the sizes of the diagonal blocks set with MatSetVariableBlockSizes()
+
+   Not Collective
+
+   Input Parameter:
+.  mat - the matrix
+
+   Output Parameters:
++  nblocks - the number of blocks on this process, 0 if MatSetVariableBlockSizes() was not called
+-  bsizes - the block sizes, do not free
+
+   Level: intermediate
+
+   Concepts: matrices^block size
+
+.seealso: MatCreateSeqBAIJ(), MatCreateBAIJ(), MatGetBlockSize(), MatSetBlockSizes(), MatSetVariableBlockSizes()
+@*/
+PetscErrorCode  MatGetVariableBlockSizes(Mat mat,PetscInt *nblocks,const PetscInt *bsizes[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  if (nblocks) *nblocks = mat->nblocks;
+  if (bsizes)  *bsizes  = mat->bsizes;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatResidual"
 /*@
@@ -8338,6 +8420,11 @@ PetscErrorCode  MatFactorInfoInitialize(MatFactorInfo *info)
    Output Parameters:
 .  C - the product matrix
 
+   Options Database Keys:
++  -matptap_via <scalable,nonscalable,allatonce> - the algorithm for SeqAIJ matrices; for MPIAIJ matrices only allatonce
+   changes it, to the product that forms and discards one row of A*P at a time
+-  -matptap_scalable <true,false> - sparse (default) or dense axpy in the numeric product of MPIAIJ matrices
+
    Notes:
    C will be created and must be destroyed by the user with MatDestroy().
 
@@ -9420,6 +9507,42 @@ PetscErrorCode MatInvertBlockDiagonal(Mat mat,const PetscScalar **values)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "MatInvertVariableBlockDiagonal"
+/*@C
+  MatInvertVariableBlockDiagonal - Inverts the diagonal blocks of varying size.
+
+  Collective on Mat
+
+  Input Parameters:
++ mat - the matrix
+. nblocks - the number of blocks on this process
+- bsizes - the size of each block, they must add up to the local number of rows
+
+  Output Parameters:
+. diag - the block inverses one after the other, each in column major order (FORTRAN-like), the array must have length the
+         sum of the squares of the block sizes
+
+   Note:
+   This routine is not available from Fortran.
+
+  Level: advanced
+
+.seealso: MatInvertBlockDiagonal(), MatSetVariableBlockSizes(), PCVPBJACOBI
+@*/
+PetscErrorCode MatInvertVariableBlockDiagonal(Mat mat,PetscInt nblocks,const PetscInt *bsizes,PetscScalar *diag)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  if (!mat->assembled) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Not for unassembled matrix");
+  if (mat->factortype) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Not for factored matrix");
+  if (!mat->ops->invertvariableblockdiagonal) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Not supported for matrix type %s",((PetscObject)mat)->type_name);
+  ierr = (*mat->ops->invertvariableblockdiagonal)(mat,nblocks,bsizes,diag);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatTransposeColoringDestroy"
 /*@C
@@ -131,10 +131,117 @@ PetscErrorCode PetscFinalize_DynamicLibraries(void)
 struct _n_PetscFunctionList {
   void              (*routine)(void);    /* the routine */
   char              *name;               /* string to identify routine */
+  unsigned int      hval;                /* hash of the name */
   PetscFunctionList next;                /* next pointer */
   PetscFunctionList next_list;           /* used to maintain list of all lists for freeing */
+  /* the following are only used in the first entry of the list */
+  PetscFunctionList tail;                /* last entry, where new entries are added */
+  PetscInt          n;                   /* number of entries */
+  PetscInt          nhash;               /* size of the hash table, a power of two, or 0 if it is not built yet */
+  PetscFunctionList *hash;               /* open addressing table of entries, NULL is an empty slot */
 };
 
+/*
+    The hash table of a list is built when the list reaches PETSC_FUNCTIONLIST_HASH_MIN entries, so registering
+  many types is not quadratic, or at the first lookup in a list with at least two entries. The latter makes the
+  table of the composed functions of an object (PetscObjectComposeFunction()) a lookup cache for the object:
+  repeated PetscObjectQueryFunction() calls, most of which find nothing, cost one hash and one probe.
+*/
+#define PETSC_FUNCTIONLIST_HASH_MIN 8
+
+PETSC_STATIC_INLINE unsigned int PetscFunctionListHash_Private(const char name[])
+{
+  unsigned int h = 2166136261U;
+
+  while (*name) {
+    h ^= (unsigned int)(unsigned char)*name++;
+    h *= 16777619U;
+  }
+  return h;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscFunctionListHashFind_Private"
+/*
+    Finds the entry with the given name in a list, or NULL
+*/
+static PetscErrorCode PetscFunctionListHashFind_Private(PetscFunctionList fl,const char name[],PetscFunctionList *entry)
+{
+  PetscErrorCode ierr;
+  PetscBool      match;
+  unsigned int   h;
+
+  PetscFunctionBegin;
+  *entry = NULL;
+  if (!fl) PetscFunctionReturn(0);
+  if (fl->hash) {
+    unsigned int hval = PetscFunctionListHash_Private(name);
+
+    for (h=hval&(fl->nhash-1); fl->hash[h]; h=(h+1)&(fl->nhash-1)) {
+      if (fl->hash[h]->hval != hval) continue;
+      ierr = PetscStrcmp(fl->hash[h]->name,name,&match);CHKERRQ(ierr);
+      if (match) {
+        *entry = fl->hash[h];
+        PetscFunctionReturn(0);
+      }
+    }
+  } else {
+    for (; fl; fl=fl->next) {
+      ierr = PetscStrcmp(fl->name,name,&match);CHKERRQ(ierr);
+      if (match) {
+        *entry = fl;
+        PetscFunctionReturn(0);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscFunctionListHashBuild_Private"
+/*
+    Builds the hash table of the list, large enough to be at most half full
+*/
+static PetscErrorCode PetscFunctionListHashBuild_Private(PetscFunctionList fl)
+{
+  PetscErrorCode    ierr;
+  PetscFunctionList e;
+  unsigned int      h;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(fl->hash);CHKERRQ(ierr);
+  if (!fl->nhash) fl->nhash = 2*PETSC_FUNCTIONLIST_HASH_MIN;
+  while (2*fl->n > fl->nhash) fl->nhash *= 2;
+  ierr = PetscMalloc(fl->nhash*sizeof(PetscFunctionList),&fl->hash);CHKERRQ(ierr);
+  ierr = PetscMemzero(fl->hash,fl->nhash*sizeof(PetscFunctionList));CHKERRQ(ierr);
+  for (e=fl; e; e=e->next) {
+    for (h=e->hval&(fl->nhash-1); fl->hash[h]; h=(h+1)&(fl->nhash-1)) ;
+    fl->hash[h] = e;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscFunctionListHashInsert_Private"
+/*
+    Puts an entry, not already there, in the hash table of the list, enlarging the table to keep it at most half full
+*/
+static PetscErrorCode PetscFunctionListHashInsert_Private(PetscFunctionList fl,PetscFunctionList entry)
+{
+  PetscErrorCode ierr;
+  unsigned int   h;
+
+  PetscFunctionBegin;
+  if (!fl->hash && fl->n < PETSC_FUNCTIONLIST_HASH_MIN) PetscFunctionReturn(0);
+  if (!fl->hash || 2*fl->n > fl->nhash) {
+    ierr = PetscFunctionListHashBuild_Private(fl);CHKERRQ(ierr);
+  } else {
+    for (h=entry->hval&(fl->nhash-1); fl->hash[h]; h=(h+1)&(fl->nhash-1)) ;
+    fl->hash[h] = entry;
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
      Keep a linked list of PetscFunctionLists so that we can destroy all the left-over ones.
 */
@@ -179,8 +286,11 @@ PETSC_EXTERN PetscErrorCode PetscFunctionListAdd_Private(PetscFunctionList *fl,c
   if (!*fl) {
     ierr           = PetscNew(struct _n_PetscFunctionList,&entry);CHKERRQ(ierr);
     ierr           = PetscStrallocpy(name,&entry->name);CHKERRQ(ierr);
+    entry->hval    = PetscFunctionListHash_Private(name);
     entry->routine = fnc;
     entry->next    = 0;
+    entry->tail    = entry;
+    entry->n       = 1;
     *fl            = entry;
 
     /* add this new list to list of all lists */
@@ -194,24 +304,21 @@ PETSC_EXTERN PetscErrorCode PetscFunctionListAdd_Private(PetscFunctionList *fl,c
     }
   } else {
     /* search list to see if it is already there */
-    ne = *fl;
-    while (ne) {
-      PetscBool founddup;
-
-      ierr = PetscStrcmp(ne->name,name,&founddup);CHKERRQ(ierr);
-      if (founddup) { /* found duplicate */
-        ne->routine = fnc;
-        PetscFunctionReturn(0);
-      }
-      if (ne->next) ne = ne->next;
-      else break;
+    ierr = PetscFunctionListHashFind_Private(*fl,name,&ne);CHKERRQ(ierr);
+    if (ne) { /* found duplicate */
+      ne->routine = fnc;
+      PetscFunctionReturn(0);
     }
     /* create new entry and add to end of list */
-    ierr           = PetscNew(struct _n_PetscFunctionList,&entry);CHKERRQ(ierr);
-    ierr           = PetscStrallocpy(name,&entry->name);CHKERRQ(ierr);
-    entry->routine = fnc;
-    entry->next    = 0;
-    ne->next       = entry;
+    ierr              = PetscNew(struct _n_PetscFunctionList,&entry);CHKERRQ(ierr);
+    ierr              = PetscStrallocpy(name,&entry->name);CHKERRQ(ierr);
+    entry->hval       = PetscFunctionListHash_Private(name);
+    entry->routine    = fnc;
+    entry->next       = 0;
+    (*fl)->tail->next = entry;
+    (*fl)->tail       = entry;
+    (*fl)->n++;
+    ierr = PetscFunctionListHashInsert_Private(*fl,entry);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -251,6 +358,7 @@ PetscErrorCode  PetscFunctionListDestroy(PetscFunctionList *fl)
   }
 
   /* free this list */
+  ierr  = PetscFree((*fl)->hash);CHKERRQ(ierr);
   entry = *fl;
   while (entry) {
     next  = entry->next;
@@ -297,6 +405,10 @@ PetscErrorCode  PetscFunctionListPrintAll(void)
     Output Parameters:
 .   fptr - the function pointer if name was found, else NULL
 
+    Notes:
+    The first lookup builds a hash table of the list, so later lookups, including those that find nothing,
+    do not depend on the length of the list.
+
     Level: developer
 
 .seealso: PetscFunctionListAdd(), PetscFunctionList, PetscObjectQueryFunction()
@@ -305,22 +417,15 @@ M*/
 #define __FUNCT__ "PetscFunctionListFind_Private"
 PETSC_EXTERN PetscErrorCode PetscFunctionListFind_Private(PetscFunctionList fl,const char name[],void (**r)(void))
 {
-  PetscFunctionList entry = fl;
+  PetscFunctionList entry;
   PetscErrorCode    ierr;
-  PetscBool         flg;
 
   PetscFunctionBegin;
   if (!name) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_NULL,"Trying to find routine with null name");
 
-  *r = 0;
-  while (entry) {
-    ierr = PetscStrcmp(name,entry->name,&flg);CHKERRQ(ierr);
-    if (flg) {
-      *r   = entry->routine;
-      PetscFunctionReturn(0);
-    }
-    entry = entry->next;
-  }
+  if (fl && !fl->hash && fl->n > 1) {ierr = PetscFunctionListHashBuild_Private(fl);CHKERRQ(ierr);}
+  ierr = PetscFunctionListHashFind_Private(fl,name,&entry);CHKERRQ(ierr);
+  *r   = entry ? entry->routine : 0;
   PetscFunctionReturn(0);
 }
 
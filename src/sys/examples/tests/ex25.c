@@ -0,0 +1,54 @@
+
+static char help[] = "Tests nested and timeline logging of events, -log_nested, -log_nested_flamegraph and -log_timeline.\n\n";
+
+#include <petscsys.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscClassId   classid;
+  PetscLogEvent  eA,eB,eC;
+  PetscLogStage  stage;
+  PetscInt       i,j;
+  PetscMPIInt    rank;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscClassIdRegister("Nested test",&classid);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("EventA",classid,&eA);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("EventB",classid,&eB);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("EventC",classid,&eC);CHKERRQ(ierr);
+  ierr = PetscLogStageRegister("Second stage",&stage);CHKERRQ(ierr);
+
+  /* A calls B twice and C once, B calls C; C is also called outside of any event */
+  for (i=0; i<3; i++) {
+    ierr = PetscLogEventBegin(eA,0,0,0,0);CHKERRQ(ierr);
+    for (j=0; j<2; j++) {
+      ierr = PetscLogEventBegin(eB,0,0,0,0);CHKERRQ(ierr);
+      ierr = PetscLogEventBegin(eC,0,0,0,0);CHKERRQ(ierr);
+      ierr = PetscLogFlops(10.0);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(eC,0,0,0,0);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(eB,0,0,0,0);CHKERRQ(ierr);
+    }
+    ierr = PetscLogEventBegin(eC,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(eC,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(eA,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventBegin(eC,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(eC,0,0,0,0);CHKERRQ(ierr);
+
+  /* in the second stage only the first process calls B inside C */
+  ierr = PetscLogStagePush(stage);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(eC,0,0,0,0);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscLogEventBegin(eB,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(eB,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(eC,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -0,0 +1,50 @@
+static char help[] = "Tests PetscArena and, with -malloc_pool, the pooled PetscMalloc()\n";
+#include <petscsys.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscArena     arena;
+  PetscInt       i,j,*a,*b,*c;
+  PetscScalar    *x,*xprev = NULL;
+  PetscBool      aligned = PETSC_TRUE,reused = PETSC_TRUE;
+  PetscLogDouble mallocs0,hits0,mallocs,hits;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscArenaCreate(1024,&arena);CHKERRQ(ierr);
+  for (i=0; i<10; i++) {
+    ierr = PetscArenaPush(arena);CHKERRQ(ierr);
+    ierr = PetscArenaMalloc(arena,7*sizeof(PetscInt),&a);CHKERRQ(ierr);
+    ierr = PetscArenaPush(arena);CHKERRQ(ierr);
+    /* larger than the chunk size so a new chunk is needed */
+    ierr = PetscArenaMalloc(arena,300*sizeof(PetscScalar),&x);CHKERRQ(ierr);
+    ierr = PetscArenaMalloc(arena,5*sizeof(PetscInt),&b);CHKERRQ(ierr);
+    for (j=0; j<7; j++) a[j] = j;
+    for (j=0; j<300; j++) x[j] = j;
+    for (j=0; j<5; j++) b[j] = -j;
+    if (((size_t)a | (size_t)b | (size_t)x) & (PETSC_MEMALIGN-1)) aligned = PETSC_FALSE;
+    /* the chunk released by the previous PetscArenaPop() is reused */
+    if (xprev && x != xprev) reused = PETSC_FALSE;
+    xprev = x;
+    ierr  = PetscArenaPop(arena);CHKERRQ(ierr);
+    for (j=0; j<7; j++) if (a[j] != j) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Arena memory of the outer scope was overwritten");
+    ierr = PetscArenaPop(arena);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Arena memory aligned %s, reused after pop %s\n",aligned ? "yes" : "no",reused ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscArenaDestroy(&arena);CHKERRQ(ierr);
+
+  /* repeated allocations of the same sizes are satisfied from the free lists of the pool */
+  ierr = PetscMallocPoolGetStatistics(&mallocs0,&hits0);CHKERRQ(ierr);
+  for (i=0; i<100; i++) {
+    ierr = PetscMalloc3(10,PetscInt,&a,20,PetscInt,&b,1000,PetscInt,&c);CHKERRQ(ierr);
+    ierr = PetscFree3(a,b,c);CHKERRQ(ierr);
+  }
+  ierr = PetscMallocPoolGetStatistics(&mallocs,&hits);CHKERRQ(ierr);
+  if (mallocs > mallocs0) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Pool hit rate above 90%% %s\n",(hits-hits0) > 0.9*(mallocs-mallocs0) ? "yes" : "no");CHKERRQ(ierr);
+  }
+  ierr = PetscFinalize();
+  return 0;
+}
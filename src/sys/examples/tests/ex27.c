@@ -0,0 +1,51 @@
+static char help[] = "Tests and benchmarks PetscOptionsGetInt() with a large options database.\n\
+Options:\n\
+  -n <n>       : number of options in the database\n\
+  -repeat <r>  : number of times each option is looked up\n\
+  -timing      : print the number of lookups per second\n\n";
+#include <petscsys.h>
+#include <petsctime.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = 10000,repeat = 10,i,r,value,found = 0,wrong = 0;
+  char           name[64],str[64];
+  PetscBool      flg,timing = PETSC_FALSE;
+  PetscLogDouble t0,t1;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-repeat",&repeat,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-timing",&timing,NULL);CHKERRQ(ierr);
+
+  /* options with a prefix, as the options of the sub solvers of a large fieldsplit or multigrid */
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"-sub_%D_ksp_max_it",i);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(str,sizeof(str),"%D",i);CHKERRQ(ierr);
+    ierr = PetscOptionsSetValue(name,str);CHKERRQ(ierr);
+  }
+  /* overwrite and remove some of them */
+  ierr = PetscOptionsSetValue("-sub_1_ksp_max_it","-1");CHKERRQ(ierr);
+  ierr = PetscOptionsClearValue("-sub_2_ksp_max_it");CHKERRQ(ierr);
+
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (r=0; r<repeat; r++) {
+    for (i=0; i<n; i++) {
+      ierr = PetscSNPrintf(name,sizeof(name),"sub_%D_",i);CHKERRQ(ierr);
+      ierr = PetscOptionsGetInt(name,"-ksp_max_it",&value,&flg);CHKERRQ(ierr);
+      if (!r && flg) found++;
+      if (flg && value != i && i != 1) wrong++;
+    }
+  }
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt("sub_1_","-ksp_max_it",&value,&flg);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Found %D of %D options, %D with a wrong value, overwritten value %D\n",found,n,wrong,value);CHKERRQ(ierr);
+  if (timing) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%g PetscOptionsGetInt() per second\n",(double)(n*repeat)/(t1-t0));CHKERRQ(ierr);
+  }
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -0,0 +1,100 @@
+static char help[] = "Tests and benchmarks PetscFunctionList and composed function lookups.\n\
+Options:\n\
+  -n <n>       : number of functions in the list\n\
+  -repeat <r>  : number of times each function is looked up\n\
+  -timing      : print the number of lookups per second\n\n";
+#include <petscsys.h>
+#include <petsctime.h>
+
+static void FunctionA(void) {}
+static void FunctionB(void) {}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  PetscErrorCode    ierr;
+  PetscFunctionList list = NULL,copy = NULL;
+  PetscContainer    container;
+  PetscInt          n = 1000,repeat = 100,i,r,wrong = 0,missed = 0,order = 0;
+  char              name[64];
+  const char        **names;
+  int               nnames;
+  void              (*f)(void);
+  PetscBool         timing = PETSC_FALSE,same;
+  PetscLogDouble    t0,t1,t2,t3;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-repeat",&repeat,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-timing",&timing,NULL);CHKERRQ(ierr);
+
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"type%D",i);CHKERRQ(ierr);
+    ierr = PetscFunctionListAdd(&list,name,i%2 ? FunctionB : FunctionA);CHKERRQ(ierr);
+  }
+  /* registering again replaces the function but keeps the place in the list */
+  ierr = PetscFunctionListAdd(&list,"type0",FunctionB);CHKERRQ(ierr);
+  ierr = PetscFunctionListAdd(&list,"type1",NULL);CHKERRQ(ierr);
+  ierr = PetscFunctionListGet(list,&names,&nnames);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"type%D",i);CHKERRQ(ierr);
+    ierr = PetscStrcmp(name,names[i],&same);CHKERRQ(ierr);
+    if (!same) order++;
+  }
+  ierr = PetscFree(names);CHKERRQ(ierr);
+
+  ierr = PetscFunctionListDuplicate(list,&copy);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"type%D",i);CHKERRQ(ierr);
+    ierr = PetscFunctionListFind(copy,name,&f);CHKERRQ(ierr);
+    if (i == 0 && f != FunctionB) wrong++;
+    else if (i == 1 && f) wrong++;
+    else if (i > 1 && f != (i%2 ? FunctionB : FunctionA)) wrong++;
+    ierr = PetscSNPrintf(name,sizeof(name),"notatype%D",i);CHKERRQ(ierr);
+    ierr = PetscFunctionListFind(copy,name,&f);CHKERRQ(ierr);
+    if (f) missed++;
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"List of %D functions: %D out of order, %D wrong, %D found that were not registered\n",n,order,wrong,missed);CHKERRQ(ierr);
+
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (r=0; r<repeat; r++) {
+    for (i=0; i<n; i+=n/10) {
+      ierr = PetscSNPrintf(name,sizeof(name),"type%D",i);CHKERRQ(ierr);
+      ierr = PetscFunctionListFind(list,name,&f);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+
+  /* composed functions, queried as MatConvert() and the preconditioners do; most queries find nothing */
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)container,"FunctionA_C",FunctionA);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject)container,"FunctionA_C",&f);CHKERRQ(ierr);
+  if (f != FunctionA) wrong++;
+  for (i=0; i<10; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"Function%D_C",i);CHKERRQ(ierr);
+    ierr = PetscObjectComposeFunction((PetscObject)container,name,FunctionB);CHKERRQ(ierr);
+  }
+  /* composing after a query must be seen by the next query */
+  ierr = PetscObjectComposeFunction((PetscObject)container,"FunctionA_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject)container,"FunctionA_C",&f);CHKERRQ(ierr);
+  if (f) wrong++;
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  for (r=0; r<repeat*10; r++) {
+    ierr = PetscObjectQueryFunction((PetscObject)container,"Function7_C",&f);CHKERRQ(ierr);
+    if (f != FunctionB) wrong++;
+    ierr = PetscObjectQueryFunction((PetscObject)container,"MatConvert_seqaij_seqdense_C",&f);CHKERRQ(ierr);
+    if (f) missed++;
+  }
+  ierr = PetscTime(&t3);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Composed functions: %D wrong, %D found that were not composed\n",wrong,missed);CHKERRQ(ierr);
+  if (timing) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%g PetscFunctionListFind() per second\n",(double)(10*repeat)/(t1-t0));CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%g PetscObjectQueryFunction() per second\n",(double)(20*repeat)/(t3-t2));CHKERRQ(ierr);
+  }
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  ierr = PetscFunctionListDestroy(&copy);CHKERRQ(ierr);
+  ierr = PetscFunctionListDestroy(&list);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -0,0 +1,165 @@
+
+/*
+      Hardware performance counters for the logging of PETSc events.
+
+      The processor cycles, instructions and last level cache misses are read when each event begins and ends,
+   using perf_event_open() on Linux or PAPI; the counts are accumulated in the PetscEventPerfInfo of the event.
+*/
+#include <petsc-private/logimpl.h>        /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#if defined(PETSC_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+#include <errno.h>
+#elif defined(PETSC_HAVE_PAPI)
+#include <papi.h>
+extern int PAPIEventSet;
+#endif
+
+#if defined(PETSC_USE_LOG)
+
+PetscBool petsc_logcounters = PETSC_FALSE;
+
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+static int petsc_counterfd[PETSC_LOG_NUM_COUNTERS] = {-1,-1,-1};   /* the first is the leader of the group */
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogCountersOpen_Private"
+/* Opens the counter config in the group of leader for the calling thread, user space only */
+static int PetscLogCountersOpen_Private(unsigned long long config,int leader)
+{
+  struct perf_event_attr attr;
+
+  PetscMemzero(&attr,sizeof(attr));
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof(attr);
+  attr.config         = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  attr.read_format    = PERF_FORMAT_GROUP;
+  return (int)syscall(__NR_perf_event_open,&attr,0,-1,leader,0);
+}
+#endif
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogCountersRead"
+/*
+   PetscLogCountersRead - Reads the cycles, instructions and last level cache misses of the thread that called
+   PetscLogCountersBegin() since that call
+*/
+PetscErrorCode PetscLogCountersRead(PetscLogDouble counters[])
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  unsigned long long values[1+PETSC_LOG_NUM_COUNTERS];
+  int                i;
+
+  PetscFunctionBegin;
+  if (read(petsc_counterfd[0],values,sizeof(values)) != (ssize_t)sizeof(values)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to read hardware counters");
+  for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) counters[i] = (PetscLogDouble)values[1+i];
+#elif defined(PETSC_HAVE_PAPI)
+  long_long      values[1+PETSC_LOG_NUM_COUNTERS];
+  int            i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* the first counter in the event set is PAPI_FP_INS, used for the flops */
+  ierr = PAPI_read(PAPIEventSet,values);CHKERRQ(ierr);
+  for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) counters[i] = (PetscLogDouble)values[1+i];
+#else
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Hardware counters require perf_event_open() or PAPI");
+#endif
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogCountersBegin"
+/*@C
+  PetscLogCountersBegin - Turns on the collection of hardware performance counters (processor cycles,
+  instructions and last level cache misses) for each event; they are reported by PetscLogView().
+
+  Not Collective
+
+  Options Database Keys:
+. -log_counters - Turns on the collection of the counters
+
+  Notes:
+  The counters are read with perf_event_open() on Linux (the user space counts of the calling thread, so
+  /proc/sys/kernel/perf_event_paranoid must be at most 2) or else with PAPI. If the counters are not
+  available, for example in many virtual machines, a message is printed with -info and the counters are not collected.
+
+  Only the thread that called this routine is counted, not the threads it starts, for example those of a
+  PetscThreadComm or of OpenMP; the work they do within an event is missing from its counts.
+
+  The memory bandwidth is estimated from the last level cache misses, each moving a cache line of
+  PETSC_LEVEL1_DCACHE_LINESIZE bytes; prefetched lines are not counted so this is a lower bound.
+
+  Must be called after PetscLogBegin(), there is no overhead unless it is called.
+
+  Level: advanced
+
+.keywords: log, hardware, counters, bandwidth
+.seealso: PetscLogBegin(), PetscLogView(), PetscLogCountersRead()
+@*/
+PetscErrorCode  PetscLogCountersBegin(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (petsc_logcounters) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  {
+    unsigned long long config[PETSC_LOG_NUM_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,PERF_COUNT_HW_INSTRUCTIONS,PERF_COUNT_HW_CACHE_MISSES};
+    int                i;
+
+    for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) {
+      petsc_counterfd[i] = PetscLogCountersOpen_Private(config[i],i ? petsc_counterfd[0] : -1);
+      if (petsc_counterfd[i] < 0) {
+        ierr = PetscInfo2(0,"Hardware counter %d is not available, perf_event_open() failed with errno %d\n",i,errno);CHKERRQ(ierr);
+        ierr = PetscLogCountersDestroy_Private();CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+      }
+    }
+  }
+#elif defined(PETSC_HAVE_PAPI)
+  {
+    int events[PETSC_LOG_NUM_COUNTERS] = {PAPI_TOT_CYC,PAPI_TOT_INS,PAPI_L3_TCM};
+
+    ierr = PAPI_stop(PAPIEventSet,NULL);CHKERRQ(ierr);
+    if (PAPI_add_events(PAPIEventSet,events,PETSC_LOG_NUM_COUNTERS) != PAPI_OK) {
+      ierr = PAPI_start(PAPIEventSet);CHKERRQ(ierr);
+      ierr = PetscInfo(0,"Hardware counters are not available from PAPI\n");CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    ierr = PAPI_start(PAPIEventSet);CHKERRQ(ierr);
+  }
+#else
+  ierr = PetscInfo(0,"Hardware counters require perf_event_open() or PAPI\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#endif
+  petsc_logcounters = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogCountersDestroy_Private"
+PetscErrorCode PetscLogCountersDestroy_Private(void)
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  int i;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) {
+    if (petsc_counterfd[i] >= 0) close(petsc_counterfd[i]);
+    petsc_counterfd[i] = -1;
+  }
+#endif
+  petsc_logcounters = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+#endif /* PETSC_USE_LOG */
@@ -0,0 +1,509 @@
+
+/*
+      Nested (call tree) logging of PETSc events.
+
+      Every event is recorded under the chain of events that were active when it began, so the time
+   of, for example, MatMult() is split between MatMult() called inside PCApply() inside KSPSolve() and
+   MatMult() called from the line search of SNESSolve().  The flat per stage totals of the default
+   logging are still collected, so -log_summary can be used together with -log_nested.
+*/
+#include <petsc-private/logimpl.h>        /*I    "petscsys.h"   I*/
+#include <petsctime.h>
+#include <petscviewer.h>
+
+#if defined(PETSC_USE_LOG)
+
+/*
+   A node of the call tree: one event (or stage) under one chain of parent events. Node 0 is the
+   root, its children are the stages and the stages' children are the events begun with no other
+   event active.
+*/
+typedef struct {
+  PetscLogEvent  event;           /* the event, or -(stage+1) for a stage */
+  int            parent;          /* the parent node */
+  int            child,sibling;   /* the first child and the next sibling, or -1 */
+  int            count;           /* the number of times the event ended at this node */
+  PetscLogDouble time,flops,numMessages,messageLength,numReductions;
+} PetscNestedNode;
+
+/* An active event: its node and the global counters when it began */
+typedef struct {
+  int            node;
+  PetscLogDouble time,flops,numMessages,messageLength,numReductions;
+} PetscNestedFrame;
+
+static PetscNestedNode  *petsc_nestednodes  = NULL;
+static int              petsc_numnestednodes = 0,petsc_maxnestednodes = 0;
+static PetscNestedFrame *petsc_nestedstack  = NULL;
+static int              petsc_nestedtop     = 0,petsc_maxnestedstack = 0;
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedGetChild"
+/* Finds the child of parent for event, creating it if this is the first time event began under parent */
+static PetscErrorCode PetscLogNestedGetChild(int parent,PetscLogEvent event,int *node)
+{
+  PetscNestedNode *tmp;
+  int             c,last = -1;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  for (c=petsc_nestednodes[parent].child; c >= 0; c=petsc_nestednodes[c].sibling) {
+    if (petsc_nestednodes[c].event == event) {*node = c; PetscFunctionReturn(0);}
+    last = c;
+  }
+  if (petsc_numnestednodes >= petsc_maxnestednodes) {
+    ierr = PetscMalloc(2*petsc_maxnestednodes*sizeof(PetscNestedNode),&tmp);CHKERRQ(ierr);
+    ierr = PetscMemcpy(tmp,petsc_nestednodes,petsc_maxnestednodes*sizeof(PetscNestedNode));CHKERRQ(ierr);
+    ierr = PetscFree(petsc_nestednodes);CHKERRQ(ierr);
+    petsc_nestednodes     = tmp;
+    petsc_maxnestednodes *= 2;
+  }
+  c    = petsc_numnestednodes++;
+  ierr = PetscMemzero(&petsc_nestednodes[c],sizeof(PetscNestedNode));CHKERRQ(ierr);
+  petsc_nestednodes[c].event   = event;
+  petsc_nestednodes[c].parent  = parent;
+  petsc_nestednodes[c].child   = -1;
+  petsc_nestednodes[c].sibling = -1;
+  /* append, so the children are listed in the order they were first called */
+  if (last >= 0) petsc_nestednodes[last].sibling = c;
+  else petsc_nestednodes[parent].child = c;
+  *node = c;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogEventBeginNested"
+PetscErrorCode PetscLogEventBeginNested(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscNestedFrame *frame;
+  int              stage,parent,node;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBeginDefault(event,t,o1,o2,o3,o4);CHKERRQ(ierr);
+  if (petsc_nestedtop) parent = petsc_nestedstack[petsc_nestedtop-1].node;
+  else {
+    ierr = PetscStageLogGetCurrent(petsc_stageLog,&stage);CHKERRQ(ierr);
+    ierr = PetscLogNestedGetChild(0,-(stage+1),&parent);CHKERRQ(ierr);
+  }
+  ierr = PetscLogNestedGetChild(parent,event,&node);CHKERRQ(ierr);
+  if (petsc_nestedtop >= petsc_maxnestedstack) {
+    PetscNestedFrame *tmp;
+
+    ierr = PetscMalloc(2*petsc_maxnestedstack*sizeof(PetscNestedFrame),&tmp);CHKERRQ(ierr);
+    ierr = PetscMemcpy(tmp,petsc_nestedstack,petsc_maxnestedstack*sizeof(PetscNestedFrame));CHKERRQ(ierr);
+    ierr = PetscFree(petsc_nestedstack);CHKERRQ(ierr);
+    petsc_nestedstack     = tmp;
+    petsc_maxnestedstack *= 2;
+  }
+  frame                = &petsc_nestedstack[petsc_nestedtop++];
+  frame->node          = node;
+  frame->flops         = petsc_TotalFlops;
+  frame->numMessages   = petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
+  frame->messageLength = petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
+  frame->numReductions = petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  PetscTime(&frame->time);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogEventEndNested"
+PetscErrorCode PetscLogEventEndNested(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscNestedFrame *frame;
+  PetscNestedNode  *node;
+  PetscLogDouble   curTime;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  PetscTime(&curTime);
+  if (!petsc_nestedtop) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Logging event had unbalanced begin/end pairs");
+  frame = &petsc_nestedstack[--petsc_nestedtop];
+  node  = &petsc_nestednodes[frame->node];
+  if (node->event != event) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Event %d ended while event %d is the innermost active event",event,node->event);
+  node->count++;
+  node->time          += curTime - frame->time;
+  node->flops         += petsc_TotalFlops - frame->flops;
+  node->numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct - frame->numMessages;
+  node->messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len - frame->messageLength;
+  node->numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct - frame->numReductions;
+  ierr = PetscLogEventEndDefault(event,t,o1,o2,o3,o4);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedDestroy_Private"
+PetscErrorCode PetscLogNestedDestroy_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(petsc_nestednodes);CHKERRQ(ierr);
+  ierr = PetscFree(petsc_nestedstack);CHKERRQ(ierr);
+  petsc_numnestednodes = petsc_maxnestednodes = 0;
+  petsc_nestedtop      = petsc_maxnestedstack = 0;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedBegin"
+/*@C
+  PetscLogNestedBegin - Turns on nested logging of events: each event is timed separately for every
+  chain of events that were active when it was called, giving a call tree of the program.
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Options Database Keys:
++ -log_nested [filename] - Prints the call tree at PetscFinalize(), see PetscLogNestedView()
+- -log_nested_flamegraph [filename] - Prints the call tree in the folded stack format of flame graph tools at
+                                      PetscFinalize(), see PetscLogNestedViewFlameGraph()
+
+  Usage:
+.vb
+      PetscInitialize(...);
+      PetscLogNestedBegin();
+       ... code ...
+      PetscLogNestedView(viewer);
+      PetscFinalize();
+.ve
+
+  Notes:
+  The flat logging of PetscLogBegin() is done as well, so PetscLogView() (-log_summary) still works.
+  The events must be properly nested, that is an event must end before the events that were active when it began.
+
+  Level: advanced
+
+.keywords: log, begin, nested, call tree
+.seealso: PetscLogNestedView(), PetscLogNestedViewFlameGraph(), PetscLogBegin(), PetscLogView()
+@*/
+PetscErrorCode  PetscLogNestedBegin(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!petsc_nestednodes) {
+    petsc_maxnestednodes = 128;
+    petsc_maxnestedstack = 32;
+    ierr = PetscMalloc(petsc_maxnestednodes*sizeof(PetscNestedNode),&petsc_nestednodes);CHKERRQ(ierr);
+    ierr = PetscMalloc(petsc_maxnestedstack*sizeof(PetscNestedFrame),&petsc_nestedstack);CHKERRQ(ierr);
+    ierr = PetscMemzero(&petsc_nestednodes[0],sizeof(PetscNestedNode));CHKERRQ(ierr);
+    petsc_nestednodes[0].event   = 0;
+    petsc_nestednodes[0].parent  = -1;
+    petsc_nestednodes[0].child   = -1;
+    petsc_nestednodes[0].sibling = -1;
+    petsc_numnestednodes         = 1;
+  }
+  ierr = PetscLogSet(PetscLogEventBeginNested,PetscLogEventEndNested);CHKERRQ(ierr);
+  ierr = PetscLogBegin_Private();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The call tree merged over the processes of a communicator, only the root has the tree structure
+*/
+typedef struct {
+  int            n;                      /* number of nodes */
+  int            *event,*parent,*child,*sibling;
+  PetscLogDouble *count,*tmax,*tmin,*tsum,*flops,*numMessages,*messageLength,*numReductions;
+} PetscNestedTree;
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedTreeDestroy"
+static PetscErrorCode PetscLogNestedTreeDestroy(PetscNestedTree *tree)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree4(tree->event,tree->parent,tree->child,tree->sibling);CHKERRQ(ierr);
+  ierr = PetscFree4(tree->count,tree->tmax,tree->tmin,tree->tsum);CHKERRQ(ierr);
+  ierr = PetscFree4(tree->flops,tree->numMessages,tree->messageLength,tree->numReductions);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedTreeMerge"
+/*
+   Merges the call trees of the processes of comm: rank 0 gathers the (parent,event) pairs of all nodes,
+   builds the union of the trees and returns to each process the position of its nodes in the union, then
+   the node values are reduced onto rank 0.
+*/
+static PetscErrorCode PetscLogNestedTreeMerge(MPI_Comm comm,PetscNestedTree *tree)
+{
+  PetscMPIInt    rank,size,n = petsc_numnestednodes,*counts = NULL,*displs = NULL,*counts2 = NULL,*displs2 = NULL;
+  int            *local,*all = NULL,*map = NULL,*mymap,i,j,r,c,last,up,N = 0,maxN = 0;
+  int            *event = NULL,*parent = NULL,*child = NULL,*sibling = NULL;
+  PetscLogDouble *vals,*rvals;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscMalloc2(2*n,int,&local,n,int,&mymap);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    local[2*i]   = petsc_nestednodes[i].parent;
+    local[2*i+1] = petsc_nestednodes[i].event;
+  }
+  if (!rank) {ierr = PetscMalloc4(size,PetscMPIInt,&counts,size,PetscMPIInt,&displs,size,PetscMPIInt,&counts2,size,PetscMPIInt,&displs2);CHKERRQ(ierr);}
+  ierr = MPI_Gather(&n,1,MPI_INT,counts,1,MPI_INT,0,comm);CHKERRQ(ierr);
+  if (!rank) {
+    displs[0] = 0;
+    for (r=1; r<size; r++) displs[r] = displs[r-1] + counts[r-1];
+    for (r=0; r<size; r++) {counts2[r] = 2*counts[r]; displs2[r] = 2*displs[r];}
+    ierr = PetscMalloc2(2*(displs[size-1]+counts[size-1]),int,&all,displs[size-1]+counts[size-1],int,&map);CHKERRQ(ierr);
+  }
+  ierr = MPI_Gatherv(local,2*n,MPI_INT,all,counts2,displs2,MPI_INT,0,comm);CHKERRQ(ierr);
+  if (!rank) {
+    maxN = displs[size-1] + counts[size-1];
+    ierr = PetscMalloc4(maxN,int,&event,maxN,int,&parent,maxN,int,&child,maxN,int,&sibling);CHKERRQ(ierr);
+    event[0] = 0; parent[0] = -1; child[0] = -1; sibling[0] = -1; N = 1;
+    for (r=0; r<size; r++) {
+      const int *rall = all + displs2[r];
+      int       *rmap = map + displs[r];
+
+      rmap[0] = 0;
+      /* a node is always created after its parent, so the parent is already mapped */
+      for (i=1; i<counts[r]; i++) {
+        up   = rmap[rall[2*i]];
+        last = -1;
+        for (c=child[up]; c >= 0; c=sibling[c]) {
+          if (event[c] == rall[2*i+1]) break;
+          last = c;
+        }
+        if (c < 0) {
+          c = N++;
+          event[c] = rall[2*i+1]; parent[c] = up; child[c] = -1; sibling[c] = -1;
+          if (last >= 0) sibling[last] = c;
+          else child[up] = c;
+        }
+        rmap[i] = c;
+      }
+    }
+  }
+  ierr = MPI_Scatterv(map,counts,displs,MPI_INT,mymap,n,MPI_INT,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Bcast(&N,1,MPI_INT,0,comm);CHKERRQ(ierr);
+
+  /* the stages have the time of the events called directly in them */
+  for (i=1; i<n; i++) {
+    j = petsc_nestednodes[i].parent;
+    if (j > 0 && petsc_nestednodes[j].parent == 0) {
+      petsc_nestednodes[j].time  = 0.0;
+      petsc_nestednodes[j].flops = 0.0;
+    }
+  }
+  for (i=1; i<n; i++) {
+    j = petsc_nestednodes[i].parent;
+    if (j > 0 && petsc_nestednodes[j].parent == 0) {
+      petsc_nestednodes[j].time  += petsc_nestednodes[i].time;
+      petsc_nestednodes[j].flops += petsc_nestednodes[i].flops;
+    }
+  }
+
+  /* the values to be maxed: count, time, reductions; minimized: time; summed: time, flops, messages, message lengths */
+  ierr = PetscMalloc2(8*N,PetscLogDouble,&vals,8*N,PetscLogDouble,&rvals);CHKERRQ(ierr);
+  ierr = PetscMemzero(vals,8*N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    j             = mymap[i];
+    vals[j]       = petsc_nestednodes[i].count;
+    vals[N+j]     = petsc_nestednodes[i].time;
+    vals[2*N+j]   = petsc_nestednodes[i].numReductions;
+    vals[3*N+j]   = petsc_nestednodes[i].time;
+    vals[4*N+j]   = petsc_nestednodes[i].time;
+    vals[5*N+j]   = petsc_nestednodes[i].flops;
+    vals[6*N+j]   = petsc_nestednodes[i].numMessages;
+    vals[7*N+j]   = petsc_nestednodes[i].messageLength;
+  }
+  ierr = MPI_Reduce(vals,rvals,3*N,MPIU_PETSCLOGDOUBLE,MPI_MAX,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Reduce(vals+3*N,rvals+3*N,N,MPIU_PETSCLOGDOUBLE,MPI_MIN,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Reduce(vals+4*N,rvals+4*N,4*N,MPIU_PETSCLOGDOUBLE,MPI_SUM,0,comm);CHKERRQ(ierr);
+
+  tree->n = N;
+  ierr    = PetscMalloc4(N,int,&tree->event,N,int,&tree->parent,N,int,&tree->child,N,int,&tree->sibling);CHKERRQ(ierr);
+  ierr    = PetscMalloc4(N,PetscLogDouble,&tree->count,N,PetscLogDouble,&tree->tmax,N,PetscLogDouble,&tree->tmin,N,PetscLogDouble,&tree->tsum);CHKERRQ(ierr);
+  ierr    = PetscMalloc4(N,PetscLogDouble,&tree->flops,N,PetscLogDouble,&tree->numMessages,N,PetscLogDouble,&tree->messageLength,N,PetscLogDouble,&tree->numReductions);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscMemcpy(tree->event,event,N*sizeof(int));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->parent,parent,N*sizeof(int));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->child,child,N*sizeof(int));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->sibling,sibling,N*sizeof(int));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->count,rvals,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->tmax,rvals+N,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->numReductions,rvals+2*N,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->tmin,rvals+3*N,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->tsum,rvals+4*N,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->flops,rvals+5*N,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->numMessages,rvals+6*N,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscMemcpy(tree->messageLength,rvals+7*N,N*sizeof(PetscLogDouble));CHKERRQ(ierr);
+    ierr = PetscFree4(event,parent,child,sibling);CHKERRQ(ierr);
+    ierr = PetscFree2(all,map);CHKERRQ(ierr);
+    ierr = PetscFree4(counts,displs,counts2,displs2);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(vals,rvals);CHKERRQ(ierr);
+  ierr = PetscFree2(local,mymap);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedNodeName"
+static PetscErrorCode PetscLogNestedNodeName(PetscNestedTree *tree,int node,const char **name)
+{
+  PetscFunctionBegin;
+  if (tree->event[node] < 0) *name = petsc_stageLog->stageInfo[-tree->event[node]-1].name;
+  else *name = petsc_stageLog->eventLog->eventInfo[tree->event[node]].name;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedViewNode"
+static PetscErrorCode PetscLogNestedViewNode(PetscViewer viewer,PetscNestedTree *tree,int node,int depth,PetscLogDouble ptime)
+{
+  const char     *name;
+  PetscLogDouble ratio,pct,flops;
+  int            c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr  = PetscLogNestedNodeName(tree,node,&name);CHKERRQ(ierr);
+  ratio = (tree->tmin[node] > 0.0) ? tree->tmax[node]/tree->tmin[node] : 0.0;
+  pct   = (ptime > 0.0) ? 100.0*tree->tmax[node]/ptime : 0.0;
+  flops = (tree->tmax[node] > 0.0) ? 1.e-6*tree->flops[node]/tree->tmax[node] : 0.0;
+  ierr  = PetscViewerASCIIPrintf(viewer,"%*s%-*s %7.0f %10.4e %5.1f %5.1f %8.0f %9.2e %9.2e %7.0f\n",2*depth,"",PetscMax(40-2*depth,1),name,tree->count[node],tree->tmax[node],ratio,pct,flops,tree->numMessages[node],tree->messageLength[node],tree->numReductions[node]);CHKERRQ(ierr);
+  for (c=tree->child[node]; c >= 0; c=tree->sibling[c]) {
+    ierr = PetscLogNestedViewNode(viewer,tree,c,depth+1,tree->tmax[node]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedView"
+/*@C
+  PetscLogNestedView - Prints the call tree collected with PetscLogNestedBegin(), merged over the processes
+  of the viewer.
+
+  Collective over viewer
+
+  Input Parameter:
+. viewer - an ASCII viewer
+
+  Options Database Keys:
+. -log_nested [filename] - Prints the call tree at PetscFinalize()
+
+  Notes:
+  For each event under each chain of calling events the table gives the maximum number of calls and time over the
+  processes, the ratio of the maximum to the minimum time, the percentage of the time of the calling event, the flop
+  rate (total flops divided by the maximum time), the total number and length of the messages and the maximum
+  number of reductions. A stage has the time of the events called directly in it.
+
+  Level: advanced
+
+.keywords: log, view, nested, call tree
+.seealso: PetscLogNestedBegin(), PetscLogNestedViewFlameGraph(), PetscLogView()
+@*/
+PetscErrorCode  PetscLogNestedView(PetscViewer viewer)
+{
+  PetscNestedTree tree;
+  PetscMPIInt     rank;
+  PetscLogDouble  total = 0.0;
+  int             c;
+  PetscBool       isascii;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  if (!isascii) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"Only ASCII viewers are supported");
+  if (!petsc_nestednodes) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_ORDER,"Must call PetscLogNestedBegin() or use -log_nested");
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)viewer),&rank);CHKERRQ(ierr);
+  ierr = PetscLogNestedTreeMerge(PetscObjectComm((PetscObject)viewer),&tree);CHKERRQ(ierr);
+  if (!rank) {
+    for (c=tree.child[0]; c >= 0; c=tree.sibling[c]) total += tree.tmax[c];
+    ierr = PetscViewerASCIIPrintf(viewer,"Nested event log: time is the maximum over the processes, %%P is the percentage of the time of the caller\n\n");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"%-40s %7s %10s %5s %5s %8s %9s %9s %7s\n","Event","Count","Time (sec)","Ratio","%P","Mflop/s","Mess","Length","Reduct");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
+    for (c=tree.child[0]; c >= 0; c=tree.sibling[c]) {
+      ierr = PetscLogNestedViewNode(viewer,&tree,c,0,total);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscLogNestedTreeDestroy(&tree);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedViewFlameGraphNode"
+static PetscErrorCode PetscLogNestedViewFlameGraphNode(PetscViewer viewer,PetscNestedTree *tree,int node,char *path,size_t len,PetscMPIInt size)
+{
+  const char     *name;
+  size_t         plen,nlen;
+  PetscLogDouble self;
+  int            c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogNestedNodeName(tree,node,&name);CHKERRQ(ierr);
+  ierr = PetscStrlen(path,&plen);CHKERRQ(ierr);
+  ierr = PetscStrlen(name,&nlen);CHKERRQ(ierr);
+  if (plen + 1 + nlen >= len) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SUP,"Chain of events to %s is longer than %d characters",name,(int)len-1);
+  if (plen) {ierr = PetscStrcat(path,";");CHKERRQ(ierr);}
+  ierr = PetscStrcat(path,name);CHKERRQ(ierr);
+  if (tree->event[node] >= 0) {
+    self = tree->tsum[node];
+    for (c=tree->child[node]; c >= 0; c=tree->sibling[c]) self -= tree->tsum[c];
+    ierr = PetscViewerASCIIPrintf(viewer,"%s %.0f\n",path,PetscMax(1.e6*self/size,0.0));CHKERRQ(ierr);
+  }
+  for (c=tree->child[node]; c >= 0; c=tree->sibling[c]) {
+    ierr = PetscLogNestedViewFlameGraphNode(viewer,tree,c,path,len,size);CHKERRQ(ierr);
+  }
+  path[plen] = 0;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogNestedViewFlameGraph"
+/*@C
+  PetscLogNestedViewFlameGraph - Prints the call tree collected with PetscLogNestedBegin() in the folded
+  stack format read by flame graph tools such as flamegraph.pl and speedscope.
+
+  Collective over viewer
+
+  Input Parameter:
+. viewer - an ASCII viewer
+
+  Options Database Keys:
+. -log_nested_flamegraph [filename] - Prints the folded stacks at PetscFinalize()
+
+  Notes:
+  Each line has the stage and chain of events separated by semicolons followed by the time spent in the last
+  event itself, not in the events it called, in microseconds averaged over the processes.
+
+  Level: advanced
+
+.keywords: log, view, nested, call tree, flame graph
+.seealso: PetscLogNestedBegin(), PetscLogNestedView()
+@*/
+PetscErrorCode  PetscLogNestedViewFlameGraph(PetscViewer viewer)
+{
+  PetscNestedTree tree;
+  PetscMPIInt     rank,size;
+  char            path[4096];
+  int             c;
+  PetscBool       isascii;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  if (!isascii) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"Only ASCII viewers are supported");
+  if (!petsc_nestednodes) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_ORDER,"Must call PetscLogNestedBegin() or use -log_nested_flamegraph");
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)viewer),&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)viewer),&size);CHKERRQ(ierr);
+  ierr = PetscLogNestedTreeMerge(PetscObjectComm((PetscObject)viewer),&tree);CHKERRQ(ierr);
+  if (!rank) {
+    path[0] = 0;
+    for (c=tree.child[0]; c >= 0; c=tree.sibling[c]) {
+      ierr = PetscLogNestedViewFlameGraphNode(viewer,&tree,c,path,sizeof(path),size);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscLogNestedTreeDestroy(&tree);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif /* PETSC_USE_LOG */
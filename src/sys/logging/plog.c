@@ -83,6 +83,9 @@ char             petsc_tracespace[128]       = " ";
 PetscLogDouble   petsc_tracetime             = 0.0;
 static PetscBool PetscLogBegin_PrivateCalled = PETSC_FALSE;
 
+/* PetscMalloc() statistics for each stage and event */
+PetscBool petsc_logmemory = PETSC_FALSE;
+
 /*---------------------------------------------- General Functions --------------------------------------------------*/
 #undef __FUNCT__
 #define __FUNCT__ "PetscLogDestroy"
@@ -108,6 +111,9 @@ PetscErrorCode  PetscLogDestroy(void)
   PetscFunctionBegin;
   ierr = PetscFree(petsc_actions);CHKERRQ(ierr);
   ierr = PetscFree(petsc_objects);CHKERRQ(ierr);
+  ierr = PetscLogNestedDestroy_Private();CHKERRQ(ierr);
+  ierr = PetscLogTimelineDestroy_Private();CHKERRQ(ierr);
+  ierr = PetscLogCountersDestroy_Private();CHKERRQ(ierr);
   ierr = PetscLogSet(NULL, NULL);CHKERRQ(ierr);
 
   /* Resetting phase */
@@ -124,6 +130,7 @@ PetscErrorCode  PetscLogDestroy(void)
   petsc_objects               = NULL;
   petsc_logActions            = PETSC_FALSE;
   petsc_logObjects            = PETSC_FALSE;
+  petsc_logmemory             = PETSC_FALSE;
   petsc_BaseTime              = 0.0;
   petsc_TotalFlops            = 0.0;
   petsc_tmp_flops             = 0.0;
@@ -371,6 +378,58 @@ PetscErrorCode  PetscLogTraceBegin(FILE *file)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogMemoryBegin"
+/*@C
+  PetscLogMemoryBegin - Turns on the collection of PetscMalloc() statistics for each stage and event:
+  the number of calls, the bytes allocated, the maximum memory allocated and the memory allocated
+  when the stage or event ended. They are reported by PetscLogView().
+
+  Not Collective
+
+  Options Database Keys:
+. -log_memory - Turns on the collection of the statistics
+
+  Notes:
+  The statistics are kept by the tracing PetscMalloc(), which is the default in debug builds and
+  otherwise is turned on with -malloc; without it a message is printed with -info and nothing is collected.
+
+  The maximum memory allows finding the stages and events that determine the peak memory of the
+  program, while the number of calls shows those that churn the allocator.
+
+  May be called before PetscLogBegin(), the statistics are then collected from the Main Stage on.
+
+  Level: advanced
+
+.keywords: log, memory, malloc
+.seealso: PetscLogBegin(), PetscLogView(), PetscMallocGetTotalUsage(), PetscMallocPushMaximumUsage()
+@*/
+PetscErrorCode  PetscLogMemoryBegin(void)
+{
+  PetscStageLog  stageLog;
+  PetscBool      flg;
+  int            stage;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (petsc_logmemory) PetscFunctionReturn(0);
+  ierr = PetscMallocGetDebug(&flg);CHKERRQ(ierr);
+  if (!flg) {
+    ierr = PetscInfo(0,"Memory statistics require the tracing PetscMalloc(), run with -malloc\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  petsc_logmemory = PETSC_TRUE;
+  /* without the stage log PetscLogBegin_Private() starts the Main Stage when it pushes it */
+  if (!petsc_stageLog) PetscFunctionReturn(0);
+  /* start the stage that is already running */
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  ierr = PetscStageLogGetCurrent(stageLog, &stage);CHKERRQ(ierr);
+  if (stage >= 0 && stageLog->stageInfo[stage].perfInfo.active) {
+    ierr = EventPerfInfoMemoryBegin(&stageLog->stageInfo[stage].perfInfo, -(stage+1));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscLogActions"
 /*@
@@ -872,6 +931,43 @@ PetscErrorCode  PetscLogEventSetActiveAll(PetscLogEvent event, PetscBool isActiv
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogEventSetWait"
+/*@
+  PetscLogEventSetWait - Marks an event as one that only waits for communication, for example
+  around MPI_Waitall() or a blocking reduction.
+
+  Not Collective
+
+  Input Parameters:
++ event  - The event id
+- isWait - PETSC_TRUE if the event only waits
+
+  Notes:
+  With more than one process PetscLogView() splits the time of each stage into the time in these
+  events and the remaining computation, and prints their distribution over the processes. The time
+  waiting includes the time for slower processes to arrive, so an imbalanced computation shows up
+  as waiting on the faster processes.
+
+  Wait events must not be nested in each other, and every process must mark the same events.
+
+  Level: developer
+
+.keywords: log, event, wait, imbalance
+.seealso: PetscLogView(), PetscLogEventRegister()
+@*/
+PetscErrorCode  PetscLogEventSetWait(PetscLogEvent event, PetscBool isWait)
+{
+  PetscStageLog  stageLog;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  if (event < 0 || event >= stageLog->eventLog->numEvents) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Invalid event %d",event);
+  stageLog->eventLog->eventInfo[event].wait = isWait;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscLogEventActivateClass"
 /*@
@@ -1226,6 +1322,28 @@ PetscErrorCode  PetscLogDump(const char sname[])
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogViewWaitRow_Private"
+/* Prints the min, median, max, the process with the max and max/avg of column col of the values gathered from all processes */
+static PetscErrorCode PetscLogViewWaitRow_Private(MPI_Comm comm, FILE *fd, const char name[], PetscMPIInt size, int nv, int col, const PetscLogDouble values[], PetscReal work[])
+{
+  PetscLogDouble avg = 0.0;
+  PetscMPIInt    p, maxRank = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (p = 0; p < size; p++) {
+    work[p] = (PetscReal) values[p*nv+col];
+    avg    += values[p*nv+col];
+    if (values[p*nv+col] > values[maxRank*nv+col]) maxRank = p;
+  }
+  avg /= size;
+  ierr = PetscSortReal(size, work);CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm, fd, "%-20s %10.4e %10.4e %10.4e %8d %7.2f\n", name, (double) work[0], (double) work[size/2], (double) work[size-1], maxRank,
+                      avg > 0.0 ? values[maxRank*nv+col]/avg : 0.0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscLogView"
 /*@C
@@ -1274,6 +1392,7 @@ PetscErrorCode  PetscLogView(PetscViewer viewer)
   PetscLogDouble     min, max, tot, ratio, avg, x, y;
   PetscLogDouble     minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratCt, totm, totml, totr;
   PetscMPIInt        minCt, maxCt;
+  PetscMPIInt        localCounters, counters;
   PetscMPIInt        size, rank;
   PetscBool          *localStageUsed,    *stageUsed;
   PetscBool          *localStageVisible, *stageVisible;
@@ -1621,6 +1740,164 @@ PetscErrorCode  PetscLogView(PetscViewer viewer)
     }
   }
 
+  /* Load balance, the time of each stage on each process split into computation and waiting in the wait events */
+  if (size > 1) {
+    PetscLogDouble *locWait, *allWait = NULL;
+    PetscReal      *work = NULL;
+    int            *locWaitEvents, *waitEvents, numWait = 0, nv, i;
+
+    localNumEvents = stageLog->eventLog->numEvents;
+    ierr = MPI_Allreduce(&localNumEvents, &numEvents, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
+    ierr = PetscMalloc2(numEvents,int,&locWaitEvents,numEvents,int,&waitEvents);CHKERRQ(ierr);
+    for (event = 0; event < numEvents; event++) {
+      locWaitEvents[event] = (event < stageLog->eventLog->numEvents) ? (int) stageLog->eventLog->eventInfo[event].wait : 0;
+    }
+    ierr = MPI_Allreduce(locWaitEvents, waitEvents, numEvents, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
+    for (event = 0; event < numEvents; event++) if (waitEvents[event]) waitEvents[numWait++] = event;
+    /* stage time, computation, wait, and the time in each wait event */
+    nv   = numWait+3;
+    ierr = PetscMalloc(nv*sizeof(PetscLogDouble), &locWait);CHKERRQ(ierr);
+    if (!rank) {
+      ierr = PetscMalloc2(size*nv,PetscLogDouble,&allWait,size,PetscReal,&work);CHKERRQ(ierr);
+    }
+    ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "\nLoad balance: time (sec) of each stage on each process split into computation and waiting for communication,\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "  the time in the wait events listed below it. Since the faster processes wait for the slower ones, a large\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "  Max/Avg of the computation indicates a poorly balanced partition, while a balanced computation with a large\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "  wait indicates the time is spent in the network. Max Rank is the process with the largest time.\n\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "                        Min        Median       Max     Max Rank Max/Avg\n");CHKERRQ(ierr);
+    for (stage = 0; stage < numStages; stage++) {
+      if (!stageVisible[stage]) continue;
+      ierr = PetscMemzero(locWait, nv*sizeof(PetscLogDouble));CHKERRQ(ierr);
+      if (localStageUsed[stage]) {
+        eventInfo      = stageLog->stageInfo[stage].eventLog->eventInfo;
+        localNumEvents = stageLog->stageInfo[stage].eventLog->numEvents;
+        locWait[0]     = stageInfo[stage].perfInfo.time;
+        for (i = 0; i < numWait; i++) {
+          event = waitEvents[i];
+          if ((event < localNumEvents) && (eventInfo[event].depth == 0)) {
+            locWait[3+i] = eventInfo[event].time;
+            locWait[2]  += eventInfo[event].time;
+          }
+        }
+        locWait[1] = locWait[0] - locWait[2];
+      }
+      ierr = MPI_Gather(locWait, nv, MPIU_PETSCLOGDOUBLE, allWait, nv, MPIU_PETSCLOGDOUBLE, 0, comm);CHKERRQ(ierr);
+      if (rank) continue;
+      ierr = PetscFPrintf(comm, fd, "\n--- Event Stage %d: %s\n\n", stage, localStageUsed[stage] ? stageInfo[stage].name : "Unknown");CHKERRQ(ierr);
+      ierr = PetscLogViewWaitRow_Private(comm, fd, "Stage", size, nv, 0, allWait, work);CHKERRQ(ierr);
+      ierr = PetscLogViewWaitRow_Private(comm, fd, "  Computation", size, nv, 1, allWait, work);CHKERRQ(ierr);
+      ierr = PetscLogViewWaitRow_Private(comm, fd, "  Wait", size, nv, 2, allWait, work);CHKERRQ(ierr);
+      for (i = 0; i < numWait; i++) {
+        char        wname[64];
+        PetscMPIInt p;
+
+        for (p = 0, maxt = 0.0; p < size; p++) maxt = PetscMax(maxt, allWait[p*nv+3+i]);
+        if (maxt == 0.0) continue;
+        ierr = PetscSNPrintf(wname, sizeof(wname), "    %s", waitEvents[i] < stageLog->eventLog->numEvents ? stageLog->eventLog->eventInfo[waitEvents[i]].name : "Unknown");CHKERRQ(ierr);
+        ierr = PetscLogViewWaitRow_Private(comm, fd, wname, size, nv, 3+i, allWait, work);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscFree(locWait);CHKERRQ(ierr);
+    if (!rank) {
+      ierr = PetscFree2(allWait,work);CHKERRQ(ierr);
+    }
+    ierr = PetscFree2(locWaitEvents,waitEvents);CHKERRQ(ierr);
+  }
+
+  /* Hardware counters, only if they were collected on all processes */
+  localCounters = (PetscMPIInt) petsc_logcounters;
+  ierr = MPI_Allreduce(&localCounters, &counters, 1, MPI_INT, MPI_MIN, comm);CHKERRQ(ierr);
+  if (counters) {
+    ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "\nHardware counters: totals over all processes, GHz is cycles/(total time), GB/s is last level cache\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "  misses times %d byte lines/(max time), a lower bound of the memory bandwidth achieved\n\n", PETSC_LEVEL1_DCACHE_LINESIZE);CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "Event                Count   Time (sec)  Gcycles  Ginstr  IPC   GHz  LLC misses     GB/s\n");CHKERRQ(ierr);
+    for (stage = 0; stage < numStages; stage++) {
+      if (!stageVisible[stage]) continue;
+      ierr = PetscFPrintf(comm, fd, "\n--- Event Stage %d: %s\n\n", stage, localStageUsed[stage] ? stageInfo[stage].name : "Unknown");CHKERRQ(ierr);
+      if (localStageUsed[stage]) {
+        eventInfo      = stageLog->stageInfo[stage].eventLog->eventInfo;
+        localNumEvents = stageLog->stageInfo[stage].eventLog->numEvents;
+      } else localNumEvents = 0;
+      ierr = MPI_Allreduce(&localNumEvents, &numEvents, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
+      for (event = 0; event < numEvents; event++) {
+        PetscLogDouble locCounters[PETSC_LOG_NUM_COUNTERS+1] = {0.0, 0.0, 0.0, 0.0}, totCounters[PETSC_LOG_NUM_COUNTERS+1];
+        PetscMPIInt    ct = 0;
+
+        name = "";
+        if (localStageUsed[stage] && (event < stageLog->stageInfo[stage].eventLog->numEvents) && (eventInfo[event].depth == 0)) {
+          ierr = PetscMemcpy(locCounters, eventInfo[event].counters, PETSC_LOG_NUM_COUNTERS*sizeof(PetscLogDouble));CHKERRQ(ierr);
+          locCounters[PETSC_LOG_NUM_COUNTERS] = eventInfo[event].time;
+          ct   = eventInfo[event].count;
+          name = stageLog->eventLog->eventInfo[event].name;
+        }
+        ierr = MPI_Allreduce(locCounters, totCounters, PETSC_LOG_NUM_COUNTERS+1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        ierr = MPI_Allreduce(&locCounters[PETSC_LOG_NUM_COUNTERS], &maxt, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+        ierr = MPI_Allreduce(&ct, &maxCt, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
+        if (maxCt != 0) {
+          ierr = PetscFPrintf(comm, fd, "%-16s %9d %10.4e %8.3f %7.3f %4.2f %5.2f %11.4e %8.3f\n", name, maxCt, maxt, 1.e-9*totCounters[0], 1.e-9*totCounters[1],
+                              totCounters[0] > 0.0 ? totCounters[1]/totCounters[0] : 0.0,
+                              totCounters[PETSC_LOG_NUM_COUNTERS] > 0.0 ? 1.e-9*totCounters[0]/totCounters[PETSC_LOG_NUM_COUNTERS] : 0.0,
+                              totCounters[2], maxt > 0.0 ? 1.e-9*PETSC_LEVEL1_DCACHE_LINESIZE*totCounters[2]/maxt : 0.0);CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+
+  /* PetscMalloc() statistics, only if they were collected on all processes */
+  localCounters = (PetscMPIInt) petsc_logmemory;
+  ierr = MPI_Allreduce(&localCounters, &counters, 1, MPI_INT, MPI_MIN, comm);CHKERRQ(ierr);
+  if (counters) {
+    ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "\nPetscMalloc() calls: max over processes of the number of calls, the bytes allocated, the maximum memory allocated\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "  at any time during the stage or event and the memory allocated when it last ended; nested events are included\n\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "Event                Count    Mallocs   Malloced (bytes)        Max (bytes)       Live (bytes)\n");CHKERRQ(ierr);
+    for (stage = 0; stage < numStages; stage++) {
+      PetscLogDouble locMem[4], maxMem[4];
+      PetscMPIInt    ct;
+
+      if (!stageVisible[stage]) continue;
+      ierr = PetscFPrintf(comm, fd, "\n--- Event Stage %d: %s\n\n", stage, localStageUsed[stage] ? stageInfo[stage].name : "Unknown");CHKERRQ(ierr);
+      if (localStageUsed[stage]) {
+        eventInfo      = stageLog->stageInfo[stage].eventLog->eventInfo;
+        localNumEvents = stageLog->stageInfo[stage].eventLog->numEvents;
+        locMem[0]      = stageInfo[stage].perfInfo.mallocs;
+        locMem[1]      = stageInfo[stage].perfInfo.mallocSpace;
+        locMem[2]      = stageInfo[stage].perfInfo.mallocMax;
+        locMem[3]      = stageInfo[stage].perfInfo.mallocLive;
+        ct             = stageInfo[stage].perfInfo.count;
+      } else {
+        localNumEvents = 0;
+        ierr = PetscMemzero(locMem, sizeof(locMem));CHKERRQ(ierr);
+        ct   = 0;
+      }
+      ierr = MPI_Allreduce(locMem, maxMem, 4, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(&ct, &maxCt, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
+      ierr = PetscFPrintf(comm, fd, "%-16s %9d %10.0f %18.0f %18.0f %18.0f\n", "Stage", maxCt, maxMem[0], maxMem[1], maxMem[2], maxMem[3]);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(&localNumEvents, &numEvents, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
+      for (event = 0; event < numEvents; event++) {
+        ierr = PetscMemzero(locMem, sizeof(locMem));CHKERRQ(ierr);
+        ct   = 0;
+        name = "";
+        if (localStageUsed[stage] && (event < localNumEvents) && (eventInfo[event].depth == 0)) {
+          locMem[0] = eventInfo[event].mallocs;
+          locMem[1] = eventInfo[event].mallocSpace;
+          locMem[2] = eventInfo[event].mallocMax;
+          locMem[3] = eventInfo[event].mallocLive;
+          ct        = eventInfo[event].count;
+          name      = stageLog->eventLog->eventInfo[event].name;
+        }
+        ierr = MPI_Allreduce(locMem, maxMem, 4, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+        ierr = MPI_Allreduce(&ct, &maxCt, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
+        /* events that do not allocate only repeat the memory of their callers */
+        if (maxCt != 0 && maxMem[0] != 0.0) {
+          ierr = PetscFPrintf(comm, fd, "%-16s %9d %10.0f %18.0f %18.0f %18.0f\n", name, maxCt, maxMem[0], maxMem[1], maxMem[2], maxMem[3]);CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+
   /* Memory usage and object creation */
   ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "\n");CHKERRQ(ierr);
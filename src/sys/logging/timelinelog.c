@@ -0,0 +1,338 @@
+
+/*
+      Timeline logging of PETSc events.
+
+      The begin and end of every event are recorded, with the stage and thread, in a ring buffer on each
+   process. At the end the timelines of all processes are shifted to the clock of the first process and
+   written in the Chrome trace event format (read by chrome://tracing and Perfetto) or in a compact binary format.
+*/
+#include <petsc-private/logimpl.h>        /*I    "petscsys.h"   I*/
+#include <petsc-private/threadcommimpl.h>
+#include <petsctime.h>
+#include <petscviewer.h>
+
+#if defined(PETSC_USE_LOG)
+
+typedef struct {
+  PetscLogDouble time;
+  int            event;
+  short          stage;          /* -1 for events outside of all stages */
+  unsigned char  thread;
+  char           phase;          /* 'B' or 'E' */
+} PetscTimelineRecord;
+
+static PetscTimelineRecord *petsc_timeline     = NULL;
+static PetscInt            petsc_timelinesize  = 0;    /* capacity of the ring buffer */
+static PetscInt            petsc_timelinecount = 0;    /* number of records ever written, the next goes in count % size */
+static PetscLogDouble      petsc_timelinestart = 0.0;
+/* the handlers that were active when the timeline was started, they are called as well */
+static PetscErrorCode (*petsc_timelineplb)(PetscLogEvent,int,PetscObject,PetscObject,PetscObject,PetscObject) = NULL;
+static PetscErrorCode (*petsc_timelineple)(PetscLogEvent,int,PetscObject,PetscObject,PetscObject,PetscObject) = NULL;
+
+#define PetscLogTimelineRecord(e,ph) do {                                                          \
+    PetscTimelineRecord *_r = &petsc_timeline[petsc_timelinecount++ % petsc_timelinesize];          \
+    PetscInt            _t  = 0;                                                                    \
+    if (PETSC_THREAD_COMM_WORLD) {ierr = PetscThreadCommGetRank(PETSC_THREAD_COMM_WORLD,&_t);CHKERRQ(ierr);} \
+    _r->event  = (e);                                                                               \
+    _r->stage  = (short)petsc_stageLog->curStage;                                                   \
+    _r->thread = (unsigned char)_t;                                                                 \
+    _r->phase  = (ph);                                                                              \
+    PetscTime(&_r->time);                                                                           \
+  } while (0)
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogEventBeginTimeline"
+PetscErrorCode PetscLogEventBeginTimeline(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (petsc_timelineplb) {ierr = (*petsc_timelineplb)(event,t,o1,o2,o3,o4);CHKERRQ(ierr);}
+  PetscLogTimelineRecord(event,'B');
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogEventEndTimeline"
+PetscErrorCode PetscLogEventEndTimeline(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscLogTimelineRecord(event,'E');
+  if (petsc_timelineple) {ierr = (*petsc_timelineple)(event,t,o1,o2,o3,o4);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogTimelineDestroy_Private"
+PetscErrorCode PetscLogTimelineDestroy_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(petsc_timeline);CHKERRQ(ierr);
+  petsc_timelinesize  = 0;
+  petsc_timelinecount = 0;
+  petsc_timelineplb   = NULL;
+  petsc_timelineple   = NULL;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogTimelineBegin"
+/*@C
+  PetscLogTimelineBegin - Turns on recording of the timeline of the events: the time each event begins and
+  ends, with the stage and thread, is saved on each process so that it can be viewed with PetscLogTimelineView().
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Options Database Keys:
++ -log_timeline [filename] - Writes the timeline in the Chrome trace event format at PetscFinalize()
+. -log_timeline_binary <filename> - Writes the timeline in binary at PetscFinalize()
+- -log_timeline_size <n> - The number of begin and end records kept on each process, default 100000
+
+  Notes:
+  The records are kept in a ring buffer, when it is full the oldest records are overwritten, so the end of the
+  run is always available.
+
+  The logging that was active when this is called, for example from PetscLogBegin() or PetscLogNestedBegin(),
+  is still done; if no logging was active PetscLogBegin() is called.
+
+  Level: advanced
+
+.keywords: log, begin, timeline, trace
+.seealso: PetscLogTimelineView(), PetscLogBegin(), PetscLogNestedBegin(), PetscLogTraceBegin()
+@*/
+PetscErrorCode  PetscLogTimelineBegin(void)
+{
+  PetscInt       size = 100000;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (petsc_timeline) PetscFunctionReturn(0);
+  ierr = PetscOptionsGetInt(NULL,"-log_timeline_size",&size,NULL);CHKERRQ(ierr);
+  if (size < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Timeline size %D must be positive",size);
+  if (!PetscLogPLB) {
+    ierr = PetscLogSet(PetscLogEventBeginDefault,PetscLogEventEndDefault);CHKERRQ(ierr);
+  }
+  ierr = PetscLogBegin_Private();CHKERRQ(ierr);
+  ierr = PetscMalloc(size*sizeof(PetscTimelineRecord),&petsc_timeline);CHKERRQ(ierr);
+  petsc_timelinesize  = size;
+  petsc_timelinecount = 0;
+  petsc_timelineplb   = PetscLogPLB;
+  petsc_timelineple   = PetscLogPLE;
+  ierr = PetscLogSet(PetscLogEventBeginTimeline,PetscLogEventEndTimeline);CHKERRQ(ierr);
+  PetscTime(&petsc_timelinestart);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogTimelineClockOffsets"
+/*
+   Estimates on rank 0 the offset of the clock of each process from the clock of rank 0 by ping-pong messages,
+   keeping the estimate from the exchange with the shortest round trip
+*/
+static PetscErrorCode PetscLogTimelineClockOffsets(MPI_Comm comm,PetscMPIInt tag,PetscLogDouble *offsets)
+{
+  PetscMPIInt    rank,size,r;
+  PetscLogDouble t0,t1,tr,best;
+  MPI_Status     status;
+  int            k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  if (!rank) {
+    offsets[0] = 0.0;
+    for (r=1; r<size; r++) {
+      best = PETSC_MAX_REAL;
+      for (k=0; k<10; k++) {
+        PetscTime(&t0);
+        ierr = MPI_Send(&t0,1,MPIU_PETSCLOGDOUBLE,r,tag,comm);CHKERRQ(ierr);
+        ierr = MPI_Recv(&tr,1,MPIU_PETSCLOGDOUBLE,r,tag,comm,&status);CHKERRQ(ierr);
+        PetscTime(&t1);
+        if (t1 - t0 < best) {
+          best       = t1 - t0;
+          offsets[r] = tr - 0.5*(t0 + t1);
+        }
+      }
+    }
+  } else {
+    for (k=0; k<10; k++) {
+      ierr = MPI_Recv(&tr,1,MPIU_PETSCLOGDOUBLE,0,tag,comm,&status);CHKERRQ(ierr);
+      PetscTime(&tr);
+      ierr = MPI_Send(&tr,1,MPIU_PETSCLOGDOUBLE,0,tag,comm);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogTimelineGetRecords"
+/* Copies the records in the ring buffer, oldest first, dropping the ends whose begins were overwritten */
+static PetscErrorCode PetscLogTimelineGetRecords(PetscInt *n,PetscTimelineRecord **records)
+{
+  PetscInt       i,first,cnt = 0,depth = 0,num = PetscMin(petsc_timelinecount,petsc_timelinesize);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr  = PetscMalloc(num*sizeof(PetscTimelineRecord),records);CHKERRQ(ierr);
+  first = (petsc_timelinecount > petsc_timelinesize) ? petsc_timelinecount % petsc_timelinesize : 0;
+  for (i=0; i<num; i++) {
+    PetscTimelineRecord *r = &petsc_timeline[(first + i) % petsc_timelinesize];
+
+    if (r->phase == 'B') depth++;
+    else if (!depth) continue;
+    else depth--;
+    (*records)[cnt++] = *r;
+  }
+  *n = cnt;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLogTimelineView"
+/*@C
+  PetscLogTimelineView - Writes the timeline recorded with PetscLogTimelineBegin() of all processes of the viewer,
+  with the clocks of the processes shifted to that of the first process.
+
+  Collective over viewer
+
+  Input Parameter:
+. viewer - an ASCII viewer for the Chrome trace event format or a binary viewer
+
+  Options Database Keys:
++ -log_timeline [filename] - Writes the timeline in the Chrome trace event format at PetscFinalize()
+- -log_timeline_binary <filename> - Writes the timeline in binary at PetscFinalize()
+
+  Notes:
+  The trace event format file can be loaded in chrome://tracing or https://ui.perfetto.dev, each process is
+  shown as a separate track group and each thread as a track. Times are in microseconds from the earliest start
+  of the timeline on the processes.
+
+  The binary file contains, written with PetscBinaryWrite(), the number of processes, stages and events as
+  PETSC_INT, the names of the stages and then of the events each as 64 PETSC_CHAR and then for each process
+  the number of records n as PETSC_INT followed by n PETSC_DOUBLE times in seconds, n PETSC_INT events,
+  n PETSC_SHORT stages, -1 outside of all stages, n PETSC_SHORT threads and n PETSC_CHAR phases, 'B' or 'E'.
+
+  The offset between the clocks of the processes is estimated by exchanging messages when this routine is called.
+
+  Level: advanced
+
+.keywords: log, view, timeline, trace
+.seealso: PetscLogTimelineBegin(), PetscLogView(), PetscLogNestedView()
+@*/
+PetscErrorCode  PetscLogTimelineView(PetscViewer viewer)
+{
+  MPI_Comm            comm;
+  PetscMPIInt         rank,size,r,tag,cnt;
+  PetscInt            n = 0,i,nstages,nevents;
+  PetscTimelineRecord *records,*rrecords;
+  PetscLogDouble      *offsets = NULL,*starts = NULL,start = PETSC_MAX_REAL;
+  PetscEventRegInfo   *eventInfo;
+  PetscStageInfo      *stageInfo;
+  PetscBool           isascii,isbinary;
+  MPI_Status          status;
+  int                 fd;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  if (!isascii && !isbinary) SETERRQ(comm,PETSC_ERR_SUP,"Only ASCII and binary viewers are supported");
+  if (!petsc_timeline) SETERRQ(comm,PETSC_ERR_ORDER,"Must call PetscLogTimelineBegin() or use -log_timeline");
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)viewer,&tag);CHKERRQ(ierr);
+  if (!rank) {ierr = PetscMalloc2(size,PetscLogDouble,&offsets,size,PetscLogDouble,&starts);CHKERRQ(ierr);}
+  ierr = PetscLogTimelineClockOffsets(comm,tag,offsets);CHKERRQ(ierr);
+  /* the times are given from the earliest start of the timelines */
+  ierr = MPI_Gather(&petsc_timelinestart,1,MPIU_PETSCLOGDOUBLE,starts,1,MPIU_PETSCLOGDOUBLE,0,comm);CHKERRQ(ierr);
+  if (!rank) {
+    for (r=0; r<size; r++) start = PetscMin(start,starts[r] - offsets[r]);
+  }
+  ierr = PetscLogTimelineGetRecords(&n,&records);CHKERRQ(ierr);
+  nstages   = petsc_stageLog->numStages;
+  nevents   = petsc_stageLog->eventLog->numEvents;
+  stageInfo = petsc_stageLog->stageInfo;
+  eventInfo = petsc_stageLog->eventLog->eventInfo;
+  if (isbinary) {
+    ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
+  }
+  if (!rank) {
+    if (isascii) {
+      ierr = PetscViewerASCIIPrintf(viewer,"{\"traceEvents\":[\n");CHKERRQ(ierr);
+    } else {
+      PetscInt header[3];
+      char     name[64];
+
+      header[0] = size; header[1] = nstages; header[2] = nevents;
+      ierr      = PetscBinaryWrite(fd,header,3,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+      for (i=0; i<nstages+nevents; i++) {
+        ierr = PetscMemzero(name,sizeof(name));CHKERRQ(ierr);
+        ierr = PetscStrncpy(name,i < nstages ? stageInfo[i].name : eventInfo[i-nstages].name,sizeof(name)-1);CHKERRQ(ierr);
+        ierr = PetscBinaryWrite(fd,name,sizeof(name),PETSC_CHAR,PETSC_FALSE);CHKERRQ(ierr);
+      }
+    }
+    for (r=0; r<size; r++) {
+      PetscInt m = n;
+
+      rrecords = records;
+      if (r) {
+        ierr = MPI_Recv(&cnt,1,MPI_INT,r,tag,comm,&status);CHKERRQ(ierr);
+        ierr = PetscMalloc(cnt*sizeof(PetscTimelineRecord),&rrecords);CHKERRQ(ierr);
+        ierr = MPI_Recv(rrecords,cnt*sizeof(PetscTimelineRecord),MPI_BYTE,r,tag,comm,&status);CHKERRQ(ierr);
+        m    = cnt;
+      }
+      if (isascii) {
+        for (i=0; i<m; i++) {
+          PetscTimelineRecord *rec = &rrecords[i];
+
+          ierr = PetscViewerASCIIPrintf(viewer,"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d},\n",eventInfo[rec->event].name,
+                                        rec->stage >= 0 ? stageInfo[rec->stage].name : "",rec->phase,1.e6*(rec->time - offsets[r] - start),r,(int)rec->thread);CHKERRQ(ierr);
+        }
+      } else {
+        PetscLogDouble *times;
+        PetscInt       *events;
+        short          *stages,*threads;
+        char           *phases;
+
+        ierr = PetscMalloc5(m,PetscLogDouble,&times,m,PetscInt,&events,m,short,&stages,m,short,&threads,m,char,&phases);CHKERRQ(ierr);
+        for (i=0; i<m; i++) {
+          times[i]   = rrecords[i].time - offsets[r] - start;
+          events[i]  = rrecords[i].event;
+          stages[i]  = rrecords[i].stage;
+          threads[i] = rrecords[i].thread;
+          phases[i]  = rrecords[i].phase;
+        }
+        ierr = PetscBinaryWrite(fd,&m,1,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+        ierr = PetscBinaryWrite(fd,times,m,PETSC_DOUBLE,PETSC_FALSE);CHKERRQ(ierr);
+        ierr = PetscBinaryWrite(fd,events,m,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+        ierr = PetscBinaryWrite(fd,stages,m,PETSC_SHORT,PETSC_FALSE);CHKERRQ(ierr);
+        ierr = PetscBinaryWrite(fd,threads,m,PETSC_SHORT,PETSC_FALSE);CHKERRQ(ierr);
+        ierr = PetscBinaryWrite(fd,phases,m,PETSC_CHAR,PETSC_FALSE);CHKERRQ(ierr);
+        ierr = PetscFree5(times,events,stages,threads,phases);CHKERRQ(ierr);
+      }
+      if (r) {ierr = PetscFree(rrecords);CHKERRQ(ierr);}
+    }
+    if (isascii) {
+      for (r=0; r<size; r++) {
+        ierr = PetscViewerASCIIPrintf(viewer,"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}}%s\n",r,r,r < size-1 ? "," : "");CHKERRQ(ierr);
+      }
+      ierr = PetscViewerASCIIPrintf(viewer,"],\"displayTimeUnit\":\"ms\"}\n");CHKERRQ(ierr);
+    }
+    ierr = PetscFree2(offsets,starts);CHKERRQ(ierr);
+  } else {
+    cnt  = (PetscMPIInt)n;
+    ierr = MPI_Send(&cnt,1,MPI_INT,0,tag,comm);CHKERRQ(ierr);
+    ierr = MPI_Send(records,cnt*sizeof(PetscTimelineRecord),MPI_BYTE,0,tag,comm);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(records);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif /* PETSC_USE_LOG */
@@ -140,6 +140,8 @@ PetscErrorCode EventPerfLogDestroy(PetscEventPerfLog eventLog)
 @*/
 PetscErrorCode EventPerfInfoClear(PetscEventPerfInfo *eventInfo)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   eventInfo->id            = -1;
   eventInfo->active        = PETSC_TRUE;
@@ -155,6 +157,11 @@ PetscErrorCode EventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  ierr = PetscMemzero(eventInfo->counters,sizeof(eventInfo->counters));CHKERRQ(ierr);
+  eventInfo->mallocs       = 0.0;
+  eventInfo->mallocSpace   = 0.0;
+  eventInfo->mallocMax     = 0.0;
+  eventInfo->mallocLive    = 0.0;
   PetscFunctionReturn(0);
 }
 
@@ -185,6 +192,66 @@ PetscErrorCode EventPerfInfoCopy(PetscEventPerfInfo *eventInfo, PetscEventPerfIn
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "EventPerfInfoMemoryBegin"
+/*@C
+  EventPerfInfoMemoryBegin - Starts recording the PetscMalloc() calls for an event or stage, see PetscLogMemoryBegin()
+
+  Not collective
+
+  Input Paramters:
++ eventInfo - The PetscEventPerfInfo
+- id        - The identifier of the recording, the event or -(stage+1)
+
+  Level: developer
+
+.keywords: log, event, memory
+.seealso: EventPerfInfoMemoryEnd(), PetscMallocPushMaximumUsage()
+@*/
+PetscErrorCode EventPerfInfoMemoryBegin(PetscEventPerfInfo *eventInfo, int id)
+{
+  PetscLogDouble mallocs, space;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocGetTotalUsage(&mallocs, &space);CHKERRQ(ierr);
+  eventInfo->mallocs     -= mallocs;
+  eventInfo->mallocSpace -= space;
+  ierr = PetscMallocPushMaximumUsage(id);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "EventPerfInfoMemoryEnd"
+/*@C
+  EventPerfInfoMemoryEnd - Stops recording the PetscMalloc() calls for an event or stage
+
+  Not collective
+
+  Input Paramters:
++ eventInfo - The PetscEventPerfInfo
+- id        - The identifier given to EventPerfInfoMemoryBegin()
+
+  Level: developer
+
+.keywords: log, event, memory
+.seealso: EventPerfInfoMemoryBegin(), PetscMallocPopMaximumUsage()
+@*/
+PetscErrorCode EventPerfInfoMemoryEnd(PetscEventPerfInfo *eventInfo, int id)
+{
+  PetscLogDouble mallocs, space, maxSpace;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocGetTotalUsage(&mallocs, &space);CHKERRQ(ierr);
+  eventInfo->mallocs     += mallocs;
+  eventInfo->mallocSpace += space;
+  ierr = PetscMallocPopMaximumUsage(id, &maxSpace);CHKERRQ(ierr);
+  eventInfo->mallocMax   = PetscMax(eventInfo->mallocMax, maxSpace);
+  ierr = PetscMallocGetCurrentUsage(&eventInfo->mallocLive);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "EventPerfLogEnsureSize"
 /*@C
@@ -318,6 +385,7 @@ PetscErrorCode EventRegLogRegister(PetscEventRegLog eventLog, const char ename[]
 
   eventLog->eventInfo[e].name    = str;
   eventLog->eventInfo[e].classid = classid;
+  eventLog->eventInfo[e].wait    = PETSC_FALSE;
 #if defined(PETSC_HAVE_MPE)
   if (PetscLogPLB == PetscLogEventBeginMPE) {
     const char  *color;
@@ -633,7 +701,7 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event, int t, PetscObject
 #if defined(PETSC_HAVE_CHUD)
   eventLog->eventInfo[event].flopsTmp -= chudGetPMCEventCount(chudCPU1Dev,PMC_1);
 #elif defined(PETSC_HAVE_PAPI)
-  { long_long values[2];
+  { long_long values[1+PETSC_LOG_NUM_COUNTERS];
     ierr = PAPI_read(PAPIEventSet,values);CHKERRQ(ierr);
 
     eventLog->eventInfo[event].flopsTmp -= values[0];
@@ -645,6 +713,16 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event, int t, PetscObject
   eventLog->eventInfo[event].numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
   eventLog->eventInfo[event].messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
   eventLog->eventInfo[event].numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  if (petsc_logcounters) {
+    PetscLogDouble counters[PETSC_LOG_NUM_COUNTERS];
+    int            i;
+
+    ierr = PetscLogCountersRead(counters);CHKERRQ(ierr);
+    for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) eventLog->eventInfo[event].counters[i] -= counters[i];
+  }
+  if (petsc_logmemory) {
+    ierr = EventPerfInfoMemoryBegin(&eventLog->eventInfo[event], event);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -672,7 +750,7 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event, int t, PetscObject o
 #if defined(PETSC_HAVE_CHUD)
   eventLog->eventInfo[event].flopsTmp += chudGetPMCEventCount(chudCPU1Dev,PMC_1);
 #elif defined(PETSC_HAVE_PAPI)
-  { long_long values[2];
+  { long_long values[1+PETSC_LOG_NUM_COUNTERS];
     ierr = PAPI_read(PAPIEventSet,values);CHKERRQ(ierr);
 
     eventLog->eventInfo[event].flopsTmp += values[0];
@@ -686,6 +764,16 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event, int t, PetscObject o
   eventLog->eventInfo[event].numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
   eventLog->eventInfo[event].messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
   eventLog->eventInfo[event].numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  if (petsc_logcounters) {
+    PetscLogDouble counters[PETSC_LOG_NUM_COUNTERS];
+    int            i;
+
+    ierr = PetscLogCountersRead(counters);CHKERRQ(ierr);
+    for (i=0; i<PETSC_LOG_NUM_COUNTERS; i++) eventLog->eventInfo[event].counters[i] += counters[i];
+  }
+  if (petsc_logmemory) {
+    ierr = EventPerfInfoMemoryEnd(&eventLog->eventInfo[event], event);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -225,6 +225,10 @@ PetscErrorCode  PetscStageLogRegister(PetscStageLog stageLog, const char sname[]
   stageLog->stageInfo[s].perfInfo.numMessages   = 0.0;
   stageLog->stageInfo[s].perfInfo.messageLength = 0.0;
   stageLog->stageInfo[s].perfInfo.numReductions = 0.0;
+  stageLog->stageInfo[s].perfInfo.mallocs       = 0.0;
+  stageLog->stageInfo[s].perfInfo.mallocSpace   = 0.0;
+  stageLog->stageInfo[s].perfInfo.mallocMax     = 0.0;
+  stageLog->stageInfo[s].perfInfo.mallocLive    = 0.0;
 
   ierr = EventPerfLogCreate(&stageLog->stageInfo[s].eventLog);CHKERRQ(ierr);
   ierr = ClassPerfLogCreate(&stageLog->stageInfo[s].classLog);CHKERRQ(ierr);
@@ -289,6 +293,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
       stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      if (petsc_logmemory) {ierr = EventPerfInfoMemoryEnd(&stageLog->stageInfo[curStage].perfInfo, -(curStage+1));CHKERRQ(ierr);}
     }
   }
   /* Activate the stage */
@@ -304,6 +309,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
     stageLog->stageInfo[stage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[stage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[stage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    if (petsc_logmemory) {ierr = EventPerfInfoMemoryBegin(&stageLog->stageInfo[stage].perfInfo, -(stage+1));CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
@@ -356,6 +362,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
     stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    if (petsc_logmemory) {ierr = EventPerfInfoMemoryEnd(&stageLog->stageInfo[curStage].perfInfo, -(curStage+1));CHKERRQ(ierr);}
   }
   ierr = PetscIntStackEmpty(stageLog->stack, &empty);CHKERRQ(ierr);
   if (!empty) {
@@ -367,6 +374,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
       stageLog->stageInfo[curStage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      if (petsc_logmemory) {ierr = EventPerfInfoMemoryBegin(&stageLog->stageInfo[curStage].perfInfo, -(curStage+1));CHKERRQ(ierr);}
     }
     stageLog->curStage = curStage;
   } else stageLog->curStage = -1;
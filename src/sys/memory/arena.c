@@ -0,0 +1,263 @@
+#include <petscsys.h>             /*I   "petscsys.h"   I*/
+
+/*
+     An arena hands out memory from large chunks by incrementing an offset; nothing is freed
+  individually, PetscArenaPop() releases at once everything obtained since the matching PetscArenaPush().
+*/
+struct _PetscArenaChunk {
+  struct _PetscArenaChunk *next;  /* the older chunk in the arena, or the next spare chunk */
+  size_t                  alloc;  /* bytes of data in the chunk */
+  size_t                  used;
+};
+
+/* ARENA_CHUNK_BYTES is the chunk header padded so the data is PETSC_MEMALIGN aligned */
+#define ARENA_CHUNK_BYTES ((sizeof(struct _PetscArenaChunk)+(PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1))
+#define ArenaChunkData(c) (((char*)(c)) + ARENA_CHUNK_BYTES)
+
+struct _PetscArenaMark {
+  struct _PetscArenaMark  *prev;
+  struct _PetscArenaChunk *chunk; /* the chunk in use at the PetscArenaPush() */
+  size_t                  used;   /* and its offset */
+};
+
+struct _n_PetscArena {
+  struct _PetscArenaChunk *head;  /* the chunk in use */
+  struct _PetscArenaChunk *spare; /* chunks released by PetscArenaPop() kept for reuse */
+  struct _PetscArenaMark  *mark;  /* the innermost PetscArenaPush(), stored in the arena itself */
+  size_t                  chunksize;
+};
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscArenaAddChunk_Private"
+static PetscErrorCode PetscArenaAddChunk_Private(PetscArena arena,size_t bytes)
+{
+  struct _PetscArenaChunk *chunk,**prev;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  /* reuse the first spare chunk large enough */
+  for (prev=&arena->spare; *prev && (*prev)->alloc < bytes; prev=&(*prev)->next) ;
+  if (*prev) {
+    chunk = *prev;
+    *prev = chunk->next;
+  } else {
+    size_t alloc = PetscMax(bytes,arena->chunksize);
+
+    ierr         = PetscMalloc(ARENA_CHUNK_BYTES+alloc,&chunk);CHKERRQ(ierr);
+    chunk->alloc = alloc;
+  }
+  chunk->used = 0;
+  chunk->next = arena->head;
+  arena->head = chunk;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscArenaCreate"
+/*@C
+   PetscArenaCreate - Creates an arena, from which a routine that needs many temporary arrays can get them
+   cheaply and release them all at once
+
+   Not Collective
+
+   Input Argument:
+.  chunksize - number of bytes the arena gets from PetscMalloc() at a time
+
+   Output Argument:
+.  arena - the arena
+
+   Notes:
+   The memory is obtained with PetscArenaMalloc() and is released by PetscArenaPop(), PetscArenaReset() or
+   PetscArenaDestroy(), never with PetscFree(). An arena must only be used by one thread at a time.
+
+   Usage:
+.vb
+     PetscArenaCreate(4096,&arena);
+     for (i=0; i<n; i++) {
+       PetscArenaPush(arena);
+       PetscArenaMalloc(arena,m*sizeof(PetscInt),&idx);
+       PetscArenaMalloc(arena,m*sizeof(PetscScalar),&values);
+       ...
+       PetscArenaPop(arena);
+     }
+     PetscArenaDestroy(&arena);
+.ve
+
+   Level: developer
+
+.seealso: PetscArenaMalloc(), PetscArenaPush(), PetscArenaPop(), PetscArenaReset(), PetscArenaDestroy(), PetscMallocPool()
+@*/
+PetscErrorCode PetscArenaCreate(size_t chunksize,PetscArena *arena)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(struct _n_PetscArena,arena);CHKERRQ(ierr);
+  (*arena)->chunksize = PetscMax(chunksize,(size_t)PETSC_MEMALIGN);
+  ierr = PetscArenaAddChunk_Private(*arena,(*arena)->chunksize);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscArenaMalloc"
+/*@C
+   PetscArenaMalloc - Gets memory from an arena
+
+   Not Collective
+
+   Input Arguments:
++  arena - the arena
+-  bytes - number of bytes needed
+
+   Output Argument:
+.  result - address of the PETSC_MEMALIGN aligned memory, NULL if bytes is zero
+
+   Level: developer
+
+.seealso: PetscArenaCreate(), PetscArenaPush(), PetscArenaPop()
+@*/
+PetscErrorCode PetscArenaMalloc(PetscArena arena,size_t bytes,void *result)
+{
+  struct _PetscArenaChunk *chunk;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  if (!bytes) {
+    *(void**)result = NULL;
+    PetscFunctionReturn(0);
+  }
+  bytes = (bytes + (PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1);
+  if (PetscUnlikely(arena->head->used + bytes > arena->head->alloc)) {ierr = PetscArenaAddChunk_Private(arena,bytes);CHKERRQ(ierr);}
+  chunk            = arena->head;
+  *(void**)result  = ArenaChunkData(chunk) + chunk->used;
+  chunk->used     += bytes;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscArenaPush"
+/*@C
+   PetscArenaPush - Opens a scope in the arena; the memory obtained until the matching PetscArenaPop() is
+   released by it
+
+   Not Collective
+
+   Input Argument:
+.  arena - the arena
+
+   Notes:
+   The scopes may be nested, so a routine can open its own scope in an arena passed by its caller.
+
+   Level: developer
+
+.seealso: PetscArenaPop(), PetscArenaCreate(), PetscArenaMalloc()
+@*/
+PetscErrorCode PetscArenaPush(PetscArena arena)
+{
+  struct _PetscArenaChunk *chunk = arena->head;
+  size_t                  used   = chunk->used;
+  struct _PetscArenaMark  *mark;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  ierr        = PetscArenaMalloc(arena,sizeof(struct _PetscArenaMark),&mark);CHKERRQ(ierr);
+  mark->prev  = arena->mark;
+  mark->chunk = chunk;
+  mark->used  = used;
+  arena->mark = mark;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscArenaPop"
+/*@C
+   PetscArenaPop - Releases the memory obtained from the arena since the matching PetscArenaPush()
+
+   Not Collective
+
+   Input Argument:
+.  arena - the arena
+
+   Level: developer
+
+.seealso: PetscArenaPush(), PetscArenaCreate(), PetscArenaMalloc()
+@*/
+PetscErrorCode PetscArenaPop(PetscArena arena)
+{
+  struct _PetscArenaMark  *mark = arena->mark;
+  struct _PetscArenaChunk *chunk;
+
+  PetscFunctionBegin;
+  if (!mark) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"PetscArenaPop() without PetscArenaPush()");
+  arena->mark = mark->prev;
+  while (arena->head != mark->chunk) {
+    chunk        = arena->head;
+    arena->head  = chunk->next;
+    chunk->next  = arena->spare;
+    arena->spare = chunk;
+  }
+  arena->head->used = mark->used;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscArenaReset"
+/*@C
+   PetscArenaReset - Releases all the memory obtained from the arena, keeping its chunks for reuse
+
+   Not Collective
+
+   Input Argument:
+.  arena - the arena
+
+   Level: developer
+
+.seealso: PetscArenaCreate(), PetscArenaPop(), PetscArenaDestroy()
+@*/
+PetscErrorCode PetscArenaReset(PetscArena arena)
+{
+  struct _PetscArenaChunk *chunk;
+
+  PetscFunctionBegin;
+  while (arena->head->next) {
+    chunk        = arena->head;
+    arena->head  = chunk->next;
+    chunk->next  = arena->spare;
+    arena->spare = chunk;
+  }
+  arena->head->used = 0;
+  arena->mark       = NULL;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscArenaDestroy"
+/*@C
+   PetscArenaDestroy - Destroys an arena and all the memory obtained from it
+
+   Not Collective
+
+   Input Argument:
+.  arena - address of the arena
+
+   Level: developer
+
+.seealso: PetscArenaCreate()
+@*/
+PetscErrorCode PetscArenaDestroy(PetscArena *arena)
+{
+  struct _PetscArenaChunk *chunk;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  if (!*arena) PetscFunctionReturn(0);
+  ierr = PetscArenaReset(*arena);CHKERRQ(ierr);
+  ierr = PetscFree((*arena)->head);CHKERRQ(ierr);
+  while ((*arena)->spare) {
+    chunk           = (*arena)->spare;
+    (*arena)->spare = chunk->next;
+    ierr            = PetscFree(chunk);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(*arena);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
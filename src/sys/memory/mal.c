@@ -6,6 +6,18 @@
 #if defined(PETSC_HAVE_MALLOC_H)
 #include <malloc.h>
 #endif
+#if defined(PETSC_HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#endif
+#if defined(PETSC_HAVE_SYS_SYSCALL_H)
+#include <sys/syscall.h>
+#endif
+#if defined(PETSC_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+#if defined(PETSC_HAVE_MEMALIGN) && defined(PETSC_HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+#define PETSC_USE_HUGEPAGES
+#endif
 
 /*
         We want to make sure that all mallocs of double or complex numbers are complex aligned.
@@ -17,10 +29,25 @@
 */
 #define SHIFT_CLASSID 456123
 
+/*
+        Allocations of at least PetscHugePageThreshold bytes (if it is nonzero) are aligned to the
+    size of a transparent huge page and the kernel is advised to back them with huge pages; they are
+    freed with free() like the others. The large Vec and Mat arrays then need fewer TLB entries.
+*/
+#define PETSC_HUGEPAGE_SIZE 2097152
+static size_t PetscHugePageThreshold = 0;
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscMallocAlign"
 PetscErrorCode  PetscMallocAlign(size_t mem,int line,const char func[],const char file[],const char dir[],void **result)
 {
+#if defined(PETSC_USE_HUGEPAGES)
+  if (PetscHugePageThreshold && mem >= PetscHugePageThreshold) {
+    *result = memalign(PETSC_HUGEPAGE_SIZE,mem);
+    /* the advice is only a hint, the memory is usable if the kernel ignores it */
+    if (*result) madvise(*result,mem,MADV_HUGEPAGE);
+  } else
+#endif
 #if defined(PETSC_HAVE_DOUBLE_ALIGN_MALLOC) && (PETSC_MEMALIGN == 8)
   *result = malloc(mem);
 #elif defined(PETSC_HAVE_MEMALIGN)
@@ -148,3 +175,134 @@ PetscErrorCode  PetscMallocClear(void)
   petscsetmallocvisited = PETSC_FALSE;
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocSetHugePageThreshold"
+/*@C
+   PetscMallocSetHugePageThreshold - Sets the size above which PetscMallocAlign(), the default PETSc malloc,
+   asks the kernel for transparent huge pages
+
+   Not Collective
+
+   Input Parameter:
+.  threshold - number of bytes, 0 (the default) never uses huge pages
+
+   Options Database Key:
+.  -malloc_hugepage_threshold <bytes> - for example 2097152, the size of a huge page on x86-64
+
+   Notes:
+   The memory is aligned to a 2 MB boundary and given the MADV_HUGEPAGE advice with madvise(), so it is
+   backed with huge pages when /sys/kernel/mm/transparent_hugepage/enabled is "always" or "madvise".
+   This reduces the TLB misses of the streaming operations, such as MatMult(), on large vectors and matrices.
+   Systems without madvise() ignore the threshold.
+
+   The pages are placed on the NUMA node of the thread that first writes them; the arrays of
+   vectors and matrices are first written by the threads of the PetscThreadComm of the object,
+   each its own part, so that they are near to the threads using them.
+
+   Level: advanced
+
+.seealso: PetscMallocGetHugePageThreshold(), PetscMallocPlacementInfo()
+@*/
+PetscErrorCode  PetscMallocSetHugePageThreshold(size_t threshold)
+{
+  PetscFunctionBegin;
+  PetscHugePageThreshold = threshold;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocGetHugePageThreshold"
+/*@C
+   PetscMallocGetHugePageThreshold - Gets the size above which huge pages are used
+
+   Not Collective
+
+   Output Parameter:
+.  threshold - number of bytes, 0 if huge pages are not used
+
+   Level: advanced
+
+.seealso: PetscMallocSetHugePageThreshold()
+@*/
+PetscErrorCode  PetscMallocGetHugePageThreshold(size_t *threshold)
+{
+  PetscFunctionBegin;
+#if defined(PETSC_USE_HUGEPAGES)
+  *threshold = PetscHugePageThreshold;
+#else
+  *threshold = 0;
+#endif
+  PetscFunctionReturn(0);
+}
+
+#define PLACEMENT_SAMPLES 64
+#define PLACEMENT_NODES   8
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocPlacementInfo"
+/*@C
+   PetscMallocPlacementInfo - Prints with PetscInfo() whether an array of an object uses huge pages
+   and on which NUMA nodes its pages are
+
+   Not Collective
+
+   Input Parameters:
++  obj - the object owning the array
+.  name - name of the array, for example "values"
+.  ptr - the array
+-  len - its length in bytes
+
+   Notes:
+   Does nothing unless -info is used. The nodes of up to 64 pages evenly spaced in the array are
+   obtained from the kernel with move_pages(); pages not yet written are not counted.
+
+   Level: developer
+
+.seealso: PetscMallocSetHugePageThreshold(), PetscInfo()
+@*/
+PetscErrorCode  PetscMallocPlacementInfo(PetscObject obj,const char name[],const void *ptr,size_t len)
+{
+  const char     *huge = "";
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!PetscLogPrintInfo || !ptr || !len) PetscFunctionReturn(0);
+#if defined(PETSC_USE_HUGEPAGES)
+  if (PetscHugePageThreshold && len >= PetscHugePageThreshold) huge = " advised to use huge pages";
+#endif
+#if defined(PETSC_HAVE_SYS_SYSCALL_H) && defined(__NR_move_pages) && defined(PETSC_HAVE_GETPAGESIZE)
+  {
+    size_t pagesize = (size_t)getpagesize(),npages,nsamples,i;
+    char   *first   = (char*)((PETSC_UINTPTR_T)ptr & ~(PETSC_UINTPTR_T)(pagesize-1));
+    void   *pages[PLACEMENT_SAMPLES];
+    int    status[PLACEMENT_SAMPLES],counts[PLACEMENT_NODES],node,other = 0,untouched = 0;
+    char   nodes[PLACEMENT_NODES*24] = "";
+    size_t used = 0;
+
+    npages   = ((size_t)((const char*)ptr - first) + len + pagesize-1)/pagesize;
+    nsamples = PetscMin(npages,PLACEMENT_SAMPLES);
+    for (i=0; i<nsamples; i++) pages[i] = first + (npages*i/nsamples)*pagesize;
+    if (syscall(__NR_move_pages,0,(unsigned long)nsamples,pages,NULL,status,0)) {
+      ierr = PetscInfo3(obj,"%s: %.0f bytes%s, the NUMA nodes are not available\n",name,(PetscLogDouble)len,huge);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    ierr = PetscMemzero(counts,sizeof(counts));CHKERRQ(ierr);
+    for (i=0; i<nsamples; i++) {
+      if (status[i] < 0) untouched++;
+      else if (status[i] < PLACEMENT_NODES) counts[status[i]]++;
+      else other++;
+    }
+    for (node=0; node<PLACEMENT_NODES; node++) {
+      if (!counts[node]) continue;
+      ierr  = PetscSNPrintf(nodes+used,sizeof(nodes)-used," %d on node %d",counts[node],node);CHKERRQ(ierr);
+      ierr  = PetscStrlen(nodes,&used);CHKERRQ(ierr);
+    }
+    if (other) {ierr = PetscSNPrintf(nodes+used,sizeof(nodes)-used," %d on other nodes",other);CHKERRQ(ierr);}
+    ierr = PetscInfo6(obj,"%s: %.0f bytes%s, of %d sampled pages%s, %d not written yet\n",name,(PetscLogDouble)len,huge,(int)nsamples,nodes,untouched);CHKERRQ(ierr);
+  }
+#else
+  ierr = PetscInfo3(obj,"%s: %.0f bytes%s\n",name,(PetscLogDouble)len,huge);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,296 @@
+/*
+     A pooled malloc() for the many small, short lived arrays PETSc allocates. It is used with
+  PetscMallocSet(PetscMallocPool,PetscFreePool) or the option -malloc_pool.
+*/
+#include <petscsys.h>             /*I   "petscsys.h"   I*/
+#if defined(PETSC_HAVE_PTHREADCLASSES)
+#include <pthread.h>
+#elif defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/*
+     These are defined in mal.c
+*/
+extern PetscErrorCode PetscMallocAlign(size_t,int,const char[],const char[],const char[],void**);
+extern PetscErrorCode PetscFreeAlign(void*,int,const char[],const char[],const char[]);
+
+/*
+        The requests are rounded up to size classes that are powers of two from 2^POOL_MINSHIFT to
+    2^POOL_MAXSHIFT bytes, larger requests go directly to PetscMallocAlign(). A freed block is put on
+    the free list of its class and handed out again by the next request of that class; the free lists
+    are only returned to the system by PetscMallocPoolDestroy().
+*/
+#define POOL_MINSHIFT 4
+#define POOL_MAXSHIFT 13
+#define POOL_CLASSES  (POOL_MAXSHIFT-POOL_MINSHIFT+1)
+
+#define POOL_CLASSID   ((PetscClassId) 0x0f1e2d3c)
+#define POOL_FREED     ((PetscClassId) 0x0c3d2e1f)
+
+typedef struct {
+  int          sizeclass;       /* the size class of the block, -1 if it is larger than all classes */
+  PetscClassId classid;
+} POOLSPACE;
+
+/* POOL_HEADER_BYTES is sizeof(POOLSPACE) padded to keep the blocks PETSC_MEMALIGN aligned */
+#define POOL_HEADER_BYTES ((sizeof(POOLSPACE)+(PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1))
+
+typedef struct _PoolFreeBlock {
+  struct _PoolFreeBlock *next;  /* stored in the freed block itself */
+} PoolFreeBlock;
+
+typedef struct {
+  PoolFreeBlock *head;
+  size_t        mallocs;        /* the number of requests of this class */
+  size_t        hits;           /* the number of requests served from the free list */
+  size_t        cached;         /* the number of blocks on the free list */
+} PoolClass;
+
+static PoolClass PetscPool[POOL_CLASSES];
+static size_t    PetscPoolLarge = 0;
+
+#if defined(PETSC_HAVE_PTHREADCLASSES)
+static pthread_mutex_t PetscPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+#define PetscPoolLock()   pthread_mutex_lock(&PetscPoolMutex)
+#define PetscPoolUnlock() pthread_mutex_unlock(&PetscPoolMutex)
+#elif defined(PETSC_HAVE_OPENMP)
+/* initialized by the first PetscMallocPool(), in PetscInitialize() before any threads are used */
+static omp_lock_t PetscPoolOmpLock;
+static PetscBool  PetscPoolOmpLockInitialized = PETSC_FALSE;
+#define PetscPoolLock()   omp_set_lock(&PetscPoolOmpLock)
+#define PetscPoolUnlock() omp_unset_lock(&PetscPoolOmpLock)
+#else
+#define PetscPoolLock()
+#define PetscPoolUnlock()
+#endif
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocPool"
+/*@C
+   PetscMallocPool - A malloc() that keeps the freed small blocks in pools, one for each power of
+   two size, so that repeated allocations of temporary arrays rarely reach the system malloc().
+
+   Not Collective
+
+   Input Parameters:
++  mem - number of bytes to allocate
+.  line - line number where used
+.  func - function calling routine
+.  file - file name where used
+-  dir - directory where file is
+
+   Output Parameter:
+.  result - PETSC_MEMALIGN aligned memory
+
+   Options Database Keys:
++  -malloc_pool - use PetscMallocPool() and PetscFreePool() for all PetscMalloc() and PetscFree()
+-  -malloc_pool_view - print the number of requests and how many were served from the pools in PetscFinalize()
+
+   Notes:
+   Requests up to 8 kilobytes are rounded up to the next power of two and served from the pool of
+   that size, larger requests use the system malloc(). The pools are thread safe when PETSc is
+   configured with pthreads or OpenMP. The memory kept in the pools is released by PetscFinalize().
+
+   The pools replace the tracing malloc so -malloc_dump, -malloc_log and -log_memory are not available.
+
+   Use it with PetscMallocSet(PetscMallocPool,PetscFreePool) before PetscInitialize() or with -malloc_pool.
+
+   Level: advanced
+
+   Concepts: memory^allocation
+
+.seealso: PetscFreePool(), PetscMallocSet(), PetscMallocPoolView(), PetscMallocPoolGetStatistics(), PetscArenaCreate()
+@*/
+PetscErrorCode  PetscMallocPool(size_t mem,int line,const char func[],const char file[],const char dir[],void **result)
+{
+  POOLSPACE      *head;
+  PoolFreeBlock  *block = NULL;
+  int            c;
+  PetscErrorCode ierr;
+
+#if !defined(PETSC_HAVE_PTHREADCLASSES) && defined(PETSC_HAVE_OPENMP)
+  if (!PetscPoolOmpLockInitialized) {
+    omp_init_lock(&PetscPoolOmpLock);
+    PetscPoolOmpLockInitialized = PETSC_TRUE;
+  }
+#endif
+  for (c=0; c<POOL_CLASSES && ((size_t)1 << (c+POOL_MINSHIFT)) < mem; c++) ;
+  if (c == POOL_CLASSES) {
+    ierr = PetscMallocAlign(POOL_HEADER_BYTES+mem,line,func,file,dir,(void**)&head);CHKERRQ(ierr);
+    head->sizeclass = -1;
+    PetscPoolLock();
+    PetscPoolLarge++;
+    PetscPoolUnlock();
+  } else {
+    PetscPoolLock();
+    PetscPool[c].mallocs++;
+    if (PetscPool[c].head) {
+      block            = PetscPool[c].head;
+      PetscPool[c].head = block->next;
+      PetscPool[c].hits++;
+      PetscPool[c].cached--;
+    }
+    PetscPoolUnlock();
+    if (block) head = (POOLSPACE*)(((char*)block) - POOL_HEADER_BYTES);
+    else {
+      ierr = PetscMallocAlign(POOL_HEADER_BYTES+((size_t)1 << (c+POOL_MINSHIFT)),line,func,file,dir,(void**)&head);CHKERRQ(ierr);
+      head->sizeclass = c;
+    }
+  }
+  head->classid = POOL_CLASSID;
+  *result       = (void*)(((char*)head) + POOL_HEADER_BYTES);
+  return 0;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscFreePool"
+/*@C
+   PetscFreePool - Frees memory obtained with PetscMallocPool(), the small blocks are kept for reuse.
+
+   Not Collective
+
+   Input Parameters:
++  ptr - the memory
+.  line - line number where used
+.  func - function calling routine
+.  file - file name where used
+-  dir - directory where file is
+
+   Level: advanced
+
+   Concepts: memory^allocation
+
+.seealso: PetscMallocPool(), PetscMallocSet()
+@*/
+PetscErrorCode  PetscFreePool(void *ptr,int line,const char func[],const char file[],const char dir[])
+{
+  POOLSPACE      *head = (POOLSPACE*)(((char*)ptr) - POOL_HEADER_BYTES);
+  PoolFreeBlock  *block = (PoolFreeBlock*)ptr;
+  int            c;
+  PetscErrorCode ierr;
+
+  if (head->classid != POOL_CLASSID) {
+    if (head->classid == POOL_FREED) return PetscError(PETSC_COMM_SELF,line,func,file,dir,PETSC_ERR_ARG_WRONG,PETSC_ERROR_INITIAL,"Memory already freed");
+    return PetscError(PETSC_COMM_SELF,line,func,file,dir,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Block not allocated with PetscMallocPool() or corrupted memory");
+  }
+  head->classid = POOL_FREED;
+  c             = head->sizeclass;
+  if (c < 0) {
+    ierr = PetscFreeAlign(head,line,func,file,dir);CHKERRQ(ierr);
+    return 0;
+  }
+  PetscPoolLock();
+  block->next       = PetscPool[c].head;
+  PetscPool[c].head = block;
+  PetscPool[c].cached++;
+  PetscPoolUnlock();
+  return 0;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocPoolGetStatistics"
+/*@C
+   PetscMallocPoolGetStatistics - Gets the number of PetscMallocPool() requests that fit in the pools
+   and how many of them reused a freed block
+
+   Not Collective
+
+   Output Parameters:
++  mallocs - number of requests of at most 8 kilobytes
+-  hits - number of these served from the pools, without the system malloc()
+
+   Level: advanced
+
+.seealso: PetscMallocPool(), PetscMallocPoolView()
+@*/
+PetscErrorCode  PetscMallocPoolGetStatistics(PetscLogDouble *mallocs,PetscLogDouble *hits)
+{
+  int c;
+
+  PetscFunctionBegin;
+  *mallocs = 0.0;
+  *hits    = 0.0;
+  PetscPoolLock();
+  for (c=0; c<POOL_CLASSES; c++) {
+    *mallocs += (PetscLogDouble)PetscPool[c].mallocs;
+    *hits    += (PetscLogDouble)PetscPool[c].hits;
+  }
+  PetscPoolUnlock();
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocPoolView"
+/*@C
+   PetscMallocPoolView - Prints, for each size class, the number of PetscMallocPool() requests, the
+   hit rate (the fraction served from the pool) and the number of free blocks kept in the pool
+
+   Not Collective
+
+   Input Parameter:
+.  fp - file pointer.  If fp is NULL, stdout is assumed.
+
+   Options Database Key:
+.  -malloc_pool_view - calls PetscMallocPoolView() in PetscFinalize()
+
+   Level: advanced
+
+.seealso: PetscMallocPool(), PetscMallocPoolGetStatistics()
+@*/
+PetscErrorCode  PetscMallocPoolView(FILE *fp)
+{
+  PetscLogDouble mallocs,hits;
+  PetscMPIInt    rank;
+  int            c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(MPI_COMM_WORLD,&rank);CHKERRQ(ierr);
+  if (!fp) fp = PETSC_STDOUT;
+  ierr = PetscMallocPoolGetStatistics(&mallocs,&hits);CHKERRQ(ierr);
+  fprintf(fp,"[%d]PetscMallocPool(): %.0f requests, %.0f served from the pools (%.1f%%), %.0f larger than the pools\n",rank,mallocs,hits,mallocs > 0.0 ? 100.0*hits/mallocs : 0.0,(PetscLogDouble)PetscPoolLarge);
+  for (c=0; c<POOL_CLASSES; c++) {
+    if (!PetscPool[c].mallocs) continue;
+    fprintf(fp,"[%d]  %6.0f bytes: %10.0f requests %10.0f hits (%5.1f%%) %8.0f free blocks\n",rank,(PetscLogDouble)((size_t)1 << (c+POOL_MINSHIFT)),(PetscLogDouble)PetscPool[c].mallocs,
+            (PetscLogDouble)PetscPool[c].hits,100.0*PetscPool[c].hits/PetscPool[c].mallocs,(PetscLogDouble)PetscPool[c].cached);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocPoolDestroy"
+/*@C
+   PetscMallocPoolDestroy - Returns the free blocks kept in the pools to the system and resets the statistics
+
+   Not Collective
+
+   Notes:
+   This is called by PetscFinalize(). Blocks that are still in use stay valid.
+
+   Level: developer
+
+.seealso: PetscMallocPool(), PetscMallocPoolView()
+@*/
+PetscErrorCode  PetscMallocPoolDestroy(void)
+{
+  PoolFreeBlock  *block;
+  int            c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscPoolLock();
+  for (c=0; c<POOL_CLASSES; c++) {
+    while (PetscPool[c].head) {
+      block             = PetscPool[c].head;
+      PetscPool[c].head = block->next;
+      ierr = PetscFreeAlign(((char*)block) - POOL_HEADER_BYTES,__LINE__,__FUNCT__,__FILE__,__SDIR__);if (ierr) {PetscPoolUnlock();CHKERRQ(ierr);}
+    }
+    PetscPool[c].mallocs = 0;
+    PetscPool[c].hits    = 0;
+    PetscPool[c].cached  = 0;
+  }
+  PetscPoolLarge = 0;
+  PetscPoolUnlock();
+  PetscFunctionReturn(0);
+}
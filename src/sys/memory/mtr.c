@@ -58,6 +58,15 @@ static TRSPACE   *TRhead      = 0;
 static int       TRid         = 0;
 static PetscBool TRdebugLevel = PETSC_FALSE;
 static size_t    TRMaxMem     = 0;
+static size_t    TRmallocs    = 0;
+static size_t    TRtotal      = 0;
+/*
+      Maximum memory allocated since each PetscMallocPushMaximumUsage()
+*/
+#define MAXTRMAXMEMS 64
+static int       NumTRMaxMems = 0;
+static size_t    TRMaxMems[MAXTRMAXMEMS];
+static int       TRMaxMemsIds[MAXTRMAXMEMS];
 /*
       Arrays to log information on all Mallocs
 */
@@ -81,6 +90,9 @@ PetscErrorCode PetscSetUseTrMalloc_Private(void)
   TRid              = 0;
   TRdebugLevel      = PETSC_FALSE;
   TRMaxMem          = 0;
+  TRmallocs         = 0;
+  TRtotal           = 0;
+  NumTRMaxMems      = 0;
   PetscLogMallocMax = 10000;
   PetscLogMalloc    = -1;
   PetscFunctionReturn(0);
@@ -176,6 +188,7 @@ PetscErrorCode  PetscTrMallocDefault(size_t a,int lineno,const char function[],c
   TRSPACE        *head;
   char           *inew;
   size_t         nsize;
+  int            i;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -207,7 +220,12 @@ PetscErrorCode  PetscTrMallocDefault(size_t a,int lineno,const char function[],c
 
   TRallocated += nsize;
   if (TRallocated > TRMaxMem) TRMaxMem = TRallocated;
+  for (i=0; i<PetscMin(NumTRMaxMems,MAXTRMAXMEMS); i++) {
+    if (TRallocated > TRMaxMems[i]) TRMaxMems[i] = TRallocated;
+  }
   TRfrags++;
+  TRmallocs++;
+  TRtotal += nsize;
 
 #if defined(PETSC_USE_DEBUG)
   if (PetscStackActive()) {
@@ -429,6 +447,101 @@ PetscErrorCode  PetscMallocGetMaximumUsage(PetscLogDouble *space)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocGetTotalUsage"
+/*@C
+    PetscMallocGetTotalUsage - gets the number of calls to PetscMalloc() and the total amount of memory
+        they allocated during this run, including memory that has since been freed
+
+    Not Collective
+
+    Output Parameters:
++   count - number of calls to PetscMalloc()
+-   space - total number of bytes allocated
+
+    Level: intermediate
+
+    Concepts: memory usage
+
+.seealso: PetscMallocGetCurrentUsage(), PetscMallocGetMaximumUsage(), PetscLogMemoryBegin()
+ @*/
+PetscErrorCode  PetscMallocGetTotalUsage(PetscLogDouble *count,PetscLogDouble *space)
+{
+  PetscFunctionBegin;
+  *count = (PetscLogDouble) TRmallocs;
+  *space = (PetscLogDouble) TRtotal;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocPushMaximumUsage"
+/*@C
+    PetscMallocPushMaximumUsage - starts recording the maximum amount of memory PetscMalloc()ed until
+        the matching PetscMallocPopMaximumUsage()
+
+    Not Collective
+
+    Input Parameter:
+.   id - an identifier of the recording, for example the logging event
+
+    Notes:
+    The recordings may be nested or overlap, each is identified by its id. Only the innermost 64
+    recordings are kept, the others return zero from PetscMallocPopMaximumUsage().
+
+    Level: developer
+
+    Concepts: memory usage
+
+.seealso: PetscMallocPopMaximumUsage(), PetscMallocGetMaximumUsage()
+ @*/
+PetscErrorCode  PetscMallocPushMaximumUsage(int id)
+{
+  PetscFunctionBegin;
+  if (++NumTRMaxMems > MAXTRMAXMEMS) PetscFunctionReturn(0);
+  TRMaxMems[NumTRMaxMems-1]    = TRallocated;
+  TRMaxMemsIds[NumTRMaxMems-1] = id;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscMallocPopMaximumUsage"
+/*@C
+    PetscMallocPopMaximumUsage - gets the maximum amount of memory PetscMalloc()ed since the matching
+        PetscMallocPushMaximumUsage() and stops the recording
+
+    Not Collective
+
+    Input Parameter:
+.   id - the identifier given to PetscMallocPushMaximumUsage()
+
+    Output Parameter:
+.   space - maximum number of bytes allocated at one time, or zero if the recording was not kept
+
+    Level: developer
+
+    Concepts: memory usage
+
+.seealso: PetscMallocPushMaximumUsage(), PetscMallocGetMaximumUsage()
+ @*/
+PetscErrorCode  PetscMallocPopMaximumUsage(int id,PetscLogDouble *space)
+{
+  int i;
+
+  PetscFunctionBegin;
+  *space = 0.0;
+  if (!NumTRMaxMems) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"PetscMallocPopMaximumUsage() called without PetscMallocPushMaximumUsage()");
+  if (NumTRMaxMems-- > MAXTRMAXMEMS) PetscFunctionReturn(0);
+  /* the innermost recording with this id, the recordings above it move down */
+  for (i=NumTRMaxMems; i>0 && TRMaxMemsIds[i] != id; i--) ;
+  if (TRMaxMemsIds[i] != id) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"No PetscMallocPushMaximumUsage() for id %d",id);
+  *space = (PetscLogDouble) TRMaxMems[i];
+  for (; i<NumTRMaxMems; i++) {
+    TRMaxMems[i]    = TRMaxMems[i+1];
+    TRMaxMemsIds[i] = TRMaxMemsIds[i+1];
+  }
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_USE_DEBUG)
 #undef __FUNCT__
 #define __FUNCT__ "PetscMallocGetStack"
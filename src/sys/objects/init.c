@@ -271,6 +271,17 @@ PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   /*
       Setup the memory management; support for tracing malloc() usage
   */
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,"-malloc_pool",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1 && !petscsetmallocvisited) {
+    /* replaces the tracing malloc */
+    ierr = PetscOptionsHasName(NULL,"-malloc_debug",&flg2);CHKERRQ(ierr);
+    ierr = PetscOptionsHasName(NULL,"-malloc_test",&flg3);CHKERRQ(ierr);
+    if (flg2 || flg3) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"-malloc_pool cannot be used with -malloc_debug or -malloc_test");
+    ierr = PetscOptionsHasName(NULL,"-malloc_log",&flg3);CHKERRQ(ierr);
+    if (flg3) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"-malloc_pool cannot be used with -malloc_log");
+    ierr = PetscMallocSet(PetscMallocPool,PetscFreePool);CHKERRQ(ierr);
+  }
   ierr = PetscOptionsHasName(NULL,"-malloc_log",&flg3);CHKERRQ(ierr);
   logthreshold = 0.0;
   ierr = PetscOptionsGetReal(NULL,"-malloc_log_threshold",&logthreshold,&flg1);CHKERRQ(ierr);
@@ -307,6 +318,13 @@ PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   }
 #endif
 
+  {
+    PetscInt threshold;
+
+    ierr = PetscOptionsGetInt(NULL,"-malloc_hugepage_threshold",&threshold,&flg1);CHKERRQ(ierr);
+    if (flg1) {ierr = PetscMallocSetHugePageThreshold((size_t)threshold);CHKERRQ(ierr);}
+  }
+
   flg1 = PETSC_FALSE;
   ierr = PetscOptionsGetBool(NULL,"-malloc_info",&flg1,NULL);CHKERRQ(ierr);
   if (!flg1) {
@@ -490,6 +508,23 @@ PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   if (flg1)                      { ierr = PetscLogAllBegin();CHKERRQ(ierr); }
   else if (flg2 || flg3 || flg4) { ierr = PetscLogBegin();CHKERRQ(ierr);}
 
+  ierr = PetscOptionsHasName(NULL,"-log_nested",&flg1);CHKERRQ(ierr);
+  ierr = PetscOptionsHasName(NULL,"-log_nested_flamegraph",&flg2);CHKERRQ(ierr);
+  if (flg1 || flg2) { ierr = PetscLogNestedBegin();CHKERRQ(ierr);}
+
+  /* after the other logging, which the timeline handlers call */
+  ierr = PetscOptionsHasName(NULL,"-log_timeline",&flg1);CHKERRQ(ierr);
+  ierr = PetscOptionsHasName(NULL,"-log_timeline_binary",&flg2);CHKERRQ(ierr);
+  if (flg1 || flg2) { ierr = PetscLogTimelineBegin();CHKERRQ(ierr);}
+
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,"-log_counters",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) { ierr = PetscLogCountersBegin();CHKERRQ(ierr);}
+
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,"-log_memory",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) { ierr = PetscLogMemoryBegin();CHKERRQ(ierr);}
+
   ierr = PetscOptionsGetString(NULL,"-log_trace",mname,250,&flg1);CHKERRQ(ierr);
   if (flg1) {
     char name[PETSC_MAX_PATH_LEN],fname[PETSC_MAX_PATH_LEN];
@@ -609,6 +644,9 @@ PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -malloc_info: prints total memory usage\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_log: keeps log of all memory allocations\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_debug: enables extended checking for memory corruption\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_pool: reuse freed small blocks instead of the system malloc (replaces -malloc)\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_pool_view: prints how many mallocs were served from the pools\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_hugepage_threshold <bytes>: use transparent huge pages for larger mallocs\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_table: dump list of options inputted\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left: dump list of unused options\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left no: don't dump list of unused options\n");CHKERRQ(ierr);
@@ -621,11 +659,19 @@ PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -get_total_flops: total flops over all processors\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log[_summary _summary_python]: logging objects and events\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_trace [filename]: prints trace of all PETSc calls\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_nested [filename]: prints the call tree of the PETSc events\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_nested_flamegraph [filename]: prints the call tree as folded stacks for flame graphs\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_timeline [filename]: writes the timeline of the events in the Chrome trace event format\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_timeline_binary <filename>: writes the timeline of the events in binary\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_timeline_size <n>: number of begin and end records kept on each process\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_counters: collect hardware counters (cycles, instructions, cache misses) for each event\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_memory: collect PetscMalloc() calls, bytes and maximum memory for each stage and event\n");CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPE)
     ierr = (*PetscHelpPrintf)(comm," -log_mpe: Also create logfile viewable through Jumpshot\n");CHKERRQ(ierr);
 #endif
     ierr = (*PetscHelpPrintf)(comm," -info <optional filename>: print informative messages about the calculations\n");CHKERRQ(ierr);
 #endif
+    ierr = (*PetscHelpPrintf)(comm," -log_startup: prints the time spent in each phase of PetscInitialize()\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -v: prints PETSc version number and release date\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_file <file>: reads options from file\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -petsc_sleep n: sleeps n seconds before running program\n");CHKERRQ(ierr);
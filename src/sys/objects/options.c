@@ -21,18 +21,19 @@
 #endif
 
 /*
-    This table holds all the options set by the user. For simplicity, we use a static size database
+    This table holds all the options set by the user. The options are kept in the order they were
+    set, in arrays that grow as needed, and found with a hash table of their names
 */
-#define MAXOPTIONS 512
 #define MAXALIASES 25
 #define MAXOPTIONSMONITORS 5
 #define MAXPREFIXES 25
 
 typedef struct {
-  int            N,argc,Naliases;
-  char           **args,*names[MAXOPTIONS],*values[MAXOPTIONS];
+  int            N,Nalloc,argc,Naliases;
+  char           **args,**names,**values;
   char           *aliases1[MAXALIASES],*aliases2[MAXALIASES];
-  PetscBool      used[MAXOPTIONS];
+  PetscBool      *used;
+  int            Nhash,*hash;        /* open addressing, hash[h] is 1 + the index of the option, or 0 */
   PetscBool      namegiven;
   char           programname[PETSC_MAX_PATH_LEN]; /* HP includes entire path in name */
 
@@ -51,6 +52,89 @@ typedef struct {
 static PetscOptionsTable      *options = 0;
 extern PetscOptionsObjectType PetscOptionsObject;
 
+/*
+    The hash of an option name, ignoring case since the options are matched with PetscStrcasecmp()
+*/
+PETSC_STATIC_INLINE unsigned int PetscOptionsHash_Private(const char name[])
+{
+  unsigned int h = 2166136261U;
+
+  while (*name) {
+    h ^= (unsigned int)tolower((unsigned char)*name++);
+    h *= 16777619U;
+  }
+  return h;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscOptionsHashFind_Private"
+/*
+    Finds the index of the option name (without the -), or -1 if it is not in the database
+*/
+static PetscErrorCode PetscOptionsHashFind_Private(const char name[],PetscInt *i)
+{
+  PetscErrorCode ierr;
+  unsigned int   h;
+  PetscBool      match;
+
+  PetscFunctionBegin;
+  *i = -1;
+  if (!options->Nhash) PetscFunctionReturn(0);
+  for (h=PetscOptionsHash_Private(name)&(options->Nhash-1); options->hash[h]; h=(h+1)&(options->Nhash-1)) {
+    ierr = PetscStrcasecmp(options->names[options->hash[h]-1],name,&match);CHKERRQ(ierr);
+    if (match) {
+      *i = options->hash[h]-1;
+      break;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscOptionsHashRebuild_Private"
+/*
+    Rebuilds the hash table with at least twice as many slots as options
+*/
+static PetscErrorCode PetscOptionsHashRebuild_Private(void)
+{
+  PetscErrorCode ierr;
+  int            i,nhash = options->Nhash ? options->Nhash : 64;
+  unsigned int   h;
+
+  PetscFunctionBegin;
+  while (nhash < 2*options->Nalloc) nhash *= 2;
+  if (nhash != options->Nhash) {
+    free(options->hash);
+    options->hash  = (int*)malloc(nhash*sizeof(int));
+    if (!options->hash) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to allocate the options hash table");
+    options->Nhash = nhash;
+  }
+  ierr = PetscMemzero(options->hash,nhash*sizeof(int));CHKERRQ(ierr);
+  for (i=0; i<options->N; i++) {
+    for (h=PetscOptionsHash_Private(options->names[i])&(nhash-1); options->hash[h]; h=(h+1)&(nhash-1)) ;
+    options->hash[h] = i+1;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscOptionsSorted_Private"
+/*
+    Gets the indices of the options in alphabetical order, free the result with free()
+*/
+static PetscErrorCode PetscOptionsSorted_Private(PetscInt **perm)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  *perm = (PetscInt*)malloc((options->N+1)*sizeof(PetscInt));
+  if (!*perm) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to allocate permutation");
+  for (i=0; i<options->N; i++) (*perm)[i] = i;
+  ierr = PetscSortStrWithPermutation(options->N,(const char**)options->names,*perm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
     Options events monitor
 */
@@ -681,7 +765,7 @@ PetscErrorCode  PetscOptionsInsert(int *argc,char ***args,const char file[])
 PetscErrorCode  PetscOptionsView(PetscViewer viewer)
 {
   PetscErrorCode ierr;
-  PetscInt       i;
+  PetscInt       i,*perm;
   PetscBool      isascii;
 
   PetscFunctionBegin;
@@ -695,13 +779,15 @@ PetscErrorCode  PetscOptionsView(PetscViewer viewer)
   } else {
     ierr = PetscViewerASCIIPrintf(viewer,"#No PETSc Option Table entries\n");CHKERRQ(ierr);
   }
+  ierr = PetscOptionsSorted_Private(&perm);CHKERRQ(ierr);
   for (i=0; i<options->N; i++) {
-    if (options->values[i]) {
-      ierr = PetscViewerASCIIPrintf(viewer,"-%s %s\n",options->names[i],options->values[i]);CHKERRQ(ierr);
+    if (options->values[perm[i]]) {
+      ierr = PetscViewerASCIIPrintf(viewer,"-%s %s\n",options->names[perm[i]],options->values[perm[i]]);CHKERRQ(ierr);
     } else {
-      ierr = PetscViewerASCIIPrintf(viewer,"-%s\n",options->names[i]);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"-%s\n",options->names[perm[i]]);CHKERRQ(ierr);
     }
   }
+  free(perm);
   if (options->N) {
     ierr = PetscViewerASCIIPrintf(viewer,"#End of PETSc Option Table entries\n");CHKERRQ(ierr);
   }
@@ -729,7 +815,7 @@ PetscErrorCode  PetscOptionsView(PetscViewer viewer)
 PetscErrorCode  PetscOptionsGetAll(char *copts[])
 {
   PetscErrorCode ierr;
-  PetscInt       i;
+  PetscInt       i,*perm;
   size_t         len       = 1,lent = 0;
   char           *coptions = NULL;
 
@@ -747,15 +833,17 @@ PetscErrorCode  PetscOptionsGetAll(char *copts[])
   }
   ierr = PetscMalloc(len*sizeof(char),&coptions);CHKERRQ(ierr);
   coptions[0] = 0;
+  ierr        = PetscOptionsSorted_Private(&perm);CHKERRQ(ierr);
   for (i=0; i<options->N; i++) {
     ierr = PetscStrcat(coptions,"-");CHKERRQ(ierr);
-    ierr = PetscStrcat(coptions,options->names[i]);CHKERRQ(ierr);
+    ierr = PetscStrcat(coptions,options->names[perm[i]]);CHKERRQ(ierr);
     ierr = PetscStrcat(coptions," ");CHKERRQ(ierr);
-    if (options->values[i]) {
-      ierr = PetscStrcat(coptions,options->values[i]);CHKERRQ(ierr);
+    if (options->values[perm[i]]) {
+      ierr = PetscStrcat(coptions,options->values[perm[i]]);CHKERRQ(ierr);
       ierr = PetscStrcat(coptions," ");CHKERRQ(ierr);
     }
   }
+  free(perm);
   *copts = coptions;
   PetscFunctionReturn(0);
 }
@@ -846,7 +934,8 @@ PetscErrorCode  PetscOptionsPrefixPop(void)
 @*/
 PetscErrorCode  PetscOptionsClear(void)
 {
-  PetscInt i;
+  PetscErrorCode ierr;
+  PetscInt       i;
 
   PetscFunctionBegin;
   if (!options) PetscFunctionReturn(0);
@@ -858,6 +947,7 @@ PetscErrorCode  PetscOptionsClear(void)
     free(options->aliases1[i]);
     free(options->aliases2[i]);
   }
+  if (options->hash) {ierr = PetscMemzero(options->hash,options->Nhash*sizeof(int));CHKERRQ(ierr);}
   options->prefix[0] = 0;
   options->prefixind = 0;
   options->N         = 0;
@@ -885,6 +975,10 @@ PetscErrorCode  PetscOptionsDestroy(void)
   PetscFunctionBegin;
   if (!options) PetscFunctionReturn(0);
   ierr = PetscOptionsClear();CHKERRQ(ierr);
+  free(options->names);
+  free(options->values);
+  free(options->used);
+  free(options->hash);
   free(options);
   options = 0;
   PetscFunctionReturn(0);
@@ -920,10 +1014,9 @@ PetscErrorCode  PetscOptionsSetValue(const char iname[],const char value[])
   size_t         len;
   PetscErrorCode ierr;
   PetscInt       N,n,i;
-  char           **names;
   char           fullname[2048];
   const char     *name = iname;
-  PetscBool      gt,match;
+  PetscBool      match;
 
   PetscFunctionBegin;
   if (!options) {ierr = PetscOptionsInsert(0,0,0);CHKERRQ(ierr);}
@@ -949,36 +1042,30 @@ PetscErrorCode  PetscOptionsSetValue(const char iname[],const char value[])
     }
   }
 
-  N     = options->N;
-  n     = N;
-  names = options->names;
-
-  for (i=0; i<N; i++) {
-    ierr = PetscStrcasecmp(names[i],name,&match);CHKERRQ(ierr);
-    ierr = PetscStrgrt(names[i],name,&gt);CHKERRQ(ierr);
-    if (match) {
-      if (options->values[i]) free(options->values[i]);
-      ierr = PetscStrlen(value,&len);CHKERRQ(ierr);
-      if (len) {
-        options->values[i] = (char*)malloc((len+1)*sizeof(char));
-        ierr = PetscStrcpy(options->values[i],value);CHKERRQ(ierr);
-      } else options->values[i] = 0;
-      PetscOptionsMonitor(name,value);
-      PetscFunctionReturn(0);
-    } else if (gt) {
-      n = i;
-      break;
-    }
+  ierr = PetscOptionsHashFind_Private(name,&i);CHKERRQ(ierr);
+  if (i >= 0) {
+    if (options->values[i]) free(options->values[i]);
+    ierr = PetscStrlen(value,&len);CHKERRQ(ierr);
+    if (len) {
+      options->values[i] = (char*)malloc((len+1)*sizeof(char));
+      ierr = PetscStrcpy(options->values[i],value);CHKERRQ(ierr);
+    } else options->values[i] = 0;
+    PetscOptionsMonitor(name,value);
+    PetscFunctionReturn(0);
   }
-  if (N >= MAXOPTIONS) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"No more room in option table, limit %d recompile \n src/sys/objects/options.c with larger value for MAXOPTIONS\n",MAXOPTIONS);
 
-  /* shift remaining values down 1 */
-  for (i=N; i>n; i--) {
-    options->names[i]  = options->names[i-1];
-    options->values[i] = options->values[i-1];
-    options->used[i]   = options->used[i-1];
+  N = options->N;
+  if (N >= options->Nalloc) {
+    int nalloc = options->Nalloc ? 2*options->Nalloc : 128;
+
+    options->names  = (char**)realloc(options->names,nalloc*sizeof(char*));
+    options->values = (char**)realloc(options->values,nalloc*sizeof(char*));
+    options->used   = (PetscBool*)realloc(options->used,nalloc*sizeof(PetscBool));
+    if (!options->names || !options->values || !options->used) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to allocate room for %d options",nalloc);
+    options->Nalloc = nalloc;
   }
-  /* insert new name and value */
+  /* append the new name and value */
+  n    = N;
   ierr = PetscStrlen(name,&len);CHKERRQ(ierr);
   options->names[n] = (char*)malloc((len+1)*sizeof(char));
   ierr = PetscStrcpy(options->names[n],name);CHKERRQ(ierr);
@@ -989,6 +1076,14 @@ PetscErrorCode  PetscOptionsSetValue(const char iname[],const char value[])
   } else options->values[n] = 0;
   options->used[n] = PETSC_FALSE;
   options->N++;
+  if (2*options->N > options->Nhash) {
+    ierr = PetscOptionsHashRebuild_Private();CHKERRQ(ierr);
+  } else {
+    unsigned int h;
+
+    for (h=PetscOptionsHash_Private(options->names[n])&(options->Nhash-1); options->hash[h]; h=(h+1)&(options->Nhash-1)) ;
+    options->hash[h] = n+1;
+  }
   PetscOptionsMonitor(name,value);
   PetscFunctionReturn(0);
 }
@@ -1013,9 +1108,8 @@ PetscErrorCode  PetscOptionsSetValue(const char iname[],const char value[])
 PetscErrorCode  PetscOptionsClearValue(const char iname[])
 {
   PetscErrorCode ierr;
-  PetscInt       N,n,i;
-  char           **names,*name=(char*)iname;
-  PetscBool      gt,match;
+  PetscInt       i,N;
+  char           *name=(char*)iname;
 
   PetscFunctionBegin;
   if (name[0] != '-') SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Name must begin with -: Instead %s",name);
@@ -1023,30 +1117,18 @@ PetscErrorCode  PetscOptionsClearValue(const char iname[])
 
   name++;
 
-  N     = options->N; n = 0;
-  names = options->names;
-
-  for (i=0; i<N; i++) {
-    ierr  = PetscStrcasecmp(names[i],name,&match);CHKERRQ(ierr);
-    ierr  = PetscStrgrt(names[i],name,&gt);CHKERRQ(ierr);
-    if (match) {
-      if (options->names[i])  free(options->names[i]);
-      if (options->values[i]) free(options->values[i]);
-      PetscOptionsMonitor(name,"");
-      break;
-    } else if (gt) PetscFunctionReturn(0); /* it was not listed */
-
-    n++;
-  }
-  if (n == N) PetscFunctionReturn(0); /* it was not listed */
-
-  /* shift remaining values down 1 */
-  for (i=n; i<N-1; i++) {
-    options->names[i]  = options->names[i+1];
-    options->values[i] = options->values[i+1];
-    options->used[i]   = options->used[i+1];
-  }
-  options->N--;
+  ierr = PetscOptionsHashFind_Private(name,&i);CHKERRQ(ierr);
+  if (i < 0) PetscFunctionReturn(0); /* it was not listed */
+  free(options->names[i]);
+  if (options->values[i]) free(options->values[i]);
+  PetscOptionsMonitor(name,"");
+
+  /* move the last option into the hole */
+  N                  = --options->N;
+  options->names[i]  = options->names[N];
+  options->values[i] = options->values[N];
+  options->used[i]   = options->used[N];
+  ierr = PetscOptionsHashRebuild_Private();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1099,15 +1181,12 @@ PetscErrorCode  PetscOptionsSetAlias(const char inewname[],const char ioldname[]
 PetscErrorCode PetscOptionsFindPair_Private(const char pre[],const char name[],char *value[],PetscBool  *flg)
 {
   PetscErrorCode ierr;
-  PetscInt       i,N;
+  PetscInt       i;
   size_t         len;
-  char           **names,tmp[256];
-  PetscBool      match;
+  char           tmp[256];
 
   PetscFunctionBegin;
   if (!options) {ierr = PetscOptionsInsert(0,0,0);CHKERRQ(ierr);}
-  N     = options->N;
-  names = options->names;
 
   if (name[0] != '-') SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Name must begin with -: Instead %s",name);
 
@@ -1139,18 +1218,13 @@ PetscErrorCode PetscOptionsFindPair_Private(const char pre[],const char name[],c
   }
 #endif
 
-  /* slow search */
   *flg = PETSC_FALSE;
-  for (i=0; i<N; i++) {
-    ierr = PetscStrcasecmp(names[i],tmp,&match);CHKERRQ(ierr);
-    if (match) {
-      *value           = options->values[i];
-      options->used[i] = PETSC_TRUE;
-      *flg             = PETSC_TRUE;
-      break;
-    }
-  }
-  if (!*flg) {
+  ierr = PetscOptionsHashFind_Private(tmp,&i);CHKERRQ(ierr);
+  if (i >= 0) {
+    *value           = options->values[i];
+    options->used[i] = PETSC_TRUE;
+    *flg             = PETSC_TRUE;
+  } else {
     PetscInt j,cnt = 0,locs[16],loce[16];
     size_t   n;
     ierr = PetscStrlen(tmp,&n);CHKERRQ(ierr);
@@ -1186,7 +1260,7 @@ PetscErrorCode PetscOptionsFindPair_Private(const char pre[],const char name[],c
 PETSC_EXTERN PetscErrorCode PetscOptionsFindPairPrefix_Private(const char pre[], const char name[], char *value[], PetscBool *flg)
 {
   PetscErrorCode ierr;
-  PetscInt       i,N;
+  PetscInt       i,N,first = -1;
   size_t         len;
   char           **names,tmp[256];
   PetscBool      match;
@@ -1226,18 +1300,21 @@ PETSC_EXTERN PetscErrorCode PetscOptionsFindPairPrefix_Private(const char pre[],
   }
 #endif
 
-  /* slow search */
-  *flg = PETSC_FALSE;
+  /* slow search, finding the first matching option in alphabetical order */
+  if (flg) *flg = PETSC_FALSE;
   ierr = PetscStrlen(tmp,&len);CHKERRQ(ierr);
   for (i = 0; i < N; ++i) {
     ierr = PetscStrncmp(names[i], tmp, len, &match);CHKERRQ(ierr);
     if (match) {
-      if (value) *value = options->values[i];
-      options->used[i]  = PETSC_TRUE;
-      if (flg)   *flg   = PETSC_TRUE;
-      break;
+      if (first >= 0) {ierr = PetscStrgrt(names[first],names[i],&match);CHKERRQ(ierr);}
+      if (match) first = i;
     }
   }
+  if (first >= 0) {
+    if (value) *value     = options->values[first];
+    options->used[first]  = PETSC_TRUE;
+    if (flg)   *flg       = PETSC_TRUE;
+  }
   PetscFunctionReturn(0);
 }
 
@@ -2091,12 +2168,10 @@ PetscErrorCode  PetscOptionsUsed(const char *option,PetscBool *used)
 
   PetscFunctionBegin;
   *used = PETSC_FALSE;
-  for (i=0; i<options->N; i++) {
+  ierr  = PetscOptionsHashFind_Private(option,&i);CHKERRQ(ierr);
+  if (i >= 0) {
     ierr = PetscStrcmp(options->names[i],option,used);CHKERRQ(ierr);
-    if (*used) {
-      *used = options->used[i];
-      break;
-    }
+    if (*used) *used = options->used[i];
   }
   PetscFunctionReturn(0);
 }
@@ -2145,10 +2220,12 @@ PetscErrorCode  PetscOptionsAllUsed(PetscInt *N)
 PetscErrorCode  PetscOptionsLeft(void)
 {
   PetscErrorCode ierr;
-  PetscInt       i;
+  PetscInt       i,j,*perm;
 
   PetscFunctionBegin;
-  for (i=0; i<options->N; i++) {
+  ierr = PetscOptionsSorted_Private(&perm);CHKERRQ(ierr);
+  for (j=0; j<options->N; j++) {
+    i = perm[j];
     if (!options->used[i]) {
       if (options->values[i]) {
         ierr = PetscPrintf(PETSC_COMM_WORLD,"Option left: name:-%s value: %s\n",options->names[i],options->values[i]);CHKERRQ(ierr);
@@ -2157,6 +2234,7 @@ PetscErrorCode  PetscOptionsLeft(void)
       }
     }
   }
+  free(perm);
   PetscFunctionReturn(0);
 }
 
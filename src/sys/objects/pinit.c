@@ -11,6 +11,7 @@
 #endif
 
 #include <petscthreadcomm.h>
+#include <petsctime.h>
 
 #if defined(PETSC_USE_LOG)
 extern PetscErrorCode PetscLogBegin_Private(void);
@@ -553,6 +554,50 @@ PetscErrorCode  PetscFreeArguments(char **args)
   PetscFunctionReturn(0);
 }
 
+/*
+     The times at which the phases of PetscInitialize() end, printed with -log_startup
+*/
+#define PETSC_STARTUP_MAX_PHASES 16
+static PetscLogDouble PetscStartupTimes[PETSC_STARTUP_MAX_PHASES];
+static const char     *PetscStartupPhases[PETSC_STARTUP_MAX_PHASES];
+static int            PetscStartupNumPhases = 0;
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscStartupPhaseEnd_Private"
+static PetscErrorCode PetscStartupPhaseEnd_Private(const char phase[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscStartupNumPhases == PETSC_STARTUP_MAX_PHASES) PetscFunctionReturn(0);
+  ierr = PetscTime(&PetscStartupTimes[PetscStartupNumPhases]);CHKERRQ(ierr);
+  PetscStartupPhases[PetscStartupNumPhases++] = phase;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscStartupView_Private"
+/*
+     Prints the time of each phase of PetscInitialize(), the maximum over the processes
+*/
+static PetscErrorCode PetscStartupView_Private(void)
+{
+  PetscErrorCode ierr;
+  PetscLogDouble local[PETSC_STARTUP_MAX_PHASES],times[PETSC_STARTUP_MAX_PHASES];
+  int            i,n = PetscStartupNumPhases-1;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) local[i] = PetscStartupTimes[i+1] - PetscStartupTimes[i];
+  local[n] = PetscStartupTimes[n] - PetscStartupTimes[0];
+  ierr     = MPI_Allreduce(local,times,n+1,MPIU_PETSCLOGDOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr     = PetscPrintf(PETSC_COMM_WORLD,"PetscInitialize() time by phase, maximum over the processes:\n");CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  %-36s %10.4e sec %5.1f%%\n",PetscStartupPhases[i+1],times[i],times[n] > 0.0 ? 100.0*times[i]/times[n] : 0.0);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"  %-36s %10.4e sec\n","Total",times[n]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscInitialize"
 /*@C
@@ -614,7 +659,8 @@ PetscErrorCode  PetscFreeArguments(char **args)
 .  -log_summary_python [filename] - Prints data on of flop and timing usage to a file or screen. See PetscLogPrintSViewPython().
 .  -log_all [filename] - Logs extensive profiling information  See PetscLogDump().
 .  -log [filename] - Logs basic profiline information  See PetscLogDump().
--  -log_mpe [filename] - Creates a logfile viewable by the utility Jumpshot (in MPICH distribution)
+.  -log_mpe [filename] - Creates a logfile viewable by the utility Jumpshot (in MPICH distribution)
+-  -log_startup - Prints the time spent in each phase of PetscInitialize()
 
     Only one of -log_trace, -log_summary, -log_all, -log, or -log_mpe may be used at a time
 
@@ -663,6 +709,8 @@ PetscErrorCode  PetscInitialize(int *argc,char ***args,const char file[],const c
 
   PetscFunctionBegin;
   if (PetscInitializeCalled) PetscFunctionReturn(0);
+  PetscStartupNumPhases = 0;
+  ierr = PetscStartupPhaseEnd_Private(NULL);CHKERRQ(ierr);
 
   /* these must be initialized in a routine, not as a constant declaration*/
   PETSC_STDOUT = stdout;
@@ -693,6 +741,7 @@ PetscErrorCode  PetscInitialize(int *argc,char ***args,const char file[],const c
 #endif
     PetscBeganMPI = PETSC_TRUE;
   }
+  ierr = PetscStartupPhaseEnd_Private("MPI_Init()");CHKERRQ(ierr);
   if (argc && args) {
     PetscGlobalArgc = *argc;
     PetscGlobalArgs = *args;
@@ -775,7 +824,9 @@ PetscErrorCode  PetscInitialize(int *argc,char ***args,const char file[],const c
   /*
      Build the options database
   */
+  ierr = PetscStartupPhaseEnd_Private("MPI datatypes and operations");CHKERRQ(ierr);
   ierr = PetscOptionsInsert(argc,args,file);CHKERRQ(ierr);
+  ierr = PetscStartupPhaseEnd_Private("Options database");CHKERRQ(ierr);
 
 
   /*
@@ -786,18 +837,20 @@ PetscErrorCode  PetscInitialize(int *argc,char ***args,const char file[],const c
     ierr = PetscPrintf(PETSC_COMM_WORLD,help);CHKERRQ(ierr);
   }
   ierr = PetscOptionsCheckInitial_Private();CHKERRQ(ierr);
-
+  ierr = PetscStartupPhaseEnd_Private("Memory, debugger and error handling");CHKERRQ(ierr);
 
   /* SHOULD PUT IN GUARDS: Make sure logging is initialized, even if we do not print it out */
 #if defined(PETSC_USE_LOG)
   ierr = PetscLogBegin_Private();CHKERRQ(ierr);
 #endif
+  ierr = PetscStartupPhaseEnd_Private("Logging");CHKERRQ(ierr);
 
   /*
      Load the dynamic libraries (on machines that support them), this registers all
      the solvers etc. (On non-dynamic machines this initializes the PetscDraw and PetscViewer classes)
   */
   ierr = PetscInitialize_DynamicLibraries();CHKERRQ(ierr);
+  ierr = PetscStartupPhaseEnd_Private("Dynamic libraries");CHKERRQ(ierr);
 
   ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
   ierr = PetscInfo1(0,"PETSc successfully started: number of processors = %d\n",size);CHKERRQ(ierr);
@@ -855,7 +908,9 @@ PetscErrorCode  PetscInitialize(int *argc,char ***args,const char file[],const c
     ierr = PetscPythonInitialize(NULL,NULL);CHKERRQ(ierr);
   }
 
+  ierr = PetscStartupPhaseEnd_Private("Components and options monitors");CHKERRQ(ierr);
   ierr = PetscThreadCommInitializePackage();CHKERRQ(ierr);
+  ierr = PetscStartupPhaseEnd_Private("Thread communicators");CHKERRQ(ierr);
 
   /*
       Setup building of stack frames for all function calls
@@ -870,6 +925,11 @@ PetscErrorCode  PetscInitialize(int *argc,char ***args,const char file[],const c
 #endif
 
   ierr = PetscCitationsInitialize();CHKERRQ(ierr);
+  ierr = PetscStartupPhaseEnd_Private("Stack and citations");CHKERRQ(ierr);
+
+  flg  = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,"-log_startup",&flg,NULL);CHKERRQ(ierr);
+  if (flg) {ierr = PetscStartupView_Private();CHKERRQ(ierr);}
 
   /*
       Once we are completedly initialized then we can set this variables
@@ -1018,6 +1078,62 @@ PetscErrorCode  PetscFinalize(void)
 
   mname[0] = 0;
 
+  ierr = PetscOptionsGetString(NULL,"-log_nested",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
+  if (flg1) {
+    PetscViewer viewer;
+    if (mname[0]) {
+      ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD,mname,&viewer);CHKERRQ(ierr);
+      ierr = PetscLogNestedView(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+    } else {
+      viewer = PETSC_VIEWER_STDOUT_WORLD;
+      ierr   = PetscLogNestedView(viewer);CHKERRQ(ierr);
+    }
+  }
+
+  mname[0] = 0;
+
+  ierr = PetscOptionsGetString(NULL,"-log_nested_flamegraph",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
+  if (flg1) {
+    PetscViewer viewer;
+    if (mname[0]) {
+      ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD,mname,&viewer);CHKERRQ(ierr);
+      ierr = PetscLogNestedViewFlameGraph(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+    } else {
+      viewer = PETSC_VIEWER_STDOUT_WORLD;
+      ierr   = PetscLogNestedViewFlameGraph(viewer);CHKERRQ(ierr);
+    }
+  }
+
+  mname[0] = 0;
+
+  ierr = PetscOptionsGetString(NULL,"-log_timeline",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
+  if (flg1) {
+    PetscViewer viewer;
+    if (mname[0]) {
+      ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD,mname,&viewer);CHKERRQ(ierr);
+      ierr = PetscLogTimelineView(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+    } else {
+      viewer = PETSC_VIEWER_STDOUT_WORLD;
+      ierr   = PetscLogTimelineView(viewer);CHKERRQ(ierr);
+    }
+  }
+
+  mname[0] = 0;
+
+  ierr = PetscOptionsGetString(NULL,"-log_timeline_binary",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
+  if (flg1) {
+    PetscViewer viewer;
+    if (!mname[0]) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_ARG_WRONG,"Must give a file name with -log_timeline_binary");
+    ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,mname,FILE_MODE_WRITE,&viewer);CHKERRQ(ierr);
+    ierr = PetscLogTimelineView(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  }
+
+  mname[0] = 0;
+
   ierr = PetscOptionsGetString(NULL,"-log_summary_python",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
   if (flg1) {
     PetscViewer viewer;
@@ -1068,6 +1184,7 @@ PetscErrorCode  PetscFinalize(void)
   /* preemptive call to avoid listing this option in options table as unused */
   ierr = PetscOptionsHasName(NULL,"-malloc_dump",&flg1);CHKERRQ(ierr);
   ierr = PetscOptionsHasName(NULL,"-objects_dump",&flg1);CHKERRQ(ierr);
+  ierr = PetscOptionsHasName(NULL,"-malloc_pool_view",&flg1);CHKERRQ(ierr);
   ierr = PetscOptionsGetBool(NULL,"-options_table",&flg2,NULL);CHKERRQ(ierr);
 
   if (flg2) {
@@ -1226,6 +1343,18 @@ PetscErrorCode  PetscFinalize(void)
     }
   }
 
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,"-malloc_pool_view",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {
+    MPI_Comm local_comm;
+
+    ierr = MPI_Comm_dup(MPI_COMM_WORLD,&local_comm);CHKERRQ(ierr);
+    ierr = PetscSequentialPhaseBegin_Private(local_comm,1);CHKERRQ(ierr);
+    ierr = PetscMallocPoolView(stdout);CHKERRQ(ierr);
+    ierr = PetscSequentialPhaseEnd_Private(local_comm,1);CHKERRQ(ierr);
+    ierr = MPI_Comm_free(&local_comm);CHKERRQ(ierr);
+  }
+
 #if defined(PETSC_HAVE_CUDA)
   flg  = PETSC_TRUE;
   ierr = PetscOptionsGetBool(NULL,"-cublas",&flg,NULL);CHKERRQ(ierr);
@@ -1329,6 +1458,7 @@ PetscErrorCode  PetscFinalize(void)
    memory was not freed.
 
 */
+  ierr = PetscMallocPoolDestroy();CHKERRQ(ierr);
   ierr = PetscMallocClear();CHKERRQ(ierr);
 
   PetscInitializeCalled = PETSC_FALSE;
@@ -186,8 +186,8 @@ PetscErrorCode PetscSubcommSetTypeGeneral(PetscSubcomm psubcomm,PetscMPIInt colo
   ierr = MPI_Allgather(sendbuf,2,MPI_INT,recvbuf,2,MPI_INT,comm);CHKERRQ(ierr);
 
   ierr = PetscMalloc(nsubcomm*sizeof(PetscMPIInt),&subsize);CHKERRQ(ierr);
-  for (i=0; i<2*size; i++) {
-    subsize[recvbuf[i]] = recvbuf[i+1];
+  for (i=0; i<size; i++) {
+    subsize[recvbuf[2*i]] = recvbuf[2*i+1];
   }
   ierr = PetscFree(recvbuf);CHKERRQ(ierr);
   
@@ -451,7 +451,9 @@ static PetscErrorCode PetscSFBasicPackWaitall(PetscSF sf,PetscSFBasicPack link)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = PetscLogEventBegin(PETSCSF_Wait,sf,0,0,0);CHKERRQ(ierr);
   ierr = MPI_Waitall(bas->niranks+sf->nranks,link->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(PETSCSF_Wait,sf,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1,6 +1,7 @@
 #include <petsc-private/sfimpl.h>
 
-PetscClassId PETSCSF_CLASSID;
+PetscClassId  PETSCSF_CLASSID;
+PetscLogEvent PETSCSF_Wait;
 
 static PetscBool PetscSFPackageInitialized = PETSC_FALSE;
 
@@ -27,6 +28,8 @@ PetscErrorCode PetscSFInitializePackage(void)
 
   ierr = PetscClassIdRegister("Bipartite Graph",&PETSCSF_CLASSID);CHKERRQ(ierr);
   ierr = PetscSFRegisterAll();CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("SFWait",PETSCSF_CLASSID,&PETSCSF_Wait);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(PETSCSF_Wait,PETSC_TRUE);CHKERRQ(ierr);
   ierr = PetscRegisterFinalize(PetscSFFinalizePackage);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -83,6 +83,7 @@ PetscErrorCode PetscSFReset(PetscSF sf)
   ierr         = PetscSFDestroy(&sf->multi);CHKERRQ(ierr);
   sf->graphset = PETSC_FALSE;
   if (sf->ops->Reset) {ierr = (*sf->ops->Reset)(sf);CHKERRQ(ierr);}
+  sf->degreeknown = PETSC_FALSE;
   sf->setupcalled = PETSC_FALSE;
   PetscFunctionReturn(0);
 }
@@ -298,12 +299,6 @@ PetscErrorCode PetscSFSetGraph(PetscSF sf,PetscInt nroots,PetscInt nleaves,const
       ierr        = PetscMalloc(nleaves*sizeof(*sf->mine),&sf->mine_alloc);CHKERRQ(ierr);
       sf->mine    = sf->mine_alloc;
       ierr        = PetscMemcpy(sf->mine,ilocal,nleaves*sizeof(*sf->mine));CHKERRQ(ierr);
-      sf->minleaf = PETSC_MAX_INT;
-      sf->maxleaf = PETSC_MIN_INT;
-      for (i=0; i<nleaves; i++) {
-        sf->minleaf = PetscMin(sf->minleaf,ilocal[i]);
-        sf->maxleaf = PetscMax(sf->maxleaf,ilocal[i]);
-      }
       break;
     case PETSC_OWN_POINTER:
       sf->mine_alloc = (PetscInt*)ilocal;
@@ -315,7 +310,14 @@ PetscErrorCode PetscSFSetGraph(PetscSF sf,PetscInt nroots,PetscInt nleaves,const
     default: SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_OUTOFRANGE,"Unknown localmode");
     }
   }
-  if (!ilocal || nleaves > 0) {
+  if (ilocal) {
+    sf->minleaf = PETSC_MAX_INT;
+    sf->maxleaf = PETSC_MIN_INT;
+    for (i=0; i<nleaves; i++) {
+      sf->minleaf = PetscMin(sf->minleaf,ilocal[i]);
+      sf->maxleaf = PetscMax(sf->maxleaf,ilocal[i]);
+    }
+  } else {
     sf->minleaf = 0;
     sf->maxleaf = nleaves - 1;
   }
@@ -1043,11 +1045,11 @@ PetscErrorCode PetscSFComputeDegreeBegin(PetscSF sf,const PetscInt **degree)
   PetscSFCheckGraphSet(sf,1);
   PetscValidPointer(degree,2);
   if (!sf->degree) {
-    PetscInt i;
+    PetscInt i,nleafdata = PetscMax(sf->maxleaf+1,0); /* Leaf data is indexed by the local leaf numbers */
     ierr = PetscMalloc(sf->nroots*sizeof(PetscInt),&sf->degree);CHKERRQ(ierr);
-    ierr = PetscMalloc(sf->nleaves*sizeof(PetscInt),&sf->degreetmp);CHKERRQ(ierr);
+    ierr = PetscMalloc(nleafdata*sizeof(PetscInt),&sf->degreetmp);CHKERRQ(ierr);
     for (i=0; i<sf->nroots; i++) sf->degree[i] = 0;
-    for (i=0; i<sf->nleaves; i++) sf->degreetmp[i] = 1;
+    for (i=0; i<nleafdata; i++) sf->degreetmp[i] = 1;
     ierr = PetscSFReduceBegin(sf,MPIU_INT,sf->degreetmp,sf->degree,MPIU_SUM);CHKERRQ(ierr);
   }
   *degree = NULL;
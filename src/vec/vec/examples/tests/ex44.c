@@ -0,0 +1,31 @@
+static char help[] = "Tests that the parallel reductions are logged as wait events when an IS is created before any Vec.\n\
+Run with -log_summary on more than one process; the load balance table lists VecReduceComm.\n\n";
+#include <petscvec.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  IS             is;
+  Vec            x,y;
+  PetscInt       i,n = 100;
+  PetscScalar    dot;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  /* initializes the IS package before the Vec package */
+  ierr = ISCreateStride(PETSC_COMM_WORLD,n,0,1,&is);CHKERRQ(ierr);
+  ierr = VecCreateMPI(PETSC_COMM_WORLD,n,PETSC_DECIDE,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  ierr = VecSet(y,2.0);CHKERRQ(ierr);
+  for (i=0; i<200; i++) {
+    ierr = VecDot(x,y,&dot);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = ISDestroy(&is);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -13,7 +13,9 @@ static PetscErrorCode VecDot_MPI(Vec xin,Vec yin,PetscScalar *z)
 
   PetscFunctionBegin;
   ierr = VecDot_Seq(xin,yin,&work);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   ierr = MPI_Allreduce(&work,&sum,1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   *z   = sum;
   PetscFunctionReturn(0);
 }
@@ -27,7 +29,9 @@ static PetscErrorCode VecTDot_MPI(Vec xin,Vec yin,PetscScalar *z)
 
   PetscFunctionBegin;
   ierr = VecTDot_Seq(xin,yin,&work);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   ierr = MPI_Allreduce(&work,&sum,1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   *z   = sum;
   PetscFunctionReturn(0);
 }
@@ -196,8 +200,10 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
     PetscInt n = v->map->n+nghost;
     ierr               = PetscMalloc(n*sizeof(PetscScalar),&s->array);CHKERRQ(ierr);
     ierr               = PetscLogObjectMemory((PetscObject)v,n*sizeof(PetscScalar));CHKERRQ(ierr);
-    ierr               = PetscMemzero(s->array,v->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
     s->array_allocated = s->array;
+    /* written first by the threads that use each part, which places its pages on their NUMA nodes */
+    ierr = VecSet_Seq(v,0.0);CHKERRQ(ierr);
+    ierr = PetscMallocPlacementInfo((PetscObject)v,"array",s->array,n*sizeof(PetscScalar));CHKERRQ(ierr);
   }
 
   /* By default parallel vectors do not have local representation */
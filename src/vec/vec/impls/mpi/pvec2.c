@@ -17,7 +17,9 @@ PetscErrorCode VecMDot_MPI(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
     ierr = PetscMalloc(nv*sizeof(PetscScalar),&work);CHKERRQ(ierr);
   }
   ierr = VecMDot_Seq(xin,nv,y,work);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   ierr = MPI_Allreduce(work,z,nv,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   if (nv > 128) {
     ierr = PetscFree(work);CHKERRQ(ierr);
   }
@@ -36,7 +38,9 @@ PetscErrorCode VecMTDot_MPI(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
     ierr = PetscMalloc(nv*sizeof(PetscScalar),&work);CHKERRQ(ierr);
   }
   ierr = VecMTDot_Seq(xin,nv,y,work);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   ierr = MPI_Allreduce(work,z,nv,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   if (nv > 128) {
     ierr = PetscFree(work);CHKERRQ(ierr);
   }
@@ -60,25 +64,33 @@ PetscErrorCode VecNorm_MPI(Vec xin,NormType type,PetscReal *z)
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
     work = PetscRealPart(BLASdot_(&bn,xx,&one,xx,&one));
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     ierr = MPI_Allreduce(&work,&sum,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     *z   = PetscSqrtReal(sum);
     ierr = PetscLogFlops(2.0*xin->map->n);CHKERRQ(ierr);
   } else if (type == NORM_1) {
     /* Find the local part */
     ierr = VecNorm_Seq(xin,NORM_1,&work);CHKERRQ(ierr);
     /* Find the global max */
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     ierr = MPI_Allreduce(&work,z,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   } else if (type == NORM_INFINITY) {
     /* Find the local max */
     ierr = VecNorm_Seq(xin,NORM_INFINITY,&work);CHKERRQ(ierr);
     /* Find the global max */
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     ierr = MPI_Allreduce(&work,z,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   } else if (type == NORM_1_AND_2) {
     PetscReal temp[2];
     ierr = VecNorm_Seq(xin,NORM_1,temp);CHKERRQ(ierr);
     ierr = VecNorm_Seq(xin,NORM_2,temp+1);CHKERRQ(ierr);
     temp[1] = temp[1]*temp[1];
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     ierr = MPI_Allreduce(temp,z,2,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     z[1] = PetscSqrtReal(z[1]);
   }
   PetscFunctionReturn(0);
@@ -145,14 +157,18 @@ PetscErrorCode VecMax_MPI(Vec xin,PetscInt *idx,PetscReal *z)
 
   /* Find the global max */
   if (!idx) {
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     ierr = MPI_Allreduce(&work,z,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   } else {
     PetscReal work2[2],z2[2];
     PetscInt  rstart;
     rstart   = xin->map->rstart;
     work2[0] = work;
     work2[1] = *idx + rstart;
-    ierr     = MPI_Allreduce(work2,z2,2,MPIU_REAL,VecMax_Local_Op,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
+    ierr = MPI_Allreduce(work2,z2,2,MPIU_REAL,VecMax_Local_Op,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     *z       = z2[0];
     *idx     = (PetscInt)z2[1];
   }
@@ -172,7 +188,9 @@ PetscErrorCode VecMin_MPI(Vec xin,PetscInt *idx,PetscReal *z)
 
   /* Find the global Min */
   if (!idx) {
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     ierr = MPI_Allreduce(&work,z,1,MPIU_REAL,MPIU_MIN,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
   } else {
     PetscReal work2[2],z2[2];
     PetscInt  rstart;
@@ -180,7 +198,9 @@ PetscErrorCode VecMin_MPI(Vec xin,PetscInt *idx,PetscReal *z)
     ierr = VecGetOwnershipRange(xin,&rstart,NULL);CHKERRQ(ierr);
     work2[0] = work;
     work2[1] = *idx + rstart;
+    ierr = PetscLogEventBegin(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     ierr = MPI_Allreduce(work2,z2,2,MPIU_REAL,VecMin_Local_Op,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceCommunication,xin,0,0,0);CHKERRQ(ierr);
     *z   = z2[0];
     *idx = (PetscInt)z2[1];
   }
@@ -42,7 +42,9 @@ PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec V)
   s                  = (Vec_Seq*)V->data;
   s->array_allocated = array;
 
+  /* VecSet() writes the array first, each thread its own part, which places its pages */
   ierr = VecSet(V,0.0);CHKERRQ(ierr);
+  ierr = PetscMallocPlacementInfo((PetscObject)V,"array",array,n*sizeof(PetscScalar));CHKERRQ(ierr);
 #else
   switch (((PetscObject)V)->precision) {
   case PETSC_PRECISION_SINGLE: {
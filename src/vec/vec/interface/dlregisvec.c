@@ -151,6 +151,7 @@ PetscErrorCode  VecInitializePackage(void)
   ierr = PetscLogEventRegister("VecScatterBarrie", VEC_CLASSID,&VEC_ScatterBarrier);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecScatterBegin",  VEC_CLASSID,&VEC_ScatterBegin);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecScatterEnd",    VEC_CLASSID,&VEC_ScatterEnd);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("VecScatterWait",   VEC_CLASSID,&VEC_ScatterWait);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecSetRandom",     VEC_CLASSID,&VEC_SetRandom);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecReduceArith",   VEC_CLASSID,&VEC_ReduceArithmetic);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecReduceBarrier", VEC_CLASSID,&VEC_ReduceBarrier);CHKERRQ(ierr);
@@ -168,6 +169,15 @@ PetscErrorCode  VecInitializePackage(void)
   ierr = PetscLogEventRegister("VecViennaCLCopyTo",     VEC_CLASSID,&VEC_ViennaCLCopyToGPU);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecViennaCLCopyFrom",   VEC_CLASSID,&VEC_ViennaCLCopyFromGPU);CHKERRQ(ierr);
 #endif
+  /* Events that only wait for other processes, for the load balance in PetscLogView() */
+  ierr = PetscLogEventSetWait(VEC_DotBarrier, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(VEC_DotNormBarrier, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(VEC_MDotBarrier, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(VEC_NormBarrier, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(VEC_ScatterBarrier, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(VEC_ScatterWait, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(VEC_ReduceBarrier, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscLogEventSetWait(VEC_ReduceCommunication, PETSC_TRUE);CHKERRQ(ierr);
   /* Turn off high traffic events by default */
   ierr = PetscLogEventSetActiveAll(VEC_DotBarrier, PETSC_FALSE);CHKERRQ(ierr);
   ierr = PetscLogEventSetActiveAll(VEC_DotNormBarrier, PETSC_FALSE);CHKERRQ(ierr);
@@ -177,27 +177,32 @@ PetscErrorCode PETSCMAP1(VecScatterEnd)(VecScatter ctx,Vec xin,Vec yin,InsertMod
   rstarts = from->starts;
 
   if (ctx->packtogether || (to->use_alltoallw && (addv != INSERT_VALUES)) || (to->use_alltoallv && !to->use_alltoallw) || to->use_window) {
+    ierr = PetscLogEventBegin(VEC_ScatterWait,ctx,xin,yin,0);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPI_WIN_CREATE)
     if (to->use_window) {ierr = MPI_Win_fence(0,from->window);CHKERRQ(ierr);}
     else
 #endif
     if (nrecvs && !to->use_alltoallv) {ierr = MPI_Waitall(nrecvs,rwaits,rstatus);CHKERRQ(ierr);}
+    ierr = PetscLogEventEnd(VEC_ScatterWait,ctx,xin,yin,0);CHKERRQ(ierr);
     ierr = PETSCMAP1(UnPack)(from->starts[from->n],from->values,indices,yv,addv);CHKERRQ(ierr);
   } else if (!to->use_alltoallw) {
     /* unpack one at a time */
     count = nrecvs;
     while (count) {
+      ierr = PetscLogEventBegin(VEC_ScatterWait,ctx,xin,yin,0);CHKERRQ(ierr);
       if (ctx->reproduce) {
         imdex = count - 1;
         ierr  = MPI_Wait(rwaits+imdex,&xrstatus);CHKERRQ(ierr);
       } else {
         ierr = MPI_Waitany(nrecvs,rwaits,&imdex,&xrstatus);CHKERRQ(ierr);
       }
+      ierr = PetscLogEventEnd(VEC_ScatterWait,ctx,xin,yin,0);CHKERRQ(ierr);
       /* unpack receives into our local space */
       ierr = PETSCMAP1(UnPack)(rstarts[imdex+1] - rstarts[imdex],rvalues + bs*rstarts[imdex],indices + rstarts[imdex],yv,addv);CHKERRQ(ierr);
       count--;
     }
   }
+  ierr = PetscLogEventBegin(VEC_ScatterWait,ctx,xin,yin,0);CHKERRQ(ierr);
   if (from->use_readyreceiver) {
     if (nrecvs) {ierr = MPI_Startall_irecv(from->starts[nrecvs]*bs,nrecvs,rwaits);CHKERRQ(ierr);}
     ierr = MPI_Barrier(PetscObjectComm((PetscObject)ctx));CHKERRQ(ierr);
@@ -205,6 +210,7 @@ PetscErrorCode PETSCMAP1(VecScatterEnd)(VecScatter ctx,Vec xin,Vec yin,InsertMod
 
   /* wait on sends */
   if (nsends  && !to->use_alltoallv  && !to->use_window) {ierr = MPI_Waitall(nsends,swaits,sstatus);CHKERRQ(ierr);}
+  ierr = PetscLogEventEnd(VEC_ScatterWait,ctx,xin,yin,0);CHKERRQ(ierr);
   ierr = VecRestoreArray(yin,&yv);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }